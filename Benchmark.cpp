@@ -0,0 +1,420 @@
+///============================================================================
+///@file	Benchmark.cpp
+///@brief	Benchmark Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "Benchmark.h"
+#include "MemoryStats.h"
+#include "FramePacer.h"
+#include "Thread.h"
+#include "Simd8.h"
+
+#include <math.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+const GLfloat PATH_NOD		= 25.0f;	// Largest rotation around X, in degrees
+const GLfloat PATH_ZOOM		= 35.0f;	// Closest the camera gets to its start
+const int REPORT_VERSION	= 1;		// Bumped when the report layout changes
+
+static const char *s_TierNames[QT_COUNT] = {"low", "medium", "high"};
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+Benchmark::Benchmark()
+{
+	m_Warmup		= 0;
+	m_Frames		= 0;
+	m_Frame			= 0;
+	m_StartTime		= 0.0;
+	m_EndTime		= 0.0;
+	m_DrawCalls		= 0;
+	m_Triangles		= 0;
+	m_DrawFrames	= 0;
+	m_Counters		= NULL;
+	m_CountedFrames	= 0;
+	m_Vertices		= 0.0;
+	m_Renderer		= "unknown";
+	m_Quality		= QT_HIGH;
+	m_Width			= 0;
+	m_Height		= 0;
+}
+
+///----------------------------------------------------------------------------
+///Starts a run from the first frame of the warm up.
+///@param	warmupFrames - frames rendered before measuring
+///@param	frames - frames measured
+///----------------------------------------------------------------------------
+void Benchmark::Start(int warmupFrames, int frames)
+{
+	m_Warmup		= warmupFrames > 0 ? warmupFrames : 0;
+	m_Frames		= frames > 0 ? frames : 1;
+	m_Frame			= 0;
+	m_DrawCalls		= 0;
+	m_Triangles		= 0;
+	m_DrawFrames	= 0;
+	m_CountedFrames	= 0;
+	m_Vertices		= 0.0;
+	m_StartTime		= FramePacer::GetTime();
+	m_EndTime		= m_StartTime;
+}
+
+///----------------------------------------------------------------------------
+///Moves on to the next frame once the current one has been rendered.
+///@return	true when the warm up just ended, the times recorded so far
+///			should be cleared
+///----------------------------------------------------------------------------
+bool Benchmark::NextFrame()
+{
+	if(!IsRunning())
+		return false;
+
+	m_Frame++;
+
+	if(m_Frame == m_Warmup + m_Frames)
+		m_EndTime = FramePacer::GetTime();
+
+	if(m_Frame != m_Warmup)
+		return false;
+
+	m_StartTime = FramePacer::GetTime();
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Tells whether frames are still to be rendered.
+///@return	true during the warm up & the measured frames
+///----------------------------------------------------------------------------
+bool Benchmark::IsRunning() const
+{
+	return m_Frame < m_Warmup + m_Frames;
+}
+
+///----------------------------------------------------------------------------
+///Tells whether the current frame is part of the warm up.
+///@return	true if it isn't measured
+///----------------------------------------------------------------------------
+bool Benchmark::IsWarmingUp() const
+{
+	return m_Frame < m_Warmup;
+}
+
+///----------------------------------------------------------------------------
+///Tells whether a run was started & every frame of it rendered.
+///@return	true if the report can be written
+///----------------------------------------------------------------------------
+bool Benchmark::IsFinished() const
+{
+	return m_Frames > 0 && !IsRunning();
+}
+
+///----------------------------------------------------------------------------
+///Gets the pose of the current frame. The warm up goes over the whole path
+///faster, so every view has been drawn once before measuring.
+///@param	pose - receives the model rotation & camera
+///----------------------------------------------------------------------------
+void Benchmark::GetPose(CameraPose &pose) const
+{
+	if(IsWarmingUp())
+		GetPathPose(m_Frame, m_Warmup, pose);
+	else
+		GetPathPose(m_Frame - m_Warmup, m_Frames, pose);
+}
+
+///----------------------------------------------------------------------------
+///Adds the draw calls & triangles of the current frame, warm up frames
+///aren't counted.
+///@param	stats - what the backend submitted
+///----------------------------------------------------------------------------
+void Benchmark::AddDrawStats(const DrawStats &stats)
+{
+	if(IsWarmingUp() || !IsRunning())
+		return;
+
+	m_DrawCalls	+= stats.drawCalls;
+	m_Triangles	+= stats.triangles;
+	m_DrawFrames++;
+}
+
+///----------------------------------------------------------------------------
+///Adds the hardware counts of the current frame, warm up frames aren't
+///counted.
+///@param	start - counts read before the frame's CPU work
+///@param	end - counts read after it
+///@param	vertices - vertices the frame submitted or transformed
+///----------------------------------------------------------------------------
+void Benchmark::AddCounters(const CounterValues &start, const CounterValues &end, double vertices)
+{
+	if(IsWarmingUp() || !IsRunning())
+		return;
+
+	PerfCounters::Accumulate(m_FrameCounts, start, end);
+	m_Vertices += vertices;
+	m_CountedFrames++;
+}
+
+///----------------------------------------------------------------------------
+///Sets the hardware counts of the start up (model, textures & shaders).
+///@param	counters - the counters read, NULL or none open for no counters
+///@param	start - counts read before loading
+///@param	end - counts read after it
+///----------------------------------------------------------------------------
+void Benchmark::SetLoadCounters(const PerfCounters *counters, const CounterValues &start, const CounterValues &end)
+{
+	m_Counters = (counters && counters->IsAvailable()) ? counters : NULL;
+
+	PerfCounters::Clear(m_LoadCounts);
+	PerfCounters::Clear(m_FrameCounts);
+	PerfCounters::Accumulate(m_LoadCounts, start, end);
+}
+
+///----------------------------------------------------------------------------
+///Sets what is being benchmarked, for the report.
+///@param	renderer - "core", "legacy" or "software"
+///@param	quality - quality tier of the charcoal shader
+///@param	width - frame width
+///@param	height - frame height
+///----------------------------------------------------------------------------
+void Benchmark::SetConfig(const char *renderer, QualityTier quality, int width, int height)
+{
+	m_Renderer	= renderer;
+	m_Quality	= quality;
+	m_Width		= width;
+	m_Height	= height;
+}
+
+///----------------------------------------------------------------------------
+///Reads the driver strings, the GL context must be current. Runs without
+///a context (CPU renderer) report no driver.
+///----------------------------------------------------------------------------
+void Benchmark::ReadDriverInfo()
+{
+	const char *vendor	= (const char *)glGetString(GL_VENDOR);
+	const char *device	= (const char *)glGetString(GL_RENDERER);
+	const char *version	= (const char *)glGetString(GL_VERSION);
+	const char *glsl	= (const char *)glGetString(GL_SHADING_LANGUAGE_VERSION);
+
+	m_Vendor		= vendor ? vendor : "";
+	m_Device		= device ? device : "";
+	m_Version		= version ? version : "";
+	m_GLSLVersion	= glsl ? glsl : "";
+}
+
+///----------------------------------------------------------------------------
+///Writes the report of a finished run.
+///@param	fileName - the JSON file
+///@param	recorder - the times of the measured frames, the last ones
+///			in its ring are written too
+///@param	profiler - the per stage times, NULL if there are none
+///@return	true if the file was written
+///----------------------------------------------------------------------------
+bool Benchmark::WriteReport(const char *fileName, const FrameRecorder &recorder,
+							const GpuProfiler *profiler) const
+{
+	FILE *file = fopen(fileName, "w");
+	if(!file)
+		return false;
+
+	double elapsed = m_EndTime - m_StartTime;
+
+	fprintf(file, "{\n\"benchmark\": {\"version\": %d, \"path\": \"orbit\", \"warmup_frames\": %d, "
+				  "\"frames\": %d, \"renderer\": ", REPORT_VERSION, m_Warmup, m_Frames);
+	WriteString(file, m_Renderer.c_str());
+	fprintf(file, ", \"quality\": \"%s\", \"width\": %d, \"height\": %d, \"elapsed_s\": %.4f, \"fps\": %.2f},\n",
+			s_TierNames[m_Quality], m_Width, m_Height, elapsed, elapsed > 0.0 ? m_Frames / elapsed : 0.0);
+
+	fprintf(file, "\"build\": ");
+	WriteBuildInfo(file);
+	fprintf(file, ",\n\"host\": ");
+	WriteHostInfo(file);
+
+	fprintf(file, ",\n\"driver\": ");
+	if(m_Vendor.empty())
+	{
+		fprintf(file, "null");
+	}
+	else
+	{
+		fprintf(file, "{\"vendor\": ");
+		WriteString(file, m_Vendor.c_str());
+		fprintf(file, ", \"renderer\": ");
+		WriteString(file, m_Device.c_str());
+		fprintf(file, ", \"version\": ");
+		WriteString(file, m_Version.c_str());
+		fprintf(file, ", \"glsl\": ");
+		WriteString(file, m_GLSLVersion.c_str());
+		fprintf(file, "}");
+	}
+
+	fprintf(file, ",\n\"draws\": ");
+	if(m_DrawFrames == 0)
+	{
+		fprintf(file, "null");
+	}
+	else
+	{
+		fprintf(file, "{\"draw_calls\": %lu, \"triangles\": %lu, \"draw_calls_per_frame\": %.2f, "
+					  "\"triangles_per_frame\": %.2f}",
+				m_DrawCalls, m_Triangles, (double)m_DrawCalls / m_DrawFrames,
+				(double)m_Triangles / m_DrawFrames);
+	}
+
+	//every measured frame if they fit in the ring, for tools/CompareBenchmarks.py
+	fprintf(file, ",\n\"frame_times\": ");
+	recorder.WriteJSON(file, true);
+
+	//the misses per vertex & per pixel of the frames
+	fprintf(file, ",\n\"counters\": ");
+	if(!m_Counters || m_CountedFrames == 0)
+	{
+		fprintf(file, "null");
+	}
+	else
+	{
+		const char *units[3] = {"frame", "vertex", "pixel"};
+		double items[3] = {(double)m_CountedFrames, m_Vertices, (double)m_CountedFrames * m_Width * m_Height};
+
+		fprintf(file, "{\"load\": ");
+		PerfCounters::WriteJSON(file, m_LoadCounts, *m_Counters, NULL, NULL, 0);
+		fprintf(file, ",\n\t\"frames\": ");
+		PerfCounters::WriteJSON(file, m_FrameCounts, *m_Counters, items, units, 3);
+		fprintf(file, "}");
+	}
+
+	//the calls of the measured frames, in the builds that count them
+	fprintf(file, ",\n\"gl_calls\": ");
+	if(GLStats::IsCompiledIn() && GLStats::GetFrameCount() > 0)
+		GLStats::WriteJSON(file);
+	else
+		fprintf(file, "null");
+
+	//live bytes & high-water marks at the end of the run
+	fprintf(file, ",\n\"memory\": ");
+	if(MemoryStats::IsCompiledIn())
+		MemoryStats::WriteJSON(file);
+	else
+		fprintf(file, "null");
+
+	fprintf(file, ",\n\"stages\": ");
+	if(profiler)
+		profiler->WriteJSON(file);
+	else
+		fprintf(file, "null");
+
+	fprintf(file, "\n}\n");
+
+	return fclose(file) == 0;
+}
+
+///----------------------------------------------------------------------------
+///Gets a pose of the path: one turn around the model while it nods up &
+///down twice and the camera moves in and back out. Only the frame number
+///decides the pose, never the time, so every run draws the same frames.
+///@param	frame - the frame, from 0 to frames - 1
+///@param	frames - frames the path is split in
+///@param	pose - receives the model rotation & camera
+///----------------------------------------------------------------------------
+void Benchmark::GetPathPose(int frame, int frames, CameraPose &pose)
+{
+	const double twoPi = 6.283185307179586;
+	double t = (frames > 0) ? (double)frame / frames : 0.0;
+
+	pose.spinX	= (GLfloat)(360.0 * t);
+	pose.spinY	= (GLfloat)(PATH_NOD * sin(2.0 * twoPi * t));
+	pose.zoom	= (GLfloat)(PATH_ZOOM * 0.5 * (1.0 - cos(twoPi * t)));
+}
+
+///----------------------------------------------------------------------------
+///Writes a JSON string, quotes & control characters escaped.
+///@param	file - the output file
+///@param	text - the string
+///----------------------------------------------------------------------------
+void Benchmark::WriteString(FILE *file, const char *text)
+{
+	fputc('"', file);
+
+	for(const unsigned char *c = (const unsigned char *)text; *c; c++)
+	{
+		if(*c == '"' || *c == '\\')
+			fprintf(file, "\\%c", *c);
+		else if(*c < 0x20)
+			fprintf(file, "\\u%04x", *c);
+		else
+			fputc(*c, file);
+	}
+
+	fputc('"', file);
+}
+
+///----------------------------------------------------------------------------
+///Writes how this executable was built.
+///@param	file - the output file
+///----------------------------------------------------------------------------
+void Benchmark::WriteBuildInfo(FILE *file)
+{
+	char compiler[64];
+
+#if defined(_MSC_VER)
+	sprintf(compiler, "msvc %d", _MSC_VER);
+#elif defined(__clang__)
+	sprintf(compiler, "clang %d.%d.%d", __clang_major__, __clang_minor__, __clang_patchlevel__);
+#elif defined(__GNUC__)
+	sprintf(compiler, "gcc %d.%d.%d", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+#else
+	sprintf(compiler, "unknown");
+#endif
+
+#if defined(_M_X64) || defined(__x86_64__)
+	const char *architecture = "x86_64";
+#elif defined(_M_IX86) || defined(__i386__)
+	const char *architecture = "x86";
+#else
+	const char *architecture = "unknown";
+#endif
+
+	//the CPU renderer's path, see Simd8.h
+#ifdef SIMD8_AVX2
+	const char *simd = "avx2";
+#else
+	const char *simd = "sse2";
+#endif
+
+#ifdef _DEBUG
+	const char *configuration = "debug";
+#else
+	const char *configuration = "release";
+#endif
+
+	fprintf(file, "{\"compiler\": \"%s\", \"architecture\": \"%s\", \"simd\": \"%s\", "
+				  "\"configuration\": \"%s\", \"date\": \"%s %s\"}",
+			compiler, architecture, simd, configuration, __DATE__, __TIME__);
+}
+
+///----------------------------------------------------------------------------
+///Writes the machine the run was made on.
+///@param	file - the output file
+///----------------------------------------------------------------------------
+void Benchmark::WriteHostInfo(FILE *file)
+{
+	char name[256] = "";
+
+#ifdef _WIN32
+	DWORD length = sizeof(name);
+	GetComputerName(name, &length);
+	const char *os = "windows";
+#else
+	gethostname(name, sizeof(name) - 1);
+	const char *os = "linux";
+#endif
+
+	fprintf(file, "{\"os\": \"%s\", \"name\": ", os);
+	WriteString(file, name);
+	fprintf(file, ", \"processors\": %u}", Thread::GetProcessorCount());
+}
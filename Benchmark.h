@@ -0,0 +1,102 @@
+///============================================================================
+///@file	Benchmark.h
+///@brief	Scripted benchmark run: the frame rate cap is off, the model &
+///			camera follow the same path every run (a turn around the model
+///			while nodding & zooming in and out), a warm up is rendered first
+///			and then a fixed number of frames is measured. The report is a
+///			JSON file with the frame time distribution, the per stage times,
+///			draw call & triangle counts, the GL calls per frame by category
+///			(in the builds with GLStats), the memory of each subsystem (in
+///			the builds with MemoryStats), the hardware counters of loading &
+///			of the measured frames (where the host has them) and the build,
+///			driver & host the run was made on, so runs from CI or other
+///			machines can be compared.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdio.h>
+#include <string>
+
+#include "RenderBackend.h"
+#include "FrameRecorder.h"
+#include "GpuProfiler.h"
+#include "PerfCounters.h"
+
+using namespace std;
+
+const int BENCHMARK_WARMUP	= 60;	// Frames rendered before measuring
+const int BENCHMARK_FRAMES	= 600;	// Frames measured
+
+//-----------------------------------------------------------------------------
+//Model rotation & camera of a frame of the path
+//-----------------------------------------------------------------------------
+struct CameraPose
+{
+	GLfloat	spinX;		///> Model rotation around Y, in degrees
+	GLfloat	spinY;		///> Model rotation around X, in degrees
+	GLfloat	zoom;		///> Camera offset along z from its start, towards the model
+};
+
+class Benchmark
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	Benchmark();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	void	Start(int warmupFrames = BENCHMARK_WARMUP, int frames = BENCHMARK_FRAMES);
+	bool	NextFrame();
+	bool	IsRunning() const;
+	bool	IsWarmingUp() const;
+	bool	IsFinished() const;
+	void	GetPose(CameraPose &pose) const;
+	void	AddDrawStats(const DrawStats &stats);
+	void	AddCounters(const CounterValues &start, const CounterValues &end, double vertices);
+	void	SetLoadCounters(const PerfCounters *counters, const CounterValues &start, const CounterValues &end);
+	void	SetConfig(const char *renderer, QualityTier quality, int width, int height);
+	void	ReadDriverInfo();
+	bool	WriteReport(const char *fileName, const FrameRecorder &recorder,
+						const GpuProfiler *profiler) const;
+
+	static void	GetPathPose(int frame, int frames, CameraPose &pose);
+	static void	WriteString(FILE *file, const char *text);
+	static void	WriteBuildInfo(FILE *file);
+	static void	WriteHostInfo(FILE *file);
+
+private:
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	int				m_Warmup;		///> Frames rendered before measuring
+	int				m_Frames;		///> Frames measured
+	int				m_Frame;		///> Frames rendered so far, warm up included
+	double			m_StartTime;	///> When the measured frames started
+	double			m_EndTime;		///> When the last one finished
+	unsigned long	m_DrawCalls;	///> Draw calls of the measured frames
+	unsigned long	m_Triangles;	///> Triangles of the measured frames
+	unsigned long	m_DrawFrames;	///> Measured frames with draw counts
+	const PerfCounters	*m_Counters;	///> Hardware counters, NULL if there are none
+	CounterValues	m_LoadCounts;	///> Counts of the start up
+	CounterValues	m_FrameCounts;	///> Counts of the measured frames
+	unsigned long	m_CountedFrames;	///> Measured frames counted
+	double			m_Vertices;		///> Vertices of the counted frames
+	string			m_Renderer;		///> "core", "legacy" or "software"
+	QualityTier		m_Quality;		///> Quality tier of the charcoal shader
+	int				m_Width;		///> Frame width
+	int				m_Height;		///> Frame height
+	string			m_Vendor;		///> GL_VENDOR, empty without a context
+	string			m_Device;		///> GL_RENDERER
+	string			m_Version;		///> GL_VERSION
+	string			m_GLSLVersion;	///> GL_SHADING_LANGUAGE_VERSION
+};
+
+#endif
@@ -5,10 +5,27 @@
 //@author	Hctor Morales Piloni
 //@date	December 29, 2006
 //
+//The charcoal features and constants are compile-time keys injected by
+//ShaderPermutation as #defines, so each variant has them folded in instead
+//of branching per fragment. The defaults below match the original look.
+//
+
+#ifndef CHARCOAL_OVERSATURATION
+#define CHARCOAL_OVERSATURATION	1.5
+#endif
+
+#ifndef CHARCOAL_CONTRAST_EXP
+#define CHARCOAL_CONTRAST_EXP	3.5
+#endif
+
+#ifndef CHARCOAL_CET_SCALE
+#define CHARCOAL_CET_SCALE		0.5
+#endif
 
 uniform sampler2D noiseTex;	//noise texture
 uniform sampler2D paperTex;	//paper texture
 uniform sampler2D CET;		//pre-computed contrast enhanced texture
+uniform sampler2D ceoLUT;	//pre-computed contrast enhancement operator
 
 varying vec2 paperCoord;	//paper texture coordinates
 varying vec2 noiseCoord;	//noise texture coordinates
@@ -36,40 +53,54 @@ float CEO(vec3 N, vec3 L, float A)
 	//add light ambient component to lambertian intensity
 	LI = clamp(LI + A, 0.0, 1.0);
 	
+#ifdef CHARCOAL_CEO_LUT
+	//oversaturation and contrast were baked into the lookup table
+	return texture2D(ceoLUT, vec2(LI, 0.5)).r;
+#else
 	//oversaturate to enhance the closure effect
-	LI = clamp(LI * 1.5, 0.0, 1.0);
+	LI = clamp(LI * CHARCOAL_OVERSATURATION, 0.0, 1.0);
 	
 	//apply the contrast enhancement operator
-	float contrast = pow(LI, 3.5);
+	float contrast = pow(LI, CHARCOAL_CONTRAST_EXP);
 	
 	return contrast;
+#endif
 }
 
 void main()
 {
-	//get a random color [0,1]
-	vec4 rand = texture2D(noiseTex, noiseCoord);
-
 	//compute the Contrast Enhancement Operator (CEO)
 	float diffuseColor = CEO(N, L, ambient);
 
+#ifdef CHARCOAL_CET_SMUDGE
+#ifdef CHARCOAL_NOISE_JITTER
+	//get a random color [0,1]
+	float jitter = texture2D(noiseTex, noiseCoord).x;
+#else
+	float jitter = 0.0;
+#endif
+
 	//compute the Contrast Enhancement Texture (CET) coordinates	
-	vec2 CETcoord = vec2(0.0, diffuseColor);
-	
 	//scale texture access from being too far apart
 	//this prevents the noise texture from showing up
-	CETcoord.s = rand.x * 0.5;
-	CETcoord.t *= 0.5;
+	vec2 CETcoord = vec2(jitter, diffuseColor) * CHARCOAL_CET_SCALE;
 	
 	//get the CET color
 	vec4 CETColor = texture2D(CET, CETcoord);
 	
 	//blend CET with CEM
 	vec4 smudgedColor = (diffuseColor + CETColor) * 0.5;
+#else
+	vec4 smudgedColor = vec4(diffuseColor);
+#endif
 
+#ifdef CHARCOAL_PAPER_OVERLAY
 	//get paper texture color
 	//invert the color so a simple vector addition overlay the paper texture onto CEM
 	vec4 bumpVec = 1.0 - texture2D(paperTex, paperCoord);
 	
 	gl_FragColor = smudgedColor - bumpVec ;
+#else
+	gl_FragColor = smudgedColor;
+#endif
 }
@@ -0,0 +1,110 @@
+#version 330
+//
+//@file	CharcoalRendering330.frag
+//@brief	Real-Time charcoal rendering fragment shader for the core profile
+//			(GLSL 3.30), same features & constants as CharcoalRendering.frag
+//
+//@author	Hctor Morales Piloni
+//@date	October 19, 2026
+//
+//The charcoal features and constants are compile-time keys injected by
+//ShaderPermutation as #defines, so each variant has them folded in instead
+//of branching per fragment. The defaults below match the original look.
+//
+
+#ifndef CHARCOAL_OVERSATURATION
+#define CHARCOAL_OVERSATURATION	1.5
+#endif
+
+#ifndef CHARCOAL_CONTRAST_EXP
+#define CHARCOAL_CONTRAST_EXP	3.5
+#endif
+
+#ifndef CHARCOAL_CET_SCALE
+#define CHARCOAL_CET_SCALE		0.5
+#endif
+
+uniform sampler2D noiseTex;	//noise texture
+uniform sampler2D paperTex;	//paper texture
+uniform sampler2D CET;		//pre-computed contrast enhanced texture
+uniform sampler2D ceoLUT;	//pre-computed contrast enhancement operator
+
+in vec2 paperCoord;	//paper texture coordinates
+in vec2 noiseCoord;	//noise texture coordinates
+in vec3 N;				//normal vector
+in vec3 L;				//light vector
+in float ambient;		//ambient light's component
+
+out vec4 fragColor;		//output color
+
+//----------------------------------------
+//Computes the lambertian intensity
+//and applies a contrast operator.
+//@param N - normal vector from VS
+//@param L - light vector from VS
+//@param A - Ambient light intensity
+//@return the computed CEO
+//----------------------------------------
+float CEO(vec3 N, vec3 L, float A)
+{
+	//normalize normal and light vectors
+	N = normalize(N);
+	L = normalize(L);
+	
+	//compute lambertian intensity
+	float LI = max(0.0, dot(N, L));
+	
+	//add light ambient component to lambertian intensity
+	LI = clamp(LI + A, 0.0, 1.0);
+	
+#ifdef CHARCOAL_CEO_LUT
+	//oversaturation and contrast were baked into the lookup table
+	return texture(ceoLUT, vec2(LI, 0.5)).r;
+#else
+	//oversaturate to enhance the closure effect
+	LI = clamp(LI * CHARCOAL_OVERSATURATION, 0.0, 1.0);
+	
+	//apply the contrast enhancement operator
+	float contrast = pow(LI, CHARCOAL_CONTRAST_EXP);
+	
+	return contrast;
+#endif
+}
+
+void main()
+{
+	//compute the Contrast Enhancement Operator (CEO)
+	float diffuseColor = CEO(N, L, ambient);
+
+#ifdef CHARCOAL_CET_SMUDGE
+#ifdef CHARCOAL_NOISE_JITTER
+	//get a random color [0,1]
+	float jitter = texture(noiseTex, noiseCoord).x;
+#else
+	float jitter = 0.0;
+#endif
+
+	//compute the Contrast Enhancement Texture (CET) coordinates	
+	//scale texture access from being too far apart
+	//this prevents the noise texture from showing up
+	vec2 CETcoord = vec2(jitter, diffuseColor) * CHARCOAL_CET_SCALE;
+	
+	//get the CET color
+	vec4 CETColor = texture(CET, CETcoord);
+	
+	//blend CET with CEM
+	vec4 smudgedColor = (diffuseColor + CETColor) * 0.5;
+#else
+	vec4 smudgedColor = vec4(diffuseColor);
+#endif
+
+#ifdef CHARCOAL_PAPER_OVERLAY
+	//get paper texture color
+	//invert the color so a simple vector addition overlay the paper texture onto CEM
+	vec4 bumpVec = 1.0 - texture(paperTex, paperCoord);
+	
+	fragColor = smudgedColor - bumpVec ;
+#else
+	fragColor = smudgedColor;
+#endif
+}
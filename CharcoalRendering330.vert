@@ -0,0 +1,44 @@
+#version 330
+//
+//@file	CharcoalRendering330.vert
+//@brief	Real-Time charcoal rendering vertex shader for the core profile
+//			(GLSL 3.30), the fixed function state is passed as uniforms
+//
+//@author	Hctor Morales Piloni
+//@date	October 19, 2026
+//
+
+layout(location = 0) in vec3 position;	//vertex position (object space)
+layout(location = 1) in vec3 normal;	//vertex normal (object space)
+
+uniform mat4 modelViewProjection;	//projection * view * model
+uniform mat3 normalMatrix;			//rotates normals to eye space
+uniform vec3 lightPosition;			//light position
+uniform float lightAmbient;			//light's ambient component
+
+out vec2 paperCoord;	//paper texture coordinates
+out vec2 noiseCoord;	//noise texture coordinates
+out vec3 N;				//normal vector
+out vec3 L;				//light vector
+out float ambient;		//ambient light's component
+
+void main()
+{	
+	//transform vertices
+	gl_Position = modelViewProjection * vec4(position, 1.0);
+		
+	//compute vertex normals
+	N = normalMatrix * normal;
+	
+	//compute light vector
+	L = lightPosition - position;
+
+	//get light's ambient component
+	ambient = lightAmbient;
+	
+	//compute paper texture coordinates to be in [0,1] range
+	paperCoord.st = (gl_Position.xy / gl_Position.w) * 0.5 + 0.5;
+	
+	//compute noise texture coordinates
+	noiseCoord.st = gl_Position.xy;
+}
@@ -0,0 +1,170 @@
+///============================================================================
+///@file	CoreBackend.cpp
+///@brief	Core Backend Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "CoreBackend.h"
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+CoreBackend::CoreBackend()
+	: RenderBackend("CharcoalRendering330.vert", "CharcoalRendering330.frag")
+{
+	m_Paper			= NULL;
+	m_PaperVertex	= NULL;
+	m_PaperFragment	= NULL;
+	m_EmptyArray	= 0;
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+CoreBackend::~CoreBackend()
+{
+	ShutDown();
+}
+
+///----------------------------------------------------------------------------
+///Uploads the model to a vertex array object and loads the shaders.
+///@param	geometry - the scene geometry, textures already created
+///@return	true if the context supports vertex array objects and all the
+///			shaders were found
+///----------------------------------------------------------------------------
+bool CoreBackend::Init(Geometry *geometry)
+{
+	m_Geometry = geometry;
+
+	m_Mesh.Build(m_Geometry->GetModel());
+	if(!m_Mesh.Upload())
+		return false;
+
+	//a core profile can't draw without a bound vertex array
+	glGenVertexArrays(1, &m_EmptyArray);
+
+	return CreatePaperProgram() && InitShaders();
+}
+
+///----------------------------------------------------------------------------
+///Draws the scene.
+///@param	scene - the frame state
+///----------------------------------------------------------------------------
+void CoreBackend::Render(const SceneState &scene)
+{
+	GLfloat modelViewProjection[16];
+	GLfloat normalMatrix[9];
+	GLfloat lightPos[3];
+
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	glViewport(0,0, scene.width, scene.height);
+
+	//the paper is a single full screen triangle
+	m_Stats.drawCalls	= 1;
+	m_Stats.triangles	= 1;
+
+	//draw the background paper texture
+	{
+		GpuZone zone(scene.profiler, RS_PAPER);
+
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, m_Geometry->GetTexObj(0));
+
+		m_Paper->EnableShader();
+		m_Paper->SetUniform("paperTex", 0);
+		glBindVertexArray(m_EmptyArray);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+		glBindVertexArray(0);
+		m_Paper->DisableShader();
+	}
+
+	//clear depth buffer in order to render 3d model
+	glClear(GL_DEPTH_BUFFER_BIT);
+
+	//get the variant for the current tier with its textures bound,
+	//there's no fixed function to fall back to while it compiles
+	GpuZone zone(scene.profiler, RS_MODEL);
+
+	ShaderProgram *shader = BindShader(scene.quality);
+	if(!shader)
+		return;
+
+	ComputeMatrices(m_Geometry, scene, modelViewProjection, normalMatrix);
+	m_Geometry->GetLightPosition(lightPos);
+
+	//enable programmable pipeline
+	shader->EnableShader();
+
+	//set uniform variables
+	SetSamplers(shader);
+	shader->SetUniformMatrix4("modelViewProjection", modelViewProjection);
+	shader->SetUniformMatrix3("normalMatrix", normalMatrix);
+	shader->SetUniform("lightPosition", lightPos[0], lightPos[1], lightPos[2]);
+	shader->SetUniform("lightAmbient", LIGHT_AMBIENT);
+
+	//and draw the model...
+	m_Mesh.Draw();
+
+	m_Stats.drawCalls	+= 1;
+	m_Stats.triangles	+= (unsigned long)m_Mesh.GetIndices().size() / 3;
+
+	//disable programmable pipeline
+	shader->DisableShader();
+}
+
+///----------------------------------------------------------------------------
+///Deletes the buffers & shaders, the context must still be current.
+///----------------------------------------------------------------------------
+void CoreBackend::ShutDown()
+{
+	m_Shaders.Clear();
+	m_Mesh.Release();
+
+	if(m_EmptyArray)
+		glDeleteVertexArrays(1, &m_EmptyArray);
+	m_EmptyArray = 0;
+
+	delete m_Paper;
+	delete m_PaperVertex;
+	delete m_PaperFragment;
+
+	m_Paper			= NULL;
+	m_PaperVertex	= NULL;
+	m_PaperFragment	= NULL;
+}
+
+///----------------------------------------------------------------------------
+///Builds the program that draws the paper background. It's tiny, so it is
+///linked right away instead of going through the asynchronous cache.
+///@return	true if the program linked
+///----------------------------------------------------------------------------
+bool CoreBackend::CreatePaperProgram()
+{
+	string vertexSource, fragmentSource;
+	unsigned int hash;
+
+	if(!ShaderSource::Load("PaperBackground330.vert", vertexSource, hash) ||
+	   !ShaderSource::Load("PaperBackground330.frag", fragmentSource, hash))
+		return false;
+
+	m_PaperVertex	= new ShaderObject(GL_VERTEX_SHADER, vertexSource, "");
+	m_PaperFragment	= new ShaderObject(GL_FRAGMENT_SHADER, fragmentSource, "");
+	m_Paper			= new ShaderProgram();
+
+	m_Paper->CreateShader();
+	m_Paper->AttachObject(m_PaperVertex);
+	m_Paper->AttachObject(m_PaperFragment);
+	m_Paper->Link();
+
+	if(m_Paper->IsLinked())
+		return true;
+
+	OutputDebugString("Paper background program failed to build:\n");
+	OutputDebugString(m_PaperVertex->GetLog().c_str());
+	OutputDebugString(m_PaperFragment->GetLog().c_str());
+	OutputDebugString(m_Paper->GetLog().c_str());
+
+	return false;
+}
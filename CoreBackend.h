@@ -0,0 +1,49 @@
+///============================================================================
+///@file	CoreBackend.h
+///@brief	GL 3.3 core profile render path: the model lives in a vertex
+///			array object, matrices & light data are computed on the CPU and
+///			passed as uniforms to GLSL 3.30 shaders.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef COREBACKEND_H
+#define COREBACKEND_H
+
+#include "RenderBackend.h"
+#include "MeshBuffer.h"
+
+class CoreBackend : public RenderBackend
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	CoreBackend();
+	virtual ~CoreBackend();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	virtual bool	Init(Geometry *geometry);
+	virtual void	Render(const SceneState &scene);
+	virtual void	ShutDown();
+
+private:
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	bool CreatePaperProgram();
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	MeshBuffer		m_Mesh;				///> Model vertex & index buffers
+	ShaderProgram	*m_Paper;			///> Paper background program
+	ShaderObject	*m_PaperVertex;		///> Paper background vertex shader
+	ShaderObject	*m_PaperFragment;	///> Paper background fragment shader
+	GLuint			m_EmptyArray;		///> Vertex array for attribute-less draws
+};
+
+#endif
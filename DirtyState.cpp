@@ -0,0 +1,68 @@
+///============================================================================
+///@file	DirtyState.cpp
+///@brief	Dirty State Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "DirtyState.h"
+
+#include <stddef.h>
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+DirtyListener::~DirtyListener()
+{
+}
+
+///----------------------------------------------------------------------------
+///Default constructor, the first frame is always dirty.
+///----------------------------------------------------------------------------
+DirtyState::DirtyState()
+{
+	m_Flags		= DIRTY_ALL;
+	m_Listener	= NULL;
+}
+
+///----------------------------------------------------------------------------
+///Sets who to wake up when the state becomes dirty.
+///@param	listener - the listener, NULL for none
+///----------------------------------------------------------------------------
+void DirtyState::SetListener(DirtyListener *listener)
+{
+	m_Listener = listener;
+}
+
+///----------------------------------------------------------------------------
+///Marks the next frame dirty, can be called from any thread.
+///@param	flags - DirtyFlag bits saying what changed
+///----------------------------------------------------------------------------
+void DirtyState::Mark(unsigned int flags)
+{
+	long previous = AtomicOr(&m_Flags, (long)flags);
+
+	//only the first change after a frame needs to wake the loop up
+	if(previous == 0 && m_Listener)
+		m_Listener->OnDirty();
+}
+
+///----------------------------------------------------------------------------
+///Gets & clears what changed, called once per frame by the render loop.
+///@return	the DirtyFlag bits set since the last call
+///----------------------------------------------------------------------------
+unsigned int DirtyState::Take()
+{
+	return (unsigned int)AtomicExchange(&m_Flags, 0);
+}
+
+///----------------------------------------------------------------------------
+///Gets what changed without clearing it.
+///@return	the DirtyFlag bits set since the last Take()
+///----------------------------------------------------------------------------
+unsigned int DirtyState::Peek() const
+{
+	//atomic read, other threads may be setting bits
+	return (unsigned int)AtomicOr(const_cast<volatile long*>(&m_Flags), 0);
+}
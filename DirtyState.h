@@ -0,0 +1,67 @@
+///============================================================================
+///@file	DirtyState.h
+///@brief	Tracks what changed since the last frame so the application can
+///			render on demand: input, resizes, shader reloads & background
+///			compiles mark the frame dirty (from any thread) and the message
+///			loop only draws when something is, blocking otherwise.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef DIRTYSTATE_H
+#define DIRTYSTATE_H
+
+#include "Thread.h"
+
+//-----------------------------------------------------------------------------
+//Reasons to draw a new frame
+//-----------------------------------------------------------------------------
+enum DirtyFlag
+{
+	DIRTY_SPIN		= 1 << 0,	///> model rotated with the mouse
+	DIRTY_ZOOM		= 1 << 1,	///> camera moved closer or further
+	DIRTY_SIZE		= 1 << 2,	///> window resized
+	DIRTY_EXPOSED	= 1 << 3,	///> window uncovered, contents lost
+	DIRTY_LIGHT		= 1 << 4,	///> light moved
+	DIRTY_SHADERS	= 1 << 5,	///> shader sources reloaded or tier changed
+	DIRTY_ASSETS	= 1 << 6,	///> something still streaming in (variants compiling)
+	DIRTY_OVERLAY	= 1 << 7,	///> performance overlay shown or hidden
+	DIRTY_ALL		= (1 << 8) - 1
+};
+
+//-----------------------------------------------------------------------------
+//Told when the state goes from clean to dirty, to wake up the render loop
+//-----------------------------------------------------------------------------
+class DirtyListener
+{
+public:
+	virtual ~DirtyListener();
+	virtual void OnDirty() = 0;
+};
+
+class DirtyState
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	DirtyState();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	void			SetListener(DirtyListener *listener);
+	void			Mark(unsigned int flags);
+	unsigned int	Take();
+	unsigned int	Peek() const;
+
+private:
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	volatile long	m_Flags;		///> DirtyFlag bits set since the last Take()
+	DirtyListener	*m_Listener;	///> Woken up on the first Mark() after a Take()
+};
+
+#endif
@@ -0,0 +1,476 @@
+///============================================================================
+///@file	EmbeddedShaders.cpp
+///@brief	Shader sources embedded at build time.
+///			GENERATED by tools/EmbedShaders.py, do not edit.
+///============================================================================
+
+#include "ShaderSource.h"
+
+//CharcoalRendering.vert
+static const char s_Source0[] =
+	"//\n"
+	"//@file\tcharcoal.vert\n"
+	"//@brief\tReal-Time charcoal rendering implementation vertex shader\n"
+	"//\n"
+	"//@author\tH\351ctor Morales Piloni\n"
+	"//@date\tDecember 29, 2006\n"
+	"//\n"
+	"\n"
+	"varying vec2 paperCoord;\t//paper texture coordinates\n"
+	"varying vec2 noiseCoord;\t//noise texture coordinates\n"
+	"varying vec3 N;\t\t\t\t//normal vector\n"
+	"varying vec3 L;\t\t\t\t//light vector\n"
+	"varying float ambient;\t\t//ambient light's component\n"
+	"\n"
+	"void main()\n"
+	"{\t\n"
+	"\t//transform vertices\n"
+	"\tgl_Position = ftransform();\n"
+	"\t\t\n"
+	"\t//compute vertex normals\n"
+	"\tN = gl_NormalMatrix * gl_Normal;\n"
+	"\t\n"
+	"\t//compute light vector\n"
+	"\tL = gl_LightSource[0].position.xyz - gl_Vertex.xyz;\n"
+	"\n"
+	"\t//get light's ambient component\n"
+	"\tambient = gl_LightSource[0].ambient.r;\n"
+	"\t\n"
+	"\t//compute paper texture coordinates to be in [0,1] range\n"
+	"\tpaperCoord.st = (gl_Position.xy / gl_Position.w) * 0.5 + 0.5;\n"
+	"\t\n"
+	"\t//compute noise texture coordinates\n"
+	"\tnoiseCoord.st = gl_Position.xy;\n"
+	"}\n";
+
+//CharcoalRendering.frag
+static const char s_Source1[] =
+	"//\n"
+	"//@file\tcharcoal.frag\n"
+	"//@brief\tReal-Time charcoal rendering implementation fragment shader\n"
+	"//\n"
+	"//@author\tH\351ctor Morales Piloni\n"
+	"//@date\tDecember 29, 2006\n"
+	"//\n"
+	"//The charcoal features and constants are compile-time keys injected by\n"
+	"//ShaderPermutation as #defines, so each variant has them folded in instead\n"
+	"//of branching per fragment. The defaults below match the original look.\n"
+	"//\n"
+	"\n"
+	"#ifndef CHARCOAL_OVERSATURATION\n"
+	"#define CHARCOAL_OVERSATURATION\t1.5\n"
+	"#endif\n"
+	"\n"
+	"#ifndef CHARCOAL_CONTRAST_EXP\n"
+	"#define CHARCOAL_CONTRAST_EXP\t3.5\n"
+	"#endif\n"
+	"\n"
+	"#ifndef CHARCOAL_CET_SCALE\n"
+	"#define CHARCOAL_CET_SCALE\t\t0.5\n"
+	"#endif\n"
+	"\n"
+	"uniform sampler2D noiseTex;\t//noise texture\n"
+	"uniform sampler2D paperTex;\t//paper texture\n"
+	"uniform sampler2D CET;\t\t//pre-computed contrast enhanced texture\n"
+	"uniform sampler2D ceoLUT;\t//pre-computed contrast enhancement operator\n"
+	"\n"
+	"varying vec2 paperCoord;\t//paper texture coordinates\n"
+	"varying vec2 noiseCoord;\t//noise texture coordinates\n"
+	"varying vec3 N;\t\t\t\t//normal vector\n"
+	"varying vec3 L;\t\t\t\t//light vector\n"
+	"varying float ambient;\t\t//ambient light's component\n"
+	"\n"
+	"//----------------------------------------\n"
+	"//Computes the lambertian intensity\n"
+	"//and applies a contrast operator.\n"
+	"//@param N - normal vector from VS\n"
+	"//@param L - light vector from VS\n"
+	"//@param A - Ambient light intensity\n"
+	"//@return the computed CEO\n"
+	"//----------------------------------------\n"
+	"float CEO(vec3 N, vec3 L, float A)\n"
+	"{\n"
+	"\t//normalize normal and light vectors\n"
+	"\tN = normalize(N);\n"
+	"\tL = normalize(L);\n"
+	"\t\n"
+	"\t//compute lambertian intensity\n"
+	"\tfloat LI = max(0.0, dot(N, L));\n"
+	"\t\n"
+	"\t//add light ambient component to lambertian intensity\n"
+	"\tLI = clamp(LI + A, 0.0, 1.0);\n"
+	"\t\n"
+	"#ifdef CHARCOAL_CEO_LUT\n"
+	"\t//oversaturation and contrast were baked into the lookup table\n"
+	"\treturn texture2D(ceoLUT, vec2(LI, 0.5)).r;\n"
+	"#else\n"
+	"\t//oversaturate to enhance the closure effect\n"
+	"\tLI = clamp(LI * CHARCOAL_OVERSATURATION, 0.0, 1.0);\n"
+	"\t\n"
+	"\t//apply the contrast enhancement operator\n"
+	"\tfloat contrast = pow(LI, CHARCOAL_CONTRAST_EXP);\n"
+	"\t\n"
+	"\treturn contrast;\n"
+	"#endif\n"
+	"}\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"\t//compute the Contrast Enhancement Operator (CEO)\n"
+	"\tfloat diffuseColor = CEO(N, L, ambient);\n"
+	"\n"
+	"#ifdef CHARCOAL_CET_SMUDGE\n"
+	"#ifdef CHARCOAL_NOISE_JITTER\n"
+	"\t//get a random color [0,1]\n"
+	"\tfloat jitter = texture2D(noiseTex, noiseCoord).x;\n"
+	"#else\n"
+	"\tfloat jitter = 0.0;\n"
+	"#endif\n"
+	"\n"
+	"\t//compute the Contrast Enhancement Texture (CET) coordinates\t\n"
+	"\t//scale texture access from being too far apart\n"
+	"\t//this prevents the noise texture from showing up\n"
+	"\tvec2 CETcoord = vec2(jitter, diffuseColor) * CHARCOAL_CET_SCALE;\n"
+	"\t\n"
+	"\t//get the CET color\n"
+	"\tvec4 CETColor = texture2D(CET, CETcoord);\n"
+	"\t\n"
+	"\t//blend CET with CEM\n"
+	"\tvec4 smudgedColor = (diffuseColor + CETColor) * 0.5;\n"
+	"#else\n"
+	"\tvec4 smudgedColor = vec4(diffuseColor);\n"
+	"#endif\n"
+	"\n"
+	"#ifdef CHARCOAL_PAPER_OVERLAY\n"
+	"\t//get paper texture color\n"
+	"\t//invert the color so a simple vector addition overlay the paper texture onto CEM\n"
+	"\tvec4 bumpVec = 1.0 - texture2D(paperTex, paperCoord);\n"
+	"\t\n"
+	"\tgl_FragColor = smudgedColor - bumpVec ;\n"
+	"#else\n"
+	"\tgl_FragColor = smudgedColor;\n"
+	"#endif\n"
+	"}\n";
+
+//CharcoalRendering330.vert
+static const char s_Source2[] =
+	"#version 330\n"
+	"//\n"
+	"//@file\tCharcoalRendering330.vert\n"
+	"//@brief\tReal-Time charcoal rendering vertex shader for the core profile\n"
+	"//\t\t\t(GLSL 3.30), the fixed function state is passed as uniforms\n"
+	"//\n"
+	"//@author\tH\351ctor Morales Piloni\n"
+	"//@date\tOctober 19, 2026\n"
+	"//\n"
+	"\n"
+	"layout(location = 0) in vec3 position;\t//vertex position (object space)\n"
+	"layout(location = 1) in vec3 normal;\t//vertex normal (object space)\n"
+	"\n"
+	"uniform mat4 modelViewProjection;\t//projection * view * model\n"
+	"uniform mat3 normalMatrix;\t\t\t//rotates normals to eye space\n"
+	"uniform vec3 lightPosition;\t\t\t//light position\n"
+	"uniform float lightAmbient;\t\t\t//light's ambient component\n"
+	"\n"
+	"out vec2 paperCoord;\t//paper texture coordinates\n"
+	"out vec2 noiseCoord;\t//noise texture coordinates\n"
+	"out vec3 N;\t\t\t\t//normal vector\n"
+	"out vec3 L;\t\t\t\t//light vector\n"
+	"out float ambient;\t\t//ambient light's component\n"
+	"\n"
+	"void main()\n"
+	"{\t\n"
+	"\t//transform vertices\n"
+	"\tgl_Position = modelViewProjection * vec4(position, 1.0);\n"
+	"\t\t\n"
+	"\t//compute vertex normals\n"
+	"\tN = normalMatrix * normal;\n"
+	"\t\n"
+	"\t//compute light vector\n"
+	"\tL = lightPosition - position;\n"
+	"\n"
+	"\t//get light's ambient component\n"
+	"\tambient = lightAmbient;\n"
+	"\t\n"
+	"\t//compute paper texture coordinates to be in [0,1] range\n"
+	"\tpaperCoord.st = (gl_Position.xy / gl_Position.w) * 0.5 + 0.5;\n"
+	"\t\n"
+	"\t//compute noise texture coordinates\n"
+	"\tnoiseCoord.st = gl_Position.xy;\n"
+	"}\n";
+
+//CharcoalRendering330.frag
+static const char s_Source3[] =
+	"#version 330\n"
+	"//\n"
+	"//@file\tCharcoalRendering330.frag\n"
+	"//@brief\tReal-Time charcoal rendering fragment shader for the core profile\n"
+	"//\t\t\t(GLSL 3.30), same features & constants as CharcoalRendering.frag\n"
+	"//\n"
+	"//@author\tH\351ctor Morales Piloni\n"
+	"//@date\tOctober 19, 2026\n"
+	"//\n"
+	"//The charcoal features and constants are compile-time keys injected by\n"
+	"//ShaderPermutation as #defines, so each variant has them folded in instead\n"
+	"//of branching per fragment. The defaults below match the original look.\n"
+	"//\n"
+	"\n"
+	"#ifndef CHARCOAL_OVERSATURATION\n"
+	"#define CHARCOAL_OVERSATURATION\t1.5\n"
+	"#endif\n"
+	"\n"
+	"#ifndef CHARCOAL_CONTRAST_EXP\n"
+	"#define CHARCOAL_CONTRAST_EXP\t3.5\n"
+	"#endif\n"
+	"\n"
+	"#ifndef CHARCOAL_CET_SCALE\n"
+	"#define CHARCOAL_CET_SCALE\t\t0.5\n"
+	"#endif\n"
+	"\n"
+	"uniform sampler2D noiseTex;\t//noise texture\n"
+	"uniform sampler2D paperTex;\t//paper texture\n"
+	"uniform sampler2D CET;\t\t//pre-computed contrast enhanced texture\n"
+	"uniform sampler2D ceoLUT;\t//pre-computed contrast enhancement operator\n"
+	"\n"
+	"in vec2 paperCoord;\t//paper texture coordinates\n"
+	"in vec2 noiseCoord;\t//noise texture coordinates\n"
+	"in vec3 N;\t\t\t\t//normal vector\n"
+	"in vec3 L;\t\t\t\t//light vector\n"
+	"in float ambient;\t\t//ambient light's component\n"
+	"\n"
+	"out vec4 fragColor;\t\t//output color\n"
+	"\n"
+	"//----------------------------------------\n"
+	"//Computes the lambertian intensity\n"
+	"//and applies a contrast operator.\n"
+	"//@param N - normal vector from VS\n"
+	"//@param L - light vector from VS\n"
+	"//@param A - Ambient light intensity\n"
+	"//@return the computed CEO\n"
+	"//----------------------------------------\n"
+	"float CEO(vec3 N, vec3 L, float A)\n"
+	"{\n"
+	"\t//normalize normal and light vectors\n"
+	"\tN = normalize(N);\n"
+	"\tL = normalize(L);\n"
+	"\t\n"
+	"\t//compute lambertian intensity\n"
+	"\tfloat LI = max(0.0, dot(N, L));\n"
+	"\t\n"
+	"\t//add light ambient component to lambertian intensity\n"
+	"\tLI = clamp(LI + A, 0.0, 1.0);\n"
+	"\t\n"
+	"#ifdef CHARCOAL_CEO_LUT\n"
+	"\t//oversaturation and contrast were baked into the lookup table\n"
+	"\treturn texture(ceoLUT, vec2(LI, 0.5)).r;\n"
+	"#else\n"
+	"\t//oversaturate to enhance the closure effect\n"
+	"\tLI = clamp(LI * CHARCOAL_OVERSATURATION, 0.0, 1.0);\n"
+	"\t\n"
+	"\t//apply the contrast enhancement operator\n"
+	"\tfloat contrast = pow(LI, CHARCOAL_CONTRAST_EXP);\n"
+	"\t\n"
+	"\treturn contrast;\n"
+	"#endif\n"
+	"}\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"\t//compute the Contrast Enhancement Operator (CEO)\n"
+	"\tfloat diffuseColor = CEO(N, L, ambient);\n"
+	"\n"
+	"#ifdef CHARCOAL_CET_SMUDGE\n"
+	"#ifdef CHARCOAL_NOISE_JITTER\n"
+	"\t//get a random color [0,1]\n"
+	"\tfloat jitter = texture(noiseTex, noiseCoord).x;\n"
+	"#else\n"
+	"\tfloat jitter = 0.0;\n"
+	"#endif\n"
+	"\n"
+	"\t//compute the Contrast Enhancement Texture (CET) coordinates\t\n"
+	"\t//scale texture access from being too far apart\n"
+	"\t//this prevents the noise texture from showing up\n"
+	"\tvec2 CETcoord = vec2(jitter, diffuseColor) * CHARCOAL_CET_SCALE;\n"
+	"\t\n"
+	"\t//get the CET color\n"
+	"\tvec4 CETColor = texture(CET, CETcoord);\n"
+	"\t\n"
+	"\t//blend CET with CEM\n"
+	"\tvec4 smudgedColor = (diffuseColor + CETColor) * 0.5;\n"
+	"#else\n"
+	"\tvec4 smudgedColor = vec4(diffuseColor);\n"
+	"#endif\n"
+	"\n"
+	"#ifdef CHARCOAL_PAPER_OVERLAY\n"
+	"\t//get paper texture color\n"
+	"\t//invert the color so a simple vector addition overlay the paper texture onto CEM\n"
+	"\tvec4 bumpVec = 1.0 - texture(paperTex, paperCoord);\n"
+	"\t\n"
+	"\tfragColor = smudgedColor - bumpVec ;\n"
+	"#else\n"
+	"\tfragColor = smudgedColor;\n"
+	"#endif\n"
+	"}\n";
+
+//PaperBackground330.vert
+static const char s_Source4[] =
+	"#version 330\n"
+	"//\n"
+	"//@file\tPaperBackground330.vert\n"
+	"//@brief\tDraws the paper texture behind the model in the core profile.\n"
+	"//\t\t\tA single triangle covers the screen, no vertex buffer needed.\n"
+	"//\n"
+	"//@author\tH\351ctor Morales Piloni\n"
+	"//@date\tOctober 19, 2026\n"
+	"//\n"
+	"\n"
+	"out vec2 paperCoord;\t//paper texture coordinates\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"\t//(-1,-1), (3,-1), (-1,3)\n"
+	"\tvec2 position = vec2((gl_VertexID & 1) * 4 - 1, (gl_VertexID & 2) * 2 - 1);\n"
+	"\n"
+	"\tgl_Position = vec4(position, 0.0, 1.0);\n"
+	"\tpaperCoord = position * 0.5 + 0.5;\n"
+	"}\n";
+
+//PaperBackground330.frag
+static const char s_Source5[] =
+	"#version 330\n"
+	"//\n"
+	"//@file\tPaperBackground330.frag\n"
+	"//@brief\tDraws the paper texture behind the model in the core profile.\n"
+	"//\n"
+	"//@author\tH\351ctor Morales Piloni\n"
+	"//@date\tOctober 19, 2026\n"
+	"//\n"
+	"\n"
+	"uniform sampler2D paperTex;\t//paper texture\n"
+	"\n"
+	"in vec2 paperCoord;\t\t\t//paper texture coordinates\n"
+	"\n"
+	"out vec4 fragColor;\t\t\t//output color\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"\tfragColor = texture(paperTex, paperCoord);\n"
+	"}\n";
+
+//PerfOverlay.vert
+static const char s_Source6[] =
+	"//\n"
+	"//@file\tPerfOverlay.vert\n"
+	"//@brief\tPerformance overlay vertex shader (GLSL 1.10): text & graphs\n"
+	"//\t\t\tgiven in pixels from the top left corner of the screen\n"
+	"//\n"
+	"//@author\tH\351ctor Morales Piloni\n"
+	"//@date\tOctober 19, 2026\n"
+	"//\n"
+	"\n"
+	"uniform vec2 screenSize;\t//viewport size, in pixels\n"
+	"\n"
+	"attribute vec2 position;\t//vertex position, in pixels\n"
+	"attribute vec2 texCoord;\t//glyph atlas coordinates\n"
+	"attribute vec4 color;\t\t//vertex color\n"
+	"\n"
+	"varying vec2 atlasCoord;\t//glyph atlas coordinates\n"
+	"varying vec4 overlayColor;\t//vertex color\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"\tgl_Position = vec4(position.x * 2.0 / screenSize.x - 1.0, 1.0 - position.y * 2.0 / screenSize.y, 0.0, 1.0);\n"
+	"\n"
+	"\tatlasCoord = texCoord;\n"
+	"\toverlayColor = color;\n"
+	"}\n";
+
+//PerfOverlay.frag
+static const char s_Source7[] =
+	"//\n"
+	"//@file\tPerfOverlay.frag\n"
+	"//@brief\tPerformance overlay fragment shader (GLSL 1.10), the atlas holds\n"
+	"//\t\t\tthe coverage of the glyphs\n"
+	"//\n"
+	"//@author\tH\351ctor Morales Piloni\n"
+	"//@date\tOctober 19, 2026\n"
+	"//\n"
+	"\n"
+	"uniform sampler2D atlasTex;\t//glyph atlas\n"
+	"\n"
+	"varying vec2 atlasCoord;\t//glyph atlas coordinates\n"
+	"varying vec4 overlayColor;\t//vertex color\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"\tgl_FragColor = vec4(overlayColor.rgb, overlayColor.a * texture2D(atlasTex, atlasCoord).a);\n"
+	"}\n";
+
+//PerfOverlay330.vert
+static const char s_Source8[] =
+	"#version 330\n"
+	"//\n"
+	"//@file\tPerfOverlay330.vert\n"
+	"//@brief\tPerformance overlay vertex shader for the core profile: text &\n"
+	"//\t\t\tgraphs given in pixels from the top left corner of the screen\n"
+	"//\n"
+	"//@author\tH\351ctor Morales Piloni\n"
+	"//@date\tOctober 19, 2026\n"
+	"//\n"
+	"\n"
+	"layout(location = 0) in vec2 position;\t//vertex position, in pixels\n"
+	"layout(location = 1) in vec2 texCoord;\t//glyph atlas coordinates\n"
+	"layout(location = 2) in vec4 color;\t\t//vertex color\n"
+	"\n"
+	"uniform vec2 screenSize;\t//viewport size, in pixels\n"
+	"\n"
+	"out vec2 atlasCoord;\t\t//glyph atlas coordinates\n"
+	"out vec4 overlayColor;\t\t//vertex color\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"\tgl_Position = vec4(position.x * 2.0 / screenSize.x - 1.0, 1.0 - position.y * 2.0 / screenSize.y, 0.0, 1.0);\n"
+	"\n"
+	"\tatlasCoord = texCoord;\n"
+	"\toverlayColor = color;\n"
+	"}\n";
+
+//PerfOverlay330.frag
+static const char s_Source9[] =
+	"#version 330\n"
+	"//\n"
+	"//@file\tPerfOverlay330.frag\n"
+	"//@brief\tPerformance overlay fragment shader for the core profile, the\n"
+	"//\t\t\tatlas holds the coverage of the glyphs\n"
+	"//\n"
+	"//@author\tH\351ctor Morales Piloni\n"
+	"//@date\tOctober 19, 2026\n"
+	"//\n"
+	"\n"
+	"uniform sampler2D atlasTex;\t//glyph atlas\n"
+	"\n"
+	"in vec2 atlasCoord;\t\t\t//glyph atlas coordinates\n"
+	"in vec4 overlayColor;\t\t//vertex color\n"
+	"\n"
+	"out vec4 fragColor;\t\t\t//output color\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"\tfragColor = vec4(overlayColor.rgb, overlayColor.a * texture(atlasTex, atlasCoord).a);\n"
+	"}\n";
+
+const EmbeddedShader g_EmbeddedShaders[] =
+{
+	{ "CharcoalRendering.vert", s_Source0, 864, 0xA8057CACu },
+	{ "CharcoalRendering.frag", s_Source1, 2962, 0xD51DA352u },
+	{ "CharcoalRendering330.vert", s_Source2, 1294, 0xCD567DCEu },
+	{ "CharcoalRendering330.frag", s_Source3, 3060, 0xF02B1CE5u },
+	{ "PaperBackground330.vert", s_Source4, 498, 0xDDB500FBu },
+	{ "PaperBackground330.frag", s_Source5, 377, 0xF49AC38Cu },
+	{ "PerfOverlay.vert", s_Source6, 686, 0xA65FE8E2u },
+	{ "PerfOverlay.frag", s_Source7, 443, 0xDDEA5254u },
+	{ "PerfOverlay330.vert", s_Source8, 747, 0x3BA6BC01u },
+	{ "PerfOverlay330.frag", s_Source9, 494, 0xA99CC4C6u },
+};
+
+const unsigned int g_EmbeddedShaderCount = sizeof(g_EmbeddedShaders) / sizeof(g_EmbeddedShaders[0]);
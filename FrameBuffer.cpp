@@ -0,0 +1,222 @@
+///============================================================================
+///@file	FrameBuffer.cpp
+///@brief	Frame Buffer Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "FrameBuffer.h"
+#include "MemoryStats.h"
+
+#include <stdio.h>
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+FrameBuffer::FrameBuffer()
+{
+	m_Framebuffer	= 0;
+	m_Color			= 0;
+	m_Depth			= 0;
+	m_Width			= 0;
+	m_Height		= 0;
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+FrameBuffer::~FrameBuffer()
+{
+	Release();
+}
+
+///----------------------------------------------------------------------------
+///Creates the framebuffer object & its renderbuffers, the context must be
+///current and InitExtensions() called.
+///@param	width - width in pixels
+///@param	height - height in pixels
+///@return	true if the framebuffer is complete
+///----------------------------------------------------------------------------
+bool FrameBuffer::Create(int width, int height)
+{
+	GLint maxSize = 0;
+	GLint maxViewport[2] = {0, 0};
+
+	Release();
+
+	if(!GetCapabilities().framebufferObjects)
+		return false;
+
+	glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &maxSize);
+	glGetIntegerv(GL_MAX_VIEWPORT_DIMS, maxViewport);
+
+	if(width <= 0 || height <= 0 || 
+	   width > maxSize || height > maxSize ||
+	   width > maxViewport[0] || height > maxViewport[1])
+		return false;
+
+	m_Width		= width;
+	m_Height	= height;
+
+	glGenRenderbuffers(1, &m_Color);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_Color);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+	glGenRenderbuffers(1, &m_Depth);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_Depth);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	MemoryStats::Allocate(MC_FRAME, MP_GPU, GetGpuSize());
+
+	glGenFramebuffers(1, &m_Framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_Color);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_Depth);
+
+	if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		Release();
+		return false;
+	}
+
+	//one buffer for the whole life of the framebuffer, reused every frame
+	m_Pixels.resize(width * height * 4);
+	MemoryStats::Allocate(MC_FRAME, MP_CPU, m_Pixels.size());
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Destroys the framebuffer object, the context must still be current.
+///----------------------------------------------------------------------------
+void FrameBuffer::Release()
+{
+	if(m_Framebuffer)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glDeleteFramebuffers(1, &m_Framebuffer);
+	}
+
+	if(m_Color)
+		glDeleteRenderbuffers(1, &m_Color);
+
+	if(m_Depth)
+		glDeleteRenderbuffers(1, &m_Depth);
+
+	if(m_Color)
+		MemoryStats::Free(MC_FRAME, MP_GPU, GetGpuSize());
+
+	//give the frame back, not just its contents
+	MemoryStats::Free(MC_FRAME, MP_CPU, m_Pixels.size());
+	vector<unsigned char>().swap(m_Pixels);
+
+	m_Framebuffer	= 0;
+	m_Color			= 0;
+	m_Depth			= 0;
+	m_Width			= 0;
+	m_Height		= 0;
+}
+
+///----------------------------------------------------------------------------
+///Makes the framebuffer the target of all drawing.
+///----------------------------------------------------------------------------
+void FrameBuffer::Bind() const
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+}
+
+///----------------------------------------------------------------------------
+///Reads the rendered frame back to memory, waiting for the GPU to finish.
+///@return	the pixels (BGRA, bottom row first), valid until the next call
+///			or until the framebuffer is released
+///----------------------------------------------------------------------------
+const unsigned char* FrameBuffer::ReadPixels()
+{
+	if(!m_Framebuffer)
+		return NULL;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(0, 0, m_Width, m_Height, GL_BGRA, GL_UNSIGNED_BYTE, &m_Pixels[0]);
+
+	return &m_Pixels[0];
+}
+
+///----------------------------------------------------------------------------
+///Writes the last frame read back as an uncompressed 32 bit TGA image.
+///@param	fileName - the image file name
+///@return	true if the file was written
+///----------------------------------------------------------------------------
+bool FrameBuffer::SaveTGA(const char *fileName) const
+{
+	if(m_Pixels.empty())
+		return false;
+
+	return WriteTGA(fileName, &m_Pixels[0], m_Width, m_Height);
+}
+
+///----------------------------------------------------------------------------
+///Writes pixels as an uncompressed 32 bit TGA image, which stores BGRA 
+///bottom row first just like ReadPixels() returns it.
+///@param	fileName - the image file name
+///@param	pixels - BGRA pixels, bottom row first
+///@param	width - width in pixels
+///@param	height - height in pixels
+///@return	true if the file was written
+///----------------------------------------------------------------------------
+bool FrameBuffer::WriteTGA(const char *fileName, const unsigned char *pixels, int width, int height)
+{
+	unsigned char header[18] = {0};
+
+	//the header stores the size in 16 bits
+	if(!pixels || width <= 0 || height <= 0 || width > 0xFFFF || height > 0xFFFF)
+		return false;
+
+	FILE *file = fopen(fileName, "wb");
+	if(!file)
+		return false;
+
+	header[2]	= 2;							//uncompressed true color
+	header[12]	= (unsigned char)(width & 0xFF);
+	header[13]	= (unsigned char)(width >> 8);
+	header[14]	= (unsigned char)(height & 0xFF);
+	header[15]	= (unsigned char)(height >> 8);
+	header[16]	= 32;							//bits per pixel
+	header[17]	= 8;							//alpha bits, bottom-left origin
+
+	bool written =	fwrite(header, sizeof(header), 1, file) == 1 &&
+					fwrite(pixels, width * height * 4, 1, file) == 1;
+
+	return (fclose(file) == 0) && written;
+}
+
+///----------------------------------------------------------------------------
+///Gets the framebuffer width.
+///@return	width in pixels
+///----------------------------------------------------------------------------
+int FrameBuffer::GetWidth() const
+{
+	return m_Width;
+}
+
+///----------------------------------------------------------------------------
+///Gets the framebuffer height.
+///@return	height in pixels
+///----------------------------------------------------------------------------
+int FrameBuffer::GetHeight() const
+{
+	return m_Height;
+}
+
+///----------------------------------------------------------------------------
+///Estimates the GPU memory of the renderbuffers.
+///@return	color & depth bytes
+///----------------------------------------------------------------------------
+size_t FrameBuffer::GetGpuSize() const
+{
+	return MemoryStats::GetTextureSize(m_Width, m_Height, GL_RGBA8) +
+		   MemoryStats::GetTextureSize(m_Width, m_Height, GL_DEPTH_COMPONENT24);
+}
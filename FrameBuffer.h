@@ -0,0 +1,65 @@
+///============================================================================
+///@file	FrameBuffer.h
+///@brief	Offscreen render target: a framebuffer object with color & depth
+///			renderbuffers of any size the driver allows. Frames are read
+///			back to memory and can be written to disk as TGA images.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <vector>
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include "GLExtensions.h"
+
+using namespace std;
+
+class FrameBuffer
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	FrameBuffer();
+	~FrameBuffer();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	bool					Create(int width, int height);
+	void					Release();
+	void					Bind() const;
+	const unsigned char*	ReadPixels();
+	bool					SaveTGA(const char *fileName) const;
+	int						GetWidth() const;
+	int						GetHeight() const;
+
+	static bool				WriteTGA(const char *fileName, const unsigned char *pixels, int width, int height);
+
+private:
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	size_t					GetGpuSize() const;
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	GLuint					m_Framebuffer;	///> Framebuffer object
+	GLuint					m_Color;		///> RGBA8 color renderbuffer
+	GLuint					m_Depth;		///> 24 bit depth renderbuffer
+	int						m_Width;		///> Width in pixels
+	int						m_Height;		///> Height in pixels
+	vector<unsigned char>	m_Pixels;		///> Last frame read back (BGRA, bottom row first)
+};
+
+#endif
@@ -0,0 +1,262 @@
+///============================================================================
+///@file	FramePacer.cpp
+///@brief	Frame Pacer Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "FramePacer.h"
+#include "Tracer.h"
+
+#ifndef _WIN32
+#include <time.h>
+#include <errno.h>
+#endif
+#include <math.h>
+#include <string.h>
+
+#ifdef _WIN32
+#pragma comment(lib, "winmm.lib")	// timeBeginPeriod
+#endif
+
+#ifdef _WIN32
+const double DEFAULT_SPIN_TIME	= 0.001;	// timeBeginPeriod(1) wakes within ~1ms
+#else
+const double DEFAULT_SPIN_TIME	= 0.0002;	// hrtimers wake within tens of us
+#endif
+
+///----------------------------------------------------------------------------
+///Default constructor, no frame rate cap.
+///----------------------------------------------------------------------------
+FramePacer::FramePacer()
+{
+	m_TargetRate	= 0.0f;
+	m_Period		= 0.0;
+	m_Deadline		= 0.0;
+	m_LastFrame		= 0.0;
+	m_SpinTime		= DEFAULT_SPIN_TIME;
+	m_VSync			= false;
+
+#ifdef _WIN32
+	//the default scheduler tick is 15.6ms, far too coarse for a frame
+	timeBeginPeriod(1);
+	m_Timer = CreateWaitableTimer(NULL, TRUE, NULL);
+#endif
+
+	ResetStats();
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+FramePacer::~FramePacer()
+{
+#ifdef _WIN32
+	if(m_Timer)
+		CloseHandle(m_Timer);
+
+	timeEndPeriod(1);
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Sets the frame rate cap.
+///@param	framesPerSecond - the cap, 0 to run as fast as possible
+///----------------------------------------------------------------------------
+void FramePacer::SetTargetRate(float framesPerSecond)
+{
+	if(framesPerSecond == m_TargetRate)
+		return;
+
+	m_TargetRate	= framesPerSecond;
+	m_Period		= (framesPerSecond > 0.0f) ? 1.0 / framesPerSecond : 0.0;
+	m_Deadline		= 0.0;
+}
+
+///----------------------------------------------------------------------------
+///Tells the pacer the swap interval waits for the display, it then only
+///measures the frames against the target rate (the refresh rate divided
+///by the swap interval).
+///@param	enabled - whether vsync is on
+///----------------------------------------------------------------------------
+void FramePacer::SetVSync(bool enabled)
+{
+	m_VSync		= enabled;
+	m_Deadline	= 0.0;
+}
+
+///----------------------------------------------------------------------------
+///Sets how long before a deadline sleeping stops & spinning starts, the
+///longest the OS may oversleep.
+///@param	seconds - the spin time
+///----------------------------------------------------------------------------
+void FramePacer::SetSpinTime(double seconds)
+{
+	m_SpinTime = seconds;
+}
+
+///----------------------------------------------------------------------------
+///Waits until the next frame should start, called once per frame.
+///----------------------------------------------------------------------------
+void FramePacer::Wait()
+{
+	TRACE_ZONE("pacing");
+
+	double now = GetTime();
+
+	if(m_Period > 0.0 && !m_VSync && m_Deadline > 0.0 && now < m_Deadline)
+	{
+		SleepUntil(m_Deadline - m_SpinTime);
+
+		double spinStart = GetTime();
+		m_Stats.sleepTime += spinStart - now;
+
+		while((now = GetTime()) < m_Deadline)
+			;
+
+		m_Stats.spinTime += now - spinStart;
+	}
+
+	//how far this frame started from a period after the previous one
+	if(m_LastFrame > 0.0 && m_Period > 0.0)
+	{
+		double interval = now - m_LastFrame;
+		double error = fabs(interval - m_Period);
+
+		m_Stats.frames++;
+		m_ErrorSum		+= error;
+		m_IntervalSum	+= interval;
+
+		if(error > m_Stats.maxError)
+			m_Stats.maxError = error;
+	}
+
+	m_LastFrame = now;
+
+	//deadlines follow each other so small errors don't add up, but a frame
+	//late by a whole period starts over instead of rushing to catch up
+	if(m_Deadline > 0.0)
+		m_Deadline += m_Period;
+	else
+		m_Deadline = now + m_Period;
+
+	if(now >= m_Deadline)
+	{
+		if(m_Period > 0.0 && m_Stats.frames > 0)
+			m_Stats.missed++;
+
+		m_Deadline = now + m_Period;
+	}
+}
+
+///----------------------------------------------------------------------------
+///Forgets the last frame after the render loop was idle (on demand mode),
+///so the pause doesn't count as a late frame.
+///----------------------------------------------------------------------------
+void FramePacer::Resume()
+{
+	m_LastFrame	= 0.0;
+	m_Deadline	= 0.0;
+}
+
+///----------------------------------------------------------------------------
+///Gets the pacing statistics since the last ResetStats().
+///@param	stats - receives the statistics
+///----------------------------------------------------------------------------
+void FramePacer::GetStats(PacingStats &stats) const
+{
+	stats = m_Stats;
+
+	if(m_Stats.frames > 0)
+	{
+		stats.meanError		= m_ErrorSum / m_Stats.frames;
+		stats.meanInterval	= m_IntervalSum / m_Stats.frames;
+	}
+}
+
+///----------------------------------------------------------------------------
+///Clears the pacing statistics.
+///----------------------------------------------------------------------------
+void FramePacer::ResetStats()
+{
+	memset(&m_Stats, 0, sizeof(m_Stats));
+	m_ErrorSum		= 0.0;
+	m_IntervalSum	= 0.0;
+	m_LastFrame		= 0.0;
+}
+
+///----------------------------------------------------------------------------
+///Gets the frame rate cap.
+///@return	the frames per second, 0 if there is no cap
+///----------------------------------------------------------------------------
+float FramePacer::GetTargetRate() const
+{
+	return m_TargetRate;
+}
+
+///----------------------------------------------------------------------------
+///Gets whether the swap does the waiting.
+///@return	true if vsync is on
+///----------------------------------------------------------------------------
+bool FramePacer::IsVSync() const
+{
+	return m_VSync;
+}
+
+///----------------------------------------------------------------------------
+///Gets a monotonic time stamp, the time base of the deadlines.
+///@return	the time in seconds
+///----------------------------------------------------------------------------
+double FramePacer::GetTime()
+{
+#ifdef _WIN32
+	static LARGE_INTEGER frequency = {0};
+	LARGE_INTEGER counter;
+
+	if(frequency.QuadPart == 0)
+		QueryPerformanceFrequency(&frequency);
+
+	QueryPerformanceCounter(&counter);
+
+	return (double)counter.QuadPart / frequency.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Sleeps until a point in time, returns right away if it has passed.
+///@param	time - the wake up time, in GetTime() seconds
+///----------------------------------------------------------------------------
+void FramePacer::SleepUntil(double time)
+{
+#ifdef _WIN32
+	double remaining = time - GetTime();
+	if(remaining <= 0.0)
+		return;
+
+	//relative due time, negative & in 100ns units
+	LARGE_INTEGER due;
+	due.QuadPart = -(LONGLONG)(remaining * 1e7);
+
+	if(m_Timer && SetWaitableTimer(m_Timer, &due, 0, NULL, NULL, FALSE))
+		WaitForSingleObject(m_Timer, INFINITE);
+	else
+		Sleep((DWORD)(remaining * 1000.0));
+#else
+	struct timespec ts;
+	ts.tv_sec	= (time_t)time;
+	ts.tv_nsec	= (long)((time - (double)ts.tv_sec) * 1e9);
+
+	if(ts.tv_sec < 0)
+		return;
+
+	//absolute, so being interrupted & restarted doesn't drift
+	while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+		;
+#endif
+}
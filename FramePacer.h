@@ -0,0 +1,84 @@
+///============================================================================
+///@file	FramePacer.h
+///@brief	Caps the frame rate without burning a core: each frame has a
+///			deadline one period after the previous one, the thread sleeps
+///			until just before it (clock_nanosleep with TIMER_ABSTIME on
+///			Linux, a waitable timer on Windows) and only spins for the last
+///			fraction of a millisecond. With vsync the swap does the waiting
+///			and the pacer just measures. The distance between the frames
+///			started & their deadlines is kept as the pacing error.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+//-----------------------------------------------------------------------------
+//Pacing statistics since the last ResetStats()
+//-----------------------------------------------------------------------------
+struct PacingStats
+{
+	unsigned long	frames;			///> Frames paced
+	unsigned long	missed;			///> Frames that started a period or more late
+	double			meanError;		///> Mean |interval - period|, in seconds
+	double			maxError;		///> Largest |interval - period|, in seconds
+	double			meanInterval;	///> Mean time between frames, in seconds
+	double			sleepTime;		///> Time spent sleeping, in seconds
+	double			spinTime;		///> Time spent spinning, in seconds
+};
+
+class FramePacer
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	FramePacer();
+	~FramePacer();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	void			SetTargetRate(float framesPerSecond);
+	void			SetVSync(bool enabled);
+	void			SetSpinTime(double seconds);
+	void			Wait();
+	void			Resume();
+
+	void			GetStats(PacingStats &stats) const;
+	void			ResetStats();
+	float			GetTargetRate() const;
+	bool			IsVSync() const;
+
+	static double	GetTime();
+
+private:
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	void			SleepUntil(double time);
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	float			m_TargetRate;		///> Frames per second, 0 for no cap
+	double			m_Period;			///> Seconds per frame, 0 for no cap
+	double			m_Deadline;			///> When the next frame should start, 0 if unknown
+	double			m_LastFrame;		///> When the last frame started
+	double			m_SpinTime;			///> Time before the deadline spent spinning
+	bool			m_VSync;			///> The swap waits, don't sleep
+	PacingStats		m_Stats;			///> Statistics being gathered
+	double			m_ErrorSum;			///> Sum of the interval errors
+	double			m_IntervalSum;		///> Sum of the intervals
+#ifdef _WIN32
+	HANDLE			m_Timer;			///> Waitable timer
+#endif
+};
+
+#endif
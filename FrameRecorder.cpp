@@ -0,0 +1,466 @@
+///============================================================================
+///@file	FrameRecorder.cpp
+///@brief	Frame Recorder Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "FrameRecorder.h"
+
+#include <string.h>
+
+const double STUTTER_FACTOR		= 2.0;		// Stutter: twice the recent average
+const unsigned long STUTTER_WARMUP = 8;		// Frames averaged before looking for stutters
+const double AVERAGE_FRAMES		= 32.0;		// Frames in the moving average
+const unsigned long MAX_MICROSECONDS = (1UL << HISTOGRAM_OCTAVES) - 1;
+
+//-----------------------------------------------------------------------------
+//Writes one JSON number or null for unmeasured values
+//-----------------------------------------------------------------------------
+static void WriteMilliseconds(FILE *file, double seconds)
+{
+	if(seconds < 0.0)
+		fprintf(file, "null");
+	else
+		fprintf(file, "%.4f", seconds * 1000.0);
+}
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+FrameHistogram::FrameHistogram()
+{
+	Clear();
+}
+
+///----------------------------------------------------------------------------
+///Adds a sample.
+///@param	seconds - the duration
+///----------------------------------------------------------------------------
+void FrameHistogram::Record(double seconds)
+{
+	if(seconds < 0.0)
+		return;
+
+	double microseconds = seconds * 1e6 + 0.5;
+	unsigned long value = (microseconds < MAX_MICROSECONDS) ? (unsigned long)microseconds : MAX_MICROSECONDS;
+
+	m_Buckets[GetBucket(value)]++;
+
+	if(m_Count == 0 || seconds < m_Min)
+		m_Min = seconds;
+	if(m_Count == 0 || seconds > m_Max)
+		m_Max = seconds;
+
+	m_Count++;
+	m_Sum += seconds;
+}
+
+///----------------------------------------------------------------------------
+///Removes every sample.
+///----------------------------------------------------------------------------
+void FrameHistogram::Clear()
+{
+	memset(m_Buckets, 0, sizeof(m_Buckets));
+	m_Count	= 0;
+	m_Sum	= 0.0;
+	m_Min	= 0.0;
+	m_Max	= 0.0;
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of samples.
+///@return	the sample count
+///----------------------------------------------------------------------------
+unsigned long FrameHistogram::GetCount() const
+{
+	return m_Count;
+}
+
+///----------------------------------------------------------------------------
+///Gets a percentile, the middle of the bucket it falls in (within the
+///exact minimum & maximum).
+///@param	percent - the percentile, 0 to 100
+///@return	the duration in seconds, 0 without samples
+///----------------------------------------------------------------------------
+double FrameHistogram::GetPercentile(double percent) const
+{
+	if(m_Count == 0)
+		return 0.0;
+
+	//rank of the sample, at least the first one
+	unsigned long rank = (unsigned long)(percent / 100.0 * m_Count + 0.5);
+	if(rank < 1)
+		rank = 1;
+	if(rank > m_Count)
+		rank = m_Count;
+
+	unsigned long seen = 0;
+
+	for(int i=0; i<HISTOGRAM_BUCKETS; i++)
+	{
+		seen += m_Buckets[i];
+
+		if(seen >= rank)
+		{
+			double value = GetBucketValue(i) * 1e-6;
+			return (value < m_Min) ? m_Min : (value > m_Max) ? m_Max : value;
+		}
+	}
+
+	return m_Max;
+}
+
+///----------------------------------------------------------------------------
+///Gets the exact mean.
+///@return	the mean in seconds, 0 without samples
+///----------------------------------------------------------------------------
+double FrameHistogram::GetMean() const
+{
+	return m_Count ? m_Sum / m_Count : 0.0;
+}
+
+///----------------------------------------------------------------------------
+///Gets the exact shortest sample.
+///@return	the minimum in seconds
+///----------------------------------------------------------------------------
+double FrameHistogram::GetMin() const
+{
+	return m_Min;
+}
+
+///----------------------------------------------------------------------------
+///Gets the exact longest sample.
+///@return	the maximum in seconds
+///----------------------------------------------------------------------------
+double FrameHistogram::GetMax() const
+{
+	return m_Max;
+}
+
+///----------------------------------------------------------------------------
+///Writes the summary as a JSON object, times in milliseconds.
+///@param	file - the output file
+///----------------------------------------------------------------------------
+void FrameHistogram::WriteJSON(FILE *file) const
+{
+	if(m_Count == 0)
+	{
+		fprintf(file, "null");
+		return;
+	}
+
+	fprintf(file, "{\"count\": %lu, \"mean\": %.4f, \"min\": %.4f, \"p50\": %.4f, \"p90\": %.4f, "
+				  "\"p99\": %.4f, \"p999\": %.4f, \"max\": %.4f}",
+			m_Count, GetMean() * 1000.0, m_Min * 1000.0, GetPercentile(50.0) * 1000.0,
+			GetPercentile(90.0) * 1000.0, GetPercentile(99.0) * 1000.0, 
+			GetPercentile(99.9) * 1000.0, m_Max * 1000.0);
+}
+
+///----------------------------------------------------------------------------
+///Gets the bucket of a value: values below 2^(SUB_BITS+1) have their own,
+///above that each power of two is split in 2^SUB_BITS equal buckets.
+///@param	microseconds - the value
+///@return	the bucket index
+///----------------------------------------------------------------------------
+int FrameHistogram::GetBucket(unsigned long microseconds)
+{
+	const unsigned long linear = 2UL << HISTOGRAM_SUB_BITS;
+
+	if(microseconds < linear)
+		return (int)microseconds;
+
+	//position of the highest bit
+	int top = 0;
+	for(unsigned long v = microseconds; v > 1; v >>= 1)
+		top++;
+
+	int shift = top - HISTOGRAM_SUB_BITS;
+	int sub = (int)(microseconds >> shift) - (1 << HISTOGRAM_SUB_BITS);
+
+	return ((shift + 1) << HISTOGRAM_SUB_BITS) + sub;
+}
+
+///----------------------------------------------------------------------------
+///Gets the value in the middle of a bucket.
+///@param	bucket - the bucket index
+///@return	the value in microseconds
+///----------------------------------------------------------------------------
+double FrameHistogram::GetBucketValue(int bucket)
+{
+	const int linear = 2 << HISTOGRAM_SUB_BITS;
+
+	if(bucket < linear)
+		return bucket;
+
+	int shift = (bucket >> HISTOGRAM_SUB_BITS) - 1;
+	unsigned long sub = (bucket & ((1 << HISTOGRAM_SUB_BITS) - 1)) + (1 << HISTOGRAM_SUB_BITS);
+	unsigned long first = sub << shift;
+
+	return first + ((1UL << shift) - 1) * 0.5;
+}
+
+///----------------------------------------------------------------------------
+///Constructor.
+///@param	capacity - frames kept in the ring, rounded up to a power of two
+///----------------------------------------------------------------------------
+FrameRecorder::FrameRecorder(unsigned int capacity)
+{
+	unsigned int size = 1;
+	while(size < capacity)
+		size <<= 1;
+
+	m_Ring.resize(size);
+	m_Mask		= size - 1;
+	m_Budget	= 0.0;
+
+	Clear();
+}
+
+///----------------------------------------------------------------------------
+///Records a frame, O(1) but for the histograms' bucket lookup.
+///@param	frameTime - time since the previous frame, in seconds
+///@param	cpuTime - CPU time of the frame, in seconds
+///@param	gpuTime - GPU time of the frame, negative if not measured
+///----------------------------------------------------------------------------
+void FrameRecorder::Record(double frameTime, double cpuTime, double gpuTime)
+{
+	FrameSample &sample = m_Ring[m_Frames & m_Mask];
+	sample.frame		= m_Frames;
+	sample.frameTime	= frameTime;
+	sample.cpuTime		= cpuTime;
+	sample.gpuTime		= gpuTime;
+
+	m_FrameTimes.Record(frameTime);
+	m_CpuTimes.Record(cpuTime);
+	m_GpuTimes.Record(gpuTime);
+
+	//compared with the frames before, not including this one
+	if(m_Frames >= STUTTER_WARMUP && frameTime > STUTTER_FACTOR * m_Average)
+		m_Stutters++;
+
+	//the frame time includes the pacing, the work is what has to fit
+	if(m_Budget > 0.0 && (cpuTime > m_Budget || gpuTime > m_Budget))
+		m_OverBudget++;
+
+	//a plain mean of the first frames, then an exponential moving average
+	m_Frames++;
+	double weight = (m_Frames < AVERAGE_FRAMES) ? 1.0 / m_Frames : 1.0 / AVERAGE_FRAMES;
+	m_Average += (frameTime - m_Average) * weight;
+}
+
+///----------------------------------------------------------------------------
+///Adds the GPU time of a frame recorded earlier, GPU times are usually
+///known a few frames late.
+///@param	frame - the frame number, GetFrameCount() when it was recorded
+///@param	gpuTime - GPU time of the frame, in seconds
+///----------------------------------------------------------------------------
+void FrameRecorder::SetGpuTime(unsigned long frame, double gpuTime)
+{
+	m_GpuTimes.Record(gpuTime);
+
+	//the ring may have moved on already
+	FrameSample &sample = m_Ring[frame & m_Mask];
+	bool inRing = (sample.frame == frame && frame < m_Frames);
+
+	if(inRing)
+		sample.gpuTime = gpuTime;
+
+	//frames over on the CPU already counted
+	if(m_Budget > 0.0 && gpuTime > m_Budget && !(inRing && sample.cpuTime > m_Budget))
+		m_OverBudget++;
+}
+
+///----------------------------------------------------------------------------
+///Sets the frame time budget, frames whose CPU or GPU time goes over it
+///are counted.
+///@param	seconds - the budget, 0 for none
+///----------------------------------------------------------------------------
+void FrameRecorder::SetBudget(double seconds)
+{
+	m_Budget = seconds;
+}
+
+///----------------------------------------------------------------------------
+///Forgets every frame.
+///----------------------------------------------------------------------------
+void FrameRecorder::Clear()
+{
+	m_Frames		= 0;
+	m_Average		= 0.0;
+	m_Stutters		= 0;
+	m_OverBudget	= 0;
+
+	m_FrameTimes.Clear();
+	m_CpuTimes.Clear();
+	m_GpuTimes.Clear();
+}
+
+///----------------------------------------------------------------------------
+///Gets the frame time budget.
+///@return	the budget in seconds, 0 for none
+///----------------------------------------------------------------------------
+double FrameRecorder::GetBudget() const
+{
+	return m_Budget;
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of frames recorded, the number of the next one.
+///@return	the frame count
+///----------------------------------------------------------------------------
+unsigned long FrameRecorder::GetFrameCount() const
+{
+	return m_Frames;
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of frames in the ring.
+///@return	the sample count, up to the ring's capacity
+///----------------------------------------------------------------------------
+unsigned int FrameRecorder::GetSampleCount() const
+{
+	return (m_Frames < m_Ring.size()) ? (unsigned int)m_Frames : (unsigned int)m_Ring.size();
+}
+
+///----------------------------------------------------------------------------
+///Gets one of the last frames.
+///@param	age - 0 for the last frame, up to GetSampleCount() - 1
+///@return	the frame's sample
+///----------------------------------------------------------------------------
+const FrameSample& FrameRecorder::GetSample(unsigned int age) const
+{
+	return m_Ring[(m_Frames - 1 - age) & m_Mask];
+}
+
+///----------------------------------------------------------------------------
+///Gets the histogram of every frame time.
+///@return	the histogram
+///----------------------------------------------------------------------------
+const FrameHistogram& FrameRecorder::GetFrameTimes() const
+{
+	return m_FrameTimes;
+}
+
+///----------------------------------------------------------------------------
+///Gets the histogram of every CPU time.
+///@return	the histogram
+///----------------------------------------------------------------------------
+const FrameHistogram& FrameRecorder::GetCpuTimes() const
+{
+	return m_CpuTimes;
+}
+
+///----------------------------------------------------------------------------
+///Gets the histogram of every measured GPU time.
+///@return	the histogram
+///----------------------------------------------------------------------------
+const FrameHistogram& FrameRecorder::GetGpuTimes() const
+{
+	return m_GpuTimes;
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of stutters, frames taking over twice as long as the
+///recent average.
+///@return	the stutter count
+///----------------------------------------------------------------------------
+unsigned long FrameRecorder::GetStutterCount() const
+{
+	return m_Stutters;
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of frames whose CPU or GPU time went over the budget.
+///@return	the count, 0 without a budget
+///----------------------------------------------------------------------------
+unsigned long FrameRecorder::GetOverBudgetCount() const
+{
+	return m_OverBudget;
+}
+
+///----------------------------------------------------------------------------
+///Writes the frames in the ring as CSV, oldest first, times in ms.
+///@param	fileName - the output file
+///@return	true if the file was written
+///----------------------------------------------------------------------------
+bool FrameRecorder::ExportCSV(const char *fileName) const
+{
+	FILE *file = fopen(fileName, "w");
+	if(!file)
+		return false;
+
+	fprintf(file, "frame,frame_ms,cpu_ms,gpu_ms\n");
+
+	for(unsigned int age=GetSampleCount(); age-- > 0; )
+	{
+		const FrameSample &sample = GetSample(age);
+
+		fprintf(file, "%lu,%.4f,%.4f,", sample.frame, sample.frameTime * 1000.0, sample.cpuTime * 1000.0);
+
+		if(sample.gpuTime >= 0.0)
+			fprintf(file, "%.4f", sample.gpuTime * 1000.0);
+
+		fprintf(file, "\n");
+	}
+
+	return fclose(file) == 0;
+}
+
+///----------------------------------------------------------------------------
+///Writes the summary & the frames in the ring as a JSON file.
+///@param	fileName - the output file
+///@return	true if the file was written
+///----------------------------------------------------------------------------
+bool FrameRecorder::ExportJSON(const char *fileName) const
+{
+	FILE *file = fopen(fileName, "w");
+	if(!file)
+		return false;
+
+	WriteJSON(file, true);
+	fprintf(file, "\n");
+
+	return fclose(file) == 0;
+}
+
+///----------------------------------------------------------------------------
+///Writes the summary as a JSON object, times in milliseconds.
+///@param	file - the output file
+///@param	samples - also write the frames in the ring, oldest first
+///----------------------------------------------------------------------------
+void FrameRecorder::WriteJSON(FILE *file, bool samples) const
+{
+	fprintf(file, "{\n\t\"frames\": %lu,\n\t\"stutters\": %lu,\n\t\"budget_ms\": %.4f,\n\t\"over_budget\": %lu,\n",
+			m_Frames, m_Stutters, m_Budget * 1000.0, m_OverBudget);
+
+	fprintf(file, "\t\"frame_ms\": ");
+	m_FrameTimes.WriteJSON(file);
+	fprintf(file, ",\n\t\"cpu_ms\": ");
+	m_CpuTimes.WriteJSON(file);
+	fprintf(file, ",\n\t\"gpu_ms\": ");
+	m_GpuTimes.WriteJSON(file);
+
+	if(samples)
+	{
+		fprintf(file, ",\n\t\"samples\": [");
+
+		for(unsigned int age=GetSampleCount(); age-- > 0; )
+		{
+			const FrameSample &sample = GetSample(age);
+
+			fprintf(file, "%s\n\t\t[%lu, ", (age + 1 == GetSampleCount()) ? "" : ",", sample.frame);
+			WriteMilliseconds(file, sample.frameTime);
+			fprintf(file, ", ");
+			WriteMilliseconds(file, sample.cpuTime);
+			fprintf(file, ", ");
+			WriteMilliseconds(file, sample.gpuTime);
+			fprintf(file, "]");
+		}
+
+		fprintf(file, "\n\t]");
+	}
+
+	fprintf(file, "\n}");
+}
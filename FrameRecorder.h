@@ -0,0 +1,125 @@
+///============================================================================
+///@file	FrameRecorder.h
+///@brief	Records frame, CPU & GPU times for monitoring: the last frames
+///			go into a ring buffer (O(1) per frame) and every frame into a
+///			log-linear histogram (HDR style, ~3% precision from 1us to
+///			minutes) that gives p50/p90/p99/max without keeping the
+///			samples. Stutters are frames much slower than the recent ones.
+///			Everything can be exported as CSV or JSON.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef FRAMERECORDER_H
+#define FRAMERECORDER_H
+
+#include <stdio.h>
+#include <vector>
+
+using namespace std;
+
+const int HISTOGRAM_SUB_BITS	= 5;	// 32 buckets per power of two
+const int HISTOGRAM_OCTAVES		= 28;	// up to 2^28 us, about 4 minutes
+const int HISTOGRAM_BUCKETS		= (HISTOGRAM_OCTAVES - HISTOGRAM_SUB_BITS + 1) << HISTOGRAM_SUB_BITS;
+
+//-----------------------------------------------------------------------------
+//Log-linear histogram of durations, in microseconds
+//-----------------------------------------------------------------------------
+class FrameHistogram
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	FrameHistogram();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	void			Record(double seconds);
+	void			Clear();
+
+	unsigned long	GetCount() const;
+	double			GetPercentile(double percent) const;
+	double			GetMean() const;
+	double			GetMin() const;
+	double			GetMax() const;
+
+	void			WriteJSON(FILE *file) const;
+
+private:
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	static int				GetBucket(unsigned long microseconds);
+	static double			GetBucketValue(int bucket);
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	unsigned long	m_Buckets[HISTOGRAM_BUCKETS];	///> Samples per bucket
+	unsigned long	m_Count;		///> Number of samples
+	double			m_Sum;			///> Sum of the samples, in seconds
+	double			m_Min;			///> Exact shortest sample, in seconds
+	double			m_Max;			///> Exact longest sample, in seconds
+};
+
+//-----------------------------------------------------------------------------
+//One frame's times, in seconds (negative when not measured)
+//-----------------------------------------------------------------------------
+struct FrameSample
+{
+	unsigned long	frame;		///> Frame number
+	double			frameTime;	///> Time since the previous frame
+	double			cpuTime;	///> Time the CPU spent building the frame
+	double			gpuTime;	///> Time the GPU spent drawing it
+};
+
+class FrameRecorder
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	FrameRecorder(unsigned int capacity = 1024);
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	void					Record(double frameTime, double cpuTime, double gpuTime = -1.0);
+	void					SetGpuTime(unsigned long frame, double gpuTime);
+	void					SetBudget(double seconds);
+	void					Clear();
+
+	double					GetBudget() const;
+	unsigned long			GetFrameCount() const;
+	unsigned int			GetSampleCount() const;
+	const FrameSample&		GetSample(unsigned int age) const;
+	const FrameHistogram&	GetFrameTimes() const;
+	const FrameHistogram&	GetCpuTimes() const;
+	const FrameHistogram&	GetGpuTimes() const;
+	unsigned long			GetStutterCount() const;
+	unsigned long			GetOverBudgetCount() const;
+
+	bool					ExportCSV(const char *fileName) const;
+	bool					ExportJSON(const char *fileName) const;
+	void					WriteJSON(FILE *file, bool samples) const;
+
+private:
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	vector<FrameSample>	m_Ring;			///> Last frames, a power of two of them
+	unsigned int		m_Mask;			///> Ring size - 1
+	unsigned long		m_Frames;		///> Frames recorded, the next ring slot
+	FrameHistogram		m_FrameTimes;	///> Every frame time
+	FrameHistogram		m_CpuTimes;		///> Every CPU time
+	FrameHistogram		m_GpuTimes;		///> Every measured GPU time
+	double				m_Average;		///> Moving average of the frame time
+	double				m_Budget;		///> Frame time budget, 0 for none
+	unsigned long		m_Stutters;		///> Frames over STUTTER_FACTOR times the average
+	unsigned long		m_OverBudget;	///> Frames whose CPU or GPU time went over the budget
+};
+
+#endif
@@ -7,6 +7,10 @@
 ///============================================================================
 
 #include "GLApp.h"
+#include "GLCapture.h"
+#include "MemoryStats.h"
+
+#include <stdio.h>
 
 //Ok, these should be working as private members, don't know why they aren't
 //so i didn't bother and make them globals... wtf?
@@ -15,6 +19,9 @@ GLboolean m_MousingL = false;
 POINT m_LastMousePos;
 POINT m_CurrentMousePos;
 
+const float FRAME_RATE		= 60.0f;	// Frame rate cap
+const int DEFAULT_REFRESH	= 60;		// Assumed when the driver won't tell
+
 ///----------------------------------------------------------------------------
 ///Default constructor.
 ///----------------------------------------------------------------------------
@@ -36,6 +43,8 @@ GLApp::GLApp(LPSTR windowTitle, USHORT width, USHORT height)
 	m_hWnd	= NULL;
 	m_hDC	= NULL;
 	m_hRC	= NULL;
+	m_CmdLine = "";
+	m_OnDemand = false;
 
 	//set all required values
 	m_WindowTitle	= windowTitle;
@@ -44,6 +53,14 @@ GLApp::GLApp(LPSTR windowTitle, USHORT width, USHORT height)
 
 	m_SpinX = 0.0f;
 	m_SpinY = 0.0f;
+	m_Zoom	= 0.0f;
+
+	m_Backend		= NULL;
+	m_CoreProfile	= false;
+	m_FrameRate		= FRAME_RATE;
+	m_WasIdle		= false;
+	m_Quality		= QT_HIGH;
+	m_SteadyFrames	= 0;
 }
 
 ///----------------------------------------------------------------------------
@@ -101,50 +118,173 @@ void GLApp::InitGraphics()
 		exit(-1);
 	}
 
-	//initialize the viewport
-	Reshape(m_Width, m_Height);
+	//"-core" replaces the context with a GL 3.3 core profile one
+	if(m_CmdLine && strstr(m_CmdLine, "-core"))
+	{
+		m_CoreProfile = CreateCoreContext();
+
+		if(!m_CoreProfile)
+			MessageBox(NULL, 
+					   "OpenGL 3.3 core profile is not available, using the legacy renderer.", 
+					   "WARNING", 
+					   MB_OK | MB_ICONWARNING);
+	}
+
+	//"-benchmark" renders a scripted path as fast as it can & exits,
+	//"-vsync" lets the swap wait for the display instead of the pacer
+	if(m_CmdLine && strstr(m_CmdLine, "-benchmark"))
+	{
+		SetVSync(false);
+		m_OnDemand = false;
+		m_Benchmark.Start();
+	}
+	else if(m_CmdLine && strstr(m_CmdLine, "-vsync"))
+	{
+		SetVSync(true);
+	}
+
+	//frames whose work doesn't fit in a frame at that rate are counted
+	m_Timer.GetRecorder().SetBudget(1.0 / m_FrameRate);
+
+	//"-capture" records the GL calls of the first frames to capture.gltrace,
+	//in the builds with GLStats; from here, the frames use what is created
+	if(m_CmdLine && strstr(m_CmdLine, "-capture") && GLStats::IsCompiledIn())
+		GLCapture::Start("capture.gltrace", CAPTURE_FRAMES, m_Width, m_Height, m_CoreProfile);
+
+	//initialize OpenGL extensions & detect what the context can do
+	if(!InitExtensions())
+		MessageBox(NULL, 
+				   "GLSL shaders are not supported, using fixed function lighting.", 
+				   "WARNING", 
+				   MB_OK | MB_ICONWARNING);
+
+	//time the stages on the GPU too if the context has timer queries
+	m_Profiler.Init();
+	m_Benchmark.ReadDriverInfo();
 
-	//set lights, materials & textures
+	//set light & camera positions
 	GLfloat lightPos[3] = {50.0, 90.0, 50.0};
-	m_Geometry.SetLights(lightPos);
-	m_Geometry.SetMaterials();
+	m_Geometry.SetLightPosition(lightPos);
+	m_Dirty.Mark(DIRTY_LIGHT);
 
-	//set camera position
 	GLfloat cameraPos[3] = {5.0, 15.0, -85.0};
 	m_Geometry.SetCameraPosition(cameraPos);
 
-	//calculate & save matrices for later use, 
-	//select modelview as temporal matrix
-	glMatrixMode(GL_MODELVIEW);
-	glPushMatrix();
-	{
-		//camera projection matrix
-		glLoadIdentity();
-		gluPerspective(45.0f, (float)m_Width/m_Height, 1.0f, 1000.0f);
-		glGetDoublev(GL_MODELVIEW_MATRIX, m_CameraProjectionMatrix);
-
-		//camera modelview matrix
-		glLoadIdentity();
-		gluLookAt(cameraPos[0], cameraPos[1], cameraPos[2], 0.0f, 30.0f, 0.0f, 0.0f, 1.0f, 0.0f);
-		glGetDoublev(GL_MODELVIEW_MATRIX, m_CameraViewMatrix);
-	}
-	glPopMatrix();
+	//initialize the viewport & camera matrices
+	Reshape(m_Width, m_Height);
+	Zoom(0.0f);
 
 	//enable needed states
     glEnable(GL_DEPTH_TEST);
-	glEnable(GL_TEXTURE_2D);
 	glClearColor(1.0f, 1.0f, 1.0f, 0.0f);
 
-	//initialize OpenGL extensions
-	InitExtensions();
-
 	m_Geometry.SetTextures();
 
-	//create vertex & pixel shaders
-	m_Shader.CreateShader();
-	m_Shader.AttachObject(new ShaderObject("CharcoalRendering.vert", GL_VERTEX_SHADER));
-	m_Shader.AttachObject(new ShaderObject("CharcoalRendering.frag", GL_FRAGMENT_SHADER));
-	m_Shader.Link();
+	//set up the render path, it sets its own GL state
+	if(m_CoreProfile)
+		m_Backend = new CoreBackend();
+	else
+		m_Backend = new LegacyBackend();
+
+	if(!m_Backend->Init(&m_Geometry))
+		OutputDebugString("Render backend failed to initialize.\n");
+
+	//'H' toggles the performance overlay, "-hud" shows it from the start
+	if(m_Overlay.Init(m_CoreProfile))
+		m_Overlay.SetVisible(m_CmdLine && strstr(m_CmdLine, "-hud"));
+
+	if(!GetCapabilities().shaderObjects)
+		return;
+
+	//create vertex & pixel shaders, the variants are compiled in the
+	//background (current tier first) while the fallback path renders
+	ShaderPermutation &shaders = m_Backend->GetShaders();
+	shaders.GetTier(m_Quality);
+	for(int tier=0; tier<QT_COUNT; tier++)
+		shaders.GetTier((QualityTier)tier);
+
+	//in development mode the sources come from disk,
+	//rebuild the shaders whenever they are saved
+	if(ShaderSource::IsDevMode())
+	{
+		m_Watcher.SetDirtyState(&m_Dirty);
+		m_Watcher.Watch(m_Backend->GetVertexFile(), m_Backend->GetFragmentFile());
+	}
+}
+
+///----------------------------------------------------------------------------
+///Replaces the current rendering context with an OpenGL 3.3 core profile
+///one. wglCreateContextAttribsARB can only be queried with a context 
+///current, so the legacy context is created first anyway.
+///@return	true if the core context is current, otherwise the legacy 
+///			context is left current
+///----------------------------------------------------------------------------
+bool GLApp::CreateCoreContext()
+{
+	PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribs = 
+		(PFNWGLCREATECONTEXTATTRIBSARBPROC)wglGetProcAddress("wglCreateContextAttribsARB");
+
+	int attribs[] = 
+	{
+		WGL_CONTEXT_MAJOR_VERSION_ARB,	3,
+		WGL_CONTEXT_MINOR_VERSION_ARB,	3,
+		WGL_CONTEXT_PROFILE_MASK_ARB,	WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
+		0
+	};
+
+	if(!wglCreateContextAttribs)
+		return false;
+
+	HGLRC coreRC = wglCreateContextAttribs(m_hDC, NULL, attribs);
+	if(!coreRC)
+		return false;
+
+	if(wglMakeCurrent(m_hDC, coreRC) == FALSE)
+	{
+		wglDeleteContext(coreRC);
+		wglMakeCurrent(m_hDC, m_hRC);
+		return false;
+	}
+
+	wglDeleteContext(m_hRC);
+	m_hRC = coreRC;
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Syncs the swaps to the display, with the swap interval closest to the 
+///frame rate cap (2 on a 120Hz display), when WGL_EXT_swap_control is there.
+///@param	enable - false swaps right away, even if the driver syncs by default
+///----------------------------------------------------------------------------
+void GLApp::SetVSync(bool enable)
+{
+	PFNWGLSWAPINTERVALEXTPROC wglSwapInterval = 
+		(PFNWGLSWAPINTERVALEXTPROC)wglGetProcAddress("wglSwapIntervalEXT");
+
+	if(!wglSwapInterval)
+		return;
+
+	if(!enable)
+	{
+		wglSwapInterval(0);
+		return;
+	}
+
+	int refresh = GetDeviceCaps(m_hDC, VREFRESH);
+	if(refresh <= 1)
+		refresh = DEFAULT_REFRESH;
+
+	int interval = (int)(refresh / FRAME_RATE + 0.5f);
+	if(interval < 1)
+		interval = 1;
+
+	if(!wglSwapInterval(interval))
+		return;
+
+	//the pacer only measures against the rate the display gives
+	m_FrameRate = (float)refresh / interval;
+	m_Timer.GetPacer().SetVSync(true);
 }
 
 ///----------------------------------------------------------------------------
@@ -152,8 +292,63 @@ void GLApp::InitGraphics()
 ///----------------------------------------------------------------------------
 bool GLApp::ShutDown()
 {
-	//destroy shader program
-	m_Shader.DestroyShader();
+	//read the GPU times still in flight, they complete the frame times
+	m_Profiler.Flush();
+
+	//report how close the frames were to the frame rate
+	PacingStats stats;
+	m_Timer.GetPacer().GetStats(stats);
+
+	if(stats.frames > 0)
+	{
+		char report[256];
+		sprintf(report, 
+				"Frame pacing: %lu frames at %.1f FPS, error mean %.3f ms max %.3f ms, %lu missed, %.1f%% of the time asleep\n",
+				stats.frames, m_FrameRate, stats.meanError * 1000.0, stats.maxError * 1000.0, stats.missed,
+				100.0 * stats.sleepTime / (stats.meanInterval * stats.frames));
+		OutputDebugString(report);
+		m_Timer.GetPacer().ResetStats();
+	}
+
+	//and the frame time percentiles, written to files with "-framestats"
+	const FrameHistogram &frameTimes = m_Timer.GetRecorder().GetFrameTimes();
+
+	if(frameTimes.GetCount() > 0)
+	{
+		char report[256];
+		sprintf(report,
+				"Frame times: p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms, %lu stutters\n",
+				frameTimes.GetPercentile(50.0) * 1000.0, frameTimes.GetPercentile(90.0) * 1000.0,
+				frameTimes.GetPercentile(99.0) * 1000.0, frameTimes.GetMax() * 1000.0,
+				m_Timer.GetRecorder().GetStutterCount());
+		OutputDebugString(report);
+
+		if(m_CmdLine && strstr(m_CmdLine, "-framestats"))
+			ExportFrameStats();
+
+		OutputDebugString(m_Profiler.GetReport().c_str());
+		OutputDebugString(GLStats::GetReport().c_str());
+		OutputDebugString(MemoryStats::GetReport().c_str());
+
+		m_Timer.GetRecorder().Clear();
+		m_Profiler.Clear();
+		GLStats::Clear();
+	}
+
+	m_Profiler.ShutDown();
+	m_Overlay.ShutDown();
+
+	//stop watching the shader sources & destroy the render path
+	m_Watcher.Stop();
+
+	if(m_Backend)
+	{
+		m_Backend->ShutDown();
+		delete m_Backend;
+		m_Backend = NULL;
+	}
+
+	m_Geometry.ReleaseTextures();
 
 	if(m_hRC)
 	{
@@ -202,6 +397,12 @@ LRESULT GLApp::DisplayWndProc(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
 			PostQuitMessage(0);
 			break;
 
+		case WM_PAINT:
+			//the whole frame is redrawn, nothing to paint here
+			ValidateRect(hWnd, NULL);
+			m_Dirty.Mark(DIRTY_EXPOSED);
+			break;
+
 		case WM_SIZE:
 			//store new viewport sizes
 			m_Width  = LOWORD(lParam);
@@ -224,10 +425,15 @@ LRESULT GLApp::DisplayWndProc(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
 			m_CurrentMousePos.x = LOWORD (lParam);
 			m_CurrentMousePos.y = HIWORD (lParam);
 			
+			//nothing to redraw unless the mouse moved while dragging
+			if(m_CurrentMousePos.x == m_LastMousePos.x && m_CurrentMousePos.y == m_LastMousePos.y)
+				break;
+
 			if(m_MousingR)
 			{
 				m_SpinX -= (m_CurrentMousePos.x - m_LastMousePos.x);
 				m_SpinY -= (m_CurrentMousePos.y - m_LastMousePos.y);
+				m_Dirty.Mark(DIRTY_SPIN);
 			}
 
 			if(m_MousingL)
@@ -247,6 +453,32 @@ LRESULT GLApp::DisplayWndProc(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
 			m_MousingL = false;
 			break;
 
+		case WM_KEYDOWN:
+		{
+			//select the quality tier, variants are compiled on first use
+			QualityTier quality = m_Quality;
+			if(wParam == '1') quality = QT_LOW;
+			if(wParam == '2') quality = QT_MEDIUM;
+			if(wParam == '3') quality = QT_HIGH;
+
+			if(quality != m_Quality)
+			{
+				m_Quality = quality;
+				m_Dirty.Mark(DIRTY_SHADERS);
+			}
+
+			//'F' writes the frame times recorded so far
+			if(wParam == 'F') ExportFrameStats();
+
+			//'H' shows or hides the performance overlay
+			if(wParam == 'H')
+			{
+				m_Overlay.Toggle();
+				m_Dirty.Mark(DIRTY_OVERLAY);
+			}
+			break;
+		}
+
 		default:
 			return DefWindowProc(hWnd, Msg, wParam, lParam);
 	}
@@ -255,10 +487,13 @@ LRESULT GLApp::DisplayWndProc(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
 }
 
 ///----------------------------------------------------------------------------
-///Draws some text in the scene (i.e. FPS, etc)
+///Draws some text in the scene (i.e. FPS, etc), on the next line of the
+///performance overlay.
+///@param	text - the text
 ///----------------------------------------------------------------------------
 void GLApp::RenderText(LPTSTR text)
 {
+	m_Overlay.AddLine(text);
 }
 
 ///----------------------------------------------------------------------------
@@ -266,71 +501,149 @@ void GLApp::RenderText(LPTSTR text)
 ///----------------------------------------------------------------------------
 void GLApp::Render()
 {
-	//lock the framerate to 60 FPS
-	m_Timer.Tick(60.0f);
-
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-	glViewport(0,0, m_Width, m_Height);
-
-	//draw the background paper texture
-    glMatrixMode( GL_PROJECTION );
-    glLoadIdentity();
-    gluOrtho2D( -1.0, 1.0, -1.0, 1.0 );
-    
-	glMatrixMode( GL_MODELVIEW );
-    glLoadIdentity();
-    
-	glBegin(GL_QUADS);
-    {
-        glTexCoord2f( 0.0f, 0.0f );
-        glVertex3f( -1.0f, -1.0f, 0.0f );
-    
-        glTexCoord2f( 0.0f, 1.0f );
-        glVertex3f( -1.0f, 1.0f, 0.0f );
-
-        glTexCoord2f( 1.0f, 1.0f );
-        glVertex3f( 1.0f, 1.0f, 0.0f );
-
-        glTexCoord2f( 1.0f, 0.0f );
-        glVertex3f( 1.0f, -1.0f, 0.0f );
-    }
-    glEnd();
-
-	//clear depth buffer in order to render 3d model
-	glClear(GL_DEPTH_BUFFER_BIT);
-
-	//load view & projection matrices
-	glMatrixMode(GL_PROJECTION);
-	glLoadMatrixd(m_CameraProjectionMatrix);
-
-	glMatrixMode(GL_MODELVIEW);
-	glLoadMatrixd(m_CameraViewMatrix);
-
-	//bind textures that our shader will use
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, m_Geometry.GetTexObj(0));
-
-	glActiveTexture(GL_TEXTURE1);
-	glBindTexture(GL_TEXTURE_2D, m_Geometry.GetTexObj(1));
-
-	glActiveTexture(GL_TEXTURE2);
-	glBindTexture(GL_TEXTURE_2D, m_Geometry.GetTexObj(2));
-
-	//enable programmable pipeline
-	m_Shader.EnableShader();
-	
-	//set uniform variables
-	m_Shader.SetUniform("paperTex", 0);
-	m_Shader.SetUniform("noise", 1);
-	m_Shader.SetUniform("CET", 2);
+	//the pause of an idle on demand loop isn't a late frame
+	bool resumed = m_WasIdle;
+	if(m_WasIdle)
+	{
+		m_Timer.GetPacer().Resume();
+		m_WasIdle = false;
+	}
+
+	//lock the framerate to 60 FPS (or the display's with vsync), 
+	//sleeping rather than spinning until the frame is due, unless
+	//a benchmark is running
+	m_Timer.Tick(m_Benchmark.IsRunning() ? 0.0f : m_FrameRate);
+	double frameStart = FramePacer::GetTime();
+
+	//the GPU time of the frame reaches the recorder a few frames later
+	m_Profiler.BeginFrame(resumed ? NULL : &m_Timer.GetRecorder());
+	GLStats::BeginFrame();
+	int frameZone = m_Profiler.BeginZone(RS_FRAME);
+
+	//once the shaders are built & the frame has warmed up, a frame must
+	//not touch the heap; checked in the builds with MemoryStats
+	AllocationGuard allocations("GLApp::Render", m_SteadyFrames >= MEMORY_WARMUP && !GLCapture::IsCapturing());
+
+	//anything marked from here on asks for another frame
+	m_Dirty.Take();
+
+	//recompile the shaders if they were edited, the programs in use
+	//are only replaced once the new ones have linked successfully
+	string vertexSource, fragmentSource;
+	if(m_Watcher.GetChanges(vertexSource, fragmentSource))
+	{
+		allocations.Disarm();
+		m_Backend->GetShaders().Reload(vertexSource, fragmentSource);
+	}
+
+	//the benchmark's path decides the view, not the mouse
+	if(m_Benchmark.IsRunning())
+	{
+		CameraPose pose;
+		m_Benchmark.GetPose(pose);
 
-	//and draw the model...
-	m_Geometry.Draw(m_SpinX, m_SpinY);
+		m_SpinX = pose.spinX;
+		m_SpinY = pose.spinY;
+		Zoom(pose.zoom - m_Zoom);
+	}
+
+	SceneState scene;
+	scene.spinX			= m_SpinX;
+	scene.spinY			= m_SpinY;
+	scene.width			= m_Width;
+	scene.height		= m_Height;
+	scene.quality		= m_Quality;
+	scene.projection	= m_CameraProjectionMatrix;
+	scene.view			= m_CameraViewMatrix;
+	scene.profiler		= &m_Profiler;
+
+	m_Backend->Render(scene);
+
+	//keep drawing while variants compile so they replace the fallback
+	if(m_Backend->GetShaders().IsPending())
+	{
+		m_Dirty.Mark(DIRTY_ASSETS);
+		m_SteadyFrames = 0;
+	}
+	else
+		m_SteadyFrames++;
+
+	//the overlay shows the frames recorded before this one
+	if(m_Overlay.IsVisible())
+	{
+		GpuZone zone(&m_Profiler, RS_OVERLAY);
+		TCHAR frameRate[32];
 
-	//disable programmable pipeline
-	m_Shader.DisableShader();
+		m_Timer.GetFrameRate(frameRate);
 
+		m_Overlay.Begin(m_Width, m_Height);
+		RenderText(frameRate);
+		m_Overlay.AddStats(m_Timer.GetRecorder(), &m_Profiler);
+		m_Overlay.Draw();
+	}
+
+	//the swap may wait for the display, it isn't part of the frame's work
+	if(!resumed)
+		m_Timer.EndFrame(FramePacer::GetTime() - frameStart);
+
+	int swapZone = m_Profiler.BeginZone(RS_SWAP);
 	SwapBuffers(m_hDC);
+	m_Profiler.EndZone(swapZone);
+
+	m_Profiler.EndZone(frameZone);
+	m_Profiler.EndFrame();
+	GLStats::EndFrame();
+
+	if(m_Benchmark.IsRunning())
+	{
+		m_Benchmark.AddDrawStats(m_Backend->GetDrawStats());
+
+		//the warm up lasts until every variant has compiled, then the
+		//times recorded so far (& the GPU's still in flight) are dropped
+		bool compiling = m_Benchmark.IsWarmingUp() && m_Backend->GetShaders().IsPending();
+
+		if(!compiling && m_Benchmark.NextFrame())
+		{
+			m_Profiler.Flush();
+			m_Profiler.Clear();
+			m_Timer.GetRecorder().Clear();
+			GLStats::Clear();
+		}
+
+		if(m_Benchmark.IsFinished())
+		{
+			allocations.Disarm();
+			FinishBenchmark();
+		}
+	}
+}
+
+///----------------------------------------------------------------------------
+///Writes the recorded frame times, the summary & last frames to
+///framestats.json and the last frames to framestats.csv.
+///----------------------------------------------------------------------------
+void GLApp::ExportFrameStats()
+{
+	const FrameRecorder &recorder = m_Timer.GetRecorder();
+
+	if(!recorder.ExportJSON("framestats.json") || !recorder.ExportCSV("framestats.csv"))
+		OutputDebugString("Could not write the frame statistics.\n");
+}
+
+///----------------------------------------------------------------------------
+///Writes the report of the benchmark to benchmark.json & quits.
+///----------------------------------------------------------------------------
+void GLApp::FinishBenchmark()
+{
+	//the last frames' GPU times complete the report
+	m_Profiler.Flush();
+
+	m_Benchmark.SetConfig(m_CoreProfile ? "core" : "legacy", m_Quality, m_Width, m_Height);
+
+	if(!m_Benchmark.WriteReport("benchmark.json", m_Timer.GetRecorder(), &m_Profiler))
+		OutputDebugString("Could not write the benchmark report.\n");
+
+	PostQuitMessage(0);
 }
 
 ///----------------------------------------------------------------------------
@@ -343,15 +656,10 @@ void GLApp::Reshape(int w, int h)
 	//set the viewport
 	glViewport(0, 0, (GLsizei) w, (GLsizei) h);
 
-	glMatrixMode(GL_MODELVIEW);
-	glPushMatrix();
-	{
-		//calculate the new projection matrix
-		glLoadIdentity();
-		gluPerspective(45.0f, (float)w/h, 1.0f, 1000.0f);
-		glGetDoublev(GL_MODELVIEW_MATRIX, m_CameraProjectionMatrix);
-	}
-	glPopMatrix();
+	//calculate the new projection matrix on the CPU, the legacy backend
+	//uploads it with the next frame
+	RenderBackend::ComputeProjection(w, h, m_CameraProjectionMatrix);
+	m_Dirty.Mark(DIRTY_SIZE);
 }
 
 ///----------------------------------------------------------------------------
@@ -370,9 +678,10 @@ void GLApp::Zoom(GLfloat zoomFactor)
 	//cameraPos[1] += zoomFactor;
 	cameraPos[2] += zoomFactor;
 	m_Geometry.SetCameraPosition(cameraPos);
+	m_Zoom += zoomFactor;
 
-	//calculate the new modelview matrix
-	glLoadIdentity();
-	gluLookAt(cameraPos[0], cameraPos[1], cameraPos[2], 0.0f, 30.0f, 0.0f, 0.0f, 1.0f, 0.0f);
-	glGetDoublev(GL_MODELVIEW_MATRIX, m_CameraViewMatrix);
+	//calculate the new modelview matrix, no GL calls so dragging the
+	//mouse never waits on the driver
+	RenderBackend::ComputeView(&m_Geometry, m_CameraViewMatrix);
+	m_Dirty.Mark(DIRTY_ZOOM);
 }
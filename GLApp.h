@@ -16,6 +16,12 @@
 #include "Timer.h"
 #include "ShaderProgram.h"
 #include "ShaderObject.h"
+#include "ShaderPermutation.h"
+#include "ShaderWatcher.h"
+#include "LegacyBackend.h"
+#include "CoreBackend.h"
+#include "PerfOverlay.h"
+#include "Benchmark.h"
 #include "GLExtensions.h"
 
 #include <GL/gl.h>
@@ -49,18 +55,31 @@ private:
 	//-------------------------------------------------------------------------
 	void Reshape(int w,int h);
 	void Zoom(GLfloat zoomFactor);
+	bool CreateCoreContext();
+	void SetVSync(bool enable);
+	void ExportFrameStats();
+	void FinishBenchmark();
 
 	//-------------------------------------------------------------------------
 	//Private members
 	//-------------------------------------------------------------------------
 	HGLRC			m_hRC;		///> Handle to OpenGL Rendering Context
 	Geometry		m_Geometry;	///> Used to draw all the geometry in the scene
-	Timer			m_Timer;	///> GL Application timer
-	ShaderProgram	m_Shader;	///> A Shader program object
-	GLdouble		m_CameraProjectionMatrix[16];	///> Camera projection matrix
-	GLdouble		m_CameraViewMatrix[16];			///> Camera model-view matrix
+	Timer			m_Timer;	///> GL Application timer & frame pacer
+	GpuProfiler		m_Profiler;	///> CPU & GPU time of each stage of the frame
+	PerfOverlay		m_Overlay;	///> Frame rate, times & graphs over the scene
+	Benchmark		m_Benchmark;	///> Scripted run started by "-benchmark"
+	float			m_FrameRate;	///> Frame rate cap, the display's with vsync
+	RenderBackend	*m_Backend;	///> Legacy or core profile render path
+	bool			m_CoreProfile;	///> Whether a GL 3.3 core context is in use
+	QualityTier		m_Quality;	///> Quality tier used to select the variant
+	ShaderWatcher	m_Watcher;	///> Reloads the shaders when their sources change
+	GLfloat			m_CameraProjectionMatrix[16];	///> Camera projection matrix
+	GLfloat			m_CameraViewMatrix[16];			///> Camera model-view matrix
 	GLfloat			m_SpinX;
 	GLfloat			m_SpinY;
+	GLfloat			m_Zoom;		///> Camera offset along z from its start
+	unsigned long	m_SteadyFrames;	///> Frames since the last shader build
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,309 @@
+///============================================================================
+///@file	GLCapture.cpp
+///@brief	GL Capture Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "GLCapture.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+const size_t CAPTURE_BUFFER = 1 << 20;	// Bytes buffered before writing
+
+FILE				*GLCapture::s_File				= NULL;
+int					GLCapture::s_Frames				= 0;
+int					GLCapture::s_Captured			= 0;
+GLint				GLCapture::s_UnpackAlignment	= 4;
+unsigned long long	GLCapture::s_Offset				= 0;
+std::vector<unsigned long long>	GLCapture::s_Index;
+
+///----------------------------------------------------------------------------
+///Starts recording the GL calls, call it before the context's objects are
+///created. The trace is complete once the frames are captured, or at exit.
+///@param	fileName - the trace file
+///@param	frames - frames to capture
+///@param	width - size of the default framebuffer
+///@param	height
+///@param	coreProfile - the context is a core profile one
+///@return	true if the file was created
+///----------------------------------------------------------------------------
+bool GLCapture::Start(const char *fileName, int frames, int width, int height, bool coreProfile)
+{
+	static bool registered = false;
+
+	Stop();
+
+	s_File = fopen(fileName, "wb");
+	if(!s_File)
+		return false;
+
+	//immediate mode frames are many small writes
+	setvbuf(s_File, NULL, _IOFBF, CAPTURE_BUFFER);
+
+	s_Frames			= frames;
+	s_Captured			= 0;
+	s_UnpackAlignment	= 4;
+	s_Offset			= 0;
+	s_Index.clear();
+
+	CaptureHeader header;
+	header.magic		= CAPTURE_MAGIC;
+	header.version		= CAPTURE_VERSION;
+	header.width		= width;
+	header.height		= height;
+	header.coreProfile	= coreProfile ? 1 : 0;
+	Write(&header, sizeof(header));
+
+	//an early return from main still gets a complete file
+	if(!registered)
+		atexit(Stop);
+	registered = true;
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Stops recording, writes the index of the frames & closes the trace.
+///----------------------------------------------------------------------------
+void GLCapture::Stop()
+{
+	if(!s_File)
+		return;
+
+	//a frame stopped halfway isn't one
+	if(s_Index.size() % 2)
+		s_Index.pop_back();
+
+	unsigned long long indexOffset = s_Offset;
+
+	Put((GLuint)(s_Index.size() / 2));
+	if(!s_Index.empty())
+		Write(&s_Index[0], s_Index.size() * sizeof(s_Index[0]));
+	Write(&indexOffset, sizeof(indexOffset));
+
+	if(fclose(s_File) != 0)
+		fprintf(stderr, "Could not write the GL capture.\n");
+
+	s_File = NULL;
+}
+
+///----------------------------------------------------------------------------
+///Marks the start of a frame.
+///----------------------------------------------------------------------------
+void GLCapture::BeginFrame()
+{
+	if(!s_File)
+		return;
+
+	s_Index.push_back(s_Offset);
+	Command(GC_FRAME);
+}
+
+///----------------------------------------------------------------------------
+///Marks the end of a frame, the trace is closed after the last one so the
+///clean up at exit isn't part of it.
+///----------------------------------------------------------------------------
+void GLCapture::EndFrame()
+{
+	if(!s_File)
+		return;
+
+	Command(GC_FRAME_END);
+	s_Index.push_back(s_Offset);
+
+	if(++s_Captured >= s_Frames)
+		Stop();
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of frames captured.
+///@return	the frames ended since Start()
+///----------------------------------------------------------------------------
+int GLCapture::GetFrameCount()
+{
+	return s_Captured;
+}
+
+///----------------------------------------------------------------------------
+///Starts recording a call, its arguments follow.
+///@param	command - the call
+///----------------------------------------------------------------------------
+void GLCapture::Command(GLCommand command)
+{
+	putc((unsigned char)command, s_File);
+	s_Offset++;
+}
+
+///----------------------------------------------------------------------------
+///Records an integer or enum argument.
+///@param	value - the value
+///----------------------------------------------------------------------------
+void GLCapture::Put(GLint value)
+{
+	Write(&value, sizeof(value));
+}
+
+void GLCapture::Put(GLuint value)
+{
+	Write(&value, sizeof(value));
+}
+
+void GLCapture::Put(GLfloat value)
+{
+	Write(&value, sizeof(value));
+}
+
+void GLCapture::Put(GLboolean value)
+{
+	putc(value, s_File);
+	s_Offset++;
+}
+
+///----------------------------------------------------------------------------
+///Records a pointer argument that is an offset into a bound buffer.
+///@param	pointer - the offset
+///----------------------------------------------------------------------------
+void GLCapture::PutOffset(const void *pointer)
+{
+	unsigned long long offset = (unsigned long long)(size_t)pointer;
+	Write(&offset, sizeof(offset));
+}
+
+///----------------------------------------------------------------------------
+///Records a block of data, its size first. NULL data (i.e. a buffer only
+///allocated) is recorded as its size with no bytes.
+///@param	data - the bytes, may be NULL
+///@param	size - their size
+///----------------------------------------------------------------------------
+void GLCapture::PutData(const void *data, size_t size)
+{
+	unsigned int length = (unsigned int)size;
+
+	Put((GLuint)length);
+	Put((GLboolean)(data != NULL));
+
+	if(data)
+		Write(data, length);
+}
+
+///----------------------------------------------------------------------------
+///Records an array of floats, i.e. a matrix.
+///@param	values - the floats
+///@param	count - how many
+///----------------------------------------------------------------------------
+void GLCapture::PutFloats(const GLfloat *values, int count)
+{
+	Write(values, count * sizeof(GLfloat));
+}
+
+///----------------------------------------------------------------------------
+///Records object names, as generated or deleted.
+///@param	count - how many
+///@param	names - the names
+///----------------------------------------------------------------------------
+void GLCapture::PutNames(GLsizei count, const GLuint *names)
+{
+	Put((GLint)count);
+	Write(names, count * sizeof(GLuint));
+}
+
+///----------------------------------------------------------------------------
+///Records a string, its length first.
+///@param	text - the string
+///@param	length - its length, negative if it ends with a 0
+///----------------------------------------------------------------------------
+void GLCapture::PutString(const char *text, GLint length)
+{
+	if(length < 0)
+		length = (GLint)strlen(text);
+
+	Put(length);
+	Write(text, length);
+}
+
+///----------------------------------------------------------------------------
+///Writes bytes to the trace, keeping its size for the index.
+///@param	data - the bytes
+///@param	size - their size
+///----------------------------------------------------------------------------
+void GLCapture::Write(const void *data, size_t size)
+{
+	fwrite(data, 1, size, s_File);
+	s_Offset += size;
+}
+
+///----------------------------------------------------------------------------
+///Keeps the GL_UNPACK_ALIGNMENT set, the size of the texture images
+///recorded from then on depends on it.
+///@param	alignment - 1, 2, 4 or 8
+///----------------------------------------------------------------------------
+void GLCapture::SetUnpackAlignment(GLint alignment)
+{
+	s_UnpackAlignment = alignment;
+}
+
+///----------------------------------------------------------------------------
+///Gets the size of an image in client memory, with its rows aligned.
+///@param	width - image width
+///@param	height - image height
+///@param	format - pixel format, i.e. GL_RGB
+///@param	type - component type, i.e. GL_UNSIGNED_BYTE
+///@param	alignment - row alignment, 0 for the GL_UNPACK_ALIGNMENT set
+///@return	the size in bytes
+///----------------------------------------------------------------------------
+size_t GLCapture::GetImageSize(GLsizei width, GLsizei height, GLenum format, GLenum type, GLint alignment)
+{
+	size_t components, bytes;
+
+	switch(format)
+	{
+	case GL_RGBA:
+	case GL_BGRA:			components = 4;	break;
+	case GL_RGB:
+	case GL_BGR:			components = 3;	break;
+	case GL_RG:
+	case GL_LUMINANCE_ALPHA:	components = 2;	break;
+	default:				components = 1;	break;
+	}
+
+	switch(type)
+	{
+	case GL_FLOAT:
+	case GL_UNSIGNED_INT:
+	case GL_INT:			bytes = 4;	break;
+	case GL_UNSIGNED_SHORT:
+	case GL_SHORT:			bytes = 2;	break;
+	default:				bytes = 1;	break;
+	}
+
+	if(alignment <= 0)
+		alignment = s_UnpackAlignment;
+
+	size_t row = (width * components * bytes + alignment - 1) / alignment * alignment;
+
+	return row * height;
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of floats a glLightfv() or glMaterialfv() parameter has.
+///@param	pname - the parameter
+///@return	1 to 4
+///----------------------------------------------------------------------------
+int GLCapture::GetParameterCount(GLenum pname)
+{
+	switch(pname)
+	{
+	case GL_AMBIENT:
+	case GL_DIFFUSE:
+	case GL_SPECULAR:
+	case GL_EMISSION:
+	case GL_POSITION:
+	case GL_AMBIENT_AND_DIFFUSE:	return 4;
+	case GL_SPOT_DIRECTION:
+	case GL_COLOR_INDEXES:			return 3;
+	default:						return 1;
+	}
+}
@@ -0,0 +1,257 @@
+///============================================================================
+///@file	GLCapture.h
+///@brief	Records the GL command stream into a compact binary trace, for
+///			GLReplay to run headless without the application. The counting
+///			wrappers of GLStats write every call they see with its data:
+///			buffer contents, texture images, shader sources, immediate mode
+///			vertices & matrices. Names the GL returns (objects, uniform
+///			locations) are recorded too, the replay maps them to its own.
+///
+///			A trace starts with a CaptureHeader, then each call is its
+///			GLCommand byte and its arguments as 4 byte values in the host's
+///			byte order, pointers into buffers as 8 byte offsets and data as
+///			a 4 byte size followed by the bytes. The calls of each frame are
+///			between GC_FRAME & GC_FRAME_END, the ones before the first frame
+///			create the objects the frames use. The file ends with an index
+///			of the frames: their count, the offsets where each starts & ends
+///			(8 bytes each) and, in the last 8 bytes, the offset of the index.
+///
+///			Capturing needs the builds with GLStats (CHARCOAL_GLSTATS), and
+///			must start before the context's objects are created.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef GLCAPTURE_H
+#define GLCAPTURE_H
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <vector>
+
+const unsigned int CAPTURE_MAGIC	= 0x544C4743;	// "CGLT"
+const unsigned int CAPTURE_VERSION	= 1;			// Trace format
+const int CAPTURE_FRAMES			= 100;			// Frames the window captures
+
+enum GLCommand
+{
+	GC_FRAME,
+	GC_FRAME_END,
+
+	//GL 1.1
+	GC_BEGIN,
+	GC_END,
+	GC_VERTEX3F,
+	GC_VERTEX3FV,
+	GC_NORMAL3FV,
+	GC_TEXCOORD2F,
+	GC_DRAW_ARRAYS,
+	GC_DRAW_ELEMENTS,
+	GC_BIND_TEXTURE,
+	GC_MATERIALF,
+	GC_MATERIALFV,
+	GC_TEX_IMAGE_2D,
+	GC_ENABLE,
+	GC_DISABLE,
+	GC_ACTIVE_TEXTURE,
+	GC_CLEAR,
+	GC_CLEAR_COLOR,
+	GC_VIEWPORT,
+	GC_PIXEL_STOREI,
+	GC_READ_PIXELS,
+	GC_COLOR_MATERIAL,
+	GC_GEN_TEXTURES,
+	GC_DELETE_TEXTURES,
+	GC_LIGHTFV,
+	GC_ROTATEF,
+	GC_TEX_PARAMETERI,
+	GC_LOAD_IDENTITY,
+	GC_LOAD_MATRIXF,
+	GC_MATRIX_MODE,
+	GC_ORTHO,
+	GC_BLEND_FUNC,
+	GC_FINISH,
+
+	//shaders
+	GC_CREATE_SHADER,
+	GC_SHADER_SOURCE,
+	GC_COMPILE_SHADER,
+	GC_DELETE_SHADER,
+	GC_CREATE_PROGRAM,
+	GC_ATTACH_SHADER,
+	GC_DETACH_SHADER,
+	GC_BIND_ATTRIB_LOCATION,
+	GC_LINK_PROGRAM,
+	GC_DELETE_PROGRAM,
+	GC_USE_PROGRAM,
+	GC_GET_UNIFORM_LOCATION,
+	GC_UNIFORM1I,
+	GC_UNIFORM2I,
+	GC_UNIFORM3I,
+	GC_UNIFORM4I,
+	GC_UNIFORM1F,
+	GC_UNIFORM2F,
+	GC_UNIFORM3F,
+	GC_UNIFORM4F,
+	GC_UNIFORM_MATRIX3FV,
+	GC_UNIFORM_MATRIX4FV,
+
+	//buffers & vertex arrays
+	GC_GEN_BUFFERS,
+	GC_DELETE_BUFFERS,
+	GC_BIND_BUFFER,
+	GC_BUFFER_DATA,
+	GC_BUFFER_STORAGE,
+	GC_VERTEX_ATTRIB_POINTER,
+	GC_ENABLE_VERTEX_ATTRIB_ARRAY,
+	GC_DISABLE_VERTEX_ATTRIB_ARRAY,
+	GC_GEN_VERTEX_ARRAYS,
+	GC_DELETE_VERTEX_ARRAYS,
+	GC_BIND_VERTEX_ARRAY,
+	GC_MULTI_DRAW_ELEMENTS_INDIRECT,
+
+	//framebuffer objects
+	GC_GEN_FRAMEBUFFERS,
+	GC_DELETE_FRAMEBUFFERS,
+	GC_BIND_FRAMEBUFFER,
+	GC_FRAMEBUFFER_RENDERBUFFER,
+	GC_GEN_RENDERBUFFERS,
+	GC_DELETE_RENDERBUFFERS,
+	GC_BIND_RENDERBUFFER,
+	GC_RENDERBUFFER_STORAGE,
+
+	//direct state access
+	GC_CREATE_BUFFERS,
+	GC_NAMED_BUFFER_DATA,
+	GC_NAMED_BUFFER_STORAGE,
+	GC_CREATE_VERTEX_ARRAYS,
+	GC_VERTEX_ARRAY_VERTEX_BUFFER,
+	GC_VERTEX_ARRAY_ELEMENT_BUFFER,
+	GC_VERTEX_ARRAY_ATTRIB_FORMAT,
+	GC_VERTEX_ARRAY_ATTRIB_BINDING,
+	GC_ENABLE_VERTEX_ARRAY_ATTRIB,
+	GC_BIND_TEXTURE_UNIT,
+
+	//queries
+	GC_GEN_QUERIES,
+	GC_DELETE_QUERIES,
+	GC_BEGIN_QUERY,
+	GC_END_QUERY,
+	GC_QUERY_COUNTER,
+	GC_GET_QUERY_OBJECTIV,
+	GC_GET_QUERY_OBJECTUI64V,
+
+	GC_COUNT
+};
+
+//-----------------------------------------------------------------------------
+//Start of a trace file
+//-----------------------------------------------------------------------------
+struct CaptureHeader
+{
+	unsigned int	magic;			///> CAPTURE_MAGIC
+	unsigned int	version;		///> CAPTURE_VERSION
+	unsigned int	width;			///> Size of the default framebuffer
+	unsigned int	height;
+	unsigned int	coreProfile;	///> 1 if captured from a core profile context
+};
+
+class GLCapture
+{
+public:
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	static bool		Start(const char *fileName, int frames, int width, int height, bool coreProfile);
+	static void		Stop();
+	static void		BeginFrame();
+	static void		EndFrame();
+	static int		GetFrameCount();
+
+	static void		Command(GLCommand command);
+	static void		Put(GLint value);
+	static void		Put(GLuint value);
+	static void		Put(GLfloat value);
+	static void		Put(GLboolean value);
+	static void		PutOffset(const void *pointer);
+	static void		PutData(const void *data, size_t size);
+	static void		PutFloats(const GLfloat *values, int count);
+	static void		PutNames(GLsizei count, const GLuint *names);
+	static void		PutString(const char *text, GLint length = -1);
+	static void		SetUnpackAlignment(GLint alignment);
+	static size_t	GetImageSize(GLsizei width, GLsizei height, GLenum format, GLenum type, GLint alignment);
+	static int		GetParameterCount(GLenum pname);
+
+	///------------------------------------------------------------------------
+	///Records a call & its arguments.
+	///@param	command - the call
+	///@param	a, b, c, d, e - the arguments, GLint, GLuint, GLfloat or GLboolean
+	///------------------------------------------------------------------------
+	template<class A> static void Record(GLCommand command, A a)
+	{
+		Command(command);
+		Put(a);
+	}
+
+	template<class A, class B> static void Record(GLCommand command, A a, B b)
+	{
+		Command(command);
+		Put(a);
+		Put(b);
+	}
+
+	template<class A, class B, class C> static void Record(GLCommand command, A a, B b, C c)
+	{
+		Command(command);
+		Put(a);
+		Put(b);
+		Put(c);
+	}
+
+	template<class A, class B, class C, class D> static void Record(GLCommand command, A a, B b, C c, D d)
+	{
+		Command(command);
+		Put(a);
+		Put(b);
+		Put(c);
+		Put(d);
+	}
+
+	template<class A, class B, class C, class D, class E> static void Record(GLCommand command, A a, B b, C c, D d, E e)
+	{
+		Record(command, a, b, c, d);
+		Put(e);
+	}
+
+	///------------------------------------------------------------------------
+	///Tells whether the calls are being recorded.
+	///@return	true between Start() & Stop()
+	///------------------------------------------------------------------------
+	static bool IsCapturing()
+	{
+		return s_File != NULL;
+	}
+
+private:
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	static void		Write(const void *data, size_t size);
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	static FILE		*s_File;			///> Trace being written, NULL if not capturing
+	static int		s_Frames;			///> Frames to capture
+	static int		s_Captured;			///> Frames captured so far
+	static GLint	s_UnpackAlignment;	///> GL_UNPACK_ALIGNMENT of the texture images
+	static unsigned long long	s_Offset;	///> Bytes written so far
+	static std::vector<unsigned long long>	s_Index;	///> Start & end offset of each frame
+};
+
+#endif
@@ -1,71 +1,401 @@
-
 #include "GLExtensions.h"
 
+#include <string.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <EGL/egl.h>
+#include <GL/glx.h>
+#endif
+
+using namespace std;
+
 //define global extensions objects
-PFNGLCREATESHADEROBJECTARBPROC		glCreateShaderObject	= NULL;
-PFNGLSHADERSOURCEARBPROC			glShaderSource			= NULL;
-PFNGLCOMPILESHADERARBPROC			glCompileShader			= NULL;
-PFNGLCREATEPROGRAMOBJECTARBPROC		glCreateProgramObject	= NULL;
-PFNGLATTACHOBJECTARBPROC			glAttachObject			= NULL;
-PFNGLLINKPROGRAMARBPROC				glLinkProgram			= NULL;
-PFNGLUSEPROGRAMOBJECTARBPROC		glUseProgramObject		= NULL;
-PFNGLGETATTRIBLOCATIONARBPROC		glGetAttribLocation		= NULL;
-PFNGLGETUNIFORMLOCATIONARBPROC		glGetUniformLocation	= NULL;
-PFNGLDELETEOBJECTARBPROC			glDeleteObject			= NULL;
-PFNGLDETACHOBJECTARBPROC			glDetachObject			= NULL;
-PFNGLUNIFORM1IARBPROC				glUniform1i				= NULL;
-PFNGLUNIFORM2IARBPROC				glUniform2i				= NULL;
-PFNGLUNIFORM3IARBPROC				glUniform3i				= NULL;
-PFNGLUNIFORM4IARBPROC				glUniform4i				= NULL;
-PFNGLUNIFORM1FARBPROC				glUniform1f				= NULL;
-PFNGLUNIFORM2FARBPROC				glUniform2f				= NULL;
-PFNGLUNIFORM3FARBPROC				glUniform3f				= NULL;
-PFNGLUNIFORM4FARBPROC				glUniform4f				= NULL;
-PFNGLACTIVETEXTUREARBPROC			glActiveTexture			= NULL;
-PFNGLGETOBJECTPARAMETERIVARBPROC	glGetObjectParameteriv	= NULL;
-PFNGLGETINFOLOGARBPROC				glGetInfoLog			= NULL;
-PFNGLVALIDATEPROGRAMARBPROC			glValidateProgram		= NULL;
-PFNWGLCREATEPBUFFERARBPROC			wglCreatePbuffer		= NULL;
-PFNWGLGETPBUFFERDCARBPROC			wglGetPbufferDC			= NULL;
-PFNWGLRELEASEPBUFFERDCARBPROC		wglReleasePbufferDC		= NULL;
-PFNWGLDESTROYPBUFFERARBPROC			wglDestroyPbuffer		= NULL;
-PFNWGLBINDTEXIMAGEARBPROC			wglBindTexImage			= NULL;
-PFNWGLRELEASETEXIMAGEARBPROC		wglReleaseTexImage		= NULL;
-PFNWGLCHOOSEPIXELFORMATARBPROC		wglChoosePixelFormat	= NULL;
+PFNGLCREATESHADERPROC				glCreateShader				= NULL;
+PFNGLSHADERSOURCEPROC				glShaderSource				= NULL;
+PFNGLCOMPILESHADERPROC				glCompileShader				= NULL;
+PFNGLCREATEPROGRAMPROC				glCreateProgram				= NULL;
+PFNGLATTACHSHADERPROC				glAttachShader				= NULL;
+PFNGLLINKPROGRAMPROC				glLinkProgram				= NULL;
+PFNGLUSEPROGRAMPROC					glUseProgram				= NULL;
+PFNGLGETATTRIBLOCATIONPROC			glGetAttribLocation			= NULL;
+PFNGLBINDATTRIBLOCATIONPROC			glBindAttribLocation		= NULL;
+PFNGLGETUNIFORMLOCATIONPROC			glGetUniformLocation		= NULL;
+PFNGLDELETESHADERPROC				glDeleteShader				= NULL;
+PFNGLDELETEPROGRAMPROC				glDeleteProgram				= NULL;
+PFNGLDETACHSHADERPROC				glDetachShader				= NULL;
+PFNGLUNIFORM1IPROC					glUniform1i					= NULL;
+PFNGLUNIFORM2IPROC					glUniform2i					= NULL;
+PFNGLUNIFORM3IPROC					glUniform3i					= NULL;
+PFNGLUNIFORM4IPROC					glUniform4i					= NULL;
+PFNGLUNIFORM1FPROC					glUniform1f					= NULL;
+PFNGLUNIFORM2FPROC					glUniform2f					= NULL;
+PFNGLUNIFORM3FPROC					glUniform3f					= NULL;
+PFNGLUNIFORM4FPROC					glUniform4f					= NULL;
+PFNGLUNIFORMMATRIX3FVPROC			glUniformMatrix3fv			= NULL;
+PFNGLUNIFORMMATRIX4FVPROC			glUniformMatrix4fv			= NULL;
+#ifdef _WIN32
+PFNGLACTIVETEXTUREPROC				glActiveTexture				= NULL;
+#endif
+PFNGLGETSHADERIVPROC				glGetShaderiv				= NULL;
+PFNGLGETPROGRAMIVPROC				glGetProgramiv				= NULL;
+PFNGLGETSHADERINFOLOGPROC			glGetShaderInfoLog			= NULL;
+PFNGLGETPROGRAMINFOLOGPROC			glGetProgramInfoLog			= NULL;
+PFNGLVALIDATEPROGRAMPROC			glValidateProgram			= NULL;
+PFNGLGENBUFFERSPROC					glGenBuffers				= NULL;
+PFNGLBINDBUFFERPROC					glBindBuffer				= NULL;
+PFNGLBUFFERDATAPROC					glBufferData				= NULL;
+PFNGLDELETEBUFFERSPROC				glDeleteBuffers				= NULL;
+PFNGLVERTEXATTRIBPOINTERPROC		glVertexAttribPointer		= NULL;
+PFNGLENABLEVERTEXATTRIBARRAYPROC	glEnableVertexAttribArray	= NULL;
+PFNGLDISABLEVERTEXATTRIBARRAYPROC	glDisableVertexAttribArray	= NULL;
+PFNGLGENVERTEXARRAYSPROC			glGenVertexArrays			= NULL;
+PFNGLBINDVERTEXARRAYPROC			glBindVertexArray			= NULL;
+PFNGLDELETEVERTEXARRAYSPROC			glDeleteVertexArrays		= NULL;
+PFNGLGETSTRINGIPROC					glGetStringi				= NULL;
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glMaxShaderCompilerThreads	= NULL;
+PFNGLGENFRAMEBUFFERSPROC			glGenFramebuffers			= NULL;
+PFNGLDELETEFRAMEBUFFERSPROC			glDeleteFramebuffers		= NULL;
+PFNGLBINDFRAMEBUFFERPROC			glBindFramebuffer			= NULL;
+PFNGLFRAMEBUFFERRENDERBUFFERPROC	glFramebufferRenderbuffer	= NULL;
+PFNGLCHECKFRAMEBUFFERSTATUSPROC		glCheckFramebufferStatus	= NULL;
+PFNGLGENRENDERBUFFERSPROC			glGenRenderbuffers			= NULL;
+PFNGLDELETERENDERBUFFERSPROC		glDeleteRenderbuffers		= NULL;
+PFNGLBINDRENDERBUFFERPROC			glBindRenderbuffer			= NULL;
+PFNGLRENDERBUFFERSTORAGEPROC		glRenderbufferStorage		= NULL;
+PFNGLCREATEBUFFERSPROC				glCreateBuffers				= NULL;
+PFNGLNAMEDBUFFERDATAPROC			glNamedBufferData			= NULL;
+PFNGLNAMEDBUFFERSTORAGEPROC			glNamedBufferStorage		= NULL;
+PFNGLCREATEVERTEXARRAYSPROC			glCreateVertexArrays		= NULL;
+PFNGLVERTEXARRAYVERTEXBUFFERPROC	glVertexArrayVertexBuffer	= NULL;
+PFNGLVERTEXARRAYELEMENTBUFFERPROC	glVertexArrayElementBuffer	= NULL;
+PFNGLVERTEXARRAYATTRIBFORMATPROC	glVertexArrayAttribFormat	= NULL;
+PFNGLVERTEXARRAYATTRIBBINDINGPROC	glVertexArrayAttribBinding	= NULL;
+PFNGLENABLEVERTEXARRAYATTRIBPROC	glEnableVertexArrayAttrib	= NULL;
+PFNGLBINDTEXTUREUNITPROC			glBindTextureUnit			= NULL;
+PFNGLBUFFERSTORAGEPROC				glBufferStorage				= NULL;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC	glMultiDrawElementsIndirect	= NULL;
+PFNGLGENQUERIESPROC					glGenQueries				= NULL;
+PFNGLDELETEQUERIESPROC				glDeleteQueries				= NULL;
+PFNGLBEGINQUERYPROC					glBeginQuery				= NULL;
+PFNGLENDQUERYPROC					glEndQuery					= NULL;
+PFNGLQUERYCOUNTERPROC				glQueryCounter				= NULL;
+PFNGLGETQUERYOBJECTIVPROC			glGetQueryObjectiv			= NULL;
+PFNGLGETQUERYOBJECTUI64VPROC		glGetQueryObjectui64v		= NULL;
+PFNGLGETPROGRAMBINARYPROC			glGetProgramBinary			= NULL;
+PFNGLPROGRAMBINARYPROC				glProgramBinary				= NULL;
+PFNGLPROGRAMPARAMETERIPROC			glProgramParameteri			= NULL;
+PFNGLDEBUGMESSAGECALLBACKPROC		glDebugMessageCallback		= NULL;
+PFNGLDEBUGMESSAGECONTROLPROC		glDebugMessageControl		= NULL;
+
+static GLCapabilities	s_Caps;			// capabilities of the current context
+static vector<string>	s_Extensions;	// sorted extension names
+
+#ifdef _WIN32
+typedef PROC EntryPoint;
+#else
+typedef void (*EntryPoint)(void);
+#endif
+
+///----------------------------------------------------------------------------
+///Gets the address of an entry point from the window system of the current
+///context: WGL on Windows, EGL or GLX elsewhere.
+///@param	name - the function name
+///@return	the function address, NULL if not available
+///----------------------------------------------------------------------------
+static EntryPoint GetProc(const char *name)
+{
+#ifdef _WIN32
+	EntryPoint proc = wglGetProcAddress(name);
+
+	//some drivers return small integers instead of NULL
+	if(proc == (EntryPoint)1 || proc == (EntryPoint)2 || proc == (EntryPoint)3 || proc == (EntryPoint)-1)
+		proc = NULL;
+
+	return proc;
+#else
+	if(eglGetCurrentContext() != EGL_NO_CONTEXT)
+		return (EntryPoint)eglGetProcAddress(name);
+
+	return (EntryPoint)glXGetProcAddressARB((const GLubyte*)name);
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Gets the address of a GL entry point, trying the ARB name if the core one
+///isn't exported. The ARB shader & buffer entry points take the same 
+///arguments and tokens as their GL 2.0 counterparts.
+///@param	name - the core function name
+///@param	fallback - the extension function name (may be NULL)
+///@return	the function address, NULL if neither name is available
+///----------------------------------------------------------------------------
+static EntryPoint GetEntryPoint(const char *name, const char *fallback)
+{
+	EntryPoint proc = GetProc(name);
+
+	if(!proc && fallback)
+		proc = GetProc(fallback);
+
+	return proc;
+}
+
+///----------------------------------------------------------------------------
+///Checks whether the context version is at least the given one.
+///@param	major - major version
+///@param	minor - minor version
+///@return	true if the context is that version or newer
+///----------------------------------------------------------------------------
+static bool HasVersion(int major, int minor)
+{
+	return s_Caps.majorVersion > major || 
+		   (s_Caps.majorVersion == major && s_Caps.minorVersion >= minor);
+}
+
+///----------------------------------------------------------------------------
+///Reads the context version & profile and its extension list, GL 3.0+
+///lists them one by one (a core profile has no GL_EXTENSIONS string),
+///older contexts in a single space separated string.
+///----------------------------------------------------------------------------
+static void ReadContextInfo()
+{
+	const char *version = (const char*)glGetString(GL_VERSION);
+
+	memset(&s_Caps, 0, sizeof(s_Caps));
+	s_Extensions.clear();
+
+	if(!version || sscanf(version, "%d.%d", &s_Caps.majorVersion, &s_Caps.minorVersion) != 2)
+		return;
+
+	glGetStringi = (PFNGLGETSTRINGIPROC)GetEntryPoint("glGetStringi", NULL);
+
+	if(HasVersion(3, 0) && glGetStringi)
+	{
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+		for(GLint i=0; i<count; i++)
+			s_Extensions.push_back((const char*)glGetStringi(GL_EXTENSIONS, i));
+	}
+	else
+	{
+		const char *extensions = (const char*)glGetString(GL_EXTENSIONS);
+		const char *start = extensions;
+
+		while(start && *start)
+		{
+			const char *end = strchr(start, ' ');
+			if(!end)
+				end = start + strlen(start);
+
+			if(end > start)
+				s_Extensions.push_back(string(start, end));
+
+			start = *end ? end + 1 : end;
+		}
+	}
+
+	sort(s_Extensions.begin(), s_Extensions.end());
+
+	//3.2+ tells the profile, 3.1 is core unless it has the compatibility extension
+	if(HasVersion(3, 2))
+	{
+		GLint mask = 0;
+		glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &mask);
+		s_Caps.coreProfile = (mask & GL_CONTEXT_CORE_PROFILE_BIT) != 0;
+	}
+	else if(HasVersion(3, 1))
+		s_Caps.coreProfile = !IsExtensionSupported("GL_ARB_compatibility");
+}
+
+///----------------------------------------------------------------------------
+///Detects the version & extensions of the current context, resolves the
+///entry points it provides and fills the capabilities table. Call it again
+///whenever a different context is made current.
+///@return	true if GLSL programs are supported, which the charcoal shaders
+///			need (the legacy path can still draw without them)
+///----------------------------------------------------------------------------
+bool InitExtensions()
+{
+	char buffer[256];
+
+	ReadContextInfo();
+
+	glCreateShader				= (PFNGLCREATESHADERPROC)				GetEntryPoint("glCreateShader", "glCreateShaderObjectARB");
+	glShaderSource				= (PFNGLSHADERSOURCEPROC)				GetEntryPoint("glShaderSource", "glShaderSourceARB");
+	glCompileShader				= (PFNGLCOMPILESHADERPROC)				GetEntryPoint("glCompileShader", "glCompileShaderARB");
+	glCreateProgram				= (PFNGLCREATEPROGRAMPROC)				GetEntryPoint("glCreateProgram", "glCreateProgramObjectARB");
+	glAttachShader				= (PFNGLATTACHSHADERPROC)				GetEntryPoint("glAttachShader", "glAttachObjectARB");
+	glLinkProgram				= (PFNGLLINKPROGRAMPROC)				GetEntryPoint("glLinkProgram", "glLinkProgramARB");
+	glUseProgram				= (PFNGLUSEPROGRAMPROC)					GetEntryPoint("glUseProgram", "glUseProgramObjectARB");
+	glGetAttribLocation			= (PFNGLGETATTRIBLOCATIONPROC)			GetEntryPoint("glGetAttribLocation", "glGetAttribLocationARB");
+	glBindAttribLocation		= (PFNGLBINDATTRIBLOCATIONPROC)			GetEntryPoint("glBindAttribLocation", "glBindAttribLocationARB");
+	glGetUniformLocation		= (PFNGLGETUNIFORMLOCATIONPROC)			GetEntryPoint("glGetUniformLocation", "glGetUniformLocationARB");
+	glDeleteShader				= (PFNGLDELETESHADERPROC)				GetEntryPoint("glDeleteShader", "glDeleteObjectARB");
+	glDeleteProgram				= (PFNGLDELETEPROGRAMPROC)				GetEntryPoint("glDeleteProgram", "glDeleteObjectARB");
+	glDetachShader				= (PFNGLDETACHSHADERPROC)				GetEntryPoint("glDetachShader", "glDetachObjectARB");
+	glUniform1i					= (PFNGLUNIFORM1IPROC)					GetEntryPoint("glUniform1i", "glUniform1iARB");
+	glUniform2i					= (PFNGLUNIFORM2IPROC)					GetEntryPoint("glUniform2i", "glUniform2iARB");
+	glUniform3i					= (PFNGLUNIFORM3IPROC)					GetEntryPoint("glUniform3i", "glUniform3iARB");
+	glUniform4i					= (PFNGLUNIFORM4IPROC)					GetEntryPoint("glUniform4i", "glUniform4iARB");
+	glUniform1f					= (PFNGLUNIFORM1FPROC)					GetEntryPoint("glUniform1f", "glUniform1fARB");
+	glUniform2f					= (PFNGLUNIFORM2FPROC)					GetEntryPoint("glUniform2f", "glUniform2fARB");
+	glUniform3f					= (PFNGLUNIFORM3FPROC)					GetEntryPoint("glUniform3f", "glUniform3fARB");
+	glUniform4f					= (PFNGLUNIFORM4FPROC)					GetEntryPoint("glUniform4f", "glUniform4fARB");
+	glUniformMatrix3fv			= (PFNGLUNIFORMMATRIX3FVPROC)			GetEntryPoint("glUniformMatrix3fv", "glUniformMatrix3fvARB");
+	glUniformMatrix4fv			= (PFNGLUNIFORMMATRIX4FVPROC)			GetEntryPoint("glUniformMatrix4fv", "glUniformMatrix4fvARB");
+#ifdef _WIN32
+	glActiveTexture				= (PFNGLACTIVETEXTUREPROC)				GetEntryPoint("glActiveTexture", "glActiveTextureARB");
+#endif
+	glGetShaderiv				= (PFNGLGETSHADERIVPROC)				GetEntryPoint("glGetShaderiv", "glGetObjectParameterivARB");
+	glGetProgramiv				= (PFNGLGETPROGRAMIVPROC)				GetEntryPoint("glGetProgramiv", "glGetObjectParameterivARB");
+	glGetShaderInfoLog			= (PFNGLGETSHADERINFOLOGPROC)			GetEntryPoint("glGetShaderInfoLog", "glGetInfoLogARB");
+	glGetProgramInfoLog			= (PFNGLGETPROGRAMINFOLOGPROC)			GetEntryPoint("glGetProgramInfoLog", "glGetInfoLogARB");
+	glValidateProgram			= (PFNGLVALIDATEPROGRAMPROC)			GetEntryPoint("glValidateProgram", "glValidateProgramARB");
+	glGenBuffers				= (PFNGLGENBUFFERSPROC)					GetEntryPoint("glGenBuffers", "glGenBuffersARB");
+	glBindBuffer				= (PFNGLBINDBUFFERPROC)					GetEntryPoint("glBindBuffer", "glBindBufferARB");
+	glBufferData				= (PFNGLBUFFERDATAPROC)					GetEntryPoint("glBufferData", "glBufferDataARB");
+	glDeleteBuffers				= (PFNGLDELETEBUFFERSPROC)				GetEntryPoint("glDeleteBuffers", "glDeleteBuffersARB");
+	glVertexAttribPointer		= (PFNGLVERTEXATTRIBPOINTERPROC)		GetEntryPoint("glVertexAttribPointer", "glVertexAttribPointerARB");
+	glEnableVertexAttribArray	= (PFNGLENABLEVERTEXATTRIBARRAYPROC)	GetEntryPoint("glEnableVertexAttribArray", "glEnableVertexAttribArrayARB");
+	glDisableVertexAttribArray	= (PFNGLDISABLEVERTEXATTRIBARRAYPROC)	GetEntryPoint("glDisableVertexAttribArray", "glDisableVertexAttribArrayARB");
+	glGenVertexArrays			= (PFNGLGENVERTEXARRAYSPROC)			GetEntryPoint("glGenVertexArrays", NULL);
+	glBindVertexArray			= (PFNGLBINDVERTEXARRAYPROC)			GetEntryPoint("glBindVertexArray", NULL);
+	glDeleteVertexArrays		= (PFNGLDELETEVERTEXARRAYSPROC)			GetEntryPoint("glDeleteVertexArrays", NULL);
+	glGenFramebuffers			= (PFNGLGENFRAMEBUFFERSPROC)			GetEntryPoint("glGenFramebuffers", "glGenFramebuffersEXT");
+	glDeleteFramebuffers		= (PFNGLDELETEFRAMEBUFFERSPROC)			GetEntryPoint("glDeleteFramebuffers", "glDeleteFramebuffersEXT");
+	glBindFramebuffer			= (PFNGLBINDFRAMEBUFFERPROC)			GetEntryPoint("glBindFramebuffer", "glBindFramebufferEXT");
+	glFramebufferRenderbuffer	= (PFNGLFRAMEBUFFERRENDERBUFFERPROC)	GetEntryPoint("glFramebufferRenderbuffer", "glFramebufferRenderbufferEXT");
+	glCheckFramebufferStatus	= (PFNGLCHECKFRAMEBUFFERSTATUSPROC)		GetEntryPoint("glCheckFramebufferStatus", "glCheckFramebufferStatusEXT");
+	glGenRenderbuffers			= (PFNGLGENRENDERBUFFERSPROC)			GetEntryPoint("glGenRenderbuffers", "glGenRenderbuffersEXT");
+	glDeleteRenderbuffers		= (PFNGLDELETERENDERBUFFERSPROC)		GetEntryPoint("glDeleteRenderbuffers", "glDeleteRenderbuffersEXT");
+	glBindRenderbuffer			= (PFNGLBINDRENDERBUFFERPROC)			GetEntryPoint("glBindRenderbuffer", "glBindRenderbufferEXT");
+	glRenderbufferStorage		= (PFNGLRENDERBUFFERSTORAGEPROC)		GetEntryPoint("glRenderbufferStorage", "glRenderbufferStorageEXT");
+	glCreateBuffers				= (PFNGLCREATEBUFFERSPROC)				GetEntryPoint("glCreateBuffers", NULL);
+	glNamedBufferData			= (PFNGLNAMEDBUFFERDATAPROC)			GetEntryPoint("glNamedBufferData", NULL);
+	glNamedBufferStorage		= (PFNGLNAMEDBUFFERSTORAGEPROC)			GetEntryPoint("glNamedBufferStorage", NULL);
+	glCreateVertexArrays		= (PFNGLCREATEVERTEXARRAYSPROC)			GetEntryPoint("glCreateVertexArrays", NULL);
+	glVertexArrayVertexBuffer	= (PFNGLVERTEXARRAYVERTEXBUFFERPROC)	GetEntryPoint("glVertexArrayVertexBuffer", NULL);
+	glVertexArrayElementBuffer	= (PFNGLVERTEXARRAYELEMENTBUFFERPROC)	GetEntryPoint("glVertexArrayElementBuffer", NULL);
+	glVertexArrayAttribFormat	= (PFNGLVERTEXARRAYATTRIBFORMATPROC)	GetEntryPoint("glVertexArrayAttribFormat", NULL);
+	glVertexArrayAttribBinding	= (PFNGLVERTEXARRAYATTRIBBINDINGPROC)	GetEntryPoint("glVertexArrayAttribBinding", NULL);
+	glEnableVertexArrayAttrib	= (PFNGLENABLEVERTEXARRAYATTRIBPROC)	GetEntryPoint("glEnableVertexArrayAttrib", NULL);
+	glBindTextureUnit			= (PFNGLBINDTEXTUREUNITPROC)			GetEntryPoint("glBindTextureUnit", NULL);
+	glBufferStorage				= (PFNGLBUFFERSTORAGEPROC)				GetEntryPoint("glBufferStorage", NULL);
+	glMultiDrawElementsIndirect	= (PFNGLMULTIDRAWELEMENTSINDIRECTPROC)	GetEntryPoint("glMultiDrawElementsIndirect", NULL);
+	glGenQueries				= (PFNGLGENQUERIESPROC)					GetEntryPoint("glGenQueries", "glGenQueriesARB");
+	glDeleteQueries				= (PFNGLDELETEQUERIESPROC)				GetEntryPoint("glDeleteQueries", "glDeleteQueriesARB");
+	glBeginQuery				= (PFNGLBEGINQUERYPROC)					GetEntryPoint("glBeginQuery", "glBeginQueryARB");
+	glEndQuery					= (PFNGLENDQUERYPROC)					GetEntryPoint("glEndQuery", "glEndQueryARB");
+	glQueryCounter				= (PFNGLQUERYCOUNTERPROC)				GetEntryPoint("glQueryCounter", NULL);
+	glGetQueryObjectiv			= (PFNGLGETQUERYOBJECTIVPROC)			GetEntryPoint("glGetQueryObjectiv", "glGetQueryObjectivARB");
+	glGetQueryObjectui64v		= (PFNGLGETQUERYOBJECTUI64VPROC)		GetEntryPoint("glGetQueryObjectui64v", "glGetQueryObjectui64vEXT");
+	glGetProgramBinary			= (PFNGLGETPROGRAMBINARYPROC)			GetEntryPoint("glGetProgramBinary", NULL);
+	glProgramBinary				= (PFNGLPROGRAMBINARYPROC)				GetEntryPoint("glProgramBinary", NULL);
+	glProgramParameteri			= (PFNGLPROGRAMPARAMETERIPROC)			GetEntryPoint("glProgramParameteri", NULL);
+	glDebugMessageCallback		= (PFNGLDEBUGMESSAGECALLBACKPROC)		GetEntryPoint("glDebugMessageCallback", NULL);
+	glDebugMessageControl		= (PFNGLDEBUGMESSAGECONTROLPROC)		GetEntryPoint("glDebugMessageControl", NULL);
+
+	//a feature is only usable if the context has it & every entry point resolved
+	s_Caps.shaderObjects =
+		(HasVersion(2, 0) || IsExtensionSupported("GL_ARB_shader_objects")) &&
+		glCreateShader && glShaderSource && glCompileShader && glCreateProgram &&
+		glAttachShader && glLinkProgram && glUseProgram && glGetUniformLocation &&
+		glDeleteShader && glDeleteProgram && glGetShaderiv && glGetProgramiv &&
+		glGetShaderInfoLog && glGetProgramInfoLog && glUniform1i && glUniform1f &&
+		glUniform3f && glUniformMatrix3fv && glUniformMatrix4fv;
+
+	s_Caps.vertexArrayObjects =
+		(HasVersion(3, 0) || IsExtensionSupported("GL_ARB_vertex_array_object")) &&
+		glGenVertexArrays && glBindVertexArray && glDeleteVertexArrays &&
+		glGenBuffers && glBindBuffer && glBufferData && glDeleteBuffers &&
+		glVertexAttribPointer && glEnableVertexAttribArray;
+
+	s_Caps.framebufferObjects =
+		(HasVersion(3, 0) || IsExtensionSupported("GL_ARB_framebuffer_object") || IsExtensionSupported("GL_EXT_framebuffer_object")) &&
+		glGenFramebuffers && glDeleteFramebuffers && glBindFramebuffer &&
+		glFramebufferRenderbuffer && glCheckFramebufferStatus && glGenRenderbuffers &&
+		glDeleteRenderbuffers && glBindRenderbuffer && glRenderbufferStorage;
+
+	s_Caps.directStateAccess =
+		(HasVersion(4, 5) || IsExtensionSupported("GL_ARB_direct_state_access")) &&
+		glCreateBuffers && glNamedBufferData && glCreateVertexArrays &&
+		glVertexArrayVertexBuffer && glVertexArrayElementBuffer &&
+		glVertexArrayAttribFormat && glVertexArrayAttribBinding &&
+		glEnableVertexArrayAttrib && glBindTextureUnit;
+
+	s_Caps.bufferStorage =
+		(HasVersion(4, 4) || IsExtensionSupported("GL_ARB_buffer_storage")) &&
+		glBufferStorage && (!s_Caps.directStateAccess || glNamedBufferStorage);
+
+	s_Caps.multiDrawIndirect =
+		(HasVersion(4, 3) || IsExtensionSupported("GL_ARB_multi_draw_indirect")) &&
+		glMultiDrawElementsIndirect;
+
+	s_Caps.timerQuery =
+		(HasVersion(3, 3) || IsExtensionSupported("GL_ARB_timer_query")) &&
+		glGenQueries && glDeleteQueries && glBeginQuery && glEndQuery &&
+		glQueryCounter && glGetQueryObjectiv && glGetQueryObjectui64v;
+
+	s_Caps.programBinary =
+		(HasVersion(4, 1) || IsExtensionSupported("GL_ARB_get_program_binary")) &&
+		glGetProgramBinary && glProgramBinary && glProgramParameteri;
+
+	s_Caps.debugOutput =
+		(HasVersion(4, 3) || IsExtensionSupported("GL_KHR_debug")) &&
+		glDebugMessageCallback && glDebugMessageControl;
+
+	//a driver may support the API but no binary format at all
+	if(s_Caps.programBinary)
+	{
+		GLint formats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		s_Caps.programBinary = formats > 0;
+	}
+
+	//compile & link in the driver's background threads when available
+	glMaxShaderCompilerThreads = NULL;
+	if(IsExtensionSupported("GL_KHR_parallel_shader_compile") || IsExtensionSupported("GL_ARB_parallel_shader_compile"))
+		glMaxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)GetEntryPoint("glMaxShaderCompilerThreadsKHR", "glMaxShaderCompilerThreadsARB");
+
+	s_Caps.parallelShaderCompile = (glMaxShaderCompilerThreads != NULL);
+
+	//let the implementation pick the number of compiler threads
+	if(glMaxShaderCompilerThreads)
+		glMaxShaderCompilerThreads(0xFFFFFFFF);
+
+	sprintf(buffer, "OpenGL %d.%d%s: GLSL %d, VAO %d, FBO %d, DSA %d, buffer storage %d, MDI %d, timer query %d, program binary %d, parallel compile %d, debug output %d\n",
+			s_Caps.majorVersion, s_Caps.minorVersion, s_Caps.coreProfile ? " core" : "",
+			s_Caps.shaderObjects, s_Caps.vertexArrayObjects, s_Caps.framebufferObjects, s_Caps.directStateAccess,
+			s_Caps.bufferStorage, s_Caps.multiDrawIndirect, s_Caps.timerQuery,
+			s_Caps.programBinary, s_Caps.parallelShaderCompile, s_Caps.debugOutput);
+	OutputDebugString(buffer);
+
+#ifdef CHARCOAL_GLSTATS
+	GLStats::Hook();
+#endif
+
+	return s_Caps.shaderObjects;
+}
+
+///----------------------------------------------------------------------------
+///Checks whether the current context supports an extension, looking it up
+///in the list read by InitExtensions().
+///@param	extension - the extension name (i.e. "GL_ARB_shader_objects")
+///@return	true if the current context supports it
+///----------------------------------------------------------------------------
+bool IsExtensionSupported(const char *extension)
+{
+	return binary_search(s_Extensions.begin(), s_Extensions.end(), string(extension));
+}
 
 ///----------------------------------------------------------------------------
-///Initializes OpenGL extensions for Win32.
+///Gets the capabilities of the current context.
+///@return	the feature table filled by InitExtensions()
 ///----------------------------------------------------------------------------
-void InitExtensions()
+const GLCapabilities& GetCapabilities()
 {
-	glCreateShaderObject	= (PFNGLCREATESHADEROBJECTARBPROC)	wglGetProcAddress("glCreateShaderObjectARB");
-	glShaderSource			= (PFNGLSHADERSOURCEARBPROC)		wglGetProcAddress("glShaderSourceARB");
-	glCompileShader			= (PFNGLCOMPILESHADERARBPROC)		wglGetProcAddress("glCompileShaderARB");
-	glCreateProgramObject	= (PFNGLCREATEPROGRAMOBJECTARBPROC) wglGetProcAddress("glCreateProgramObjectARB");
-	glAttachObject			= (PFNGLATTACHOBJECTARBPROC)		wglGetProcAddress("glAttachObjectARB");
-	glLinkProgram			= (PFNGLLINKPROGRAMARBPROC)			wglGetProcAddress("glLinkProgramARB");
-	glUseProgramObject		= (PFNGLUSEPROGRAMOBJECTARBPROC)	wglGetProcAddress("glUseProgramObjectARB");
-	glGetAttribLocation		= (PFNGLGETATTRIBLOCATIONARBPROC)	wglGetProcAddress("glGetAttribLocationARB");
-	glGetUniformLocation	= (PFNGLGETUNIFORMLOCATIONARBPROC)	wglGetProcAddress("glGetUniformLocationARB");
-	glDeleteObject			= (PFNGLDELETEOBJECTARBPROC)		wglGetProcAddress("glDeleteObjectARB");
-	glDetachObject			= (PFNGLDETACHOBJECTARBPROC)		wglGetProcAddress("glDetachObjectARB");
-	glUniform1i				= (PFNGLUNIFORM1IARBPROC)			wglGetProcAddress("glUniform1iARB");
-	glUniform2i				= (PFNGLUNIFORM2IARBPROC)			wglGetProcAddress("glUniform2iARB");
-	glUniform3i				= (PFNGLUNIFORM3IARBPROC)			wglGetProcAddress("glUniform3iARB");
-	glUniform4i				= (PFNGLUNIFORM4IARBPROC)			wglGetProcAddress("glUniform4iARB");
-	glUniform1f				= (PFNGLUNIFORM1FARBPROC)			wglGetProcAddress("glUniform1fARB");
-	glUniform2f				= (PFNGLUNIFORM2FARBPROC)			wglGetProcAddress("glUniform2fARB");
-	glUniform3f				= (PFNGLUNIFORM3FARBPROC)			wglGetProcAddress("glUniform3fARB");
-	glUniform4f				= (PFNGLUNIFORM4FARBPROC)			wglGetProcAddress("glUniform4fARB");
-	glActiveTexture			= (PFNGLACTIVETEXTUREARBPROC)		wglGetProcAddress("glActiveTextureARB");
-	glGetObjectParameteriv	= (PFNGLGETOBJECTPARAMETERIVARBPROC)wglGetProcAddress("glGetObjectParameterivARB");
-	glGetInfoLog			= (PFNGLGETINFOLOGARBPROC)			wglGetProcAddress("glGetInfoLogARB");
-	glValidateProgram		= (PFNGLVALIDATEPROGRAMARBPROC)		wglGetProcAddress("glValidateProgramARB");
-	wglCreatePbuffer		= (PFNWGLCREATEPBUFFERARBPROC)		wglGetProcAddress("wglCreatePbufferARB");
-	wglGetPbufferDC			= (PFNWGLGETPBUFFERDCARBPROC)		wglGetProcAddress("wglGetPbufferDCARB");
-	wglReleasePbufferDC		= (PFNWGLRELEASEPBUFFERDCARBPROC)	wglGetProcAddress("wglReleasePbufferDCARB");
-	wglDestroyPbuffer		= (PFNWGLDESTROYPBUFFERARBPROC)		wglGetProcAddress("wglDestroyPbufferARB");
-	wglBindTexImage			= (PFNWGLBINDTEXIMAGEARBPROC)		wglGetProcAddress("wglBindTexImageARB");
-	wglReleaseTexImage		= (PFNWGLRELEASETEXIMAGEARBPROC)	wglGetProcAddress("wglReleaseTexImageARB");
-	wglChoosePixelFormat	= (PFNWGLCHOOSEPIXELFORMATARBPROC)	wglGetProcAddress("wglChoosePixelFormatARB");
+	return s_Caps;
 }
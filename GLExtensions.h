@@ -2,49 +2,179 @@
 #ifndef GLEXTENSIONS_H
 #define GLEXTENSIONS_H
 
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <GL/gl.h>
 #include <GL/glu.h>
 #include <GL/glut.h>
 #include <GL/glext.h>
+#ifdef _WIN32
 #include <GL/wglext.h>
+#else
+#include <stdio.h>
+#endif
+
+//-------------------------------------------------------------------------
+// Win32 names used by the rendering code, so it also builds on Linux
+// for the headless renderer
+//-------------------------------------------------------------------------
+#ifndef _WIN32
+typedef char* LPSTR;
+inline void OutputDebugString(const char *text) { fputs(text, stderr); }
+#endif
+
+//-------------------------------------------------------------------------
+// Missing from older glext.h & wglext.h headers
+//-------------------------------------------------------------------------
+#ifndef GL_KHR_parallel_shader_compile
+#define GL_KHR_parallel_shader_compile 1
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR	0x91B0
+#define GL_COMPLETION_STATUS_KHR			0x91B1
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC) (GLuint count);
+#endif
+
+#ifndef GL_VERSION_4_3
+#define GL_DEBUG_OUTPUT						0x92E0
+#define GL_DEBUG_TYPE_PERFORMANCE			0x8250
+typedef void (APIENTRY *GLDEBUGPROC) (GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *message, const void *userParam);
+typedef void (APIENTRYP PFNGLDEBUGMESSAGECALLBACKPROC) (GLDEBUGPROC callback, const void *userParam);
+typedef void (APIENTRYP PFNGLDEBUGMESSAGECONTROLPROC) (GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled);
+#endif
+
+#if defined(_WIN32) && !defined(WGL_ARB_create_context_profile)
+#define WGL_ARB_create_context_profile 1
+#define WGL_CONTEXT_MAJOR_VERSION_ARB		0x2091
+#define WGL_CONTEXT_MINOR_VERSION_ARB		0x2092
+#define WGL_CONTEXT_FLAGS_ARB				0x2094
+#define WGL_CONTEXT_PROFILE_MASK_ARB		0x9126
+#define WGL_CONTEXT_CORE_PROFILE_BIT_ARB	0x00000001
+typedef HGLRC (WINAPI * PFNWGLCREATECONTEXTATTRIBSARBPROC) (HDC hDC, HGLRC hShareContext, const int *attribList);
+#endif
+
+//-------------------------------------------------------------------------
+// Capabilities of the current context, detected once by InitExtensions()
+// from the GL version & extension list. A feature is only reported when
+// all its entry points were resolved, so render paths can rely on them.
+//-------------------------------------------------------------------------
+struct GLCapabilities
+{
+	int		majorVersion;			///> GL_MAJOR_VERSION
+	int		minorVersion;			///> GL_MINOR_VERSION
+	bool	coreProfile;			///> Context without the fixed function pipeline
+	bool	shaderObjects;			///> GLSL programs (GL 2.0 / ARB_shader_objects)
+	bool	vertexArrayObjects;		///> Vertex array objects (GL 3.0 / ARB_vertex_array_object)
+	bool	framebufferObjects;		///> Offscreen render targets (GL 3.0 / ARB_framebuffer_object)
+	bool	directStateAccess;		///> Edit objects without binding them (GL 4.5 / ARB_direct_state_access)
+	bool	bufferStorage;			///> Immutable buffers (GL 4.4 / ARB_buffer_storage)
+	bool	multiDrawIndirect;		///> Many draws from one buffer (GL 4.3 / ARB_multi_draw_indirect)
+	bool	timerQuery;				///> GPU timestamps (GL 3.3 / ARB_timer_query)
+	bool	programBinary;			///> Reusable linked programs (GL 4.1 / ARB_get_program_binary)
+	bool	parallelShaderCompile;	///> Non-blocking compile status (KHR_parallel_shader_compile)
+	bool	debugOutput;			///> Driver messages callback (GL 4.3 / KHR_debug)
+};
 
 //-------------------------------------------------------------------------
 // Since Windows include only OpenGL version 1.1 support in opengl32.dll
 // and the opengl32.lib stub library also contains only version 1.1 symbols,
 // we must define entry-point functions for GL >= 1.2
 //-------------------------------------------------------------------------
-extern PFNGLCREATESHADEROBJECTARBPROC		glCreateShaderObject;
-extern PFNGLSHADERSOURCEARBPROC				glShaderSource;
-extern PFNGLCOMPILESHADERARBPROC			glCompileShader;
-extern PFNGLCREATEPROGRAMOBJECTARBPROC		glCreateProgramObject;
-extern PFNGLATTACHOBJECTARBPROC				glAttachObject;
-extern PFNGLLINKPROGRAMARBPROC				glLinkProgram;
-extern PFNGLUSEPROGRAMOBJECTARBPROC			glUseProgramObject;
-extern PFNGLGETATTRIBLOCATIONARBPROC		glGetAttribLocation;
-extern PFNGLGETUNIFORMLOCATIONARBPROC		glGetUniformLocation;
-extern PFNGLDELETEOBJECTARBPROC				glDeleteObject;
-extern PFNGLDETACHOBJECTARBPROC				glDetachObject;
-extern PFNGLUNIFORM1IARBPROC				glUniform1i;
-extern PFNGLUNIFORM2IARBPROC				glUniform2i;
-extern PFNGLUNIFORM3IARBPROC				glUniform3i;
-extern PFNGLUNIFORM4IARBPROC				glUniform4i;
-extern PFNGLUNIFORM1FARBPROC				glUniform1f;
-extern PFNGLUNIFORM2FARBPROC				glUniform2f;
-extern PFNGLUNIFORM3FARBPROC				glUniform3f;
-extern PFNGLUNIFORM4FARBPROC				glUniform4f;
-extern PFNGLACTIVETEXTUREARBPROC			glActiveTexture;
-extern PFNGLGETOBJECTPARAMETERIVARBPROC		glGetObjectParameteriv;
-extern PFNGLGETINFOLOGARBPROC				glGetInfoLog;
-extern PFNGLVALIDATEPROGRAMARBPROC			glValidateProgram;
-extern PFNWGLCREATEPBUFFERARBPROC			wglCreatePbuffer;
-extern PFNWGLGETPBUFFERDCARBPROC			wglGetPbufferDC;
-extern PFNWGLRELEASEPBUFFERDCARBPROC		wglReleasePbufferDC;
-extern PFNWGLDESTROYPBUFFERARBPROC			wglDestroyPbuffer;
-extern PFNWGLBINDTEXIMAGEARBPROC			wglBindTexImage;
-extern PFNWGLRELEASETEXIMAGEARBPROC			wglReleaseTexImage;
-extern PFNWGLCHOOSEPIXELFORMATARBPROC		wglChoosePixelFormat;
-
-void InitExtensions();
+extern PFNGLCREATESHADERPROC				glCreateShader;
+extern PFNGLSHADERSOURCEPROC				glShaderSource;
+extern PFNGLCOMPILESHADERPROC				glCompileShader;
+extern PFNGLCREATEPROGRAMPROC				glCreateProgram;
+extern PFNGLATTACHSHADERPROC				glAttachShader;
+extern PFNGLLINKPROGRAMPROC					glLinkProgram;
+extern PFNGLUSEPROGRAMPROC					glUseProgram;
+extern PFNGLGETATTRIBLOCATIONPROC			glGetAttribLocation;
+extern PFNGLBINDATTRIBLOCATIONPROC			glBindAttribLocation;
+extern PFNGLGETUNIFORMLOCATIONPROC			glGetUniformLocation;
+extern PFNGLDELETESHADERPROC				glDeleteShader;
+extern PFNGLDELETEPROGRAMPROC				glDeleteProgram;
+extern PFNGLDETACHSHADERPROC				glDetachShader;
+extern PFNGLUNIFORM1IPROC					glUniform1i;
+extern PFNGLUNIFORM2IPROC					glUniform2i;
+extern PFNGLUNIFORM3IPROC					glUniform3i;
+extern PFNGLUNIFORM4IPROC					glUniform4i;
+extern PFNGLUNIFORM1FPROC					glUniform1f;
+extern PFNGLUNIFORM2FPROC					glUniform2f;
+extern PFNGLUNIFORM3FPROC					glUniform3f;
+extern PFNGLUNIFORM4FPROC					glUniform4f;
+extern PFNGLUNIFORMMATRIX3FVPROC			glUniformMatrix3fv;
+extern PFNGLUNIFORMMATRIX4FVPROC			glUniformMatrix4fv;
+#ifdef _WIN32
+extern PFNGLACTIVETEXTUREPROC				glActiveTexture;
+#endif
+extern PFNGLGETSHADERIVPROC					glGetShaderiv;
+extern PFNGLGETPROGRAMIVPROC				glGetProgramiv;
+extern PFNGLGETSHADERINFOLOGPROC			glGetShaderInfoLog;
+extern PFNGLGETPROGRAMINFOLOGPROC			glGetProgramInfoLog;
+extern PFNGLVALIDATEPROGRAMPROC				glValidateProgram;
+extern PFNGLGENBUFFERSPROC					glGenBuffers;
+extern PFNGLBINDBUFFERPROC					glBindBuffer;
+extern PFNGLBUFFERDATAPROC					glBufferData;
+extern PFNGLDELETEBUFFERSPROC				glDeleteBuffers;
+extern PFNGLVERTEXATTRIBPOINTERPROC			glVertexAttribPointer;
+extern PFNGLENABLEVERTEXATTRIBARRAYPROC		glEnableVertexAttribArray;
+extern PFNGLDISABLEVERTEXATTRIBARRAYPROC	glDisableVertexAttribArray;
+extern PFNGLGENVERTEXARRAYSPROC				glGenVertexArrays;
+extern PFNGLBINDVERTEXARRAYPROC				glBindVertexArray;
+extern PFNGLDELETEVERTEXARRAYSPROC			glDeleteVertexArrays;
+extern PFNGLGETSTRINGIPROC					glGetStringi;
+extern PFNGLMAXSHADERCOMPILERTHREADSKHRPROC	glMaxShaderCompilerThreads;
+
+//framebuffer objects
+extern PFNGLGENFRAMEBUFFERSPROC				glGenFramebuffers;
+extern PFNGLDELETEFRAMEBUFFERSPROC			glDeleteFramebuffers;
+extern PFNGLBINDFRAMEBUFFERPROC				glBindFramebuffer;
+extern PFNGLFRAMEBUFFERRENDERBUFFERPROC		glFramebufferRenderbuffer;
+extern PFNGLCHECKFRAMEBUFFERSTATUSPROC		glCheckFramebufferStatus;
+extern PFNGLGENRENDERBUFFERSPROC			glGenRenderbuffers;
+extern PFNGLDELETERENDERBUFFERSPROC			glDeleteRenderbuffers;
+extern PFNGLBINDRENDERBUFFERPROC			glBindRenderbuffer;
+extern PFNGLRENDERBUFFERSTORAGEPROC			glRenderbufferStorage;
+
+//direct state access
+extern PFNGLCREATEBUFFERSPROC				glCreateBuffers;
+extern PFNGLNAMEDBUFFERDATAPROC				glNamedBufferData;
+extern PFNGLNAMEDBUFFERSTORAGEPROC			glNamedBufferStorage;
+extern PFNGLCREATEVERTEXARRAYSPROC			glCreateVertexArrays;
+extern PFNGLVERTEXARRAYVERTEXBUFFERPROC		glVertexArrayVertexBuffer;
+extern PFNGLVERTEXARRAYELEMENTBUFFERPROC	glVertexArrayElementBuffer;
+extern PFNGLVERTEXARRAYATTRIBFORMATPROC		glVertexArrayAttribFormat;
+extern PFNGLVERTEXARRAYATTRIBBINDINGPROC	glVertexArrayAttribBinding;
+extern PFNGLENABLEVERTEXARRAYATTRIBPROC		glEnableVertexArrayAttrib;
+extern PFNGLBINDTEXTUREUNITPROC				glBindTextureUnit;
+
+//buffer storage
+extern PFNGLBUFFERSTORAGEPROC				glBufferStorage;
+
+//multi-draw-indirect
+extern PFNGLMULTIDRAWELEMENTSINDIRECTPROC	glMultiDrawElementsIndirect;
+
+//timer queries
+extern PFNGLGENQUERIESPROC					glGenQueries;
+extern PFNGLDELETEQUERIESPROC				glDeleteQueries;
+extern PFNGLBEGINQUERYPROC					glBeginQuery;
+extern PFNGLENDQUERYPROC					glEndQuery;
+extern PFNGLQUERYCOUNTERPROC				glQueryCounter;
+extern PFNGLGETQUERYOBJECTIVPROC			glGetQueryObjectiv;
+extern PFNGLGETQUERYOBJECTUI64VPROC			glGetQueryObjectui64v;
+
+//program binary
+extern PFNGLGETPROGRAMBINARYPROC			glGetProgramBinary;
+extern PFNGLPROGRAMBINARYPROC				glProgramBinary;
+extern PFNGLPROGRAMPARAMETERIPROC			glProgramParameteri;
+
+//debug output
+extern PFNGLDEBUGMESSAGECALLBACKPROC		glDebugMessageCallback;
+extern PFNGLDEBUGMESSAGECONTROLPROC			glDebugMessageControl;
+
+bool					InitExtensions();
+bool					IsExtensionSupported(const char *extension);
+const GLCapabilities&	GetCapabilities();
+
+//counts the calls in the builds with CHARCOAL_GLSTATS
+#include "GLStats.h"
 
 #endif
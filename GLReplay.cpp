@@ -0,0 +1,1273 @@
+///============================================================================
+///@file	GLReplay.cpp
+///@brief	Charcoal Rendering, replays a GL capture (GLCapture.h) headless
+///			as fast as it can, to measure what the GL calls cost without
+///			the application: the same frames on other drivers, or the
+///			legacy & core renderers' traces against each other.
+///
+///			usage: GLReplay trace.gltrace [-loops N] [-warmup N]
+///					[-json report.json]
+///
+///			The calls before the first frame (loading) are replayed once.
+///			Then the frames are replayed -warmup times (1 by default)
+///			untimed and -loops times (10 by default) timed, each frame
+///			ending with a glFinish(); the calls between two frames aren't
+///			timed. The calls after the last frame are replayed at the end.
+///			The context has the profile of the captured one and the
+///			default framebuffer is replaced by a framebuffer object of the
+///			captured size. Objects the frames create are created again on
+///			every loop. -json writes the frame times, the calls per frame
+///			& second and the build, driver & host of the run.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+//the replay calls the GL itself, never through the counting wrappers
+#define GLSTATS_NO_MACROS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <map>
+#include <string>
+
+#include "HeadlessContext.h"
+#include "FrameBuffer.h"
+#include "GLExtensions.h"
+#include "GLCapture.h"
+#include "FrameRecorder.h"
+#include "FramePacer.h"
+#include "Benchmark.h"
+
+using namespace std;
+
+typedef map<GLuint, GLuint> NameMap;
+typedef void (APIENTRY *GenProc)(GLsizei n, GLuint *names);
+typedef void (APIENTRY *DeleteProc)(GLsizei n, const GLuint *names);
+
+//-----------------------------------------------------------------------------
+//A capture read to memory
+//-----------------------------------------------------------------------------
+struct Trace
+{
+	vector<unsigned char>			data;		///> The whole file
+	CaptureHeader					header;		///> Its header
+	size_t							end;		///> Where the calls end & the index starts
+	vector<unsigned long long>		frames;		///> Start & end offset of each frame
+};
+
+//-----------------------------------------------------------------------------
+//Reads the calls of a range of the trace
+//-----------------------------------------------------------------------------
+struct Reader
+{
+	const unsigned char		*data;		///> The trace
+	size_t					pos;		///> Next byte
+	size_t					end;		///> End of the range
+	bool					failed;		///> Read past the end
+};
+
+//-----------------------------------------------------------------------------
+//What the replay maps from the capture to its own context
+//-----------------------------------------------------------------------------
+struct ReplayState
+{
+	NameMap					textures;		///> Captured name to replay name
+	NameMap					buffers;
+	NameMap					vertexArrays;
+	NameMap					framebuffers;
+	NameMap					renderbuffers;
+	NameMap					shaders;
+	NameMap					programs;
+	NameMap					queries;
+	map<pair<GLuint, GLint>, GLint>	uniforms;	///> Captured program & location to replay location
+	GLuint					program;		///> Program in use, its captured name
+	GLuint					framebuffer;	///> Replaces the default framebuffer
+	vector<unsigned char>	pixels;			///> glReadPixels() destination
+	vector<GLfloat>			floats;			///> Aligned copy of the floats of a call
+	unsigned long			calls;			///> Calls replayed
+};
+
+///----------------------------------------------------------------------------
+///Reads the next bytes of the range.
+///@param	reader - the range
+///@param	size - how many
+///@return	the bytes, NULL past the end
+///----------------------------------------------------------------------------
+static const unsigned char* GetBytes(Reader &reader, size_t size)
+{
+	if(reader.failed || size > reader.end - reader.pos)
+	{
+		reader.failed = true;
+		return NULL;
+	}
+
+	const unsigned char *bytes = reader.data + reader.pos;
+	reader.pos += size;
+
+	return bytes;
+}
+
+///----------------------------------------------------------------------------
+///Reads an argument.
+///@param	reader - the range
+///@return	the value, 0 past the end
+///----------------------------------------------------------------------------
+template<class T> static T Get(Reader &reader)
+{
+	T value = T();
+	const unsigned char *bytes = GetBytes(reader, sizeof(T));
+
+	if(bytes)
+		memcpy(&value, bytes, sizeof(T));
+
+	return value;
+}
+
+///----------------------------------------------------------------------------
+///Reads a pointer argument that is an offset into a bound buffer.
+///@param	reader - the range
+///@return	the offset as a pointer
+///----------------------------------------------------------------------------
+static const void* GetOffset(Reader &reader)
+{
+	return (const void*)(size_t)Get<unsigned long long>(reader);
+}
+
+///----------------------------------------------------------------------------
+///Reads a block of data recorded by GLCapture::PutData().
+///@param	reader - the range
+///@param	size - receives its size
+///@return	the bytes, NULL if none were recorded
+///----------------------------------------------------------------------------
+static const void* GetData(Reader &reader, GLsizeiptr &size)
+{
+	GLuint length	= Get<GLuint>(reader);
+	bool present	= Get<GLboolean>(reader) != 0;
+
+	size = length;
+
+	return present ? GetBytes(reader, length) : NULL;
+}
+
+///----------------------------------------------------------------------------
+///Reads a string recorded by GLCapture::PutString().
+///@param	reader - the range
+///@return	the string
+///----------------------------------------------------------------------------
+static string GetString(Reader &reader)
+{
+	GLint length = Get<GLint>(reader);
+	const unsigned char *text = GetBytes(reader, length > 0 ? length : 0);
+
+	return text ? string((const char*)text, length) : string();
+}
+
+///----------------------------------------------------------------------------
+///Reads floats, copied so they are aligned.
+///@param	reader - the range
+///@param	count - how many
+///@param	state - holds the copy
+///@return	the floats, valid until the next call reads some
+///----------------------------------------------------------------------------
+static const GLfloat* GetFloats(Reader &reader, int count, ReplayState &state)
+{
+	const unsigned char *bytes = GetBytes(reader, count * sizeof(GLfloat));
+
+	if(state.floats.size() < (size_t)count)
+		state.floats.resize(count);
+
+	if(bytes)
+		memcpy(&state.floats[0], bytes, count * sizeof(GLfloat));
+
+	return &state.floats[0];
+}
+
+///----------------------------------------------------------------------------
+///Maps a captured object name to the replay's.
+///@param	names - the names of its kind
+///@param	name - the captured name
+///@return	the replay's name, 0 for 0
+///----------------------------------------------------------------------------
+static GLuint Remap(const NameMap &names, GLuint name)
+{
+	if(!name)
+		return 0;
+
+	NameMap::const_iterator it = names.find(name);
+
+	return it != names.end() ? it->second : name;
+}
+
+///----------------------------------------------------------------------------
+///Maps a captured uniform location of the program in use to the replay's.
+///@param	state - the replay state
+///@param	location - the captured location
+///@return	the replay's location, -1 stays -1
+///----------------------------------------------------------------------------
+static GLint RemapLocation(const ReplayState &state, GLint location)
+{
+	if(location < 0)
+		return location;
+
+	map<pair<GLuint, GLint>, GLint>::const_iterator it = state.uniforms.find(make_pair(state.program, location));
+
+	return it != state.uniforms.end() ? it->second : location;
+}
+
+///----------------------------------------------------------------------------
+///Creates the objects a glGen*() or glCreate*() call created.
+///@param	reader - the range
+///@param	names - receives the names of the objects
+///@param	gen - the call
+///----------------------------------------------------------------------------
+static void GenNames(Reader &reader, NameMap &names, GenProc gen)
+{
+	GLsizei count = Get<GLint>(reader);
+	const unsigned char *captured = GetBytes(reader, count > 0 ? count * sizeof(GLuint) : 0);
+
+	if(!captured || count <= 0)
+		return;
+
+	vector<GLuint> created(count);
+	gen(count, &created[0]);
+
+	for(GLsizei i=0; i<count; i++)
+	{
+		GLuint name;
+		memcpy(&name, captured + i * sizeof(GLuint), sizeof(GLuint));
+
+		names[name] = created[i];
+	}
+}
+
+///----------------------------------------------------------------------------
+///Deletes the objects a glDelete*() call deleted.
+///@param	reader - the range
+///@param	names - the names of the objects, they are removed
+///@param	del - the call
+///----------------------------------------------------------------------------
+static void DeleteNames(Reader &reader, NameMap &names, DeleteProc del)
+{
+	GLsizei count = Get<GLint>(reader);
+	const unsigned char *captured = GetBytes(reader, count > 0 ? count * sizeof(GLuint) : 0);
+
+	if(!captured || count <= 0)
+		return;
+
+	vector<GLuint> deleted(count);
+
+	for(GLsizei i=0; i<count; i++)
+	{
+		GLuint name;
+		memcpy(&name, captured + i * sizeof(GLuint), sizeof(GLuint));
+
+		deleted[i] = Remap(names, name);
+		names.erase(name);
+	}
+
+	del(count, &deleted[0]);
+}
+
+///----------------------------------------------------------------------------
+///Reports an entry point the trace uses & the context doesn't have.
+///@param	name - the entry point
+///@return	false
+///----------------------------------------------------------------------------
+static bool Missing(const char *name)
+{
+	fprintf(stderr, "The trace calls %s, the context doesn't have it.\n", name);
+	return false;
+}
+
+///----------------------------------------------------------------------------
+///Replays a call.
+///@param	command - the call
+///@param	reader - its arguments
+///@param	state - the names & locations mapped so far
+///@return	false if the call is unknown or can't be made
+///----------------------------------------------------------------------------
+static bool Execute(GLCommand command, Reader &reader, ReplayState &state)
+{
+	GLsizeiptr size;
+	const void *data;
+
+	switch(command)
+	{
+	case GC_FRAME:
+	case GC_FRAME_END:
+		return true;
+
+	//GL 1.1
+	case GC_BEGIN:
+		glBegin(Get<GLuint>(reader));
+		break;
+
+	case GC_END:
+		glEnd();
+		break;
+
+	case GC_VERTEX3F:
+	{
+		GLfloat x = Get<GLfloat>(reader);
+		GLfloat y = Get<GLfloat>(reader);
+		GLfloat z = Get<GLfloat>(reader);
+		glVertex3f(x, y, z);
+		break;
+	}
+
+	case GC_VERTEX3FV:
+		glVertex3fv(GetFloats(reader, 3, state));
+		break;
+
+	case GC_NORMAL3FV:
+		glNormal3fv(GetFloats(reader, 3, state));
+		break;
+
+	case GC_TEXCOORD2F:
+	{
+		GLfloat s = Get<GLfloat>(reader);
+		GLfloat t = Get<GLfloat>(reader);
+		glTexCoord2f(s, t);
+		break;
+	}
+
+	case GC_DRAW_ARRAYS:
+	{
+		GLenum mode		= Get<GLuint>(reader);
+		GLint first		= Get<GLint>(reader);
+		GLsizei count	= Get<GLint>(reader);
+		glDrawArrays(mode, first, count);
+		break;
+	}
+
+	case GC_DRAW_ELEMENTS:
+	{
+		GLenum mode		= Get<GLuint>(reader);
+		GLsizei count	= Get<GLint>(reader);
+		GLenum type		= Get<GLuint>(reader);
+		glDrawElements(mode, count, type, GetOffset(reader));
+		break;
+	}
+
+	case GC_BIND_TEXTURE:
+	{
+		GLenum target = Get<GLuint>(reader);
+		glBindTexture(target, Remap(state.textures, Get<GLuint>(reader)));
+		break;
+	}
+
+	case GC_MATERIALF:
+	{
+		GLenum face		= Get<GLuint>(reader);
+		GLenum pname	= Get<GLuint>(reader);
+		glMaterialf(face, pname, Get<GLfloat>(reader));
+		break;
+	}
+
+	case GC_MATERIALFV:
+	{
+		GLenum face		= Get<GLuint>(reader);
+		GLenum pname	= Get<GLuint>(reader);
+		glMaterialfv(face, pname, GetFloats(reader, GLCapture::GetParameterCount(pname), state));
+		break;
+	}
+
+	case GC_TEX_IMAGE_2D:
+	{
+		GLenum target	= Get<GLuint>(reader);
+		GLint level		= Get<GLint>(reader);
+		GLint internal	= Get<GLint>(reader);
+		GLsizei width	= Get<GLint>(reader);
+		GLsizei height	= Get<GLint>(reader);
+		GLint border	= Get<GLint>(reader);
+		GLenum format	= Get<GLuint>(reader);
+		GLenum type		= Get<GLuint>(reader);
+		data = GetData(reader, size);
+		glTexImage2D(target, level, internal, width, height, border, format, type, data);
+		break;
+	}
+
+	case GC_ENABLE:
+		glEnable(Get<GLuint>(reader));
+		break;
+
+	case GC_DISABLE:
+		glDisable(Get<GLuint>(reader));
+		break;
+
+	case GC_ACTIVE_TEXTURE:
+		glActiveTexture(Get<GLuint>(reader));
+		break;
+
+	case GC_CLEAR:
+		glClear(Get<GLuint>(reader));
+		break;
+
+	case GC_CLEAR_COLOR:
+	{
+		const GLfloat *color = GetFloats(reader, 4, state);
+		glClearColor(color[0], color[1], color[2], color[3]);
+		break;
+	}
+
+	case GC_VIEWPORT:
+	{
+		GLint x			= Get<GLint>(reader);
+		GLint y			= Get<GLint>(reader);
+		GLsizei width	= Get<GLint>(reader);
+		GLsizei height	= Get<GLint>(reader);
+		glViewport(x, y, width, height);
+		break;
+	}
+
+	case GC_PIXEL_STOREI:
+	{
+		GLenum pname = Get<GLuint>(reader);
+		glPixelStorei(pname, Get<GLint>(reader));
+		break;
+	}
+
+	case GC_READ_PIXELS:
+	{
+		GLint x			= Get<GLint>(reader);
+		GLint y			= Get<GLint>(reader);
+		GLsizei width	= Get<GLint>(reader);
+		GLsizei height	= Get<GLint>(reader);
+		GLenum format	= Get<GLuint>(reader);
+		GLenum type		= Get<GLuint>(reader);
+
+		//rows aligned to 8, the most GL_PACK_ALIGNMENT can ask
+		size_t bytes = GLCapture::GetImageSize(width, height, format, type, 8);
+		if(state.pixels.size() < bytes)
+			state.pixels.resize(bytes);
+
+		if(bytes)
+			glReadPixels(x, y, width, height, format, type, &state.pixels[0]);
+		break;
+	}
+
+	case GC_COLOR_MATERIAL:
+	{
+		GLenum face = Get<GLuint>(reader);
+		glColorMaterial(face, Get<GLuint>(reader));
+		break;
+	}
+
+	case GC_GEN_TEXTURES:
+		GenNames(reader, state.textures, glGenTextures);
+		break;
+
+	case GC_DELETE_TEXTURES:
+		DeleteNames(reader, state.textures, glDeleteTextures);
+		break;
+
+	case GC_LIGHTFV:
+	{
+		GLenum light	= Get<GLuint>(reader);
+		GLenum pname	= Get<GLuint>(reader);
+		glLightfv(light, pname, GetFloats(reader, GLCapture::GetParameterCount(pname), state));
+		break;
+	}
+
+	case GC_ROTATEF:
+	{
+		const GLfloat *rotation = GetFloats(reader, 4, state);
+		glRotatef(rotation[0], rotation[1], rotation[2], rotation[3]);
+		break;
+	}
+
+	case GC_TEX_PARAMETERI:
+	{
+		GLenum target	= Get<GLuint>(reader);
+		GLenum pname	= Get<GLuint>(reader);
+		glTexParameteri(target, pname, Get<GLint>(reader));
+		break;
+	}
+
+	case GC_LOAD_IDENTITY:
+		glLoadIdentity();
+		break;
+
+	case GC_LOAD_MATRIXF:
+		glLoadMatrixf(GetFloats(reader, 16, state));
+		break;
+
+	case GC_MATRIX_MODE:
+		glMatrixMode(Get<GLuint>(reader));
+		break;
+
+	case GC_ORTHO:
+	{
+		//gluOrtho2D() is glOrtho() with near -1 & far 1
+		const GLfloat *box = GetFloats(reader, 4, state);
+		glOrtho(box[0], box[1], box[2], box[3], -1.0, 1.0);
+		break;
+	}
+
+	case GC_BLEND_FUNC:
+	{
+		GLenum sfactor = Get<GLuint>(reader);
+		glBlendFunc(sfactor, Get<GLuint>(reader));
+		break;
+	}
+
+	case GC_FINISH:
+		glFinish();
+		break;
+
+	//shaders
+	case GC_CREATE_SHADER:
+	{
+		GLenum type		= Get<GLuint>(reader);
+		GLuint shader	= Get<GLuint>(reader);
+		state.shaders[shader] = glCreateShader(type);
+		break;
+	}
+
+	case GC_SHADER_SOURCE:
+	{
+		GLuint shader	= Get<GLuint>(reader);
+		GLsizei count	= Get<GLint>(reader);
+
+		vector<string> sources;
+		for(GLsizei i=0; i<count && !reader.failed; i++)
+			sources.push_back(GetString(reader));
+
+		vector<const GLchar*> strings;
+		vector<GLint> lengths;
+		for(size_t i=0; i<sources.size(); i++)
+		{
+			strings.push_back(sources[i].c_str());
+			lengths.push_back((GLint)sources[i].size());
+		}
+
+		if(!strings.empty())
+			glShaderSource(Remap(state.shaders, shader), (GLsizei)strings.size(), &strings[0], &lengths[0]);
+		break;
+	}
+
+	case GC_COMPILE_SHADER:
+		glCompileShader(Remap(state.shaders, Get<GLuint>(reader)));
+		break;
+
+	case GC_DELETE_SHADER:
+	{
+		GLuint shader = Get<GLuint>(reader);
+		glDeleteShader(Remap(state.shaders, shader));
+		state.shaders.erase(shader);
+		break;
+	}
+
+	case GC_CREATE_PROGRAM:
+		state.programs[Get<GLuint>(reader)] = glCreateProgram();
+		break;
+
+	case GC_ATTACH_SHADER:
+	{
+		GLuint program = Remap(state.programs, Get<GLuint>(reader));
+		glAttachShader(program, Remap(state.shaders, Get<GLuint>(reader)));
+		break;
+	}
+
+	case GC_DETACH_SHADER:
+	{
+		GLuint program = Remap(state.programs, Get<GLuint>(reader));
+		glDetachShader(program, Remap(state.shaders, Get<GLuint>(reader)));
+		break;
+	}
+
+	case GC_BIND_ATTRIB_LOCATION:
+	{
+		GLuint program	= Remap(state.programs, Get<GLuint>(reader));
+		GLuint index	= Get<GLuint>(reader);
+		glBindAttribLocation(program, index, GetString(reader).c_str());
+		break;
+	}
+
+	case GC_LINK_PROGRAM:
+		glLinkProgram(Remap(state.programs, Get<GLuint>(reader)));
+		break;
+
+	case GC_DELETE_PROGRAM:
+	{
+		GLuint program = Get<GLuint>(reader);
+		glDeleteProgram(Remap(state.programs, program));
+		state.programs.erase(program);
+		break;
+	}
+
+	case GC_USE_PROGRAM:
+		state.program = Get<GLuint>(reader);
+		glUseProgram(Remap(state.programs, state.program));
+		break;
+
+	case GC_GET_UNIFORM_LOCATION:
+	{
+		GLuint program	= Get<GLuint>(reader);
+		GLint location	= Get<GLint>(reader);
+		string name		= GetString(reader);
+
+		state.uniforms[make_pair(program, location)] = glGetUniformLocation(Remap(state.programs, program), name.c_str());
+		break;
+	}
+
+	case GC_UNIFORM1I:
+	{
+		GLint location = RemapLocation(state, Get<GLint>(reader));
+		glUniform1i(location, Get<GLint>(reader));
+		break;
+	}
+
+	case GC_UNIFORM2I:
+	{
+		GLint location	= RemapLocation(state, Get<GLint>(reader));
+		GLint v0		= Get<GLint>(reader);
+		GLint v1		= Get<GLint>(reader);
+		glUniform2i(location, v0, v1);
+		break;
+	}
+
+	case GC_UNIFORM3I:
+	{
+		GLint location	= RemapLocation(state, Get<GLint>(reader));
+		GLint v0		= Get<GLint>(reader);
+		GLint v1		= Get<GLint>(reader);
+		GLint v2		= Get<GLint>(reader);
+		glUniform3i(location, v0, v1, v2);
+		break;
+	}
+
+	case GC_UNIFORM4I:
+	{
+		GLint location	= RemapLocation(state, Get<GLint>(reader));
+		GLint v0		= Get<GLint>(reader);
+		GLint v1		= Get<GLint>(reader);
+		GLint v2		= Get<GLint>(reader);
+		GLint v3		= Get<GLint>(reader);
+		glUniform4i(location, v0, v1, v2, v3);
+		break;
+	}
+
+	case GC_UNIFORM1F:
+	{
+		GLint location = RemapLocation(state, Get<GLint>(reader));
+		glUniform1f(location, Get<GLfloat>(reader));
+		break;
+	}
+
+	case GC_UNIFORM2F:
+	{
+		GLint location	= RemapLocation(state, Get<GLint>(reader));
+		const GLfloat *v = GetFloats(reader, 2, state);
+		glUniform2f(location, v[0], v[1]);
+		break;
+	}
+
+	case GC_UNIFORM3F:
+	{
+		GLint location	= RemapLocation(state, Get<GLint>(reader));
+		const GLfloat *v = GetFloats(reader, 3, state);
+		glUniform3f(location, v[0], v[1], v[2]);
+		break;
+	}
+
+	case GC_UNIFORM4F:
+	{
+		GLint location	= RemapLocation(state, Get<GLint>(reader));
+		const GLfloat *v = GetFloats(reader, 4, state);
+		glUniform4f(location, v[0], v[1], v[2], v[3]);
+		break;
+	}
+
+	case GC_UNIFORM_MATRIX3FV:
+	case GC_UNIFORM_MATRIX4FV:
+	{
+		GLint location		= RemapLocation(state, Get<GLint>(reader));
+		GLsizei count		= Get<GLint>(reader);
+		GLboolean transpose	= Get<GLboolean>(reader);
+		bool matrix3		= (command == GC_UNIFORM_MATRIX3FV);
+		const GLfloat *m	= GetFloats(reader, count * (matrix3 ? 9 : 16), state);
+
+		if(matrix3)
+			glUniformMatrix3fv(location, count, transpose, m);
+		else
+			glUniformMatrix4fv(location, count, transpose, m);
+		break;
+	}
+
+	//buffers & vertex arrays
+	case GC_GEN_BUFFERS:
+		GenNames(reader, state.buffers, glGenBuffers);
+		break;
+
+	case GC_DELETE_BUFFERS:
+		DeleteNames(reader, state.buffers, glDeleteBuffers);
+		break;
+
+	case GC_BIND_BUFFER:
+	{
+		GLenum target = Get<GLuint>(reader);
+		glBindBuffer(target, Remap(state.buffers, Get<GLuint>(reader)));
+		break;
+	}
+
+	case GC_BUFFER_DATA:
+	{
+		GLenum target	= Get<GLuint>(reader);
+		GLenum usage	= Get<GLuint>(reader);
+		data = GetData(reader, size);
+		glBufferData(target, size, data, usage);
+		break;
+	}
+
+	case GC_BUFFER_STORAGE:
+	{
+		if(!glBufferStorage)
+			return Missing("glBufferStorage");
+
+		GLenum target		= Get<GLuint>(reader);
+		GLbitfield flags	= Get<GLuint>(reader);
+		data = GetData(reader, size);
+		glBufferStorage(target, size, data, flags);
+		break;
+	}
+
+	case GC_VERTEX_ATTRIB_POINTER:
+	{
+		GLuint index			= Get<GLuint>(reader);
+		GLint components		= Get<GLint>(reader);
+		GLenum type				= Get<GLuint>(reader);
+		GLboolean normalized	= Get<GLboolean>(reader);
+		GLsizei stride			= Get<GLint>(reader);
+		glVertexAttribPointer(index, components, type, normalized, stride, GetOffset(reader));
+		break;
+	}
+
+	case GC_ENABLE_VERTEX_ATTRIB_ARRAY:
+		glEnableVertexAttribArray(Get<GLuint>(reader));
+		break;
+
+	case GC_DISABLE_VERTEX_ATTRIB_ARRAY:
+		glDisableVertexAttribArray(Get<GLuint>(reader));
+		break;
+
+	case GC_GEN_VERTEX_ARRAYS:
+		GenNames(reader, state.vertexArrays, glGenVertexArrays);
+		break;
+
+	case GC_DELETE_VERTEX_ARRAYS:
+		DeleteNames(reader, state.vertexArrays, glDeleteVertexArrays);
+		break;
+
+	case GC_BIND_VERTEX_ARRAY:
+		glBindVertexArray(Remap(state.vertexArrays, Get<GLuint>(reader)));
+		break;
+
+	case GC_MULTI_DRAW_ELEMENTS_INDIRECT:
+	{
+		if(!glMultiDrawElementsIndirect)
+			return Missing("glMultiDrawElementsIndirect");
+
+		GLenum mode			= Get<GLuint>(reader);
+		GLenum type			= Get<GLuint>(reader);
+		GLsizei drawCount	= Get<GLint>(reader);
+		GLsizei stride		= Get<GLint>(reader);
+		glMultiDrawElementsIndirect(mode, type, GetOffset(reader), drawCount, stride);
+		break;
+	}
+
+	//framebuffer objects, the default framebuffer is replaced by the replay's
+	case GC_GEN_FRAMEBUFFERS:
+		GenNames(reader, state.framebuffers, glGenFramebuffers);
+		break;
+
+	case GC_DELETE_FRAMEBUFFERS:
+		DeleteNames(reader, state.framebuffers, glDeleteFramebuffers);
+		break;
+
+	case GC_BIND_FRAMEBUFFER:
+	{
+		GLenum target		= Get<GLuint>(reader);
+		GLuint framebuffer	= Get<GLuint>(reader);
+		glBindFramebuffer(target, framebuffer ? Remap(state.framebuffers, framebuffer) : state.framebuffer);
+		break;
+	}
+
+	case GC_FRAMEBUFFER_RENDERBUFFER:
+	{
+		GLenum target		= Get<GLuint>(reader);
+		GLenum attachment	= Get<GLuint>(reader);
+		GLenum bufferTarget	= Get<GLuint>(reader);
+		glFramebufferRenderbuffer(target, attachment, bufferTarget, Remap(state.renderbuffers, Get<GLuint>(reader)));
+		break;
+	}
+
+	case GC_GEN_RENDERBUFFERS:
+		GenNames(reader, state.renderbuffers, glGenRenderbuffers);
+		break;
+
+	case GC_DELETE_RENDERBUFFERS:
+		DeleteNames(reader, state.renderbuffers, glDeleteRenderbuffers);
+		break;
+
+	case GC_BIND_RENDERBUFFER:
+	{
+		GLenum target = Get<GLuint>(reader);
+		glBindRenderbuffer(target, Remap(state.renderbuffers, Get<GLuint>(reader)));
+		break;
+	}
+
+	case GC_RENDERBUFFER_STORAGE:
+	{
+		GLenum target	= Get<GLuint>(reader);
+		GLenum format	= Get<GLuint>(reader);
+		GLsizei width	= Get<GLint>(reader);
+		GLsizei height	= Get<GLint>(reader);
+		glRenderbufferStorage(target, format, width, height);
+		break;
+	}
+
+	//direct state access
+	case GC_CREATE_BUFFERS:
+		if(!glCreateBuffers)
+			return Missing("glCreateBuffers");
+
+		GenNames(reader, state.buffers, glCreateBuffers);
+		break;
+
+	case GC_NAMED_BUFFER_DATA:
+	{
+		if(!glNamedBufferData)
+			return Missing("glNamedBufferData");
+
+		GLuint buffer	= Remap(state.buffers, Get<GLuint>(reader));
+		GLenum usage	= Get<GLuint>(reader);
+		data = GetData(reader, size);
+		glNamedBufferData(buffer, size, data, usage);
+		break;
+	}
+
+	case GC_NAMED_BUFFER_STORAGE:
+	{
+		if(!glNamedBufferStorage)
+			return Missing("glNamedBufferStorage");
+
+		GLuint buffer		= Remap(state.buffers, Get<GLuint>(reader));
+		GLbitfield flags	= Get<GLuint>(reader);
+		data = GetData(reader, size);
+		glNamedBufferStorage(buffer, size, data, flags);
+		break;
+	}
+
+	case GC_CREATE_VERTEX_ARRAYS:
+		if(!glCreateVertexArrays)
+			return Missing("glCreateVertexArrays");
+
+		GenNames(reader, state.vertexArrays, glCreateVertexArrays);
+		break;
+
+	case GC_VERTEX_ARRAY_VERTEX_BUFFER:
+	{
+		GLuint array	= Remap(state.vertexArrays, Get<GLuint>(reader));
+		GLuint binding	= Get<GLuint>(reader);
+		GLuint buffer	= Remap(state.buffers, Get<GLuint>(reader));
+		GLsizei stride	= Get<GLint>(reader);
+		glVertexArrayVertexBuffer(array, binding, buffer, (GLintptr)GetOffset(reader), stride);
+		break;
+	}
+
+	case GC_VERTEX_ARRAY_ELEMENT_BUFFER:
+	{
+		GLuint array = Remap(state.vertexArrays, Get<GLuint>(reader));
+		glVertexArrayElementBuffer(array, Remap(state.buffers, Get<GLuint>(reader)));
+		break;
+	}
+
+	case GC_VERTEX_ARRAY_ATTRIB_FORMAT:
+	{
+		GLuint array			= Remap(state.vertexArrays, Get<GLuint>(reader));
+		GLuint index			= Get<GLuint>(reader);
+		GLint components		= Get<GLint>(reader);
+		GLenum type				= Get<GLuint>(reader);
+		GLboolean normalized	= Get<GLboolean>(reader);
+		GLuint offset			= Get<GLuint>(reader);
+		glVertexArrayAttribFormat(array, index, components, type, normalized, offset);
+		break;
+	}
+
+	case GC_VERTEX_ARRAY_ATTRIB_BINDING:
+	{
+		GLuint array	= Remap(state.vertexArrays, Get<GLuint>(reader));
+		GLuint index	= Get<GLuint>(reader);
+		glVertexArrayAttribBinding(array, index, Get<GLuint>(reader));
+		break;
+	}
+
+	case GC_ENABLE_VERTEX_ARRAY_ATTRIB:
+	{
+		GLuint array = Remap(state.vertexArrays, Get<GLuint>(reader));
+		glEnableVertexArrayAttrib(array, Get<GLuint>(reader));
+		break;
+	}
+
+	case GC_BIND_TEXTURE_UNIT:
+	{
+		if(!glBindTextureUnit)
+			return Missing("glBindTextureUnit");
+
+		GLuint unit = Get<GLuint>(reader);
+		glBindTextureUnit(unit, Remap(state.textures, Get<GLuint>(reader)));
+		break;
+	}
+
+	//queries, reading a result waits for the GPU like it did when captured
+	case GC_GEN_QUERIES:
+		GenNames(reader, state.queries, glGenQueries);
+		break;
+
+	case GC_DELETE_QUERIES:
+		DeleteNames(reader, state.queries, glDeleteQueries);
+		break;
+
+	case GC_BEGIN_QUERY:
+	{
+		GLenum target = Get<GLuint>(reader);
+		glBeginQuery(target, Remap(state.queries, Get<GLuint>(reader)));
+		break;
+	}
+
+	case GC_END_QUERY:
+		glEndQuery(Get<GLuint>(reader));
+		break;
+
+	case GC_QUERY_COUNTER:
+	{
+		if(!glQueryCounter)
+			return Missing("glQueryCounter");
+
+		GLuint query = Remap(state.queries, Get<GLuint>(reader));
+		glQueryCounter(query, Get<GLuint>(reader));
+		break;
+	}
+
+	case GC_GET_QUERY_OBJECTIV:
+	{
+		GLuint query = Remap(state.queries, Get<GLuint>(reader));
+		GLint result;
+		glGetQueryObjectiv(query, Get<GLuint>(reader), &result);
+		break;
+	}
+
+	case GC_GET_QUERY_OBJECTUI64V:
+	{
+		if(!glGetQueryObjectui64v)
+			return Missing("glGetQueryObjectui64v");
+
+		GLuint query = Remap(state.queries, Get<GLuint>(reader));
+		GLuint64 result;
+		glGetQueryObjectui64v(query, Get<GLuint>(reader), &result);
+		break;
+	}
+
+	default:
+		fprintf(stderr, "Unknown call %d in the trace.\n", (int)command);
+		return false;
+	}
+
+	state.calls++;
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Replays the calls of a range of the trace.
+///@param	trace - the trace
+///@param	start - offset of the first call
+///@param	end - offset past the last one
+///@param	state - the names & locations mapped so far
+///@return	false if a call couldn't be replayed
+///----------------------------------------------------------------------------
+static bool Run(const Trace &trace, size_t start, size_t end, ReplayState &state)
+{
+	Reader reader;
+	reader.data		= &trace.data[0];
+	reader.pos		= start;
+	reader.end		= end;
+	reader.failed	= false;
+
+	while(reader.pos < reader.end)
+	{
+		GLCommand command = (GLCommand)reader.data[reader.pos++];
+
+		if(!Execute(command, reader, state))
+			return false;
+
+		if(reader.failed)
+		{
+			fprintf(stderr, "The trace is cut in the middle of call %d.\n", (int)command);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Reads a trace & its index of frames.
+///@param	fileName - the trace
+///@param	trace - receives it
+///@return	false if it can't be read or isn't complete
+///----------------------------------------------------------------------------
+static bool LoadTrace(const char *fileName, Trace &trace)
+{
+	FILE *file = fopen(fileName, "rb");
+	if(!file)
+	{
+		fprintf(stderr, "Could not open %s\n", fileName);
+		return false;
+	}
+
+	fseek(file, 0, SEEK_END);
+	long length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	if(length > 0)
+	{
+		trace.data.resize(length);
+		length = (long)fread(&trace.data[0], 1, length, file);
+	}
+
+	fclose(file);
+
+	size_t size = length > 0 ? (size_t)length : 0;
+	const size_t minimum = sizeof(CaptureHeader) + sizeof(GLuint) + sizeof(unsigned long long);
+
+	if(size < minimum)
+	{
+		fprintf(stderr, "%s is not a GL capture.\n", fileName);
+		return false;
+	}
+
+	memcpy(&trace.header, &trace.data[0], sizeof(CaptureHeader));
+
+	if(trace.header.magic != CAPTURE_MAGIC || trace.header.version != CAPTURE_VERSION)
+	{
+		fprintf(stderr, "%s is not a GL capture of version %u.\n", fileName, CAPTURE_VERSION);
+		return false;
+	}
+
+	//the index was written when the capture stopped
+	unsigned long long indexOffset;
+	memcpy(&indexOffset, &trace.data[size - sizeof(indexOffset)], sizeof(indexOffset));
+
+	if(indexOffset < sizeof(CaptureHeader) || indexOffset + sizeof(GLuint) + sizeof(indexOffset) > size)
+	{
+		fprintf(stderr, "%s has no index, the capture didn't stop.\n", fileName);
+		return false;
+	}
+
+	GLuint frames;
+	memcpy(&frames, &trace.data[(size_t)indexOffset], sizeof(frames));
+
+	size_t indexSize = (size_t)frames * 2 * sizeof(unsigned long long);
+	if(indexOffset + sizeof(frames) + indexSize + sizeof(indexOffset) != size)
+	{
+		fprintf(stderr, "The index of %s is damaged.\n", fileName);
+		return false;
+	}
+
+	trace.end = (size_t)indexOffset;
+	trace.frames.resize(frames * 2);
+
+	if(frames)
+		memcpy(&trace.frames[0], &trace.data[(size_t)indexOffset + sizeof(frames)], indexSize);
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Writes the report of the replay.
+///@param	fileName - the JSON file
+///@param	traceName - the trace replayed
+///@param	trace - the trace
+///@param	times - the frame times
+///@param	loops - timed loops
+///@param	callsPerFrame - calls of a frame
+///@param	elapsed - time of the timed frames
+///@return	true if the file was written
+///----------------------------------------------------------------------------
+static bool WriteJSON(const char *fileName, const char *traceName, const Trace &trace, const FrameHistogram &times,
+					  int loops, double callsPerFrame, double elapsed)
+{
+	FILE *file = fopen(fileName, "w");
+	if(!file)
+		return false;
+
+	fprintf(file, "{\n\"trace\": ");
+	Benchmark::WriteString(file, traceName);
+	fprintf(file, ",\n\"capture\": {\"profile\": \"%s\", \"width\": %u, \"height\": %u, \"frames\": %u},\n",
+			trace.header.coreProfile ? "core" : "compatibility", trace.header.width, trace.header.height,
+			(unsigned int)(trace.frames.size() / 2));
+
+	fprintf(file, "\"build\": ");
+	Benchmark::WriteBuildInfo(file);
+	fprintf(file, ",\n\"host\": ");
+	Benchmark::WriteHostInfo(file);
+
+	fprintf(file, ",\n\"driver\": {\"vendor\": ");
+	Benchmark::WriteString(file, (const char *)glGetString(GL_VENDOR));
+	fprintf(file, ", \"renderer\": ");
+	Benchmark::WriteString(file, (const char *)glGetString(GL_RENDERER));
+	fprintf(file, ", \"version\": ");
+	Benchmark::WriteString(file, (const char *)glGetString(GL_VERSION));
+	fprintf(file, "},\n");
+
+	fprintf(file, "\"loops\": %d,\n\"calls_per_frame\": %.1f,\n\"calls_per_second\": %.0f,\n\"frame_times_ms\": ",
+			loops, callsPerFrame, elapsed > 0.0 ? callsPerFrame * times.GetCount() / elapsed : 0.0);
+	times.WriteJSON(file);
+	fprintf(file, "\n}\n");
+
+	return fclose(file) == 0;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *traceName	= NULL;
+	const char *json		= NULL;
+	int loops				= 10;
+	int warmup				= 1;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-loops") && i+1 < argc)
+			loops = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-warmup") && i+1 < argc)
+			warmup = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-json") && i+1 < argc)
+			json = argv[++i];
+		else if(argv[i][0] != '-' && !traceName)
+			traceName = argv[i];
+		else
+		{
+			traceName = NULL;
+			break;
+		}
+	}
+
+	if(!traceName)
+	{
+		fprintf(stderr, "usage: %s trace.gltrace [-loops N] [-warmup N] [-json report.json]\n", argv[0]);
+		return 1;
+	}
+
+	if(loops < 1)
+		loops = 1;
+
+	Trace trace;
+	if(!LoadTrace(traceName, trace))
+		return 1;
+
+	size_t frames = trace.frames.size() / 2;
+	if(frames == 0)
+	{
+		fprintf(stderr, "%s has no frames.\n", traceName);
+		return 1;
+	}
+
+	HeadlessContext context;
+	FrameBuffer frameBuffer;
+	bool coreProfile = (trace.header.coreProfile != 0);
+
+	if(!context.Create(coreProfile) || !InitExtensions() ||
+	   !frameBuffer.Create(trace.header.width, trace.header.height))
+	{
+		fprintf(stderr, "Could not create a headless OpenGL %s context of %ux%u.\n",
+				coreProfile ? "core" : "compatibility", trace.header.width, trace.header.height);
+		return 1;
+	}
+
+	ReplayState state;
+	state.program	= 0;
+	state.calls		= 0;
+	state.floats.resize(16);
+
+	//the frames drawn to the default framebuffer go to this one
+	GLint framebuffer;
+	frameBuffer.Bind();
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebuffer);
+	state.framebuffer = (GLuint)framebuffer;
+
+	//loading
+	if(!Run(trace, sizeof(CaptureHeader), (size_t)trace.frames[0], state))
+		return 1;
+
+	GLenum error = glGetError();
+	if(error != GL_NO_ERROR)
+		fprintf(stderr, "GL error 0x%04x replaying the loading, the frames may not be the same.\n", error);
+
+	FrameHistogram times;
+	unsigned long frameCalls = 0;
+	double elapsed = 0.0;
+
+	for(int loop=0; loop<warmup + loops; loop++)
+	{
+		bool timed = (loop >= warmup);
+
+		for(size_t frame=0; frame<frames; frame++)
+		{
+			size_t start	= (size_t)trace.frames[frame * 2];
+			size_t end		= (size_t)trace.frames[frame * 2 + 1];
+			unsigned long calls = state.calls;
+
+			double frameStart = FramePacer::GetTime();
+
+			if(!Run(trace, start, end, state))
+				return 1;
+
+			glFinish();
+
+			double frameTime = FramePacer::GetTime() - frameStart;
+
+			if(timed)
+			{
+				times.Record(frameTime);
+				frameCalls += state.calls - calls;
+				elapsed += frameTime;
+			}
+
+			//between this frame & the next, the calls after the last are replayed once
+			size_t next = (frame + 1 < frames) ? (size_t)trace.frames[frame * 2 + 2] : end;
+
+			if(!Run(trace, end, next, state))
+				return 1;
+		}
+	}
+
+	double callsPerFrame = (double)frameCalls / times.GetCount();
+
+	printf("%s: %u frames of %ux%u (%s) replayed %d times in %.3f s (%.1f FPS)\n",
+		   traceName, (unsigned int)frames, trace.header.width, trace.header.height,
+		   coreProfile ? "core" : "compatibility", loops, elapsed, elapsed > 0.0 ? times.GetCount() / elapsed : 0.0);
+	printf("frame time: mean %.3f ms, p50 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+		   times.GetMean() * 1000.0, times.GetPercentile(50.0) * 1000.0,
+		   times.GetPercentile(99.0) * 1000.0, times.GetMax() * 1000.0);
+	printf("%.1f GL calls per frame, %.0f calls/s\n", callsPerFrame, elapsed > 0.0 ? frameCalls / elapsed : 0.0);
+
+	//what the capture did after its last frame, i.e. shutting down
+	if(!Run(trace, (size_t)trace.frames[frames * 2 - 1], trace.end, state))
+		return 1;
+
+	if(json && !WriteJSON(json, traceName, trace, times, loops, callsPerFrame, elapsed))
+	{
+		fprintf(stderr, "Could not write %s\n", json);
+		return 1;
+	}
+
+	frameBuffer.Release();
+	context.Destroy();
+
+	return 0;
+}
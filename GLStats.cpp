@@ -0,0 +1,1427 @@
+///============================================================================
+///@file	GLStats.cpp
+///@brief	GL Call Statistics Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+//the wrappers below call the real GL functions
+#define GLSTATS_NO_MACROS
+
+#include "GLStats.h"
+#include "GLExtensions.h"
+#include "GLCapture.h"
+#include "Thread.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+using namespace std;
+
+const unsigned long GLSTATS_NO_BUDGET	= (unsigned long)-1;	// Category without a budget
+const long GLSTATS_LOGGED				= 16;					// Performance messages printed at most
+
+static const char *s_CategoryNames[GS_COUNT] = {"calls", "draws", "binds", "uniforms", "materials",
+												"vertices", "uploads", "perf_warnings"};
+
+GLCallCounts	GLStats::s_Frame;
+GLCallCounts	GLStats::s_Last;
+GLCallCounts	GLStats::s_Total;
+GLCallCounts	GLStats::s_Max;
+GLCallCounts	GLStats::s_Over;
+GLCallCounts	GLStats::s_Budget	= {{GLSTATS_NO_BUDGET, GLSTATS_NO_BUDGET, GLSTATS_NO_BUDGET, GLSTATS_NO_BUDGET,
+										GLSTATS_NO_BUDGET, GLSTATS_NO_BUDGET, GLSTATS_NO_BUDGET, GLSTATS_NO_BUDGET}};
+unsigned long	GLStats::s_Frames	= 0;
+volatile long	GLStats::s_Warnings	= 0;
+long			GLStats::s_FrameWarnings = 0;
+
+#ifdef CHARCOAL_GLSTATS
+static volatile long	s_Logged = 0;	// Performance messages printed so far
+
+//the entry points the wrappers call
+static PFNGLUSEPROGRAMPROC					s_UseProgram;
+static PFNGLUNIFORM1IPROC					s_Uniform1i;
+static PFNGLUNIFORM2IPROC					s_Uniform2i;
+static PFNGLUNIFORM3IPROC					s_Uniform3i;
+static PFNGLUNIFORM4IPROC					s_Uniform4i;
+static PFNGLUNIFORM1FPROC					s_Uniform1f;
+static PFNGLUNIFORM2FPROC					s_Uniform2f;
+static PFNGLUNIFORM3FPROC					s_Uniform3f;
+static PFNGLUNIFORM4FPROC					s_Uniform4f;
+static PFNGLUNIFORMMATRIX3FVPROC			s_UniformMatrix3fv;
+static PFNGLUNIFORMMATRIX4FVPROC			s_UniformMatrix4fv;
+#ifdef _WIN32
+static PFNGLACTIVETEXTUREPROC				s_ActiveTexture;
+#endif
+static PFNGLBINDBUFFERPROC					s_BindBuffer;
+static PFNGLBUFFERDATAPROC					s_BufferData;
+static PFNGLBINDVERTEXARRAYPROC				s_BindVertexArray;
+static PFNGLBINDFRAMEBUFFERPROC				s_BindFramebuffer;
+static PFNGLBINDRENDERBUFFERPROC			s_BindRenderbuffer;
+static PFNGLNAMEDBUFFERDATAPROC				s_NamedBufferData;
+static PFNGLNAMEDBUFFERSTORAGEPROC			s_NamedBufferStorage;
+static PFNGLBINDTEXTUREUNITPROC				s_BindTextureUnit;
+static PFNGLBUFFERSTORAGEPROC				s_BufferStorage;
+static PFNGLMULTIDRAWELEMENTSINDIRECTPROC	s_MultiDrawElementsIndirect;
+
+//the ones only wrapped to be captured
+static PFNGLCREATESHADERPROC				s_CreateShader;
+static PFNGLSHADERSOURCEPROC				s_ShaderSource;
+static PFNGLCOMPILESHADERPROC				s_CompileShader;
+static PFNGLDELETESHADERPROC				s_DeleteShader;
+static PFNGLCREATEPROGRAMPROC				s_CreateProgram;
+static PFNGLATTACHSHADERPROC				s_AttachShader;
+static PFNGLDETACHSHADERPROC				s_DetachShader;
+static PFNGLBINDATTRIBLOCATIONPROC			s_BindAttribLocation;
+static PFNGLLINKPROGRAMPROC					s_LinkProgram;
+static PFNGLDELETEPROGRAMPROC				s_DeleteProgram;
+static PFNGLGETUNIFORMLOCATIONPROC			s_GetUniformLocation;
+static PFNGLGENBUFFERSPROC					s_GenBuffers;
+static PFNGLDELETEBUFFERSPROC				s_DeleteBuffers;
+static PFNGLVERTEXATTRIBPOINTERPROC			s_VertexAttribPointer;
+static PFNGLENABLEVERTEXATTRIBARRAYPROC		s_EnableVertexAttribArray;
+static PFNGLDISABLEVERTEXATTRIBARRAYPROC	s_DisableVertexAttribArray;
+static PFNGLGENVERTEXARRAYSPROC				s_GenVertexArrays;
+static PFNGLDELETEVERTEXARRAYSPROC			s_DeleteVertexArrays;
+static PFNGLGENFRAMEBUFFERSPROC				s_GenFramebuffers;
+static PFNGLDELETEFRAMEBUFFERSPROC			s_DeleteFramebuffers;
+static PFNGLFRAMEBUFFERRENDERBUFFERPROC		s_FramebufferRenderbuffer;
+static PFNGLGENRENDERBUFFERSPROC			s_GenRenderbuffers;
+static PFNGLDELETERENDERBUFFERSPROC			s_DeleteRenderbuffers;
+static PFNGLRENDERBUFFERSTORAGEPROC			s_RenderbufferStorage;
+static PFNGLCREATEBUFFERSPROC				s_CreateBuffers;
+static PFNGLCREATEVERTEXARRAYSPROC			s_CreateVertexArrays;
+static PFNGLVERTEXARRAYVERTEXBUFFERPROC		s_VertexArrayVertexBuffer;
+static PFNGLVERTEXARRAYELEMENTBUFFERPROC	s_VertexArrayElementBuffer;
+static PFNGLVERTEXARRAYATTRIBFORMATPROC		s_VertexArrayAttribFormat;
+static PFNGLVERTEXARRAYATTRIBBINDINGPROC	s_VertexArrayAttribBinding;
+static PFNGLENABLEVERTEXARRAYATTRIBPROC		s_EnableVertexArrayAttrib;
+static PFNGLGENQUERIESPROC					s_GenQueries;
+static PFNGLDELETEQUERIESPROC				s_DeleteQueries;
+static PFNGLBEGINQUERYPROC					s_BeginQuery;
+static PFNGLENDQUERYPROC					s_EndQuery;
+static PFNGLQUERYCOUNTERPROC				s_QueryCounter;
+static PFNGLGETQUERYOBJECTIVPROC			s_GetQueryObjectiv;
+static PFNGLGETQUERYOBJECTUI64VPROC			s_GetQueryObjectui64v;
+
+static void APIENTRY UseProgram(GLuint program)
+{
+	GLStats::Count(GS_BINDS);
+	s_UseProgram(program);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_USE_PROGRAM, program);
+}
+
+static void APIENTRY Uniform1i(GLint location, GLint v0)
+{
+	GLStats::Count(GS_UNIFORMS);
+	s_Uniform1i(location, v0);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_UNIFORM1I, location, v0);
+}
+
+static void APIENTRY Uniform2i(GLint location, GLint v0, GLint v1)
+{
+	GLStats::Count(GS_UNIFORMS);
+	s_Uniform2i(location, v0, v1);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_UNIFORM2I, location, v0, v1);
+}
+
+static void APIENTRY Uniform3i(GLint location, GLint v0, GLint v1, GLint v2)
+{
+	GLStats::Count(GS_UNIFORMS);
+	s_Uniform3i(location, v0, v1, v2);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_UNIFORM3I, location, v0, v1, v2);
+}
+
+static void APIENTRY Uniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3)
+{
+	GLStats::Count(GS_UNIFORMS);
+	s_Uniform4i(location, v0, v1, v2, v3);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_UNIFORM4I, location, v0, v1, v2, v3);
+}
+
+static void APIENTRY Uniform1f(GLint location, GLfloat v0)
+{
+	GLStats::Count(GS_UNIFORMS);
+	s_Uniform1f(location, v0);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_UNIFORM1F, location, v0);
+}
+
+static void APIENTRY Uniform2f(GLint location, GLfloat v0, GLfloat v1)
+{
+	GLStats::Count(GS_UNIFORMS);
+	s_Uniform2f(location, v0, v1);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_UNIFORM2F, location, v0, v1);
+}
+
+static void APIENTRY Uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+{
+	GLStats::Count(GS_UNIFORMS);
+	s_Uniform3f(location, v0, v1, v2);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_UNIFORM3F, location, v0, v1, v2);
+}
+
+static void APIENTRY Uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{
+	GLStats::Count(GS_UNIFORMS);
+	s_Uniform4f(location, v0, v1, v2, v3);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_UNIFORM4F, location, v0, v1, v2, v3);
+}
+
+static void APIENTRY UniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	GLStats::Count(GS_UNIFORMS);
+	s_UniformMatrix3fv(location, count, transpose, value);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_UNIFORM_MATRIX3FV, location, count, transpose);
+		GLCapture::PutFloats(value, count * 9);
+	}
+}
+
+static void APIENTRY UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	GLStats::Count(GS_UNIFORMS);
+	s_UniformMatrix4fv(location, count, transpose, value);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_UNIFORM_MATRIX4FV, location, count, transpose);
+		GLCapture::PutFloats(value, count * 16);
+	}
+}
+
+#ifdef _WIN32
+static void APIENTRY ActiveTexture(GLenum texture)
+{
+	GLStats::Count(GS_BINDS);
+	s_ActiveTexture(texture);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_ACTIVE_TEXTURE, texture);
+}
+#endif
+
+static void APIENTRY BindBuffer(GLenum target, GLuint buffer)
+{
+	GLStats::Count(GS_BINDS);
+	s_BindBuffer(target, buffer);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_BIND_BUFFER, target, buffer);
+}
+
+static void APIENTRY BufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+	GLStats::Count(GS_UPLOADS);
+	s_BufferData(target, size, data, usage);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_BUFFER_DATA, target, usage);
+		GLCapture::PutData(data, size);
+	}
+}
+
+static void APIENTRY BindVertexArray(GLuint array)
+{
+	GLStats::Count(GS_BINDS);
+	s_BindVertexArray(array);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_BIND_VERTEX_ARRAY, array);
+}
+
+static void APIENTRY BindFramebuffer(GLenum target, GLuint framebuffer)
+{
+	GLStats::Count(GS_BINDS);
+	s_BindFramebuffer(target, framebuffer);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_BIND_FRAMEBUFFER, target, framebuffer);
+}
+
+static void APIENTRY BindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+	GLStats::Count(GS_BINDS);
+	s_BindRenderbuffer(target, renderbuffer);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_BIND_RENDERBUFFER, target, renderbuffer);
+}
+
+static void APIENTRY NamedBufferData(GLuint buffer, GLsizeiptr size, const void *data, GLenum usage)
+{
+	GLStats::Count(GS_UPLOADS);
+	s_NamedBufferData(buffer, size, data, usage);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_NAMED_BUFFER_DATA, buffer, usage);
+		GLCapture::PutData(data, size);
+	}
+}
+
+static void APIENTRY NamedBufferStorage(GLuint buffer, GLsizeiptr size, const void *data, GLbitfield flags)
+{
+	GLStats::Count(GS_UPLOADS);
+	s_NamedBufferStorage(buffer, size, data, flags);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_NAMED_BUFFER_STORAGE, buffer, flags);
+		GLCapture::PutData(data, size);
+	}
+}
+
+static void APIENTRY BindTextureUnit(GLuint unit, GLuint texture)
+{
+	GLStats::Count(GS_BINDS);
+	s_BindTextureUnit(unit, texture);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_BIND_TEXTURE_UNIT, unit, texture);
+}
+
+static void APIENTRY BufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags)
+{
+	GLStats::Count(GS_UPLOADS);
+	s_BufferStorage(target, size, data, flags);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_BUFFER_STORAGE, target, flags);
+		GLCapture::PutData(data, size);
+	}
+}
+
+static void APIENTRY MultiDrawElementsIndirect(GLenum mode, GLenum type, const void *indirect, GLsizei drawcount, GLsizei stride)
+{
+	GLStats::Count(GS_DRAWS);
+	s_MultiDrawElementsIndirect(mode, type, indirect, drawcount, stride);
+
+	//the commands are in the GL_DRAW_INDIRECT_BUFFER
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_MULTI_DRAW_ELEMENTS_INDIRECT, mode, type, drawcount, stride);
+		GLCapture::PutOffset(indirect);
+	}
+}
+
+static GLuint APIENTRY CreateShader(GLenum type)
+{
+	GLStats::Count(GS_CALLS);
+	GLuint shader = s_CreateShader(type);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_CREATE_SHADER, type, shader);
+
+	return shader;
+}
+
+static void APIENTRY ShaderSource(GLuint shader, GLsizei count, const GLchar *const *strings, const GLint *lengths)
+{
+	GLStats::Count(GS_UPLOADS);
+	s_ShaderSource(shader, count, strings, lengths);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_SHADER_SOURCE, shader, count);
+
+		for(GLsizei i=0; i<count; i++)
+			GLCapture::PutString(strings[i], lengths ? lengths[i] : -1);
+	}
+}
+
+static void APIENTRY CompileShader(GLuint shader)
+{
+	GLStats::Count(GS_CALLS);
+	s_CompileShader(shader);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_COMPILE_SHADER, shader);
+}
+
+static void APIENTRY DeleteShader(GLuint shader)
+{
+	GLStats::Count(GS_CALLS);
+	s_DeleteShader(shader);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_DELETE_SHADER, shader);
+}
+
+static GLuint APIENTRY CreateProgram()
+{
+	GLStats::Count(GS_CALLS);
+	GLuint program = s_CreateProgram();
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_CREATE_PROGRAM, program);
+
+	return program;
+}
+
+static void APIENTRY AttachShader(GLuint program, GLuint shader)
+{
+	GLStats::Count(GS_CALLS);
+	s_AttachShader(program, shader);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_ATTACH_SHADER, program, shader);
+}
+
+static void APIENTRY DetachShader(GLuint program, GLuint shader)
+{
+	GLStats::Count(GS_CALLS);
+	s_DetachShader(program, shader);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_DETACH_SHADER, program, shader);
+}
+
+static void APIENTRY BindAttribLocation(GLuint program, GLuint index, const GLchar *name)
+{
+	GLStats::Count(GS_CALLS);
+	s_BindAttribLocation(program, index, name);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_BIND_ATTRIB_LOCATION, program, index);
+		GLCapture::PutString(name);
+	}
+}
+
+static void APIENTRY LinkProgram(GLuint program)
+{
+	GLStats::Count(GS_CALLS);
+	s_LinkProgram(program);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_LINK_PROGRAM, program);
+}
+
+static void APIENTRY DeleteProgram(GLuint program)
+{
+	GLStats::Count(GS_CALLS);
+	s_DeleteProgram(program);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_DELETE_PROGRAM, program);
+}
+
+static GLint APIENTRY GetUniformLocation(GLuint program, const GLchar *name)
+{
+	GLStats::Count(GS_CALLS);
+	GLint location = s_GetUniformLocation(program, name);
+
+	//the replay maps the location it gets to this one
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_GET_UNIFORM_LOCATION, program, location);
+		GLCapture::PutString(name);
+	}
+
+	return location;
+}
+
+static void APIENTRY GenBuffers(GLsizei n, GLuint *buffers)
+{
+	GLStats::Count(GS_CALLS);
+	s_GenBuffers(n, buffers);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_GEN_BUFFERS);
+		GLCapture::PutNames(n, buffers);
+	}
+}
+
+static void APIENTRY DeleteBuffers(GLsizei n, const GLuint *buffers)
+{
+	GLStats::Count(GS_CALLS);
+	s_DeleteBuffers(n, buffers);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_DELETE_BUFFERS);
+		GLCapture::PutNames(n, buffers);
+	}
+}
+
+static void APIENTRY VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride,
+										 const void *pointer)
+{
+	GLStats::Count(GS_CALLS);
+	s_VertexAttribPointer(index, size, type, normalized, stride, pointer);
+
+	//the vertices are always in a GL_ARRAY_BUFFER
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_VERTEX_ATTRIB_POINTER, index, size, type, normalized, stride);
+		GLCapture::PutOffset(pointer);
+	}
+}
+
+static void APIENTRY EnableVertexAttribArray(GLuint index)
+{
+	GLStats::Count(GS_CALLS);
+	s_EnableVertexAttribArray(index);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_ENABLE_VERTEX_ATTRIB_ARRAY, index);
+}
+
+static void APIENTRY DisableVertexAttribArray(GLuint index)
+{
+	GLStats::Count(GS_CALLS);
+	s_DisableVertexAttribArray(index);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_DISABLE_VERTEX_ATTRIB_ARRAY, index);
+}
+
+static void APIENTRY GenVertexArrays(GLsizei n, GLuint *arrays)
+{
+	GLStats::Count(GS_CALLS);
+	s_GenVertexArrays(n, arrays);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_GEN_VERTEX_ARRAYS);
+		GLCapture::PutNames(n, arrays);
+	}
+}
+
+static void APIENTRY DeleteVertexArrays(GLsizei n, const GLuint *arrays)
+{
+	GLStats::Count(GS_CALLS);
+	s_DeleteVertexArrays(n, arrays);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_DELETE_VERTEX_ARRAYS);
+		GLCapture::PutNames(n, arrays);
+	}
+}
+
+static void APIENTRY GenFramebuffers(GLsizei n, GLuint *framebuffers)
+{
+	GLStats::Count(GS_CALLS);
+	s_GenFramebuffers(n, framebuffers);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_GEN_FRAMEBUFFERS);
+		GLCapture::PutNames(n, framebuffers);
+	}
+}
+
+static void APIENTRY DeleteFramebuffers(GLsizei n, const GLuint *framebuffers)
+{
+	GLStats::Count(GS_CALLS);
+	s_DeleteFramebuffers(n, framebuffers);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_DELETE_FRAMEBUFFERS);
+		GLCapture::PutNames(n, framebuffers);
+	}
+}
+
+static void APIENTRY FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+	GLStats::Count(GS_CALLS);
+	s_FramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_FRAMEBUFFER_RENDERBUFFER, target, attachment, renderbuffertarget, renderbuffer);
+}
+
+static void APIENTRY GenRenderbuffers(GLsizei n, GLuint *renderbuffers)
+{
+	GLStats::Count(GS_CALLS);
+	s_GenRenderbuffers(n, renderbuffers);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_GEN_RENDERBUFFERS);
+		GLCapture::PutNames(n, renderbuffers);
+	}
+}
+
+static void APIENTRY DeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers)
+{
+	GLStats::Count(GS_CALLS);
+	s_DeleteRenderbuffers(n, renderbuffers);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_DELETE_RENDERBUFFERS);
+		GLCapture::PutNames(n, renderbuffers);
+	}
+}
+
+static void APIENTRY RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+	GLStats::Count(GS_CALLS);
+	s_RenderbufferStorage(target, internalformat, width, height);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_RENDERBUFFER_STORAGE, target, internalformat, width, height);
+}
+
+static void APIENTRY CreateBuffers(GLsizei n, GLuint *buffers)
+{
+	GLStats::Count(GS_CALLS);
+	s_CreateBuffers(n, buffers);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_CREATE_BUFFERS);
+		GLCapture::PutNames(n, buffers);
+	}
+}
+
+static void APIENTRY CreateVertexArrays(GLsizei n, GLuint *arrays)
+{
+	GLStats::Count(GS_CALLS);
+	s_CreateVertexArrays(n, arrays);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_CREATE_VERTEX_ARRAYS);
+		GLCapture::PutNames(n, arrays);
+	}
+}
+
+static void APIENTRY VertexArrayVertexBuffer(GLuint vaobj, GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride)
+{
+	GLStats::Count(GS_CALLS);
+	s_VertexArrayVertexBuffer(vaobj, bindingindex, buffer, offset, stride);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_VERTEX_ARRAY_VERTEX_BUFFER, vaobj, bindingindex, buffer, stride);
+		GLCapture::PutOffset((const void*)offset);
+	}
+}
+
+static void APIENTRY VertexArrayElementBuffer(GLuint vaobj, GLuint buffer)
+{
+	GLStats::Count(GS_CALLS);
+	s_VertexArrayElementBuffer(vaobj, buffer);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_VERTEX_ARRAY_ELEMENT_BUFFER, vaobj, buffer);
+}
+
+static void APIENTRY VertexArrayAttribFormat(GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLboolean normalized,
+											 GLuint relativeoffset)
+{
+	GLStats::Count(GS_CALLS);
+	s_VertexArrayAttribFormat(vaobj, attribindex, size, type, normalized, relativeoffset);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_VERTEX_ARRAY_ATTRIB_FORMAT, vaobj, attribindex, size, type, normalized);
+		GLCapture::Put(relativeoffset);
+	}
+}
+
+static void APIENTRY VertexArrayAttribBinding(GLuint vaobj, GLuint attribindex, GLuint bindingindex)
+{
+	GLStats::Count(GS_CALLS);
+	s_VertexArrayAttribBinding(vaobj, attribindex, bindingindex);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_VERTEX_ARRAY_ATTRIB_BINDING, vaobj, attribindex, bindingindex);
+}
+
+static void APIENTRY EnableVertexArrayAttrib(GLuint vaobj, GLuint index)
+{
+	GLStats::Count(GS_CALLS);
+	s_EnableVertexArrayAttrib(vaobj, index);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_ENABLE_VERTEX_ARRAY_ATTRIB, vaobj, index);
+}
+
+static void APIENTRY GenQueries(GLsizei n, GLuint *ids)
+{
+	GLStats::Count(GS_CALLS);
+	s_GenQueries(n, ids);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_GEN_QUERIES);
+		GLCapture::PutNames(n, ids);
+	}
+}
+
+static void APIENTRY DeleteQueries(GLsizei n, const GLuint *ids)
+{
+	GLStats::Count(GS_CALLS);
+	s_DeleteQueries(n, ids);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_DELETE_QUERIES);
+		GLCapture::PutNames(n, ids);
+	}
+}
+
+static void APIENTRY BeginQuery(GLenum target, GLuint id)
+{
+	GLStats::Count(GS_CALLS);
+	s_BeginQuery(target, id);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_BEGIN_QUERY, target, id);
+}
+
+static void APIENTRY EndQuery(GLenum target)
+{
+	GLStats::Count(GS_CALLS);
+	s_EndQuery(target);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_END_QUERY, target);
+}
+
+static void APIENTRY QueryCounter(GLuint id, GLenum target)
+{
+	GLStats::Count(GS_CALLS);
+	s_QueryCounter(id, target);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_QUERY_COUNTER, id, target);
+}
+
+//reading a query result may wait for the GPU, the replay waits there too
+static void APIENTRY GetQueryObjectiv(GLuint id, GLenum pname, GLint *params)
+{
+	GLStats::Count(GS_CALLS);
+	s_GetQueryObjectiv(id, pname, params);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_GET_QUERY_OBJECTIV, id, pname);
+}
+
+static void APIENTRY GetQueryObjectui64v(GLuint id, GLenum pname, GLuint64 *params)
+{
+	GLStats::Count(GS_CALLS);
+	s_GetQueryObjectui64v(id, pname, params);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_GET_QUERY_OBJECTUI64V, id, pname);
+}
+
+///----------------------------------------------------------------------------
+///Replaces an entry point by its wrapper, keeping the real one for it.
+///@param	entryPoint - the global entry point, left NULL if it is
+///@param	real - receives the real entry point
+///@param	wrapper - the counting wrapper
+///----------------------------------------------------------------------------
+template<class Proc> static void Wrap(Proc &entryPoint, Proc &real, Proc wrapper)
+{
+	//already wrapped, the real one is kept
+	if(entryPoint == wrapper)
+		return;
+
+	real = entryPoint;
+
+	if(entryPoint)
+		entryPoint = wrapper;
+}
+
+///----------------------------------------------------------------------------
+///KHR_debug callback, may be called from a driver thread. Only the
+///performance messages are counted, the first ones are printed too.
+///----------------------------------------------------------------------------
+static void APIENTRY OnDebugMessage(GLenum, GLenum type, GLuint id, GLenum, GLsizei, const GLchar *message, const void*)
+{
+	if(type != GL_DEBUG_TYPE_PERFORMANCE)
+		return;
+
+	GLStats::AddWarning();
+
+	if(AtomicIncrement(&s_Logged) <= GLSTATS_LOGGED)
+	{
+		char text[512];
+		sprintf(text, "GL performance warning %u: %.400s\n", id, message ? message : "");
+		OutputDebugString(text);
+	}
+}
+#endif
+
+///----------------------------------------------------------------------------
+///Wraps the entry points InitExtensions() just loaded and, where the
+///context has KHR_debug, asks for its performance messages. Called by
+///InitExtensions() in the builds with the layer.
+///----------------------------------------------------------------------------
+void GLStats::Hook()
+{
+#ifdef CHARCOAL_GLSTATS
+	Wrap(glUseProgram,					s_UseProgram,					UseProgram);
+	Wrap(glUniform1i,					s_Uniform1i,					Uniform1i);
+	Wrap(glUniform2i,					s_Uniform2i,					Uniform2i);
+	Wrap(glUniform3i,					s_Uniform3i,					Uniform3i);
+	Wrap(glUniform4i,					s_Uniform4i,					Uniform4i);
+	Wrap(glUniform1f,					s_Uniform1f,					Uniform1f);
+	Wrap(glUniform2f,					s_Uniform2f,					Uniform2f);
+	Wrap(glUniform3f,					s_Uniform3f,					Uniform3f);
+	Wrap(glUniform4f,					s_Uniform4f,					Uniform4f);
+	Wrap(glUniformMatrix3fv,			s_UniformMatrix3fv,				UniformMatrix3fv);
+	Wrap(glUniformMatrix4fv,			s_UniformMatrix4fv,				UniformMatrix4fv);
+#ifdef _WIN32
+	Wrap(glActiveTexture,				s_ActiveTexture,				ActiveTexture);
+#endif
+	Wrap(glBindBuffer,					s_BindBuffer,					BindBuffer);
+	Wrap(glBufferData,					s_BufferData,					BufferData);
+	Wrap(glBindVertexArray,				s_BindVertexArray,				BindVertexArray);
+	Wrap(glBindFramebuffer,				s_BindFramebuffer,				BindFramebuffer);
+	Wrap(glBindRenderbuffer,			s_BindRenderbuffer,				BindRenderbuffer);
+	Wrap(glNamedBufferData,				s_NamedBufferData,				NamedBufferData);
+	Wrap(glNamedBufferStorage,			s_NamedBufferStorage,			NamedBufferStorage);
+	Wrap(glBindTextureUnit,				s_BindTextureUnit,				BindTextureUnit);
+	Wrap(glBufferStorage,				s_BufferStorage,				BufferStorage);
+	Wrap(glMultiDrawElementsIndirect,	s_MultiDrawElementsIndirect,	MultiDrawElementsIndirect);
+	Wrap(glCreateShader,				s_CreateShader,					CreateShader);
+	Wrap(glShaderSource,				s_ShaderSource,					ShaderSource);
+	Wrap(glCompileShader,				s_CompileShader,				CompileShader);
+	Wrap(glDeleteShader,				s_DeleteShader,					DeleteShader);
+	Wrap(glCreateProgram,				s_CreateProgram,				CreateProgram);
+	Wrap(glAttachShader,				s_AttachShader,					AttachShader);
+	Wrap(glDetachShader,				s_DetachShader,					DetachShader);
+	Wrap(glBindAttribLocation,			s_BindAttribLocation,			BindAttribLocation);
+	Wrap(glLinkProgram,					s_LinkProgram,					LinkProgram);
+	Wrap(glDeleteProgram,				s_DeleteProgram,				DeleteProgram);
+	Wrap(glGetUniformLocation,			s_GetUniformLocation,			GetUniformLocation);
+	Wrap(glGenBuffers,					s_GenBuffers,					GenBuffers);
+	Wrap(glDeleteBuffers,				s_DeleteBuffers,				DeleteBuffers);
+	Wrap(glVertexAttribPointer,			s_VertexAttribPointer,			VertexAttribPointer);
+	Wrap(glEnableVertexAttribArray,		s_EnableVertexAttribArray,		EnableVertexAttribArray);
+	Wrap(glDisableVertexAttribArray,	s_DisableVertexAttribArray,		DisableVertexAttribArray);
+	Wrap(glGenVertexArrays,				s_GenVertexArrays,				GenVertexArrays);
+	Wrap(glDeleteVertexArrays,			s_DeleteVertexArrays,			DeleteVertexArrays);
+	Wrap(glGenFramebuffers,				s_GenFramebuffers,				GenFramebuffers);
+	Wrap(glDeleteFramebuffers,			s_DeleteFramebuffers,			DeleteFramebuffers);
+	Wrap(glFramebufferRenderbuffer,		s_FramebufferRenderbuffer,		FramebufferRenderbuffer);
+	Wrap(glGenRenderbuffers,			s_GenRenderbuffers,				GenRenderbuffers);
+	Wrap(glDeleteRenderbuffers,			s_DeleteRenderbuffers,			DeleteRenderbuffers);
+	Wrap(glRenderbufferStorage,			s_RenderbufferStorage,			RenderbufferStorage);
+	Wrap(glCreateBuffers,				s_CreateBuffers,				CreateBuffers);
+	Wrap(glCreateVertexArrays,			s_CreateVertexArrays,			CreateVertexArrays);
+	Wrap(glVertexArrayVertexBuffer,		s_VertexArrayVertexBuffer,		VertexArrayVertexBuffer);
+	Wrap(glVertexArrayElementBuffer,	s_VertexArrayElementBuffer,		VertexArrayElementBuffer);
+	Wrap(glVertexArrayAttribFormat,		s_VertexArrayAttribFormat,		VertexArrayAttribFormat);
+	Wrap(glVertexArrayAttribBinding,	s_VertexArrayAttribBinding,		VertexArrayAttribBinding);
+	Wrap(glEnableVertexArrayAttrib,		s_EnableVertexArrayAttrib,		EnableVertexArrayAttrib);
+	Wrap(glGenQueries,					s_GenQueries,					GenQueries);
+	Wrap(glDeleteQueries,				s_DeleteQueries,				DeleteQueries);
+	Wrap(glBeginQuery,					s_BeginQuery,					BeginQuery);
+	Wrap(glEndQuery,					s_EndQuery,						EndQuery);
+	Wrap(glQueryCounter,				s_QueryCounter,					QueryCounter);
+	Wrap(glGetQueryObjectiv,			s_GetQueryObjectiv,				GetQueryObjectiv);
+	Wrap(glGetQueryObjectui64v,			s_GetQueryObjectui64v,			GetQueryObjectui64v);
+
+	//low severity messages are off by default, most performance ones are
+	if(GetCapabilities().debugOutput)
+	{
+		glDebugMessageCallback(OnDebugMessage, NULL);
+		glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_PERFORMANCE, GL_DONT_CARE, 0, NULL, GL_TRUE);
+		::glEnable(GL_DEBUG_OUTPUT);
+	}
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Tells whether this build counts the calls.
+///@return	true in debug builds & with CHARCOAL_GLSTATS
+///----------------------------------------------------------------------------
+bool GLStats::IsCompiledIn()
+{
+#ifdef CHARCOAL_GLSTATS
+	return true;
+#else
+	return false;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Starts counting a frame, the calls made since the last frame ended (i.e.
+///loading) aren't part of any. A capture marks the frame too.
+///----------------------------------------------------------------------------
+void GLStats::BeginFrame()
+{
+	memset(&s_Frame, 0, sizeof(s_Frame));
+	s_FrameWarnings = AtomicOr(&s_Warnings, 0);
+
+#ifdef CHARCOAL_GLSTATS
+	GLCapture::BeginFrame();
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Ends the frame, adding its counts to the totals & checking them against
+///the budgets.
+///----------------------------------------------------------------------------
+void GLStats::EndFrame()
+{
+	//messages of the frame, whichever thread the driver sent them from
+	long warnings = AtomicOr(&s_Warnings, 0);
+	s_Frame.counts[GS_PERF_WARNINGS] = (unsigned long)(warnings - s_FrameWarnings);
+
+	for(int i=0; i<GS_COUNT; i++)
+	{
+		unsigned long count = s_Frame.counts[i];
+
+		s_Total.counts[i] += count;
+
+		if(count > s_Max.counts[i])
+			s_Max.counts[i] = count;
+
+		if(s_Budget.counts[i] != GLSTATS_NO_BUDGET && count > s_Budget.counts[i])
+			s_Over.counts[i]++;
+	}
+
+	s_Last = s_Frame;
+	s_Frames++;
+
+#ifdef CHARCOAL_GLSTATS
+	GLCapture::EndFrame();
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Forgets the frames counted so far, the budgets are kept.
+///----------------------------------------------------------------------------
+void GLStats::Clear()
+{
+	memset(&s_Last, 0, sizeof(s_Last));
+	memset(&s_Total, 0, sizeof(s_Total));
+	memset(&s_Max, 0, sizeof(s_Max));
+	memset(&s_Over, 0, sizeof(s_Over));
+
+	s_Frames = 0;
+}
+
+///----------------------------------------------------------------------------
+///Sets the most calls a frame may make per category.
+///@param	budgets - comma separated "category=count", i.e.
+///			"draws=4,binds=16,perf_warnings=0"
+///@return	false if a category is unknown or a count missing
+///----------------------------------------------------------------------------
+bool GLStats::SetBudgets(const char *budgets)
+{
+	string text(budgets);
+	size_t start = 0;
+
+	while(start < text.size())
+	{
+		size_t end = text.find(',', start);
+		if(end == string::npos)
+			end = text.size();
+
+		string item = text.substr(start, end - start);
+		size_t equals = item.find('=');
+
+		if(equals == string::npos || equals + 1 == item.size())
+			return false;
+
+		string name = item.substr(0, equals);
+		char *last;
+		unsigned long count = strtoul(item.c_str() + equals + 1, &last, 10);
+
+		if(*last != '\0')
+			return false;
+
+		int category = 0;
+		while(category < GS_COUNT && name != s_CategoryNames[category])
+			category++;
+
+		if(category == GS_COUNT)
+			return false;
+
+		s_Budget.counts[category] = count;
+		start = end + 1;
+	}
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Tells whether any category has a budget.
+///@return	true if SetBudgets() set one
+///----------------------------------------------------------------------------
+bool GLStats::HasBudgets()
+{
+	for(int i=0; i<GS_COUNT; i++)
+	{
+		if(s_Budget.counts[i] != GLSTATS_NO_BUDGET)
+			return true;
+	}
+
+	return false;
+}
+
+///----------------------------------------------------------------------------
+///Checks the frames counted so far against the budgets.
+///@return	true if no frame went over any budget
+///----------------------------------------------------------------------------
+bool GLStats::IsWithinBudgets()
+{
+	for(int i=0; i<GS_COUNT; i++)
+	{
+		if(s_Over.counts[i] > 0)
+			return false;
+	}
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of frames counted.
+///@return	frames ended since Clear()
+///----------------------------------------------------------------------------
+unsigned long GLStats::GetFrameCount()
+{
+	return s_Frames;
+}
+
+///----------------------------------------------------------------------------
+///Gets the counts of the last frame ended.
+///@return	the counts
+///----------------------------------------------------------------------------
+const GLCallCounts& GLStats::GetLastFrame()
+{
+	return s_Last;
+}
+
+///----------------------------------------------------------------------------
+///Adds a performance message to the current frame, from any thread.
+///----------------------------------------------------------------------------
+void GLStats::AddWarning()
+{
+	AtomicIncrement(&s_Warnings);
+}
+
+///----------------------------------------------------------------------------
+///Formats the calls per frame as a table.
+///@return	one line per category, empty if no frame was counted or the
+///			counting isn't compiled in
+///----------------------------------------------------------------------------
+string GLStats::GetReport()
+{
+	char line[256];
+	string report;
+
+	if(!IsCompiledIn() || s_Frames == 0)
+		return report;
+
+	sprintf(line, "%-14s %10s %8s %8s %8s\n", "GL per frame", "mean", "max", "budget", "over");
+	report += line;
+
+	for(int i=0; i<GS_COUNT; i++)
+	{
+		sprintf(line, "%-14s %10.1f %8lu", s_CategoryNames[i], (double)s_Total.counts[i] / s_Frames, s_Max.counts[i]);
+		report += line;
+
+		if(s_Budget.counts[i] != GLSTATS_NO_BUDGET)
+			sprintf(line, " %8lu %8lu\n", s_Budget.counts[i], s_Over.counts[i]);
+		else
+			sprintf(line, " %8s %8s\n", "-", "-");
+		report += line;
+	}
+
+	return report;
+}
+
+///----------------------------------------------------------------------------
+///Writes the calls per frame as a JSON object.
+///@param	file - the output file
+///----------------------------------------------------------------------------
+void GLStats::WriteJSON(FILE *file)
+{
+	fprintf(file, "{\"frames\": %lu, \"within_budgets\": %s, \"categories\": {",
+			s_Frames, IsWithinBudgets() ? "true" : "false");
+
+	for(int i=0; i<GS_COUNT; i++)
+	{
+		fprintf(file, "%s\n\t\"%s\": {\"mean\": %.2f, \"max\": %lu, \"budget\": ", i ? "," : "",
+				s_CategoryNames[i], s_Frames ? (double)s_Total.counts[i] / s_Frames : 0.0, s_Max.counts[i]);
+
+		if(s_Budget.counts[i] != GLSTATS_NO_BUDGET)
+			fprintf(file, "%lu", s_Budget.counts[i]);
+		else
+			fprintf(file, "null");
+
+		fprintf(file, ", \"over_budget_frames\": %lu}", s_Over.counts[i]);
+	}
+
+	fprintf(file, "\n}}");
+}
+
+///----------------------------------------------------------------------------
+///Gets the name of a category.
+///@param	category - the category
+///@return	its name, i.e. "draws"
+///----------------------------------------------------------------------------
+const char* GLStats::GetCategoryName(GLStatCategory category)
+{
+	return s_CategoryNames[category];
+}
+
+#ifdef CHARCOAL_GLSTATS
+void APIENTRY CountedBegin(GLenum mode)
+{
+	GLStats::Count(GS_DRAWS);
+	glBegin(mode);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_BEGIN, mode);
+}
+
+void APIENTRY CountedEnd()
+{
+	GLStats::Count(GS_CALLS);
+	glEnd();
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Command(GC_END);
+}
+
+void APIENTRY CountedVertex3f(GLfloat x, GLfloat y, GLfloat z)
+{
+	GLStats::Count(GS_VERTICES);
+	glVertex3f(x, y, z);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_VERTEX3F, x, y, z);
+}
+
+void APIENTRY CountedVertex3fv(const GLfloat *v)
+{
+	GLStats::Count(GS_VERTICES);
+	glVertex3fv(v);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_VERTEX3FV);
+		GLCapture::PutFloats(v, 3);
+	}
+}
+
+void APIENTRY CountedNormal3fv(const GLfloat *v)
+{
+	GLStats::Count(GS_CALLS);
+	glNormal3fv(v);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_NORMAL3FV);
+		GLCapture::PutFloats(v, 3);
+	}
+}
+
+void APIENTRY CountedTexCoord2f(GLfloat s, GLfloat t)
+{
+	GLStats::Count(GS_CALLS);
+	glTexCoord2f(s, t);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_TEXCOORD2F, s, t);
+}
+
+void APIENTRY CountedDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+	GLStats::Count(GS_DRAWS);
+	glDrawArrays(mode, first, count);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_DRAW_ARRAYS, mode, first, count);
+}
+
+void APIENTRY CountedDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices)
+{
+	GLStats::Count(GS_DRAWS);
+	glDrawElements(mode, count, type, indices);
+
+	//the indices are always in a GL_ELEMENT_ARRAY_BUFFER
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_DRAW_ELEMENTS, mode, count, type);
+		GLCapture::PutOffset(indices);
+	}
+}
+
+void APIENTRY CountedBindTexture(GLenum target, GLuint texture)
+{
+	GLStats::Count(GS_BINDS);
+	glBindTexture(target, texture);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_BIND_TEXTURE, target, texture);
+}
+
+void APIENTRY CountedMaterialf(GLenum face, GLenum pname, GLfloat param)
+{
+	GLStats::Count(GS_MATERIALS);
+	glMaterialf(face, pname, param);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_MATERIALF, face, pname, param);
+}
+
+void APIENTRY CountedMaterialfv(GLenum face, GLenum pname, const GLfloat *params)
+{
+	GLStats::Count(GS_MATERIALS);
+	glMaterialfv(face, pname, params);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_MATERIALFV, face, pname);
+		GLCapture::PutFloats(params, GLCapture::GetParameterCount(pname));
+	}
+}
+
+void APIENTRY CountedTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+								GLint border, GLenum format, GLenum type, const GLvoid *pixels)
+{
+	GLStats::Count(GS_UPLOADS);
+	glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_TEX_IMAGE_2D, target, level, internalFormat, width, height);
+		GLCapture::Put(border);
+		GLCapture::Put(format);
+		GLCapture::Put(type);
+		GLCapture::PutData(pixels, GLCapture::GetImageSize(width, height, format, type, 0));
+	}
+}
+
+void APIENTRY CountedEnable(GLenum cap)
+{
+	GLStats::Count(GS_CALLS);
+	glEnable(cap);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_ENABLE, cap);
+}
+
+void APIENTRY CountedDisable(GLenum cap)
+{
+	GLStats::Count(GS_CALLS);
+	glDisable(cap);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_DISABLE, cap);
+}
+
+void APIENTRY CountedClear(GLbitfield mask)
+{
+	GLStats::Count(GS_CALLS);
+	glClear(mask);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_CLEAR, mask);
+}
+
+void APIENTRY CountedClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
+{
+	GLStats::Count(GS_CALLS);
+	glClearColor(red, green, blue, alpha);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_CLEAR_COLOR, red, green, blue, alpha);
+}
+
+void APIENTRY CountedViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	GLStats::Count(GS_CALLS);
+	glViewport(x, y, width, height);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_VIEWPORT, x, y, width, height);
+}
+
+void APIENTRY CountedPixelStorei(GLenum pname, GLint param)
+{
+	GLStats::Count(GS_CALLS);
+	glPixelStorei(pname, param);
+
+	//the size of the texture images recorded depends on it
+	if(pname == GL_UNPACK_ALIGNMENT)
+		GLCapture::SetUnpackAlignment(param);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_PIXEL_STOREI, pname, param);
+}
+
+void APIENTRY CountedReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type,
+								GLvoid *pixels)
+{
+	GLStats::Count(GS_CALLS);
+	glReadPixels(x, y, width, height, format, type, pixels);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_READ_PIXELS, x, y, width, height);
+		GLCapture::Put(format);
+		GLCapture::Put(type);
+	}
+}
+
+void APIENTRY CountedColorMaterial(GLenum face, GLenum mode)
+{
+	GLStats::Count(GS_CALLS);
+	glColorMaterial(face, mode);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_COLOR_MATERIAL, face, mode);
+}
+
+void APIENTRY CountedGenTextures(GLsizei n, GLuint *textures)
+{
+	GLStats::Count(GS_CALLS);
+	glGenTextures(n, textures);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_GEN_TEXTURES);
+		GLCapture::PutNames(n, textures);
+	}
+}
+
+void APIENTRY CountedDeleteTextures(GLsizei n, const GLuint *textures)
+{
+	GLStats::Count(GS_CALLS);
+	glDeleteTextures(n, textures);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_DELETE_TEXTURES);
+		GLCapture::PutNames(n, textures);
+	}
+}
+
+void APIENTRY CountedLightfv(GLenum light, GLenum pname, const GLfloat *params)
+{
+	GLStats::Count(GS_CALLS);
+	glLightfv(light, pname, params);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Record(GC_LIGHTFV, light, pname);
+		GLCapture::PutFloats(params, GLCapture::GetParameterCount(pname));
+	}
+}
+
+void APIENTRY CountedRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z)
+{
+	GLStats::Count(GS_CALLS);
+	glRotatef(angle, x, y, z);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_ROTATEF, angle, x, y, z);
+}
+
+void APIENTRY CountedTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+	GLStats::Count(GS_CALLS);
+	glTexParameteri(target, pname, param);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_TEX_PARAMETERI, target, pname, param);
+}
+
+void APIENTRY CountedLoadIdentity()
+{
+	GLStats::Count(GS_CALLS);
+	glLoadIdentity();
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Command(GC_LOAD_IDENTITY);
+}
+
+void APIENTRY CountedLoadMatrixf(const GLfloat *m)
+{
+	GLStats::Count(GS_CALLS);
+	glLoadMatrixf(m);
+
+	if(GLCapture::IsCapturing())
+	{
+		GLCapture::Command(GC_LOAD_MATRIXF);
+		GLCapture::PutFloats(m, 16);
+	}
+}
+
+void APIENTRY CountedMatrixMode(GLenum mode)
+{
+	GLStats::Count(GS_CALLS);
+	glMatrixMode(mode);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_MATRIX_MODE, mode);
+}
+
+void APIENTRY CountedBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+	GLStats::Count(GS_CALLS);
+	glBlendFunc(sfactor, dfactor);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_BLEND_FUNC, sfactor, dfactor);
+}
+
+void APIENTRY CountedFinish()
+{
+	GLStats::Count(GS_CALLS);
+	glFinish();
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Command(GC_FINISH);
+}
+
+//the replay calls glOrtho() instead, without GLU
+void APIENTRY CountedOrtho2D(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top)
+{
+	GLStats::Count(GS_CALLS);
+	gluOrtho2D(left, right, bottom, top);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_ORTHO, (GLfloat)left, (GLfloat)right, (GLfloat)bottom, (GLfloat)top);
+}
+
+#ifndef _WIN32
+void APIENTRY CountedActiveTexture(GLenum texture)
+{
+	GLStats::Count(GS_BINDS);
+	glActiveTexture(texture);
+
+	if(GLCapture::IsCapturing())
+		GLCapture::Record(GC_ACTIVE_TEXTURE, texture);
+}
+#endif
+#endif
@@ -0,0 +1,185 @@
+///============================================================================
+///@file	GLStats.h
+///@brief	Counts the GL calls of each frame by category: draws, binds,
+///			uniform sets, material sets, immediate mode vertices & uploads,
+///			plus the performance warnings the driver sends through
+///			KHR_debug. The entry points loaded by InitExtensions() are
+///			replaced by counting wrappers, the GL 1.1 functions called
+///			directly are redirected to them by the macros below. The
+///			counts of a frame can be checked against per frame budgets.
+///
+///			The layer is compiled in debug builds, and in release builds
+///			only with CHARCOAL_GLSTATS defined; otherwise the GL is called
+///			directly and every count stays 0. While GLCapture records, the
+///			same wrappers write the calls to its trace.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef GLSTATS_H
+#define GLSTATS_H
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+#include <GL/glu.h>
+#include <stdio.h>
+#include <string>
+
+//debug builds always count
+#if defined(_DEBUG) && !defined(CHARCOAL_GLSTATS)
+#define CHARCOAL_GLSTATS
+#endif
+
+enum GLStatCategory
+{
+	GS_CALLS,			// Every GL call counted
+	GS_DRAWS,			// Draw calls, a glBegin/glEnd pair counts as one
+	GS_BINDS,			// Program, texture, buffer, vertex array & framebuffer binds
+	GS_UNIFORMS,		// glUniform*
+	GS_MATERIALS,		// glMaterial*
+	GS_VERTICES,		// glVertex*, immediate mode
+	GS_UPLOADS,			// Buffer & texture data
+	GS_PERF_WARNINGS,	// KHR_debug performance messages
+	GS_COUNT
+};
+
+//-----------------------------------------------------------------------------
+//Counts of a frame, or of many
+//-----------------------------------------------------------------------------
+struct GLCallCounts
+{
+	unsigned long	counts[GS_COUNT];	///> Per category
+};
+
+class GLStats
+{
+public:
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	static void			Hook();
+	static bool			IsCompiledIn();
+	static void			BeginFrame();
+	static void			EndFrame();
+	static void			Clear();
+	static bool			SetBudgets(const char *budgets);
+	static bool			HasBudgets();
+	static bool			IsWithinBudgets();
+	static unsigned long	GetFrameCount();
+	static const GLCallCounts&	GetLastFrame();
+	static std::string	GetReport();
+	static void			WriteJSON(FILE *file);
+	static const char*	GetCategoryName(GLStatCategory category);
+	static void			AddWarning();
+
+	///------------------------------------------------------------------------
+	///Counts a call of the current frame.
+	///@param	category - its category, GS_CALLS for no other
+	///------------------------------------------------------------------------
+	static void Count(GLStatCategory category)
+	{
+		s_Frame.counts[GS_CALLS]++;
+
+		if(category != GS_CALLS)
+			s_Frame.counts[category]++;
+	}
+
+private:
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	static GLCallCounts		s_Frame;		///> Counts of the current frame
+	static GLCallCounts		s_Last;			///> Counts of the last frame ended
+	static GLCallCounts		s_Total;		///> Sum of the frames ended
+	static GLCallCounts		s_Max;			///> Highest count of a frame
+	static GLCallCounts		s_Over;			///> Frames over the budget
+	static GLCallCounts		s_Budget;		///> Per frame budget, ~0 for none
+	static unsigned long	s_Frames;		///> Frames ended since Clear()
+	static volatile long	s_Warnings;		///> Performance messages received, from any thread
+	static long				s_FrameWarnings;	///> s_Warnings when the frame began
+};
+
+//-----------------------------------------------------------------------------
+//The GL 1.1 functions called directly, redirected to counting wrappers
+//-----------------------------------------------------------------------------
+#ifdef CHARCOAL_GLSTATS
+void APIENTRY	CountedBegin(GLenum mode);
+void APIENTRY	CountedEnd();
+void APIENTRY	CountedVertex3f(GLfloat x, GLfloat y, GLfloat z);
+void APIENTRY	CountedVertex3fv(const GLfloat *v);
+void APIENTRY	CountedNormal3fv(const GLfloat *v);
+void APIENTRY	CountedTexCoord2f(GLfloat s, GLfloat t);
+void APIENTRY	CountedDrawArrays(GLenum mode, GLint first, GLsizei count);
+void APIENTRY	CountedDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices);
+void APIENTRY	CountedBindTexture(GLenum target, GLuint texture);
+void APIENTRY	CountedMaterialf(GLenum face, GLenum pname, GLfloat param);
+void APIENTRY	CountedMaterialfv(GLenum face, GLenum pname, const GLfloat *params);
+void APIENTRY	CountedTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+								  GLint border, GLenum format, GLenum type, const GLvoid *pixels);
+void APIENTRY	CountedEnable(GLenum cap);
+void APIENTRY	CountedDisable(GLenum cap);
+void APIENTRY	CountedClear(GLbitfield mask);
+void APIENTRY	CountedClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha);
+void APIENTRY	CountedViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+void APIENTRY	CountedPixelStorei(GLenum pname, GLint param);
+void APIENTRY	CountedReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type,
+								  GLvoid *pixels);
+void APIENTRY	CountedColorMaterial(GLenum face, GLenum mode);
+void APIENTRY	CountedGenTextures(GLsizei n, GLuint *textures);
+void APIENTRY	CountedDeleteTextures(GLsizei n, const GLuint *textures);
+void APIENTRY	CountedLightfv(GLenum light, GLenum pname, const GLfloat *params);
+void APIENTRY	CountedRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z);
+void APIENTRY	CountedTexParameteri(GLenum target, GLenum pname, GLint param);
+void APIENTRY	CountedLoadIdentity();
+void APIENTRY	CountedLoadMatrixf(const GLfloat *m);
+void APIENTRY	CountedMatrixMode(GLenum mode);
+void APIENTRY	CountedBlendFunc(GLenum sfactor, GLenum dfactor);
+void APIENTRY	CountedFinish();
+void APIENTRY	CountedOrtho2D(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top);
+#ifndef _WIN32
+void APIENTRY	CountedActiveTexture(GLenum texture);
+#endif
+
+//GLStats.cpp calls the real functions
+#ifndef GLSTATS_NO_MACROS
+#define glBegin			CountedBegin
+#define glEnd			CountedEnd
+#define glVertex3f		CountedVertex3f
+#define glVertex3fv		CountedVertex3fv
+#define glNormal3fv		CountedNormal3fv
+#define glTexCoord2f	CountedTexCoord2f
+#define glDrawArrays	CountedDrawArrays
+#define glDrawElements	CountedDrawElements
+#define glBindTexture	CountedBindTexture
+#define glMaterialf		CountedMaterialf
+#define glMaterialfv	CountedMaterialfv
+#define glTexImage2D	CountedTexImage2D
+#define glEnable		CountedEnable
+#define glDisable		CountedDisable
+#define glClear			CountedClear
+#define glClearColor	CountedClearColor
+#define glViewport		CountedViewport
+#define glPixelStorei	CountedPixelStorei
+#define glReadPixels	CountedReadPixels
+#define glColorMaterial	CountedColorMaterial
+#define glGenTextures	CountedGenTextures
+#define glDeleteTextures	CountedDeleteTextures
+#define glLightfv		CountedLightfv
+#define glRotatef		CountedRotatef
+#define glTexParameteri	CountedTexParameteri
+#define glLoadIdentity	CountedLoadIdentity
+#define glLoadMatrixf	CountedLoadMatrixf
+#define glMatrixMode	CountedMatrixMode
+#define glBlendFunc		CountedBlendFunc
+#define glFinish		CountedFinish
+#define gluOrtho2D		CountedOrtho2D
+#ifndef _WIN32
+#define glActiveTexture	CountedActiveTexture
+#endif
+#endif
+#endif
+
+#endif
@@ -7,14 +7,29 @@
 ///============================================================================
 
 #include "Geometry.h"
+#include "Tracer.h"
+#include "MemoryStats.h"
 
 ///----------------------------------------------------------------------------
 ///Default constructor
 ///----------------------------------------------------------------------------
 Geometry::Geometry()
 {
+	TRACE_ZONE("Geometry");
+
+	m_Textures[0] = m_Textures[1] = m_Textures[2] = 0;
+	m_TextureSize = 0;
+
 	m_Model = new MilkshapeModel();
-	m_Model->loadModelData( "textures\\model.ms3d" );
+	m_Model->loadModelData( "textures/model.ms3d" );
+}
+
+///----------------------------------------------------------------------------
+///Default destructor, ReleaseTextures() must have deleted the textures.
+///----------------------------------------------------------------------------
+Geometry::~Geometry()
+{
+	delete m_Model;
 }
 
 ///----------------------------------------------------------------------------
@@ -33,6 +48,8 @@ void Geometry::Draw(GLfloat angleX, GLfloat angleY)
 ///----------------------------------------------------------------------------
 void Geometry::SetLights(GLfloat pos[])
 {
+	SetLightPosition(pos);
+
 	//define the light position
 	glLightfv(GL_LIGHT0, GL_POSITION, pos);
 
@@ -59,6 +76,17 @@ void Geometry::SetMaterials()
 	glMaterialf(GL_FRONT, GL_SHININESS, 20.f);
 }
 
+///----------------------------------------------------------------------------
+///Sets the light position without touching the fixed function lights.
+///@param	pos[] - the light position (x,y,z)
+///----------------------------------------------------------------------------
+void Geometry::SetLightPosition(GLfloat pos[])
+{
+	m_Light[0] = pos[0];
+	m_Light[1] = pos[1];
+	m_Light[2] = pos[2];
+}
+
 ///----------------------------------------------------------------------------
 ///Sets the camera position.
 ///@param	pos[] - the camera position (x,y,z)
@@ -97,12 +125,15 @@ void Geometry::GetLightPosition(GLfloat *pos) const
 ///----------------------------------------------------------------------------
 void Geometry::SetTextures()
 {
+	TRACE_ZONE("SetTextures");
+
 	//generate the texture names
+	ReleaseTextures();
 	glGenTextures(3, m_Textures);
 
-	LTGA noise("textures\\noise.tga");
-	LTGA contrast("textures\\contrast.tga");
-	LTGA paper("textures\\paper.tga");
+	LTGA noise("textures/noise.tga");
+	LTGA contrast("textures/contrast.tga");
+	LTGA paper("textures/paper.tga");
 
 	//set paper texture
 	glBindTexture(GL_TEXTURE_2D, m_Textures[0]);
@@ -152,7 +183,23 @@ void Geometry::SetTextures()
 				 GL_UNSIGNED_BYTE,	
 				 contrast.GetPixels());
 
+	m_TextureSize = MemoryStats::GetTextureSize(512, 512, GL_RGB) + 2 * MemoryStats::GetTextureSize(256, 256, GL_RGB);
+	MemoryStats::Allocate(MC_TEXTURE, MP_GPU, m_TextureSize);
+}
+
+///----------------------------------------------------------------------------
+///Deletes the textures, the context must still be current.
+///----------------------------------------------------------------------------
+void Geometry::ReleaseTextures()
+{
+	if(!m_Textures[0])
+		return;
+
+	glDeleteTextures(3, m_Textures);
+	m_Textures[0] = m_Textures[1] = m_Textures[2] = 0;
 
+	MemoryStats::Free(MC_TEXTURE, MP_GPU, m_TextureSize);
+	m_TextureSize = 0;
 }
 
 ///----------------------------------------------------------------------------
@@ -163,4 +210,13 @@ void Geometry::SetTextures()
 GLuint Geometry::GetTexObj(int obj) const
 {
 	return m_Textures[obj];
+}
+
+///----------------------------------------------------------------------------
+///Gets the milkshape model drawn by this object.
+///@returns the model
+///----------------------------------------------------------------------------
+const Model* Geometry::GetModel() const
+{
+	return m_Model;
 }
\ No newline at end of file
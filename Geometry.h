@@ -9,7 +9,9 @@
 #ifndef GEOMETRY_H
 #define GEOMETRY_H
 
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <math.h>
 #include <GL/gl.h>
 #include <GL/glu.h>
@@ -29,6 +31,7 @@ public:
 	//Constructors and destructors
 	//-------------------------------------------------------------------------
 	Geometry();
+	~Geometry();
 
 	//-------------------------------------------------------------------------
 	//Public methods
@@ -37,10 +40,13 @@ public:
 	void SetLights(GLfloat pos[]);
 	void SetMaterials();
 	void SetTextures();
+	void ReleaseTextures();
+	void SetLightPosition(GLfloat pos[]);
 	void SetCameraPosition(GLfloat pos[]);
 	void GetCameraPosition(GLfloat *pos) const;
 	void GetLightPosition(GLfloat *pos) const;
 	GLuint GetTexObj(int obj) const;
+	const Model* GetModel() const;
 
 private:
 	//-------------------------------------------------------------------------
@@ -50,6 +56,11 @@ private:
 	GLfloat m_Light[3];		///> Light's position
 	GLfloat m_Camera[3];	///> Camera's position
 	Model	*m_Model;		///> Milkshape3D mesh
+	size_t	m_TextureSize;	///> GPU bytes of the textures
+
+	//owns the model, not copyable
+	Geometry(const Geometry&);
+	Geometry& operator=(const Geometry&);
 };
 
 #endif
@@ -0,0 +1,381 @@
+///============================================================================
+///@file	GpuProfiler.cpp
+///@brief	GPU Profiler Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "GpuProfiler.h"
+#include "FramePacer.h"
+
+#include <string.h>
+
+static const char *s_StageNames[RS_COUNT] = {"frame", "paper", "model", "swap", "readback", "overlay"};
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+GpuProfiler::GpuProfiler()
+{
+	memset(m_Frames, 0, sizeof(m_Frames));
+
+	m_Queries	= NULL;
+	m_Current	= 0;
+	m_Recording	= false;
+	m_ZoneCount	= 0;
+	m_Dropped	= 0;
+}
+
+///----------------------------------------------------------------------------
+///Default destructor, ShutDown() must have deleted the queries.
+///----------------------------------------------------------------------------
+GpuProfiler::~GpuProfiler()
+{
+	delete [] m_Queries;
+}
+
+///----------------------------------------------------------------------------
+///Creates the query objects, the context must be current & its extensions
+///initialized. Without timer queries only the CPU times are measured.
+///@return	true if the GPU times are measured
+///----------------------------------------------------------------------------
+bool GpuProfiler::Init()
+{
+	ShutDown();
+
+	if(!GetCapabilities().timerQuery)
+		return false;
+
+	const int count = PROFILER_LATENCY * PROFILER_ZONES * 2;
+	m_Queries = new GLuint[count];
+	glGenQueries(count, m_Queries);
+
+	GLuint *query = m_Queries;
+
+	for(int i=0; i<PROFILER_LATENCY; i++)
+	{
+		for(int j=0; j<PROFILER_ZONES; j++)
+		{
+			m_Frames[i].zones[j].queries[0] = *query++;
+			m_Frames[i].zones[j].queries[1] = *query++;
+		}
+	}
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Deletes the query objects, the context must still be current. Results
+///not read yet are lost, Flush() first to keep them.
+///----------------------------------------------------------------------------
+void GpuProfiler::ShutDown()
+{
+	if(m_Queries)
+	{
+		glDeleteQueries(PROFILER_LATENCY * PROFILER_ZONES * 2, m_Queries);
+		delete [] m_Queries;
+		m_Queries = NULL;
+	}
+
+	for(int i=0; i<PROFILER_LATENCY; i++)
+		m_Frames[i].pending = false;
+
+	m_Recording = false;
+}
+
+///----------------------------------------------------------------------------
+///Starts a frame. Its queries reuse the ones of PROFILER_LATENCY frames
+///ago: if the GPU hasn't finished that frame yet, this one is only timed
+///on the CPU rather than waiting.
+///@param	recorder - gets the GPU time of the frame once it's known, in
+///			the frame it's about to record; NULL not to report it
+///----------------------------------------------------------------------------
+void GpuProfiler::BeginFrame(FrameRecorder *recorder)
+{
+	m_ZoneCount	= 0;
+	m_Current	= (m_Current + 1) % PROFILER_LATENCY;
+
+	Frame &frame = m_Frames[m_Current];
+	m_Recording = (m_Queries != NULL);
+
+	if(m_Recording && frame.pending && !Collect(frame, false))
+	{
+		m_Recording = false;
+		m_Dropped++;
+		return;
+	}
+
+	frame.zoneCount		= 0;
+	frame.recorder		= recorder;
+	frame.recorderFrame	= recorder ? recorder->GetFrameCount() : 0;
+}
+
+///----------------------------------------------------------------------------
+///Ends the frame, its GPU times are read PROFILER_LATENCY frames later.
+///----------------------------------------------------------------------------
+void GpuProfiler::EndFrame()
+{
+	if(m_Recording)
+		m_Frames[m_Current].pending = (m_Frames[m_Current].zoneCount > 0);
+
+	m_Recording = false;
+}
+
+///----------------------------------------------------------------------------
+///Starts timing a stage, zones may nest.
+///@param	stage - the stage
+///@return	the zone for EndZone(), -1 if the frame has no zones left
+///----------------------------------------------------------------------------
+int GpuProfiler::BeginZone(RenderStage stage)
+{
+	if(m_ZoneCount >= PROFILER_ZONES)
+		return -1;
+
+	int zone = m_ZoneCount++;
+	m_ZoneStages[zone] = stage;
+
+	if(m_Recording)
+	{
+		Frame &frame = m_Frames[m_Current];
+		frame.zones[zone].stage = stage;
+		frame.zoneCount = m_ZoneCount;
+
+		glQueryCounter(frame.zones[zone].queries[0], GL_TIMESTAMP);
+	}
+
+	//last, so the CPU time doesn't include issuing the query
+	m_ZoneStarts[zone] = FramePacer::GetTime();
+#ifdef CHARCOAL_TRACE
+	m_TraceStarts[zone] = Tracer::IsEnabled() ? Tracer::GetTimestamp() : 0;
+#endif
+
+	return zone;
+}
+
+///----------------------------------------------------------------------------
+///Stops timing a stage.
+///@param	zone - the zone BeginZone() returned
+///----------------------------------------------------------------------------
+void GpuProfiler::EndZone(int zone)
+{
+	if(zone < 0)
+		return;
+
+	m_CpuTimes[m_ZoneStages[zone]].Record(FramePacer::GetTime() - m_ZoneStarts[zone]);
+#ifdef CHARCOAL_TRACE
+	if(m_TraceStarts[zone])
+		Tracer::AddZone(s_StageNames[m_ZoneStages[zone]], m_TraceStarts[zone], Tracer::GetTimestamp());
+#endif
+
+	if(m_Recording)
+	{
+		Frame &frame = m_Frames[m_Current];
+		frame.lastQuery = frame.zones[zone].queries[1];
+
+		glQueryCounter(frame.lastQuery, GL_TIMESTAMP);
+	}
+}
+
+///----------------------------------------------------------------------------
+///Reads the results of every frame still in flight, waiting for the GPU.
+///Meant for the end of a run, before reporting.
+///----------------------------------------------------------------------------
+void GpuProfiler::Flush()
+{
+	//oldest first, so the recorder gets the frames in order
+	for(int i=1; i<=PROFILER_LATENCY; i++)
+	{
+		Frame &frame = m_Frames[(m_Current + i) % PROFILER_LATENCY];
+
+		if(frame.pending && m_Queries)
+			Collect(frame, true);
+	}
+}
+
+///----------------------------------------------------------------------------
+///Forgets the times measured so far.
+///----------------------------------------------------------------------------
+void GpuProfiler::Clear()
+{
+	for(int i=0; i<RS_COUNT; i++)
+	{
+		m_CpuTimes[i].Clear();
+		m_GpuTimes[i].Clear();
+	}
+
+	m_Dropped = 0;
+}
+
+///----------------------------------------------------------------------------
+///Tells whether the GPU times are measured.
+///@return	true if the context has timer queries
+///----------------------------------------------------------------------------
+bool GpuProfiler::HasGpuTimes() const
+{
+	return m_Queries != NULL;
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of frames only timed on the CPU because the GPU was
+///more than PROFILER_LATENCY frames behind.
+///@return	the frame count
+///----------------------------------------------------------------------------
+unsigned long GpuProfiler::GetDroppedFrames() const
+{
+	return m_Dropped;
+}
+
+///----------------------------------------------------------------------------
+///Gets the CPU times of a stage, the time spent issuing its GL calls.
+///@param	stage - the stage
+///@return	the histogram
+///----------------------------------------------------------------------------
+const FrameHistogram& GpuProfiler::GetCpuTimes(RenderStage stage) const
+{
+	return m_CpuTimes[stage];
+}
+
+///----------------------------------------------------------------------------
+///Gets the GPU times of a stage, between the time stamps around it.
+///@param	stage - the stage
+///@return	the histogram
+///----------------------------------------------------------------------------
+const FrameHistogram& GpuProfiler::GetGpuTimes(RenderStage stage) const
+{
+	return m_GpuTimes[stage];
+}
+
+///----------------------------------------------------------------------------
+///Formats the per stage times as a table, in milliseconds.
+///@return	one line per stage measured
+///----------------------------------------------------------------------------
+string GpuProfiler::GetReport() const
+{
+	char line[256];
+	string report;
+
+	sprintf(line, "%-10s %8s %9s %9s %9s %9s\n", "stage", "count", "cpu mean", "cpu p99", "gpu mean", "gpu p99");
+	report += line;
+
+	for(int i=0; i<RS_COUNT; i++)
+	{
+		const FrameHistogram &cpu = m_CpuTimes[i];
+		const FrameHistogram &gpu = m_GpuTimes[i];
+
+		if(cpu.GetCount() == 0)
+			continue;
+
+		sprintf(line, "%-10s %8lu %9.3f %9.3f", s_StageNames[i], cpu.GetCount(), 
+				cpu.GetMean() * 1000.0, cpu.GetPercentile(99.0) * 1000.0);
+		report += line;
+
+		if(gpu.GetCount() > 0)
+			sprintf(line, " %9.3f %9.3f\n", gpu.GetMean() * 1000.0, gpu.GetPercentile(99.0) * 1000.0);
+		else
+			sprintf(line, " %9s %9s\n", "-", "-");
+		report += line;
+	}
+
+	if(m_Dropped > 0)
+	{
+		sprintf(line, "%lu frames not timed on the GPU, it was %d frames behind\n", m_Dropped, PROFILER_LATENCY);
+		report += line;
+	}
+
+	return report;
+}
+
+///----------------------------------------------------------------------------
+///Writes the per stage times as a JSON object, in milliseconds.
+///@param	file - the output file
+///----------------------------------------------------------------------------
+void GpuProfiler::WriteJSON(FILE *file) const
+{
+	fprintf(file, "{\n\t\"timer_query\": %s,\n\t\"dropped_frames\": %lu,\n\t\"stages\": {",
+			m_Queries ? "true" : "false", m_Dropped);
+
+	bool first = true;
+
+	for(int i=0; i<RS_COUNT; i++)
+	{
+		if(m_CpuTimes[i].GetCount() == 0)
+			continue;
+
+		fprintf(file, "%s\n\t\t\"%s\": {\"cpu_ms\": ", first ? "" : ",", s_StageNames[i]);
+		m_CpuTimes[i].WriteJSON(file);
+		fprintf(file, ", \"gpu_ms\": ");
+		m_GpuTimes[i].WriteJSON(file);
+		fprintf(file, "}");
+
+		first = false;
+	}
+
+	fprintf(file, "\n\t}\n}");
+}
+
+///----------------------------------------------------------------------------
+///Gets the name of a stage.
+///@param	stage - the stage
+///@return	its name, i.e. "model"
+///----------------------------------------------------------------------------
+const char* GpuProfiler::GetStageName(RenderStage stage)
+{
+	return s_StageNames[stage];
+}
+
+///----------------------------------------------------------------------------
+///Reads the GPU times of a frame. The queries finish in the order they
+///were issued, so once the last one is available all of them are.
+///@param	frame - the frame
+///@param	wait - wait for the GPU, otherwise fail if it isn't done
+///@return	true if the times were read
+///----------------------------------------------------------------------------
+bool GpuProfiler::Collect(Frame &frame, bool wait)
+{
+	if(!wait)
+	{
+		GLint available = 0;
+		glGetQueryObjectiv(frame.lastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+
+		if(!available)
+			return false;
+	}
+
+	for(int i=0; i<frame.zoneCount; i++)
+	{
+		GLuint64 start = 0, end = 0;
+		glGetQueryObjectui64v(frame.zones[i].queries[0], GL_QUERY_RESULT, &start);
+		glGetQueryObjectui64v(frame.zones[i].queries[1], GL_QUERY_RESULT, &end);
+
+		double seconds = (end > start) ? (end - start) * 1e-9 : 0.0;
+		m_GpuTimes[frame.zones[i].stage].Record(seconds);
+
+		if(frame.zones[i].stage == RS_FRAME && frame.recorder)
+			frame.recorder->SetGpuTime(frame.recorderFrame, seconds);
+	}
+
+	frame.pending = false;
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Constructor, starts timing.
+///@param	profiler - the profiler, NULL to time nothing
+///@param	stage - the stage
+///----------------------------------------------------------------------------
+GpuZone::GpuZone(GpuProfiler *profiler, RenderStage stage)
+{
+	m_Profiler	= profiler;
+	m_Zone		= profiler ? profiler->BeginZone(stage) : -1;
+}
+
+///----------------------------------------------------------------------------
+///Destructor, stops timing.
+///----------------------------------------------------------------------------
+GpuZone::~GpuZone()
+{
+	if(m_Profiler)
+		m_Profiler->EndZone(m_Zone);
+}
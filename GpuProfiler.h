@@ -0,0 +1,136 @@
+///============================================================================
+///@file	GpuProfiler.h
+///@brief	Times the stages of a frame (paper quad, model draw, swap) on the
+///			GPU with ARB_timer_query timestamps and on the CPU around the
+///			same calls. The queries of the last PROFILER_LATENCY frames are
+///			kept in flight and a frame's results are only read once they
+///			are available, so profiling never waits for the GPU. Times are
+///			aggregated per stage into histograms, and each zone is a zone
+///			of the timeline too when tracing (Tracer.h).
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef GPUPROFILER_H
+#define GPUPROFILER_H
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <string>
+
+#include "FrameRecorder.h"
+#include "GLExtensions.h"
+#include "Tracer.h"
+
+using namespace std;
+
+const int PROFILER_LATENCY	= 4;	// Frames of queries in flight
+const int PROFILER_ZONES	= 16;	// Zones per frame at most
+
+//-----------------------------------------------------------------------------
+//Stages of a frame
+//-----------------------------------------------------------------------------
+enum RenderStage
+{
+	RS_FRAME = 0,	///> the whole frame, from the first call to the swap
+	RS_PAPER,		///> background paper quad
+	RS_MODEL,		///> charcoal model draw
+	RS_SWAP,		///> buffer swap
+	RS_READBACK,	///> headless frame read back
+	RS_OVERLAY,		///> performance overlay
+	RS_COUNT
+};
+
+class GpuProfiler
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	GpuProfiler();
+	~GpuProfiler();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	bool					Init();
+	void					ShutDown();
+	void					BeginFrame(FrameRecorder *recorder = NULL);
+	void					EndFrame();
+	int						BeginZone(RenderStage stage);
+	void					EndZone(int zone);
+	void					Flush();
+	void					Clear();
+
+	bool					HasGpuTimes() const;
+	unsigned long			GetDroppedFrames() const;
+	const FrameHistogram&	GetCpuTimes(RenderStage stage) const;
+	const FrameHistogram&	GetGpuTimes(RenderStage stage) const;
+	string					GetReport() const;
+	void					WriteJSON(FILE *file) const;
+
+	static const char*		GetStageName(RenderStage stage);
+
+private:
+	//-------------------------------------------------------------------------
+	//Private types
+	//-------------------------------------------------------------------------
+	struct Zone
+	{
+		RenderStage	stage;			///> Stage timed
+		GLuint		queries[2];		///> GPU time stamps at the start & end
+	};
+
+	struct Frame
+	{
+		Zone			zones[PROFILER_ZONES];	///> Zones of the frame
+		int				zoneCount;		///> Zones begun
+		GLuint			lastQuery;		///> Query issued last, done when all are
+		bool			pending;		///> Queries issued, results not read yet
+		FrameRecorder	*recorder;		///> Gets the frame's GPU time, or NULL
+		unsigned long	recorderFrame;	///> Frame number in the recorder
+	};
+
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	bool	Collect(Frame &frame, bool wait);
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	Frame			m_Frames[PROFILER_LATENCY];	///> Ring of frames in flight
+	GLuint			*m_Queries;		///> Every query object, 2 per zone
+	int				m_Current;		///> Frame being recorded
+	bool			m_Recording;	///> Whether the current frame issues queries
+	RenderStage		m_ZoneStages[PROFILER_ZONES];	///> Stage of each zone this frame
+	double			m_ZoneStarts[PROFILER_ZONES];	///> CPU time stamp of each zone's start
+#ifdef CHARCOAL_TRACE
+	unsigned long long	m_TraceStarts[PROFILER_ZONES];	///> Trace time stamp of each zone's start
+#endif
+	int				m_ZoneCount;	///> Zones begun this frame
+	unsigned long	m_Dropped;		///> Frames not timed, the GPU was behind
+	FrameHistogram	m_CpuTimes[RS_COUNT];	///> CPU time per stage
+	FrameHistogram	m_GpuTimes[RS_COUNT];	///> GPU time per stage
+};
+
+//-----------------------------------------------------------------------------
+//Times a stage from its construction to the end of the scope
+//-----------------------------------------------------------------------------
+class GpuZone
+{
+public:
+	GpuZone(GpuProfiler *profiler, RenderStage stage);
+	~GpuZone();
+
+private:
+	GpuProfiler	*m_Profiler;	///> Profiler, NULL for none
+	int			m_Zone;			///> Zone in the profiler's frame
+};
+
+#endif
@@ -8,11 +8,21 @@
 
 #include "GraphicsApp.h"
 
+#include <string.h>
+
 ///----------------------------------------------------------------------------
 ///Initializes this GraphicsApp instance
 ///----------------------------------------------------------------------------
 bool GraphicsApp::InitInstance(HANDLE hInstance, LPCTSTR lpCmdLine, int iCmdShow)
 {
+	//keep the options around for InitGraphics()
+	m_CmdLine = lpCmdLine;
+
+	//"-ondemand" only redraws when something changed
+	m_OnDemand = (lpCmdLine && strstr(lpCmdLine, "-ondemand"));
+	m_WasIdle = false;
+	m_Dirty.SetListener(this);
+
 	if(!CreateDisplay())
 	{
 		ShutDown();
@@ -39,16 +49,32 @@ int GraphicsApp::StartApp()
 			TranslateMessage(&msg);
 			DispatchMessage(&msg);
 		}
-		else
+		else if(!m_OnDemand || m_Dirty.Peek())
 		{
 			//render the scene
 			Render();
 		}
+		else
+		{
+			//nothing changed, sleep until the next message
+			WaitMessage();
+			m_WasIdle = true;
+		}
 	}
 
 	return 0;
 }
 
+///----------------------------------------------------------------------------
+///Wakes up the message loop when the frame becomes dirty, other threads
+///(shader watcher) can't touch the window so a message is posted instead.
+///----------------------------------------------------------------------------
+void GraphicsApp::OnDirty()
+{
+	if(m_hWnd)
+		PostMessage(m_hWnd, WM_NULL, 0, 0);
+}
+
 ///----------------------------------------------------------------------------
 ///Creates the main rendering window and initializes graphics device
 ///----------------------------------------------------------------------------
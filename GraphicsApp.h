@@ -11,7 +11,9 @@
 
 #include <windows.h>
 
-class GraphicsApp
+#include "DirtyState.h"
+
+class GraphicsApp : public DirtyListener
 {
 public:
 	//-------------------------------------------------------------------------
@@ -25,6 +27,7 @@ public:
 	virtual void	RenderText(LPTSTR text);
 	virtual bool	ShutDown() = 0;
 	virtual LRESULT DisplayWndProc(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam) = 0;
+	virtual void	OnDirty();
 
 protected:
 	//-------------------------------------------------------------------------
@@ -40,6 +43,10 @@ protected:
 	USHORT	m_Width;		///> Main Window Width
 	USHORT	m_Height;		///> Main Window Height
 	HDC		m_hDC;			///> Handle to Device Context
+	LPCTSTR	m_CmdLine;		///> Command line arguments
+	DirtyState	m_Dirty;	///> What changed since the last frame
+	bool	m_OnDemand;		///> Only render when m_Dirty is set ("-ondemand")
+	bool	m_WasIdle;		///> The loop slept since the last frame
 };
 
 #endif
\ No newline at end of file
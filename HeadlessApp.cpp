@@ -0,0 +1,367 @@
+///============================================================================
+///@file	HeadlessApp.cpp
+///@brief	Headless Application Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "HeadlessApp.h"
+#include "Thread.h"
+#include "MemoryStats.h"
+#include "GLCapture.h"
+
+///----------------------------------------------------------------------------
+///Constructor.
+///@param	width - frame width
+///@param	height - frame height
+///----------------------------------------------------------------------------
+HeadlessApp::HeadlessApp(int width, int height)
+{
+	m_Width			= width;
+	m_Height		= height;
+
+	m_SpinX = 0.0f;
+	m_SpinY = 0.0f;
+	m_Zoom	= 0.0f;
+
+	m_Backend		= NULL;
+	m_Software		= NULL;
+	m_Frame			= NULL;
+	m_Recorder		= NULL;
+	m_CoreProfile	= false;
+	m_Quality		= QT_HIGH;
+	m_SteadyFrames	= 0;
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+HeadlessApp::~HeadlessApp()
+{
+	//perform clean-up
+	ShutDown();
+}
+
+///----------------------------------------------------------------------------
+///Creates the context & the offscreen framebuffer and sets up the scene
+///the same way GLApp::InitGraphics() does.
+///@param	coreProfile - use the GL 3.3 core backend instead of the legacy one
+///@param	quality - quality tier of the charcoal shader
+///@return	true if everything needed to render was created
+///----------------------------------------------------------------------------
+bool HeadlessApp::InitGraphics(bool coreProfile, QualityTier quality)
+{
+	m_CoreProfile	= coreProfile;
+	m_Quality		= quality;
+
+	if(!m_Context.Create(m_CoreProfile))
+	{
+		OutputDebugString("Could not create a headless OpenGL context.\n");
+		return false;
+	}
+
+	//the charcoal look needs GLSL, unlike the window there is no point 
+	//in rendering a batch with the fixed function fallback
+	if(!InitExtensions())
+	{
+		OutputDebugString("GLSL shaders are not supported.\n");
+		return false;
+	}
+
+	//Mesa has timer queries, llvmpipe included
+	m_Profiler.Init();
+
+	if(!m_FrameBuffer.Create(m_Width, m_Height))
+	{
+		OutputDebugString("Could not create the offscreen framebuffer.\n");
+		return false;
+	}
+
+	SetScene();
+	SetCamera();
+
+	//enable needed states
+	glEnable(GL_DEPTH_TEST);
+	glClearColor(1.0f, 1.0f, 1.0f, 0.0f);
+
+	m_Geometry.SetTextures();
+
+	//set up the render path, it sets its own GL state
+	if(m_CoreProfile)
+		m_Backend = new CoreBackend();
+	else
+		m_Backend = new LegacyBackend();
+
+	if(!m_Backend->Init(&m_Geometry))
+	{
+		OutputDebugString("Render backend failed to initialize.\n");
+		return false;
+	}
+
+	WaitForShaders();
+
+	if(!m_Overlay.Init(m_CoreProfile))
+		OutputDebugString("The performance overlay is not available.\n");
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Sets up the CPU renderer, either alone (no GL context is needed) or after
+///InitGraphics() to render every frame both ways.
+///@param	quality - quality tier of the charcoal look
+///@param	threads - number of worker threads, 0 for one per processor
+///@return	true if the renderer is ready
+///----------------------------------------------------------------------------
+bool HeadlessApp::InitSoftware(QualityTier quality, unsigned int threads)
+{
+	m_Quality = quality;
+
+	SetScene();
+
+	m_Software = new SoftwareRenderer();
+
+	if(!m_Software->Init(&m_Geometry, threads))
+	{
+		OutputDebugString("Software renderer failed to initialize.\n");
+		return false;
+	}
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Draws the scene into the framebuffer & reads it back, or with the CPU 
+///renderer if there is no GL backend.
+///@return	the frame pixels (BGRA, bottom row first), valid until the next 
+///			frame is rendered
+///----------------------------------------------------------------------------
+const unsigned char* HeadlessApp::RenderFrame()
+{
+	if(!m_Backend)
+		return RenderSoftwareFrame();
+
+	//like the window's, a warmed up frame must not touch the heap
+	AllocationGuard allocations("HeadlessApp::RenderFrame", m_SteadyFrames++ >= MEMORY_WARMUP && !GLCapture::IsCapturing());
+
+	GLStats::BeginFrame();
+	m_Profiler.BeginFrame(m_Recorder);
+	int frameZone = m_Profiler.BeginZone(RS_FRAME);
+
+	m_FrameBuffer.Bind();
+	m_Backend->Render(GetSceneState());
+
+	//the frames recorded so far, this one isn't yet
+	if(m_Overlay.IsVisible() && m_Recorder)
+	{
+		GpuZone zone(&m_Profiler, RS_OVERLAY);
+
+		m_Overlay.Begin(m_Width, m_Height);
+		m_Overlay.AddStats(*m_Recorder, &m_Profiler);
+		m_Overlay.Draw();
+	}
+
+	int readZone = m_Profiler.BeginZone(RS_READBACK);
+	m_Frame = m_FrameBuffer.ReadPixels();
+	m_Profiler.EndZone(readZone);
+
+	m_Profiler.EndZone(frameZone);
+	m_Profiler.EndFrame();
+	GLStats::EndFrame();
+
+	return m_Frame;
+}
+
+///----------------------------------------------------------------------------
+///Draws the scene with the CPU renderer.
+///@return	the frame pixels (BGRA, bottom row first), valid until the next 
+///			frame is rendered
+///----------------------------------------------------------------------------
+const unsigned char* HeadlessApp::RenderSoftwareFrame()
+{
+	if(!m_Software)
+		return NULL;
+
+	m_Frame = m_Software->Render(GetSceneState());
+
+	return m_Frame;
+}
+
+///----------------------------------------------------------------------------
+///Writes the last rendered frame to disk.
+///@param	fileName - TGA file name
+///@return	true if the file was written
+///----------------------------------------------------------------------------
+bool HeadlessApp::SaveFrame(const char *fileName) const
+{
+	return FrameBuffer::WriteTGA(fileName, m_Frame, m_Width, m_Height);
+}
+
+///----------------------------------------------------------------------------
+///Sets the model rotation for the next frames.
+///@param	spinX - rotation around Y, in degrees
+///@param	spinY - rotation around X, in degrees
+///----------------------------------------------------------------------------
+void HeadlessApp::SetSpin(GLfloat spinX, GLfloat spinY)
+{
+	m_SpinX = spinX;
+	m_SpinY = spinY;
+}
+
+///----------------------------------------------------------------------------
+///Moves the camera along z, like dragging with the left button in the window.
+///@param	zoom - offset from the start position, positive towards the model
+///----------------------------------------------------------------------------
+void HeadlessApp::SetZoom(GLfloat zoom)
+{
+	GLfloat cameraPos[3];
+
+	m_Geometry.GetCameraPosition(cameraPos);
+	cameraPos[2] += zoom - m_Zoom;
+	m_Geometry.SetCameraPosition(cameraPos);
+
+	m_Zoom = zoom;
+	SetCamera();
+}
+
+///----------------------------------------------------------------------------
+///Sets the recorder that gets the GPU time of each frame, once known.
+///@param	recorder - the recorder, NULL for none
+///----------------------------------------------------------------------------
+void HeadlessApp::SetRecorder(FrameRecorder *recorder)
+{
+	m_Recorder = recorder;
+}
+
+///----------------------------------------------------------------------------
+///Shows the performance overlay over the GL frames, it needs a recorder.
+///@param	visible - true to draw it
+///----------------------------------------------------------------------------
+void HeadlessApp::SetOverlay(bool visible)
+{
+	m_Overlay.SetVisible(visible);
+}
+
+///----------------------------------------------------------------------------
+///Gets the profiler timing the stages of the GL frames.
+///@return	the profiler
+///----------------------------------------------------------------------------
+GpuProfiler& HeadlessApp::GetProfiler()
+{
+	return m_Profiler;
+}
+
+///----------------------------------------------------------------------------
+///Gets what the GL backend submitted for the last frame.
+///@param	stats - receives the draw call & triangle counts
+///@return	false if the frames are drawn by the CPU renderer
+///----------------------------------------------------------------------------
+bool HeadlessApp::GetDrawStats(DrawStats &stats) const
+{
+	if(!m_Backend)
+		return false;
+
+	stats = m_Backend->GetDrawStats();
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Gets the scene geometry.
+///@return	the model, camera & light
+///----------------------------------------------------------------------------
+const Geometry& HeadlessApp::GetGeometry() const
+{
+	return m_Geometry;
+}
+
+///----------------------------------------------------------------------------
+///Clean up resources.
+///----------------------------------------------------------------------------
+bool HeadlessApp::ShutDown()
+{
+	if(m_Software)
+	{
+		m_Software->ShutDown();
+		delete m_Software;
+		m_Software = NULL;
+	}
+
+	if(m_Backend)
+	{
+		m_Backend->ShutDown();
+		delete m_Backend;
+		m_Backend = NULL;
+	}
+
+	m_Profiler.ShutDown();
+	m_Overlay.ShutDown();
+	m_Geometry.ReleaseTextures();
+	m_FrameBuffer.Release();
+	m_Context.Destroy();
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Sets the light & camera positions, the same ones GLApp uses.
+///----------------------------------------------------------------------------
+void HeadlessApp::SetScene()
+{
+	GLfloat lightPos[3] = {50.0, 90.0, 50.0};
+	m_Geometry.SetLightPosition(lightPos);
+
+	GLfloat cameraPos[3] = {5.0, 15.0, -85.0};
+	m_Geometry.SetCameraPosition(cameraPos);
+}
+
+///----------------------------------------------------------------------------
+///Computes the camera matrices for the legacy backend, the same ones
+///GLApp::Reshape() & GLApp::Zoom() compute for the window.
+///----------------------------------------------------------------------------
+void HeadlessApp::SetCamera()
+{
+	RenderBackend::ComputeProjection(m_Width, m_Height, m_CameraProjectionMatrix);
+	RenderBackend::ComputeView(&m_Geometry, m_CameraViewMatrix);
+}
+
+///----------------------------------------------------------------------------
+///Gathers the state of the next frame.
+///@return	the scene state handed to the renderers
+///----------------------------------------------------------------------------
+SceneState HeadlessApp::GetSceneState()
+{
+	SceneState scene;
+	scene.spinX			= m_SpinX;
+	scene.spinY			= m_SpinY;
+	scene.width			= m_Width;
+	scene.height		= m_Height;
+	scene.quality		= m_Quality;
+	scene.projection	= m_CameraProjectionMatrix;
+	scene.view			= m_CameraViewMatrix;
+	scene.profiler		= &m_Profiler;
+
+	return scene;
+}
+
+///----------------------------------------------------------------------------
+///Waits for the variant of the requested tier to finish compiling, so 
+///every frame of the batch is rendered with it and none with the fallback.
+///----------------------------------------------------------------------------
+void HeadlessApp::WaitForShaders()
+{
+	ShaderPermutation &shaders = m_Backend->GetShaders();
+	unsigned int features = ShaderPermutation::GetTierFeatures(m_Quality);
+
+	do
+	{
+		if(shaders.Acquire(features) && shaders.GetCurrentFeatures() == features)
+			return;
+
+		Thread::Sleep(1);
+	}
+	while(shaders.IsPending());
+
+	OutputDebugString("Charcoal shader failed to build, using the fallback.\n");
+}
@@ -0,0 +1,87 @@
+///============================================================================
+///@file	HeadlessApp.h
+///@brief	Batch renderer for machines without a display or GPU. Runs the
+///			same Geometry & render backends as GLApp in a headless context,
+///			drawing into a framebuffer object of any size and reading each
+///			frame back to memory or to disk. The SoftwareRenderer can draw
+///			the frames instead, or next to the GL to compare both.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef HEADLESSAPP_H
+#define HEADLESSAPP_H
+
+#include "HeadlessContext.h"
+#include "FrameBuffer.h"
+#include "Geometry.h"
+#include "ShaderPermutation.h"
+#include "LegacyBackend.h"
+#include "CoreBackend.h"
+#include "SoftwareRenderer.h"
+#include "GpuProfiler.h"
+#include "FrameRecorder.h"
+#include "PerfOverlay.h"
+#include "GLExtensions.h"
+
+class HeadlessApp
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	HeadlessApp(int width, int height);
+	~HeadlessApp();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	bool					InitGraphics(bool coreProfile, QualityTier quality);
+	bool					InitSoftware(QualityTier quality, unsigned int threads = 0);
+	const unsigned char*	RenderFrame();
+	const unsigned char*	RenderSoftwareFrame();
+	bool					SaveFrame(const char *fileName) const;
+	void					SetSpin(GLfloat spinX, GLfloat spinY);
+	void					SetZoom(GLfloat zoom);
+	void					SetRecorder(FrameRecorder *recorder);
+	void					SetOverlay(bool visible);
+	GpuProfiler&			GetProfiler();
+	bool					GetDrawStats(DrawStats &stats) const;
+	const Geometry&			GetGeometry() const;
+	bool					ShutDown();
+
+private:
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	void SetScene();
+	void SetCamera();
+	SceneState GetSceneState();
+	void WaitForShaders();
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	HeadlessContext		m_Context;			///> Windowless GL context
+	FrameBuffer			m_FrameBuffer;		///> Offscreen render target
+	Geometry			m_Geometry;			///> Used to draw all the geometry in the scene
+	RenderBackend		*m_Backend;			///> Legacy or core profile render path
+	SoftwareRenderer	*m_Software;		///> CPU render path
+	GpuProfiler			m_Profiler;			///> CPU & GPU time of each stage
+	FrameRecorder		*m_Recorder;		///> Gets the GPU frame times, or NULL
+	PerfOverlay			m_Overlay;			///> Performance overlay drawn over the frames
+	const unsigned char	*m_Frame;			///> Last frame rendered
+	bool				m_CoreProfile;		///> Whether a GL 3.3 core context is in use
+	QualityTier			m_Quality;			///> Quality tier used to select the variant
+	int					m_Width;			///> Frame width
+	int					m_Height;			///> Frame height
+	GLfloat				m_CameraProjectionMatrix[16];	///> Camera projection matrix
+	GLfloat				m_CameraViewMatrix[16];	///> Camera model-view matrix
+	GLfloat				m_SpinX;
+	GLfloat				m_SpinY;
+	GLfloat				m_Zoom;				///> Camera offset along z from its start
+	unsigned long		m_SteadyFrames;		///> GL frames rendered since the shaders were built
+};
+
+#endif
@@ -0,0 +1,173 @@
+///============================================================================
+///@file	HeadlessContext.cpp
+///@brief	Headless Context Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "HeadlessContext.h"
+
+#include <string.h>
+
+///----------------------------------------------------------------------------
+///Checks whether an extension is in an EGL extension string.
+///@param	extensions - space separated extension list (may be NULL)
+///@param	name - the extension name
+///@return	true if the extension is listed
+///----------------------------------------------------------------------------
+static bool HasExtension(const char *extensions, const char *name)
+{
+	size_t length = strlen(name);
+
+	for(const char *start = extensions; start && (start = strstr(start, name)); start += length)
+		if((start == extensions || start[-1] == ' ') && (start[length] == ' ' || start[length] == '\0'))
+			return true;
+
+	return false;
+}
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+HeadlessContext::HeadlessContext()
+{
+	m_Display	= EGL_NO_DISPLAY;
+	m_Context	= EGL_NO_CONTEXT;
+	m_Surface	= EGL_NO_SURFACE;
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+HeadlessContext::~HeadlessContext()
+{
+	Destroy();
+}
+
+///----------------------------------------------------------------------------
+///Creates the context and makes it current on the calling thread.
+///@param	coreProfile - true for a GL 3.3 core profile, false for a 
+///			compatibility context the legacy backend can use
+///@return	true if the context is current
+///----------------------------------------------------------------------------
+bool HeadlessContext::Create(bool coreProfile)
+{
+	EGLConfig config;
+	EGLint count = 0;
+
+	Destroy();
+
+	m_Display = GetDisplay();
+	if(m_Display == EGL_NO_DISPLAY || !eglInitialize(m_Display, NULL, NULL))
+	{
+		m_Display = EGL_NO_DISPLAY;
+		return false;
+	}
+
+	//without surfaceless support a tiny pbuffer is made current instead,
+	//the frames are rendered into a framebuffer object anyway
+	bool surfaceless = HasExtension(eglQueryString(m_Display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+
+	EGLint configAttribs[] = 
+	{
+		EGL_RENDERABLE_TYPE,	EGL_OPENGL_BIT,
+		EGL_SURFACE_TYPE,		surfaceless ? 0 : EGL_PBUFFER_BIT,
+		EGL_NONE
+	};
+
+	if(!eglBindAPI(EGL_OPENGL_API) || 
+	   !eglChooseConfig(m_Display, configAttribs, &config, 1, &count) || count == 0)
+	{
+		Destroy();
+		return false;
+	}
+
+	EGLint coreAttribs[] = 
+	{
+		EGL_CONTEXT_MAJOR_VERSION_KHR,			3,
+		EGL_CONTEXT_MINOR_VERSION_KHR,			3,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR,	EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+		EGL_NONE
+	};
+
+	//the default context is a compatibility one
+	EGLint legacyAttribs[] = {EGL_NONE};
+
+	m_Context = eglCreateContext(m_Display, config, EGL_NO_CONTEXT, coreProfile ? coreAttribs : legacyAttribs);
+	if(m_Context == EGL_NO_CONTEXT)
+	{
+		Destroy();
+		return false;
+	}
+
+	if(!surfaceless)
+	{
+		EGLint pbufferAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+
+		m_Surface = eglCreatePbufferSurface(m_Display, config, pbufferAttribs);
+		if(m_Surface == EGL_NO_SURFACE)
+		{
+			Destroy();
+			return false;
+		}
+	}
+
+	if(!eglMakeCurrent(m_Display, m_Surface, m_Surface, m_Context))
+	{
+		Destroy();
+		return false;
+	}
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Releases the context & the display connection.
+///----------------------------------------------------------------------------
+void HeadlessContext::Destroy()
+{
+	if(m_Display == EGL_NO_DISPLAY)
+		return;
+
+	eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+	if(m_Surface != EGL_NO_SURFACE)
+		eglDestroySurface(m_Display, m_Surface);
+
+	if(m_Context != EGL_NO_CONTEXT)
+		eglDestroyContext(m_Display, m_Context);
+
+	eglTerminate(m_Display);
+
+	m_Display	= EGL_NO_DISPLAY;
+	m_Context	= EGL_NO_CONTEXT;
+	m_Surface	= EGL_NO_SURFACE;
+}
+
+///----------------------------------------------------------------------------
+///Gets a display that doesn't need a window system. Mesa's surfaceless
+///platform is preferred, otherwise the default display is used, which 
+///also works without X on drivers exposing EGL devices.
+///@return	the display, EGL_NO_DISPLAY if none is available
+///----------------------------------------------------------------------------
+EGLDisplay HeadlessContext::GetDisplay() const
+{
+	const char *clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+	if(HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless") && 
+	   HasExtension(clientExtensions, "EGL_EXT_platform_base"))
+	{
+		PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplay = 
+			(PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+		if(eglGetPlatformDisplay)
+		{
+			EGLDisplay display = eglGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+			if(display != EGL_NO_DISPLAY)
+				return display;
+		}
+	}
+
+	return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
@@ -0,0 +1,46 @@
+///============================================================================
+///@file	HeadlessContext.h
+///@brief	OpenGL context without a window or display server, created with
+///			EGL (i.e. Mesa llvmpipe on a render server). Nothing is drawn
+///			to the default framebuffer, render into a FrameBuffer instead.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef HEADLESSCONTEXT_H
+#define HEADLESSCONTEXT_H
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+class HeadlessContext
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	HeadlessContext();
+	~HeadlessContext();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	bool Create(bool coreProfile);
+	void Destroy();
+
+private:
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	EGLDisplay GetDisplay() const;
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	EGLDisplay	m_Display;	///> EGL display connection
+	EGLContext	m_Context;	///> OpenGL rendering context
+	EGLSurface	m_Surface;	///> 1x1 pbuffer, only if surfaceless contexts aren't supported
+};
+
+#endif
@@ -0,0 +1,500 @@
+///============================================================================
+///@file	HeadlessMain.cpp
+///@brief	Charcoal Rendering, headless batch renderer.
+///			Renders a turntable of the charcoal model without a window,
+///			i.e. on a Linux server with Mesa's llvmpipe software renderer.
+///
+///			usage: CharcoalHeadless [-size WxH] [-frames N] [-spin degrees]
+///					[-quality low|medium|high] [-legacy] [-software] [-compare]
+///					[-threads N] [-fps N] [-hud] [-stats file.json|file.csv]
+///					[-benchmark report.json] [-warmup N] [-trace trace.json]
+///					[-profile stacks.folded] [-budget draws=N,binds=N...]
+///					[-capture frames.gltrace] [-out frame%04d.tga]
+///
+///			Without -out the frames are only read back to memory. -software
+///			renders on the CPU without a GL context, -compare renders every
+///			frame with both the core backend & the CPU and fails if they
+///			differ by more than the tolerance below. -threads sets the CPU
+///			renderer's worker count, one per processor by default. -fps
+///			caps the frame rate like the window does & reports the pacing.
+///			-stats writes the frame time percentiles & the last frames as
+///			JSON, or the frames as CSV if the file name ends in .csv.
+///			The time of each stage on the CPU & GPU is printed at the end,
+///			-hud draws the performance overlay over the GL frames, it
+///			can't be combined with -compare (the CPU frames have none).
+///			-benchmark renders -warmup frames (60 by default) and then
+///			-frames measured ones (600 by default) along the scripted path
+///			of Benchmark.h, uncapped, and writes the report.
+///			Where the host has hardware counters, the IPC & misses of the
+///			start up and per vertex & pixel of the frames are printed too.
+///			-trace writes the timeline of the zones of every thread as a
+///			Chrome trace, in debug builds & those with CHARCOAL_TRACE.
+///			-profile samples the stacks of the process & writes them folded
+///			for flamegraph.pl, see SamplingProfiler.h.
+///			In the builds with GLStats the GL calls per frame are printed,
+///			-budget fails the run if a frame makes more calls of a category
+///			than its budget (i.e. "draws=4,perf_warnings=0"), and -capture
+///			records the GL calls of the frames for GLReplay, see GLCapture.h.
+///			In the builds with MemoryStats the live memory & high-water
+///			marks of each subsystem are printed, and a frame after the
+///			warm up that allocates from the heap asserts.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+#include "HeadlessApp.h"
+#include "FramePacer.h"
+#include "FrameRecorder.h"
+#include "Benchmark.h"
+#include "PerfCounters.h"
+#include "Tracer.h"
+#include "SamplingProfiler.h"
+#include "GLCapture.h"
+#include "MemoryStats.h"
+
+const double COMPARE_MEAN_ERROR	= 1.0;	// Mean absolute difference per channel
+const int COMPARE_THRESHOLD		= 32;	// Pixels off by more count as outliers
+const double COMPARE_OUTLIERS	= 1.0;	// Percentage of outliers allowed
+
+///----------------------------------------------------------------------------
+///Compares two frames.
+///@param	a, b - BGRA frames of the same size
+///@param	count - number of pixels
+///@param	meanError - receives the mean absolute difference of the color channels
+///@param	maxError - receives the largest difference
+///@param	outliers - receives the percentage of pixels off by more than
+///			COMPARE_THRESHOLD in any channel
+///----------------------------------------------------------------------------
+static void CompareFrames(const unsigned char *a, const unsigned char *b, int count,
+						  double &meanError, int &maxError, double &outliers)
+{
+	double total = 0.0;
+	int outlierCount = 0;
+
+	maxError = 0;
+
+	for(int i=0; i<count; i++)
+	{
+		int pixelError = 0;
+
+		//alpha is not displayed
+		for(int c=0; c<3; c++)
+		{
+			int error = abs((int)a[i*4 + c] - (int)b[i*4 + c]);
+
+			total += error;
+			if(error > pixelError)
+				pixelError = error;
+		}
+
+		if(pixelError > maxError)
+			maxError = pixelError;
+
+		if(pixelError > COMPARE_THRESHOLD)
+			outlierCount++;
+	}
+
+	meanError	= total / (count * 3.0);
+	outliers	= 100.0 * outlierCount / count;
+}
+
+///----------------------------------------------------------------------------
+///Prints the IPC & the counts of a zone per item.
+///@param	zone - name of the zone
+///@param	values - its counts
+///@param	counters - tells which counters are open
+///@param	items - items processed, 0 to print the totals
+///@param	unit - what the items are
+///----------------------------------------------------------------------------
+static void PrintCounters(const char *zone, const CounterValues &values, const PerfCounters &counters,
+						  double items, const char *unit)
+{
+	printf("%s counters:", zone);
+
+	if(counters.IsCounting(PC_CYCLES) && counters.IsCounting(PC_INSTRUCTIONS) && values.counts[PC_CYCLES] > 0.0)
+		printf(" IPC %.2f,", values.counts[PC_INSTRUCTIONS] / values.counts[PC_CYCLES]);
+
+	for(int i=0; i<PC_COUNT; i++)
+	{
+		if(!counters.IsCounting((CounterType)i))
+			continue;
+
+		if(items > 0.0)
+			printf(" %.3f %s", values.counts[i] / items, PerfCounters::GetCounterName((CounterType)i));
+		else
+			printf(" %.0f %s", values.counts[i], PerfCounters::GetCounterName((CounterType)i));
+	}
+
+	printf(items > 0.0 ? " per %s\n" : "\n", unit);
+}
+
+int main(int argc, char *argv[])
+{
+	int width		= 512;
+	int height		= 512;
+	int frames		= 0;
+	int warmup		= BENCHMARK_WARMUP;
+	float spin		= 0.0f;
+	bool core		= true;
+	bool software	= false;
+	bool compare	= false;
+	int threads		= 0;
+	float fps		= 0.0f;
+	const char *out	= NULL;
+	const char *stats = NULL;
+	const char *report = NULL;
+	const char *trace = NULL;
+	const char *profile = NULL;
+	const char *budgets = NULL;
+	const char *capture = NULL;
+	bool hud		= false;
+	QualityTier quality = QT_HIGH;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-size") && i+1 < argc)
+			sscanf(argv[++i], "%dx%d", &width, &height);
+		else if(!strcmp(argv[i], "-frames") && i+1 < argc)
+			frames = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-spin") && i+1 < argc)
+			spin = (float)atof(argv[++i]);
+		else if(!strcmp(argv[i], "-out") && i+1 < argc)
+			out = argv[++i];
+		else if(!strcmp(argv[i], "-legacy"))
+			core = false;
+		else if(!strcmp(argv[i], "-software"))
+			software = true;
+		else if(!strcmp(argv[i], "-compare"))
+			compare = true;
+		else if(!strcmp(argv[i], "-threads") && i+1 < argc)
+			threads = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-fps") && i+1 < argc)
+			fps = (float)atof(argv[++i]);
+		else if(!strcmp(argv[i], "-hud"))
+			hud = true;
+		else if(!strcmp(argv[i], "-stats") && i+1 < argc)
+			stats = argv[++i];
+		else if(!strcmp(argv[i], "-benchmark") && i+1 < argc)
+			report = argv[++i];
+		else if(!strcmp(argv[i], "-warmup") && i+1 < argc)
+			warmup = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-trace") && i+1 < argc)
+			trace = argv[++i];
+		else if(!strcmp(argv[i], "-profile") && i+1 < argc)
+			profile = argv[++i];
+		else if(!strcmp(argv[i], "-budget") && i+1 < argc)
+			budgets = argv[++i];
+		else if(!strcmp(argv[i], "-capture") && i+1 < argc)
+			capture = argv[++i];
+		else if(!strcmp(argv[i], "-quality") && i+1 < argc)
+		{
+			i++;
+			if(!strcmp(argv[i], "low"))		quality = QT_LOW;
+			if(!strcmp(argv[i], "medium"))	quality = QT_MEDIUM;
+			if(!strcmp(argv[i], "high"))	quality = QT_HIGH;
+		}
+		else
+		{
+			fprintf(stderr, "usage: %s [-size WxH] [-frames N] [-spin degrees] "
+							"[-quality low|medium|high] [-legacy] [-software] [-compare] "
+							"[-threads N] [-fps N] [-hud] [-stats file.json|file.csv] "
+							"[-benchmark report.json] [-warmup N] [-trace trace.json] "
+							"[-profile stacks.folded] [-budget draws=N,binds=N...] "
+							"[-capture frames.gltrace] [-out frame%%04d.tga]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if(frames <= 0)
+		frames = report ? BENCHMARK_FRAMES : 1;
+
+	//the overlay is drawn into the GL frames only, they would never match
+	if(hud && compare)
+	{
+		fprintf(stderr, "-hud can't be used with -compare, the CPU frames have no overlay.\n");
+		return 1;
+	}
+
+	if(budgets && !GLStats::SetBudgets(budgets))
+	{
+		fprintf(stderr, "Bad -budget %s, the categories are", budgets);
+		for(int i=0; i<GS_COUNT; i++)
+			fprintf(stderr, " %s", GLStats::GetCategoryName((GLStatCategory)i));
+		fprintf(stderr, "\n");
+		return 1;
+	}
+
+	//the warm up frames are rendered before the measured ones
+	Benchmark benchmark;
+	int total = frames;
+
+	if(report)
+	{
+		benchmark.SetConfig(software ? "software" : (core || compare ? "core" : "legacy"), quality, width, height);
+		total += (warmup > 0) ? warmup : 0;
+	}
+
+	//the file is completed at exit
+	if(trace && !Tracer::Start(trace))
+	{
+		fprintf(stderr, Tracer::IsCompiledIn() ? "Could not write %s\n" :
+				"Built without CHARCOAL_TRACE, %s is not written.\n", trace);
+	}
+
+	TRACE_THREAD("main");
+
+	//also written at exit
+	if(profile && !SamplingProfiler::Start(profile))
+		fprintf(stderr, "Could not start the sampling profiler, %s is not written.\n", profile);
+
+	//opened first, the render threads started from here on are counted too
+	PerfCounters counters;
+	CounterValues loadStart, loadEnd;
+
+	counters.Open();
+	counters.Read(loadStart);
+
+	HeadlessApp app(width, height);
+
+	//before InitGraphics(), the frames use the objects it creates
+	if(capture && !software)
+	{
+		if(!GLStats::IsCompiledIn())
+			fprintf(stderr, "Built without CHARCOAL_GLSTATS, %s is not written.\n", capture);
+		else if(!GLCapture::Start(capture, total, width, height, core || compare))
+			fprintf(stderr, "Could not write %s\n", capture);
+	}
+
+	//the CPU renderer matches the core backend's shaders
+	if(!software && !app.InitGraphics(core || compare, quality))
+		return 1;
+
+	if((software || compare) && !app.InitSoftware(quality, threads > 0 ? threads : 0))
+		return 1;
+
+	counters.Read(loadEnd);
+
+	if(report && !software)
+		benchmark.ReadDriverInfo();
+
+	if(report)
+		benchmark.SetLoadCounters(&counters, loadStart, loadEnd);
+
+	FramePacer pacer;
+	pacer.SetTargetRate(fps);
+
+	FrameRecorder recorder(frames);
+	recorder.SetBudget(fps > 0.0f ? 1.0 / fps : 0.0);
+	app.SetRecorder(&recorder);
+	app.SetOverlay(hud);
+
+	if(report)
+		benchmark.Start(warmup, frames);
+
+	double start = FramePacer::GetTime();
+	clock_t cpuStart = clock();
+	double softwareTime = 0.0;
+	bool passed = true;
+
+	CounterValues frameCounts;
+	PerfCounters::Clear(frameCounts);
+	double countedVertices = 0.0;
+
+	double frameStart = start;
+
+	for(int frame=0; frame<total; frame++)
+	{
+		//a benchmark measures how fast the frames can go, uncapped
+		if(!report)
+			pacer.Wait();
+
+		//the first frame's time is from the start of the loop
+		double now = FramePacer::GetTime();
+		double frameTime = now - frameStart;
+		frameStart = now;
+
+		//turntable around the vertical axis, or the benchmark's path
+		if(report)
+		{
+			CameraPose pose;
+			benchmark.GetPose(pose);
+
+			app.SetSpin(pose.spinX, pose.spinY);
+			app.SetZoom(pose.zoom);
+		}
+		else
+		{
+			app.SetSpin(frame * spin, 0.0f);
+		}
+
+		CounterValues renderStart, renderEnd;
+		counters.Read(renderStart);
+
+		const unsigned char *pixels = app.RenderFrame();
+		if(!pixels)
+			return 1;
+
+		counters.Read(renderEnd);
+
+		//the read back waits for the GPU, so this is CPU & GPU time
+		recorder.Record(frameTime, FramePacer::GetTime() - now);
+
+		//the CPU renderer transforms every vertex of the model's triangles
+		DrawStats draws;
+		bool drawn = app.GetDrawStats(draws);
+		double vertices = 3.0 * (drawn ? draws.triangles : app.GetGeometry().GetModel()->getNumTriangles());
+
+		PerfCounters::Accumulate(frameCounts, renderStart, renderEnd);
+		countedVertices += vertices;
+
+		if(report)
+		{
+			if(drawn)
+				benchmark.AddDrawStats(draws);
+
+			benchmark.AddCounters(renderStart, renderEnd, vertices);
+
+			//the warm up's GPU times still in flight are dropped too
+			if(benchmark.NextFrame())
+			{
+				app.GetProfiler().Flush();
+				app.GetProfiler().Clear();
+				recorder.Clear();
+				PerfCounters::Clear(frameCounts);
+				GLStats::Clear();
+				countedVertices = 0.0;
+
+				//frameStart keeps running, the next frame's time is a whole one
+				start = FramePacer::GetTime();
+				cpuStart = clock();
+				softwareTime = 0.0;
+			}
+		}
+
+		if(compare)
+		{
+			double meanError, outliers;
+			int maxError;
+
+			//the GL frame is overwritten by the next one only
+			vector<unsigned char> glFrame(pixels, pixels + width * height * 4);
+
+			double softwareStart = FramePacer::GetTime();
+			const unsigned char *cpuPixels = app.RenderSoftwareFrame();
+			softwareTime += FramePacer::GetTime() - softwareStart;
+
+			if(!cpuPixels)
+				return 1;
+
+			CompareFrames(&glFrame[0], cpuPixels, width * height, meanError, maxError, outliers);
+
+			bool ok = (meanError <= COMPARE_MEAN_ERROR && outliers <= COMPARE_OUTLIERS);
+			passed = passed && ok;
+
+			printf("frame %d: mean error %.3f, max error %d, %.3f%% outliers%s\n",
+				   frame, meanError, maxError, outliers, ok ? "" : " FAILED");
+		}
+
+		if(out)
+		{
+			char fileName[1024];
+			snprintf(fileName, sizeof(fileName), out, frame);
+
+			if(!app.SaveFrame(fileName))
+			{
+				fprintf(stderr, "Could not write %s\n", fileName);
+				return 1;
+			}
+		}
+	}
+
+	double elapsed = FramePacer::GetTime() - start;
+	double cpuTime = (double)(clock() - cpuStart) / CLOCKS_PER_SEC;
+
+	//the GPU times of the last frames are still in flight
+	app.GetProfiler().Flush();
+
+	printf("%d frames of %dx%d in %.3f s (%.1f FPS)\n", 
+		   frames, width, height, elapsed, elapsed > 0.0 ? frames / elapsed : 0.0);
+
+	const FrameHistogram &renderTimes = recorder.GetCpuTimes();
+	printf("render time: p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms, %lu stutters\n",
+		   renderTimes.GetPercentile(50.0) * 1000.0, renderTimes.GetPercentile(90.0) * 1000.0,
+		   renderTimes.GetPercentile(99.0) * 1000.0, renderTimes.GetMax() * 1000.0, 
+		   recorder.GetStutterCount());
+
+	if(!software)
+		printf("%s%s", app.GetProfiler().GetReport().c_str(), GLStats::GetReport().c_str());
+
+	printf("%s", MemoryStats::GetReport().c_str());
+
+	//a budget that can't be checked fails too, rather than passing unseen
+	if(budgets && !GLStats::IsCompiledIn())
+	{
+		fprintf(stderr, "Built without CHARCOAL_GLSTATS, the GL call budgets can't be checked.\n");
+		passed = false;
+	}
+	else if(!GLStats::IsWithinBudgets())
+	{
+		fprintf(stderr, "Frames went over the GL call budgets.\n");
+		passed = false;
+	}
+
+	if(counters.IsAvailable())
+	{
+		CounterValues load;
+		PerfCounters::Clear(load);
+		PerfCounters::Accumulate(load, loadStart, loadEnd);
+
+		PrintCounters("start up", load, counters, 0.0, "");
+		PrintCounters("frame", frameCounts, counters, countedVertices, "vertex");
+		PrintCounters("frame", frameCounts, counters, (double)frames * width * height, "pixel");
+	}
+	else
+	{
+		printf("no hardware counters (%s)\n", counters.GetError().c_str());
+	}
+
+	if(report && !benchmark.WriteReport(report, recorder, software ? NULL : &app.GetProfiler()))
+	{
+		fprintf(stderr, "Could not write %s\n", report);
+		return 1;
+	}
+
+	if(stats)
+	{
+		size_t length = strlen(stats);
+		bool csv = (length > 4 && !strcmp(stats + length - 4, ".csv"));
+
+		if(!(csv ? recorder.ExportCSV(stats) : recorder.ExportJSON(stats)))
+		{
+			fprintf(stderr, "Could not write %s\n", stats);
+			return 1;
+		}
+	}
+
+	if(fps > 0.0f && !report)
+	{
+		PacingStats pacing;
+		pacer.GetStats(pacing);
+
+		printf("pacing at %.1f FPS: error mean %.3f ms max %.3f ms, %lu missed, %.1f%% CPU\n",
+			   fps, pacing.meanError * 1000.0, pacing.maxError * 1000.0, pacing.missed,
+			   elapsed > 0.0 ? 100.0 * cpuTime / elapsed : 0.0);
+	}
+
+	if(compare)
+	{
+		printf("CPU renderer: %.3f s (%.1f FPS)\n", 
+			   softwareTime, softwareTime > 0.0 ? frames / softwareTime : 0.0);
+	}
+
+	return passed ? 0 : 1;
+}
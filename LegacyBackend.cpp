@@ -0,0 +1,134 @@
+///============================================================================
+///@file	LegacyBackend.cpp
+///@brief	Legacy Backend Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "LegacyBackend.h"
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+LegacyBackend::LegacyBackend()
+	: RenderBackend("CharcoalRendering.vert", "CharcoalRendering.frag")
+{
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+LegacyBackend::~LegacyBackend()
+{
+	ShutDown();
+}
+
+///----------------------------------------------------------------------------
+///Sets the fixed function lights & materials and loads the shaders.
+///@param	geometry - the scene geometry, textures already created
+///@return	true if the shader sources were found
+///----------------------------------------------------------------------------
+bool LegacyBackend::Init(Geometry *geometry)
+{
+	GLfloat lightPos[3];
+
+	m_Geometry = geometry;
+
+	//set lights & materials
+	m_Geometry->GetLightPosition(lightPos);
+	m_Geometry->SetLights(lightPos);
+	m_Geometry->SetMaterials();
+
+	glEnable(GL_TEXTURE_2D);
+
+	return InitShaders();
+}
+
+///----------------------------------------------------------------------------
+///Draws the scene.
+///@param	scene - the frame state
+///----------------------------------------------------------------------------
+void LegacyBackend::Render(const SceneState &scene)
+{
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	glViewport(0,0, scene.width, scene.height);
+
+	//the paper quad, then a glBegin/glEnd per group of the model
+	const Model *model = m_Geometry->GetModel();
+	m_Stats.drawCalls	= 1 + model->getNumMeshes();
+	m_Stats.triangles	= 2 + model->getNumTriangles();
+
+	//draw the background paper texture
+	{
+		GpuZone zone(scene.profiler, RS_PAPER);
+
+		//unit 0 is left active, but the overlay may have bound its atlas
+		glBindTexture(GL_TEXTURE_2D, m_Geometry->GetTexObj(0));
+
+		glMatrixMode( GL_PROJECTION );
+		glLoadIdentity();
+		gluOrtho2D( -1.0, 1.0, -1.0, 1.0 );
+
+		glMatrixMode( GL_MODELVIEW );
+		glLoadIdentity();
+
+		glBegin(GL_QUADS);
+		{
+			glTexCoord2f( 0.0f, 0.0f );
+			glVertex3f( -1.0f, -1.0f, 0.0f );
+
+			glTexCoord2f( 0.0f, 1.0f );
+			glVertex3f( -1.0f, 1.0f, 0.0f );
+
+			glTexCoord2f( 1.0f, 1.0f );
+			glVertex3f( 1.0f, 1.0f, 0.0f );
+
+			glTexCoord2f( 1.0f, 0.0f );
+			glVertex3f( 1.0f, -1.0f, 0.0f );
+		}
+		glEnd();
+	}
+
+	//clear depth buffer in order to render 3d model
+	glClear(GL_DEPTH_BUFFER_BIT);
+
+	//load view & projection matrices
+	glMatrixMode(GL_PROJECTION);
+	glLoadMatrixf(scene.projection);
+
+	glMatrixMode(GL_MODELVIEW);
+	glLoadMatrixf(scene.view);
+
+	//get the variant for the current tier with its textures bound
+	GpuZone zone(scene.profiler, RS_MODEL);
+	ShaderProgram *shader = BindShader(scene.quality);
+
+	if(shader)
+	{
+		//enable programmable pipeline
+		shader->EnableShader();
+		
+		//set uniform variables
+		SetSamplers(shader);
+
+		//and draw the model...
+		m_Geometry->Draw(scene.spinX, scene.spinY);
+
+		//disable programmable pipeline
+		shader->DisableShader();
+	}
+	else
+	{
+		//no variant has been built yet, fall back to fixed function lighting
+		m_Geometry->Draw(scene.spinX, scene.spinY);
+	}
+}
+
+///----------------------------------------------------------------------------
+///Destroys the shader programs, the context must still be current.
+///----------------------------------------------------------------------------
+void LegacyBackend::ShutDown()
+{
+	m_Shaders.Clear();
+}
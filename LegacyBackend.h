@@ -0,0 +1,32 @@
+///============================================================================
+///@file	LegacyBackend.h
+///@brief	Original render path: fixed function pipeline, immediate mode
+///			drawing & GLSL 1.10 shaders reading the built-in GL state.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef LEGACYBACKEND_H
+#define LEGACYBACKEND_H
+
+#include "RenderBackend.h"
+
+class LegacyBackend : public RenderBackend
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	LegacyBackend();
+	virtual ~LegacyBackend();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	virtual bool	Init(Geometry *geometry);
+	virtual void	Render(const SceneState &scene);
+	virtual void	ShutDown();
+};
+
+#endif
@@ -0,0 +1,170 @@
+///============================================================================
+///@file	MatrixMath.cpp
+///@brief	Matrix Helpers Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "MatrixMath.h"
+
+#include <string.h>
+#include <xmmintrin.h>
+
+///----------------------------------------------------------------------------
+///Builds an identity matrix.
+///@param	m - receives the column-major matrix
+///----------------------------------------------------------------------------
+void IdentityMatrix(GLfloat *m)
+{
+	memset(m, 0, 16 * sizeof(GLfloat));
+	m[0] = m[5] = m[10] = m[15] = 1.0f;
+}
+
+///----------------------------------------------------------------------------
+///Multiplies two column-major 4x4 matrices.
+///@param	a - left matrix
+///@param	b - right matrix
+///@param	result - receives a * b (must not alias a or b)
+///----------------------------------------------------------------------------
+void MultiplyMatrix(const GLfloat *a, const GLfloat *b, GLfloat *result)
+{
+	__m128 a0 = _mm_loadu_ps(a);
+	__m128 a1 = _mm_loadu_ps(a + 4);
+	__m128 a2 = _mm_loadu_ps(a + 8);
+	__m128 a3 = _mm_loadu_ps(a + 12);
+
+	//each column of the result is a mix of a's columns
+	for(int col=0; col<4; col++)
+	{
+		const GLfloat *bc = b + col*4;
+		__m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+						_mm_mul_ps(a0, _mm_set1_ps(bc[0])),
+						_mm_mul_ps(a1, _mm_set1_ps(bc[1]))),
+						_mm_mul_ps(a2, _mm_set1_ps(bc[2]))),
+						_mm_mul_ps(a3, _mm_set1_ps(bc[3])));
+
+		_mm_storeu_ps(result + col*4, sum);
+	}
+}
+
+///----------------------------------------------------------------------------
+///Transforms a point (w = 1) by a column-major 4x4 matrix.
+///@param	m - the matrix
+///@param	point - x, y & z
+///@param	result - receives the x, y, z & w of m * point
+///----------------------------------------------------------------------------
+void TransformPoint(const GLfloat *m, const GLfloat *point, GLfloat *result)
+{
+	__m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(point[0])),
+					_mm_mul_ps(_mm_loadu_ps(m + 4), _mm_set1_ps(point[1]))),
+					_mm_mul_ps(_mm_loadu_ps(m + 8), _mm_set1_ps(point[2]))),
+					_mm_loadu_ps(m + 12));
+
+	_mm_storeu_ps(result, sum);
+}
+
+///----------------------------------------------------------------------------
+///Builds the same matrix as gluPerspective().
+///@param	fovy - vertical field of view in degrees
+///@param	aspect - width / height
+///@param	zNear - near plane distance
+///@param	zFar - far plane distance
+///@param	m - receives the column-major matrix
+///----------------------------------------------------------------------------
+void PerspectiveMatrix(GLfloat fovy, GLfloat aspect, GLfloat zNear, GLfloat zFar, GLfloat *m)
+{
+	GLfloat f = 1.0f / tanf(fovy * PI / 360.0f);
+
+	memset(m, 0, 16 * sizeof(GLfloat));
+	m[0]	= f / aspect;
+	m[5]	= f;
+	m[10]	= (zFar + zNear) / (zNear - zFar);
+	m[11]	= -1.0f;
+	m[14]	= 2.0f * zFar * zNear / (zNear - zFar);
+}
+
+///----------------------------------------------------------------------------
+///Builds the same matrix as gluLookAt() with the Y axis up.
+///@param	eye - camera position
+///@param	center - point the camera looks at
+///@param	m - receives the column-major matrix
+///----------------------------------------------------------------------------
+void LookAtMatrix(const GLfloat *eye, const GLfloat *center, GLfloat *m)
+{
+	GLfloat f[3] = {center[0] - eye[0], center[1] - eye[1], center[2] - eye[2]};
+	Normalize(f);
+
+	//side = forward x up, with up = (0,1,0)
+	GLfloat s[3] = {-f[2], 0.0f, f[0]};
+	Normalize(s);
+
+	//recomputed up = side x forward
+	GLfloat u[3];
+	Cross(s, f, u);
+
+	m[0] = s[0];	m[4] = s[1];	m[8]  = s[2];
+	m[1] = u[0];	m[5] = u[1];	m[9]  = u[2];
+	m[2] = -f[0];	m[6] = -f[1];	m[10] = -f[2];
+	m[3] = 0.0f;	m[7] = 0.0f;	m[11] = 0.0f;
+
+	m[12] = -Dot(s, eye);
+	m[13] = -Dot(u, eye);
+	m[14] = Dot(f, eye);
+	m[15] = 1.0f;
+}
+
+///----------------------------------------------------------------------------
+///Builds the same matrix as glRotatef() around one of the main axes.
+///@param	angle - rotation in degrees
+///@param	axis - 0 for X, 1 for Y
+///@param	m - receives the column-major matrix
+///----------------------------------------------------------------------------
+void RotationMatrix(GLfloat angle, int axis, GLfloat *m)
+{
+	GLfloat c = cosf(angle * PI / 180.0f);
+	GLfloat s = sinf(angle * PI / 180.0f);
+
+	memset(m, 0, 16 * sizeof(GLfloat));
+	m[15] = 1.0f;
+
+	if(axis == 0)
+	{
+		m[0] = 1.0f;
+		m[5] = c;	m[9]  = -s;
+		m[6] = s;	m[10] = c;
+	}
+	else
+	{
+		m[5] = 1.0f;
+		m[0] = c;	m[8]  = s;
+		m[2] = -s;	m[10] = c;
+	}
+}
+
+///----------------------------------------------------------------------------
+///Builds the normal matrix (gl_NormalMatrix): the inverse transpose of the
+///upper 3x3 of the model-view, as its cofactors over its determinant.
+///@param	modelView - column-major 4x4 model-view matrix
+///@param	normal - receives the column-major 3x3 matrix
+///----------------------------------------------------------------------------
+void NormalMatrix(const GLfloat *modelView, GLfloat *normal)
+{
+	//the 3x3 columns
+	const GLfloat *c0 = modelView;
+	const GLfloat *c1 = modelView + 4;
+	const GLfloat *c2 = modelView + 8;
+
+	//the cofactor columns are the crosses of the other two columns
+	GLfloat cofactor[9];
+	Cross(c1, c2, cofactor);
+	Cross(c2, c0, cofactor + 3);
+	Cross(c0, c1, cofactor + 6);
+
+	GLfloat det = Dot(c0, cofactor);
+	GLfloat inverse = (det != 0.0f) ? 1.0f / det : 0.0f;
+
+	for(int i=0; i<9; i++)
+		normal[i] = cofactor[i] * inverse;
+}
@@ -0,0 +1,60 @@
+///============================================================================
+///@file	MatrixMath.h
+///@brief	Column-major 4x4 matrix & 3 component vector helpers, the CPU
+///			equivalents of the fixed function matrix calls (gluPerspective,
+///			gluLookAt, glRotatef, gl_NormalMatrix) so matrices are computed
+///			on the CPU & uploaded, never read back from the GL. Products
+///			use SSE, one column per register.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef MATRIXMATH_H
+#define MATRIXMATH_H
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+
+#include <math.h>
+
+const GLfloat PI = 3.14159265f;
+
+//-----------------------------------------------------------------------------
+//3 component vectors
+//-----------------------------------------------------------------------------
+inline GLfloat Dot(const GLfloat *a, const GLfloat *b)
+{
+	return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+inline void Cross(const GLfloat *a, const GLfloat *b, GLfloat *result)
+{
+	result[0] = a[1]*b[2] - a[2]*b[1];
+	result[1] = a[2]*b[0] - a[0]*b[2];
+	result[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+inline void Normalize(GLfloat *v)
+{
+	GLfloat length = sqrtf(Dot(v, v));
+
+	v[0] /= length;
+	v[1] /= length;
+	v[2] /= length;
+}
+
+//-----------------------------------------------------------------------------
+//4x4 column-major matrices
+//-----------------------------------------------------------------------------
+void IdentityMatrix(GLfloat *m);
+void MultiplyMatrix(const GLfloat *a, const GLfloat *b, GLfloat *result);
+void TransformPoint(const GLfloat *m, const GLfloat *point, GLfloat *result);
+void PerspectiveMatrix(GLfloat fovy, GLfloat aspect, GLfloat zNear, GLfloat zFar, GLfloat *m);
+void LookAtMatrix(const GLfloat *eye, const GLfloat *center, GLfloat *m);
+void RotationMatrix(GLfloat angle, int axis, GLfloat *m);
+void NormalMatrix(const GLfloat *modelView, GLfloat *normal);
+
+#endif
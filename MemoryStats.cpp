@@ -0,0 +1,350 @@
+///============================================================================
+///@file	MemoryStats.cpp
+///@brief	Memory Statistics Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "MemoryStats.h"
+#include "GLExtensions.h"
+
+#include <stdlib.h>
+#include <assert.h>
+#include <new>
+
+using namespace std;
+
+static const char *s_CategoryNames[MC_COUNT] = {"mesh", "texture", "shader", "frame"};
+static const char *s_PoolNames[MP_COUNT] = {"cpu", "gpu"};
+
+MemoryUsage	MemoryStats::s_Usage[MC_COUNT][MP_COUNT];
+size_t		MemoryStats::s_Total[MP_COUNT];
+size_t		MemoryStats::s_Peak[MP_COUNT];
+
+#ifdef CHARCOAL_MEMSTATS
+#ifdef _MSC_VER
+#define MEMORY_THREAD_LOCAL	__declspec(thread)
+#else
+#define MEMORY_THREAD_LOCAL	__thread
+#endif
+
+static MEMORY_THREAD_LOCAL unsigned long	s_Allocations = 0;	// operator new calls of the thread
+
+//-----------------------------------------------------------------------------
+//The global allocation operators, counting the calls of each thread
+//-----------------------------------------------------------------------------
+void* operator new(size_t size) throw(std::bad_alloc)
+{
+	s_Allocations++;
+
+	void *block = malloc(size ? size : 1);
+	if(!block)
+		throw std::bad_alloc();
+
+	return block;
+}
+
+void* operator new[](size_t size) throw(std::bad_alloc)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) throw()
+{
+	s_Allocations++;
+
+	return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) throw()
+{
+	return operator new(size, std::nothrow);
+}
+
+void operator delete(void *block) throw()
+{
+	free(block);
+}
+
+void operator delete[](void *block) throw()
+{
+	free(block);
+}
+
+void operator delete(void *block, const std::nothrow_t&) throw()
+{
+	free(block);
+}
+
+void operator delete[](void *block, const std::nothrow_t&) throw()
+{
+	free(block);
+}
+#endif
+
+///----------------------------------------------------------------------------
+///Tells whether the accounting is compiled in.
+///@return	true in debug builds & those with CHARCOAL_MEMSTATS
+///----------------------------------------------------------------------------
+bool MemoryStats::IsCompiledIn()
+{
+#ifdef CHARCOAL_MEMSTATS
+	return true;
+#else
+	return false;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Accounts memory a subsystem allocated.
+///@param	category - the subsystem
+///@param	pool - CPU heap or GPU
+///@param	bytes - its size, 0 is ignored
+///----------------------------------------------------------------------------
+void MemoryStats::Allocate(MemoryCategory category, MemoryPool pool, size_t bytes)
+{
+#ifdef CHARCOAL_MEMSTATS
+	if(bytes == 0)
+		return;
+
+	MemoryUsage &usage = s_Usage[category][pool];
+
+	usage.bytes += bytes;
+	usage.blocks++;
+
+	if(usage.bytes > usage.peak)
+		usage.peak = usage.bytes;
+
+	s_Total[pool] += bytes;
+
+	if(s_Total[pool] > s_Peak[pool])
+		s_Peak[pool] = s_Total[pool];
+#else
+	(void)category;
+	(void)pool;
+	(void)bytes;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Accounts memory a subsystem freed, the same size it allocated.
+///@param	category - the subsystem
+///@param	pool - CPU heap or GPU
+///@param	bytes - its size, 0 is ignored
+///----------------------------------------------------------------------------
+void MemoryStats::Free(MemoryCategory category, MemoryPool pool, size_t bytes)
+{
+#ifdef CHARCOAL_MEMSTATS
+	if(bytes == 0)
+		return;
+
+	MemoryUsage &usage = s_Usage[category][pool];
+
+	//more freed than allocated is a bug in the owner
+	assert(usage.bytes >= bytes && usage.blocks > 0);
+
+	usage.bytes		-= (bytes < usage.bytes) ? bytes : usage.bytes;
+	usage.blocks	-= (usage.blocks > 0) ? 1 : 0;
+	s_Total[pool]	-= (bytes < s_Total[pool]) ? bytes : s_Total[pool];
+#else
+	(void)category;
+	(void)pool;
+	(void)bytes;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Gets the memory of a subsystem.
+///@param	category - the subsystem
+///@param	pool - CPU heap or GPU
+///@return	its live bytes, high-water mark & allocations
+///----------------------------------------------------------------------------
+const MemoryUsage& MemoryStats::GetUsage(MemoryCategory category, MemoryPool pool)
+{
+	return s_Usage[category][pool];
+}
+
+///----------------------------------------------------------------------------
+///Gets the live bytes of every subsystem.
+///@param	pool - CPU heap or GPU
+///@return	the sum
+///----------------------------------------------------------------------------
+size_t MemoryStats::GetTotal(MemoryPool pool)
+{
+	return s_Total[pool];
+}
+
+///----------------------------------------------------------------------------
+///Gets the high-water mark of every subsystem together.
+///@param	pool - CPU heap or GPU
+///@return	the most live bytes at once
+///----------------------------------------------------------------------------
+size_t MemoryStats::GetPeak(MemoryPool pool)
+{
+	return s_Peak[pool];
+}
+
+///----------------------------------------------------------------------------
+///Gets a table of the live memory & high-water marks of each subsystem.
+///@return	the table, empty if the accounting isn't compiled in
+///----------------------------------------------------------------------------
+string MemoryStats::GetReport()
+{
+	char line[256];
+	string report;
+
+	if(!IsCompiledIn())
+		return report;
+
+	sprintf(line, "%-14s %10s %10s %10s %10s\n", "Memory (KB)", "cpu live", "cpu peak", "gpu live", "gpu peak");
+	report += line;
+
+	for(int i=0; i<MC_COUNT; i++)
+	{
+		const MemoryUsage &cpu = s_Usage[i][MP_CPU];
+		const MemoryUsage &gpu = s_Usage[i][MP_GPU];
+
+		sprintf(line, "%-14s %10.1f %10.1f %10.1f %10.1f\n", s_CategoryNames[i],
+				cpu.bytes / 1024.0, cpu.peak / 1024.0, gpu.bytes / 1024.0, gpu.peak / 1024.0);
+		report += line;
+	}
+
+	sprintf(line, "%-14s %10.1f %10.1f %10.1f %10.1f\n", "total",
+			s_Total[MP_CPU] / 1024.0, s_Peak[MP_CPU] / 1024.0, s_Total[MP_GPU] / 1024.0, s_Peak[MP_GPU] / 1024.0);
+	report += line;
+
+	return report;
+}
+
+///----------------------------------------------------------------------------
+///Gets a one line summary for the performance overlay, without allocating.
+///@param	text - receives the line, MEMORY_SUMMARY chars at least
+///----------------------------------------------------------------------------
+void MemoryStats::GetSummary(char *text)
+{
+	const double MB = 1024.0 * 1024.0;
+
+	sprintf(text, "mem cpu %.2f MB peak %.2f  gpu %.2f MB peak %.2f",
+			s_Total[MP_CPU] / MB, s_Peak[MP_CPU] / MB, s_Total[MP_GPU] / MB, s_Peak[MP_GPU] / MB);
+}
+
+///----------------------------------------------------------------------------
+///Writes the memory of each subsystem as a JSON object.
+///@param	file - the open file
+///----------------------------------------------------------------------------
+void MemoryStats::WriteJSON(FILE *file)
+{
+	fprintf(file, "{");
+
+	for(int p=0; p<MP_COUNT; p++)
+		fprintf(file, "\"%s\": {\"live\": %lu, \"peak\": %lu}, ", s_PoolNames[p],
+				(unsigned long)s_Total[p], (unsigned long)s_Peak[p]);
+
+	fprintf(file, "\"categories\": {");
+
+	for(int i=0; i<MC_COUNT; i++)
+	{
+		fprintf(file, "%s\n\t\"%s\": {", i ? "," : "", s_CategoryNames[i]);
+
+		for(int p=0; p<MP_COUNT; p++)
+		{
+			const MemoryUsage &usage = s_Usage[i][p];
+
+			fprintf(file, "%s\"%s\": {\"live\": %lu, \"peak\": %lu, \"blocks\": %lu}", p ? ", " : "",
+					s_PoolNames[p], (unsigned long)usage.bytes, (unsigned long)usage.peak, usage.blocks);
+		}
+
+		fprintf(file, "}");
+	}
+
+	fprintf(file, "\n}}");
+}
+
+///----------------------------------------------------------------------------
+///Gets the name of a category, as in the reports.
+///@param	category - the category
+///@return	its name
+///----------------------------------------------------------------------------
+const char* MemoryStats::GetCategoryName(MemoryCategory category)
+{
+	return s_CategoryNames[category];
+}
+
+///----------------------------------------------------------------------------
+///Estimates the GPU size of an image, without mipmaps. RGB is counted as 4
+///bytes a texel, drivers store it padded.
+///@param	width - image width
+///@param	height - image height
+///@param	internalFormat - format of the texture or renderbuffer
+///@return	the size in bytes
+///----------------------------------------------------------------------------
+size_t MemoryStats::GetTextureSize(GLsizei width, GLsizei height, GLenum internalFormat)
+{
+	size_t bytes;
+
+	switch(internalFormat)
+	{
+	case GL_ALPHA:
+	case GL_LUMINANCE:
+	case GL_R8:					bytes = 1;	break;
+	case GL_LUMINANCE_ALPHA:
+	case GL_RG8:
+	case GL_DEPTH_COMPONENT16:	bytes = 2;	break;
+	case GL_RGBA16F:			bytes = 8;	break;
+	case GL_RGBA32F:			bytes = 16;	break;
+	default:					bytes = 4;	break;
+	}
+
+	return (size_t)width * height * bytes;
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of operator new calls the calling thread made so far.
+///@return	the count, 0 if the accounting isn't compiled in
+///----------------------------------------------------------------------------
+unsigned long MemoryStats::GetThreadAllocations()
+{
+#ifdef CHARCOAL_MEMSTATS
+	return s_Allocations;
+#else
+	return 0;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Starts checking a scope.
+///@param	name - the scope, a literal
+///@param	armed - false to let the scope allocate, i.e. while warming up
+///----------------------------------------------------------------------------
+AllocationGuard::AllocationGuard(const char *name, bool armed)
+{
+	m_Name	= name;
+	m_Armed	= armed && MemoryStats::IsCompiledIn();
+	m_Start	= MemoryStats::GetThreadAllocations();
+}
+
+///----------------------------------------------------------------------------
+///Ends the scope, reporting the allocations it made if armed.
+///----------------------------------------------------------------------------
+AllocationGuard::~AllocationGuard()
+{
+	unsigned long allocations = MemoryStats::GetThreadAllocations() - m_Start;
+
+	if(!m_Armed || allocations == 0)
+		return;
+
+	char message[256];
+	sprintf(message, "%s made %lu heap allocations in a steady state frame.\n", m_Name, allocations);
+	OutputDebugString(message);
+
+	assert(!"A steady state frame allocated from the heap");
+}
+
+///----------------------------------------------------------------------------
+///Lets the rest of the scope allocate, i.e. when it reloads something.
+///----------------------------------------------------------------------------
+void AllocationGuard::Disarm()
+{
+	m_Armed = false;
+}
@@ -0,0 +1,113 @@
+///============================================================================
+///@file	MemoryStats.h
+///@brief	Accounts the memory of each subsystem: meshes, textures, shaders
+///			and per frame resources (framebuffers, read backs, streamed
+///			vertices), on the CPU heap & on the GPU. The owners report what
+///			they allocate & free, the live bytes and their high-water marks
+///			are kept per subsystem. GPU sizes are estimates from the sizes
+///			& formats of the objects, drivers pad and keep copies freely.
+///
+///			In the same builds, every operator new is counted per thread so
+///			an AllocationGuard can check a scope, i.e. a steady state frame,
+///			doesn't touch the heap. It asserts in debug builds.
+///
+///			Accounting is compiled in debug builds, and in release builds
+///			only with CHARCOAL_MEMSTATS defined; otherwise nothing is kept
+///			and every size stays 0. Allocate() & Free() are meant for the
+///			thread owning the GL context.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef MEMORYSTATS_H
+#define MEMORYSTATS_H
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <string>
+
+//debug builds always account
+#if defined(_DEBUG) && !defined(CHARCOAL_MEMSTATS)
+#define CHARCOAL_MEMSTATS
+#endif
+
+const int MEMORY_SUMMARY = 128;				// Chars GetSummary() may write
+const unsigned long MEMORY_WARMUP = 60;		// Frames before a frame loop is in steady state
+
+enum MemoryCategory
+{
+	MC_MESH,		// Model arrays, welded vertices & their buffers
+	MC_TEXTURE,		// Images loaded & textures created from them
+	MC_SHADER,		// Shader sources, variants & their programs
+	MC_FRAME,		// Framebuffers, frames read back & streamed vertices
+	MC_COUNT
+};
+
+enum MemoryPool
+{
+	MP_CPU,			// Heap
+	MP_GPU,			// GL objects' storage
+	MP_COUNT
+};
+
+//-----------------------------------------------------------------------------
+//Memory of a category in a pool
+//-----------------------------------------------------------------------------
+struct MemoryUsage
+{
+	size_t			bytes;		///> Live bytes
+	size_t			peak;		///> Most live bytes at once
+	unsigned long	blocks;		///> Live allocations
+};
+
+class MemoryStats
+{
+public:
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	static bool			IsCompiledIn();
+	static void			Allocate(MemoryCategory category, MemoryPool pool, size_t bytes);
+	static void			Free(MemoryCategory category, MemoryPool pool, size_t bytes);
+	static const MemoryUsage&	GetUsage(MemoryCategory category, MemoryPool pool);
+	static size_t		GetTotal(MemoryPool pool);
+	static size_t		GetPeak(MemoryPool pool);
+	static std::string	GetReport();
+	static void			GetSummary(char *text);
+	static void			WriteJSON(FILE *file);
+	static const char*	GetCategoryName(MemoryCategory category);
+	static size_t		GetTextureSize(GLsizei width, GLsizei height, GLenum internalFormat);
+	static unsigned long	GetThreadAllocations();
+
+private:
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	static MemoryUsage	s_Usage[MC_COUNT][MP_COUNT];	///> Per category & pool
+	static size_t		s_Total[MP_COUNT];	///> Live bytes of all categories
+	static size_t		s_Peak[MP_COUNT];	///> Most live bytes of all categories at once
+};
+
+//-----------------------------------------------------------------------------
+//Checks that a scope makes no heap allocations on its thread
+//-----------------------------------------------------------------------------
+class AllocationGuard
+{
+public:
+	AllocationGuard(const char *name, bool armed);
+	~AllocationGuard();
+
+	void	Disarm();
+
+private:
+	const char		*m_Name;	///> Scope name, a literal
+	unsigned long	m_Start;	///> Thread's allocations when the scope began
+	bool			m_Armed;	///> Checked when the scope ends
+};
+
+#endif
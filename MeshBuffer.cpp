@@ -0,0 +1,238 @@
+///============================================================================
+///@file	MeshBuffer.cpp
+///@brief	Mesh Buffer Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "MeshBuffer.h"
+#include "MemoryStats.h"
+
+#include <map>
+#include <string.h>
+#include <stddef.h>
+
+//-----------------------------------------------------------------------------
+//Orders vertices by their bytes so identical ones share an index
+//-----------------------------------------------------------------------------
+struct VertexLess
+{
+	bool operator()(const MeshVertex &a, const MeshVertex &b) const
+	{
+		return memcmp(&a, &b, sizeof(MeshVertex)) < 0;
+	}
+};
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+MeshBuffer::MeshBuffer()
+{
+	m_VertexArray	= 0;
+	m_VertexBuffer	= 0;
+	m_IndexBuffer	= 0;
+	m_BufferSize	= 0;
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+MeshBuffer::~MeshBuffer()
+{
+	Release();
+	MemoryStats::Free(MC_MESH, MP_CPU, GetArraySize());
+}
+
+///----------------------------------------------------------------------------
+///Builds the vertex & index arrays from the triangles of a model. Milkshape
+///stores normals & texture coordinates per triangle corner, corners with
+///the same position, normal & coordinates are welded into one vertex.
+///Only CPU memory is touched, call Upload() to create the GL buffers.
+///@param	model - the model to build from
+///----------------------------------------------------------------------------
+void MeshBuffer::Build(const Model *model)
+{
+	map<MeshVertex, GLuint, VertexLess> welded;
+
+	MemoryStats::Free(MC_MESH, MP_CPU, GetArraySize());
+
+	m_Vertices.clear();
+	m_Indices.clear();
+
+	const Model::Mesh		*meshes		= model->getMeshes();
+	const Model::Triangle	*triangles	= model->getTriangles();
+	const Model::Vertex		*vertices	= model->getVertices();
+
+	for(int i=0; i<model->getNumMeshes(); i++)
+	{
+		for(int j=0; j<meshes[i].m_numTriangles; j++)
+		{
+			const Model::Triangle &triangle = triangles[meshes[i].m_pTriangleIndices[j]];
+
+			for(int k=0; k<3; k++)
+			{
+				MeshVertex vertex;
+
+				//clear the padding too, vertices are compared bytewise
+				memset(&vertex, 0, sizeof(vertex));
+				memcpy(vertex.position, vertices[triangle.m_vertexIndices[k]].m_location, sizeof(vertex.position));
+				memcpy(vertex.normal, triangle.m_vertexNormals[k], sizeof(vertex.normal));
+				vertex.texCoord[0] = triangle.m_s[k];
+				vertex.texCoord[1] = triangle.m_t[k];
+
+				map<MeshVertex, GLuint, VertexLess>::iterator it = welded.find(vertex);
+				if(it == welded.end())
+				{
+					it = welded.insert(make_pair(vertex, (GLuint)m_Vertices.size())).first;
+					m_Vertices.push_back(vertex);
+				}
+
+				m_Indices.push_back(it->second);
+			}
+		}
+	}
+
+	MemoryStats::Allocate(MC_MESH, MP_CPU, GetArraySize());
+}
+
+///----------------------------------------------------------------------------
+///Creates the vertex array object and copies the arrays to GL buffers.
+///With direct state access the objects are set up without binding them,
+///and the buffers are immutable when buffer storage is available.
+///@return	true if vertex array objects are supported
+///----------------------------------------------------------------------------
+bool MeshBuffer::Upload()
+{
+	const GLCapabilities &caps = GetCapabilities();
+
+	Release();
+
+	if(!caps.vertexArrayObjects || m_Indices.empty())
+		return false;
+
+	GLsizeiptr vertexSize	= m_Vertices.size() * sizeof(MeshVertex);
+	GLsizeiptr indexSize	= m_Indices.size() * sizeof(GLuint);
+
+	m_BufferSize = vertexSize + indexSize;
+	MemoryStats::Allocate(MC_MESH, MP_GPU, m_BufferSize);
+
+	if(caps.directStateAccess)
+	{
+		glCreateBuffers(1, &m_VertexBuffer);
+		glCreateBuffers(1, &m_IndexBuffer);
+
+		if(caps.bufferStorage)
+		{
+			glNamedBufferStorage(m_VertexBuffer, vertexSize, &m_Vertices[0], 0);
+			glNamedBufferStorage(m_IndexBuffer, indexSize, &m_Indices[0], 0);
+		}
+		else
+		{
+			glNamedBufferData(m_VertexBuffer, vertexSize, &m_Vertices[0], GL_STATIC_DRAW);
+			glNamedBufferData(m_IndexBuffer, indexSize, &m_Indices[0], GL_STATIC_DRAW);
+		}
+
+		glCreateVertexArrays(1, &m_VertexArray);
+		glVertexArrayVertexBuffer(m_VertexArray, 0, m_VertexBuffer, 0, sizeof(MeshVertex));
+		glVertexArrayElementBuffer(m_VertexArray, m_IndexBuffer);
+
+		glEnableVertexArrayAttrib(m_VertexArray, VA_POSITION);
+		glVertexArrayAttribFormat(m_VertexArray, VA_POSITION, 3, GL_FLOAT, GL_FALSE, offsetof(MeshVertex, position));
+		glVertexArrayAttribBinding(m_VertexArray, VA_POSITION, 0);
+		glEnableVertexArrayAttrib(m_VertexArray, VA_NORMAL);
+		glVertexArrayAttribFormat(m_VertexArray, VA_NORMAL, 3, GL_FLOAT, GL_FALSE, offsetof(MeshVertex, normal));
+		glVertexArrayAttribBinding(m_VertexArray, VA_NORMAL, 0);
+		glEnableVertexArrayAttrib(m_VertexArray, VA_TEXCOORD);
+		glVertexArrayAttribFormat(m_VertexArray, VA_TEXCOORD, 2, GL_FLOAT, GL_FALSE, offsetof(MeshVertex, texCoord));
+		glVertexArrayAttribBinding(m_VertexArray, VA_TEXCOORD, 0);
+
+		return true;
+	}
+
+	glGenVertexArrays(1, &m_VertexArray);
+	glBindVertexArray(m_VertexArray);
+
+	glGenBuffers(1, &m_VertexBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, m_VertexBuffer);
+	glGenBuffers(1, &m_IndexBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBuffer);
+
+	if(caps.bufferStorage)
+	{
+		glBufferStorage(GL_ARRAY_BUFFER, vertexSize, &m_Vertices[0], 0);
+		glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, indexSize, &m_Indices[0], 0);
+	}
+	else
+	{
+		glBufferData(GL_ARRAY_BUFFER, vertexSize, &m_Vertices[0], GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexSize, &m_Indices[0], GL_STATIC_DRAW);
+	}
+
+	//the vertex array object records the layout & the index buffer
+	glEnableVertexAttribArray(VA_POSITION);
+	glVertexAttribPointer(VA_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (const GLvoid*)offsetof(MeshVertex, position));
+	glEnableVertexAttribArray(VA_NORMAL);
+	glVertexAttribPointer(VA_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (const GLvoid*)offsetof(MeshVertex, normal));
+	glEnableVertexAttribArray(VA_TEXCOORD);
+	glVertexAttribPointer(VA_TEXCOORD, 2, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (const GLvoid*)offsetof(MeshVertex, texCoord));
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Draws the whole mesh with the program currently in use.
+///----------------------------------------------------------------------------
+void MeshBuffer::Draw() const
+{
+	glBindVertexArray(m_VertexArray);
+	glDrawElements(GL_TRIANGLES, (GLsizei)m_Indices.size(), GL_UNSIGNED_INT, 0);
+	glBindVertexArray(0);
+}
+
+///----------------------------------------------------------------------------
+///Deletes the GL buffers, the CPU arrays are kept.
+///----------------------------------------------------------------------------
+void MeshBuffer::Release()
+{
+	if(m_VertexArray)	glDeleteVertexArrays(1, &m_VertexArray);
+	if(m_VertexBuffer)	glDeleteBuffers(1, &m_VertexBuffer);
+	if(m_IndexBuffer)	glDeleteBuffers(1, &m_IndexBuffer);
+
+	m_VertexArray	= 0;
+	m_VertexBuffer	= 0;
+	m_IndexBuffer	= 0;
+
+	MemoryStats::Free(MC_MESH, MP_GPU, m_BufferSize);
+	m_BufferSize = 0;
+}
+
+///----------------------------------------------------------------------------
+///Gets the heap bytes of the vertex & index arrays.
+///@return	their capacity in bytes
+///----------------------------------------------------------------------------
+size_t MeshBuffer::GetArraySize() const
+{
+	return m_Vertices.capacity() * sizeof(MeshVertex) + m_Indices.capacity() * sizeof(GLuint);
+}
+
+///----------------------------------------------------------------------------
+///Gets the welded vertices.
+///@return	the vertex array
+///----------------------------------------------------------------------------
+const vector<MeshVertex>& MeshBuffer::GetVertices() const
+{
+	return m_Vertices;
+}
+
+///----------------------------------------------------------------------------
+///Gets the triangle list indices.
+///@return	the index array
+///----------------------------------------------------------------------------
+const vector<GLuint>& MeshBuffer::GetIndices() const
+{
+	return m_Indices;
+}
@@ -0,0 +1,84 @@
+///============================================================================
+///@file	MeshBuffer.h
+///@brief	Indexed vertex buffer built from a milkshape model, drawn with a
+///			vertex array object by the core profile backend.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef MESHBUFFER_H
+#define MESHBUFFER_H
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <vector>
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include "GLExtensions.h"
+#include "Model.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//Vertex attribute locations, must match the layout() qualifiers in the
+//GLSL 3.30 shaders
+//-----------------------------------------------------------------------------
+enum VertexAttribute
+{
+	VA_POSITION	= 0,
+	VA_NORMAL	= 1,
+	VA_TEXCOORD	= 2
+};
+
+//-----------------------------------------------------------------------------
+//Interleaved vertex
+//-----------------------------------------------------------------------------
+struct MeshVertex
+{
+	GLfloat position[3];
+	GLfloat normal[3];
+	GLfloat texCoord[2];
+};
+
+class MeshBuffer
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	MeshBuffer();
+	~MeshBuffer();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	void	Build(const Model *model);
+	bool	Upload();
+	void	Draw() const;
+	void	Release();
+
+	const vector<MeshVertex>&	GetVertices() const;
+	const vector<GLuint>&		GetIndices() const;
+
+private:
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	size_t	GetArraySize() const;
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	vector<MeshVertex>	m_Vertices;		///> Welded vertices
+	vector<GLuint>		m_Indices;		///> Triangle list indices
+	GLuint				m_VertexArray;	///> Vertex array object
+	GLuint				m_VertexBuffer;	///> Vertex buffer object
+	GLuint				m_IndexBuffer;	///> Index buffer object
+	size_t				m_BufferSize;	///> GPU bytes of both buffers
+};
+
+#endif
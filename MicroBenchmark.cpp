@@ -0,0 +1,663 @@
+///============================================================================
+///@file	MicroBenchmark.cpp
+///@brief	Charcoal Rendering, microbenchmarks of the hot subsystems, each
+///			measured alone: TGA loading (raw & RLE), milkshape model loading,
+///			vertex welding, the camera matrices, the CPU cost of submitting
+///			the model (Model::draw & MeshBuffer::Draw), shader compiling
+///			& linking and the performance overlay's batch & draw. Runs
+///			headless, the GL cases in a Mesa EGL context.
+///
+///			usage: MicroBenchmark [-reps N] [-warmup N] [-mintime ms]
+///					[-pin cpu] [-filter text] [-json file] [-list]
+///
+///			Each case runs -warmup samples that are thrown away, then -reps
+///			samples of as many iterations as fill -mintime (10 ms by
+///			default, one at least). The table gives the time of one
+///			iteration, -json writes every sample too. -pin keeps the
+///			process on one processor, -filter only runs the cases whose
+///			name contains the text. Where the host has hardware counters
+///			(PerfCounters.h) the IPC & cache misses per item are printed
+///			and every count per iteration & item is in the JSON.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sched.h>
+#include <vector>
+#include <algorithm>
+
+#include "HeadlessContext.h"
+#include "FrameBuffer.h"
+#include "Geometry.h"
+#include "MilkshapeModel.h"
+#include "MeshBuffer.h"
+#include "RenderBackend.h"
+#include "ShaderObject.h"
+#include "ShaderProgram.h"
+#include "ShaderPermutation.h"
+#include "ShaderSource.h"
+#include "GLExtensions.h"
+#include "FramePacer.h"
+#include "FrameRecorder.h"
+#include "PerfOverlay.h"
+#include "Benchmark.h"
+#include "PerfCounters.h"
+#include "ltga.h"
+
+using namespace std;
+
+const char *MODEL_FILE		= "textures/model.ms3d";
+const char *TEXTURE_FILE	= "textures/paper.tga";
+const char *RLE_FILE		= "/tmp/charcoal_rle.tga";	// RLE copy of TEXTURE_FILE
+const int DRAW_SIZE			= 64;	// Side of the framebuffer the draws go to
+const int MAX_ITERATIONS	= 1 << 20;	// Iterations of a sample at most
+const int OVERLAY_FRAMES	= 240;	// Frames recorded for the overlay cases
+
+//-----------------------------------------------------------------------------
+//A case runs one iteration & returns the items it processed (texels,
+//vertices...), the fixture holds what the cases share
+//-----------------------------------------------------------------------------
+struct Fixture
+{
+	Geometry		*geometry;		///> The scene, for the matrices
+	MeshBuffer		mesh;			///> The welded model, uploaded for its draw case
+	string			vertexSource;	///> GLSL 1.10 charcoal shader
+	string			fragmentSource;
+	string			vertexSource330;	///> GLSL 3.30 charcoal shader
+	string			fragmentSource330;
+	unsigned int	iteration;		///> Makes every shader source unique
+	FrameRecorder	recorder;		///> OVERLAY_FRAMES frames of a 60 Hz run
+	PerfOverlay		overlay;		///> Batch of the recorder's stats, drawn by its case
+};
+
+typedef double (*CaseFunction)(Fixture &fixture);
+
+struct Case
+{
+	const char		*name;
+	const char		*unit;		///> What an item is
+	CaseFunction	function;
+	bool			graphics;	///> Needs the GL context
+};
+
+struct Result
+{
+	const Case		*test;
+	int				iterations;	///> Iterations per sample
+	double			items;		///> Items per iteration
+	vector<double>	samples;	///> Seconds per iteration, one per sample
+	CounterValues	counts;		///> Hardware counts of the samples
+};
+
+///----------------------------------------------------------------------------
+///Writes an RLE (type 10) copy of a 24 bit TGA, packets of repeated pixels
+///where there are any & raw packets between them.
+///@param	source - the uncompressed TGA
+///@param	fileName - the file to write
+///@return	true if the file was written
+///----------------------------------------------------------------------------
+static bool WriteRLE(const char *source, const char *fileName)
+{
+	LTGA image;
+	if(!image.LoadFromFile(source) || image.GetPixelDepth() != 24)
+		return false;
+
+	FILE *file = fopen(fileName, "wb");
+	if(!file)
+		return false;
+
+	int width = image.GetImageWidth();
+	int height = image.GetImageHeight();
+	const byte *pixels = image.GetPixels();
+
+	//LTGA hands out RGB, the file is BGR
+	unsigned char header[18] = {0};
+	header[2]	= 10;
+	header[12]	= width & 0xFF;
+	header[13]	= width >> 8;
+	header[14]	= height & 0xFF;
+	header[15]	= height >> 8;
+	header[16]	= 24;
+	fwrite(header, 1, sizeof(header), file);
+
+	int count = width * height;
+	int i = 0;
+
+	while(i < count)
+	{
+		//length of the run starting here
+		int run = 1;
+		while(i + run < count && run < 128 && !memcmp(pixels + i*3, pixels + (i + run)*3, 3))
+			run++;
+
+		int length = run;
+		if(run == 1)
+		{
+			//raw packet up to the next run
+			while(i + length < count && length < 128 &&
+				  (i + length + 1 >= count || memcmp(pixels + (i + length)*3, pixels + (i + length + 1)*3, 3)))
+				length++;
+		}
+
+		fputc((run > 1 ? 0x80 : 0) | (length - 1), file);
+
+		for(int p=0; p<(run > 1 ? 1 : length); p++)
+		{
+			const byte *pixel = pixels + (i + p)*3;
+			unsigned char bgr[3] = {pixel[2], pixel[1], pixel[0]};
+			fwrite(bgr, 1, 3, file);
+		}
+
+		i += length;
+	}
+
+	return fclose(file) == 0;
+}
+
+///----------------------------------------------------------------------------
+///Tells whether two TGAs decode to the same image.
+///@param	first, second - the files
+///@return	true if both load & their pixels match
+///----------------------------------------------------------------------------
+static bool SamePixels(const char *first, const char *second)
+{
+	LTGA a, b;
+	if(!a.LoadFromFile(first) || !b.LoadFromFile(second))
+		return false;
+
+	if(a.GetImageWidth() != b.GetImageWidth() || a.GetImageHeight() != b.GetImageHeight() ||
+	   a.GetPixelDepth() != b.GetPixelDepth() || a.GetAlphaDepth() != b.GetAlphaDepth())
+		return false;
+
+	size_t size = a.GetImageWidth() * a.GetImageHeight() * ((a.GetPixelDepth() + a.GetAlphaDepth()) / 8);
+
+	return !memcmp(a.GetPixels(), b.GetPixels(), size);
+}
+
+//-----------------------------------------------------------------------------
+//The cases
+//-----------------------------------------------------------------------------
+static double LoadTGA(const char *fileName)
+{
+	LTGA image;
+	if(!image.LoadFromFile(fileName))
+		return 0.0;
+
+	return (double)image.GetImageWidth() * image.GetImageHeight();
+}
+
+static double LoadRawTGA(Fixture &)
+{
+	return LoadTGA(TEXTURE_FILE);
+}
+
+static double LoadRLETGA(Fixture &)
+{
+	return LoadTGA(RLE_FILE);
+}
+
+static double LoadModel(Fixture &)
+{
+	MilkshapeModel model;
+	if(!model.loadModelData(MODEL_FILE))
+		return 0.0;
+
+	return model.getNumVertices();
+}
+
+static double WeldVertices(Fixture &fixture)
+{
+	MeshBuffer mesh;
+	mesh.Build(fixture.geometry->GetModel());
+
+	return (double)mesh.GetIndices().size();
+}
+
+static double ComputeMatrices(Fixture &fixture)
+{
+	GLfloat projection[16], view[16], modelViewProjection[16];
+	GLfloat normalMatrix[9];
+
+	SceneState scene;
+	memset(&scene, 0, sizeof(scene));
+	scene.spinX		= (GLfloat)(fixture.iteration++ % 360);
+	scene.spinY		= 10.0f;
+	scene.width		= 1920;
+	scene.height	= 1080;
+
+	//what a frame of either backend computes
+	RenderBackend::ComputeProjection(scene.width, scene.height, projection);
+	RenderBackend::ComputeView(fixture.geometry, view);
+	RenderBackend::ComputeMatrices(fixture.geometry, scene, modelViewProjection, normalMatrix);
+
+	return 1.0;
+}
+
+static double DrawModel(Fixture &fixture)
+{
+	glLoadIdentity();
+	fixture.geometry->Draw(30.0f, 10.0f);
+
+	return fixture.geometry->GetModel()->getNumTriangles() * 3.0;
+}
+
+static double DrawMesh(Fixture &fixture)
+{
+	fixture.mesh.Draw();
+
+	return (double)fixture.mesh.GetIndices().size();
+}
+
+static double BuildShader(const string &vertexSource, const string &fragmentSource, Fixture &fixture)
+{
+	CharcoalConstants constants;
+	constants.oversaturation	= 1.5f;
+	constants.contrastExp		= 3.5f;
+	constants.cetScale			= 0.5f;
+
+	//a new source every time, so the driver's shader cache never has it
+	char unique[64];
+	sprintf(unique, "//microbenchmark %u\n", fixture.iteration++);
+	string defines = ShaderPermutation::BuildDefines(ShaderPermutation::GetTierFeatures(QT_HIGH), constants) + unique;
+
+	ShaderObject vertex(GL_VERTEX_SHADER, vertexSource, defines);
+	ShaderObject fragment(GL_FRAGMENT_SHADER, fragmentSource, defines);
+	ShaderProgram program;
+
+	program.CreateShader();
+	program.AttachObject(&vertex);
+	program.AttachObject(&fragment);
+	program.Link();
+
+	//waits for the compiler & linker
+	bool linked = program.IsLinked();
+	program.DestroyShader();
+
+	return linked ? 1.0 : 0.0;
+}
+
+static double BuildShader110(Fixture &fixture)
+{
+	return BuildShader(fixture.vertexSource, fixture.fragmentSource, fixture);
+}
+
+static double BuildShader330(Fixture &fixture)
+{
+	return BuildShader(fixture.vertexSource330, fixture.fragmentSource330, fixture);
+}
+
+static double BatchOverlay(Fixture &fixture)
+{
+	//what a -hud frame of CharcoalHeadless builds, without the stage lines
+	fixture.overlay.Begin(DRAW_SIZE, DRAW_SIZE);
+	fixture.overlay.AddStats(fixture.recorder, NULL);
+
+	return fixture.overlay.GetVertexCount();
+}
+
+static double DrawOverlay(Fixture &fixture)
+{
+	fixture.overlay.Draw();
+
+	return fixture.overlay.GetVertexCount();
+}
+
+static const Case s_Cases[] =
+{
+	{"tga raw",			"texel",	LoadRawTGA,		false},
+	{"tga rle",			"texel",	LoadRLETGA,		false},
+	{"model load",		"vertex",	LoadModel,		false},
+	{"mesh weld",		"vertex",	WeldVertices,	false},
+	{"matrices",		"frame",	ComputeMatrices, false},
+	{"model draw",		"vertex",	DrawModel,		true},
+	{"mesh draw",		"vertex",	DrawMesh,		true},
+	{"shader 110",		"program",	BuildShader110,	true},
+	{"shader 330",		"program",	BuildShader330,	true},
+	{"overlay batch",	"vertex",	BatchOverlay,	false},
+	{"overlay draw",	"vertex",	DrawOverlay,	true}
+};
+
+///----------------------------------------------------------------------------
+///Runs the iterations of a sample.
+///@param	test - the case
+///@param	fixture - the shared state
+///@param	iterations - iterations to run
+///@param	items - receives the items of an iteration
+///@param	counters - the hardware counters
+///@param	counts - gets the sample's counts added, NULL if it isn't kept
+///@return	seconds per iteration
+///----------------------------------------------------------------------------
+static double RunSample(const Case &test, Fixture &fixture, int iterations, double &items,
+						const PerfCounters &counters, CounterValues *counts)
+{
+	CounterValues countStart, countEnd;
+	counters.Read(countStart);
+
+	double start = FramePacer::GetTime();
+
+	for(int i=0; i<iterations; i++)
+		items = test.function(fixture);
+
+	double elapsed = FramePacer::GetTime() - start;
+
+	counters.Read(countEnd);
+	if(counts)
+		PerfCounters::Accumulate(*counts, countStart, countEnd);
+
+	//the draws are only queued, the GPU works outside the timing
+	if(test.graphics)
+		glFinish();
+
+	return elapsed / iterations;
+}
+
+///----------------------------------------------------------------------------
+///Gets a percentile of sorted samples.
+///@param	sorted - the samples, in ascending order
+///@param	percent - the percentile
+///@return	the nearest sample
+///----------------------------------------------------------------------------
+static double GetPercentile(const vector<double> &sorted, double percent)
+{
+	size_t index = (size_t)(percent / 100.0 * (sorted.size() - 1) + 0.5);
+
+	return sorted[index];
+}
+
+///----------------------------------------------------------------------------
+///Writes the results as JSON, times in microseconds.
+///@param	fileName - the file
+///@param	results - the cases that ran
+///@param	counters - the hardware counters, for the counts that are meaningful
+///@param	graphics - whether the GL context was created, for the driver
+///@param	reps, warmup, minTime, pin - the options
+///@return	true if the file was written
+///----------------------------------------------------------------------------
+static bool WriteJSON(const char *fileName, const vector<Result> &results, const PerfCounters &counters,
+					  bool graphics, int reps, int warmup, double minTime, int pin)
+{
+	FILE *file = fopen(fileName, "w");
+	if(!file)
+		return false;
+
+	fprintf(file, "{\n\"options\": {\"reps\": %d, \"warmup\": %d, \"mintime_ms\": %.3f, \"pin\": %d},\n",
+			reps, warmup, minTime * 1000.0, pin);
+
+	fprintf(file, "\"build\": ");
+	Benchmark::WriteBuildInfo(file);
+	fprintf(file, ",\n\"host\": ");
+	Benchmark::WriteHostInfo(file);
+
+	fprintf(file, ",\n\"driver\": ");
+	if(graphics)
+	{
+		fprintf(file, "{\"renderer\": ");
+		Benchmark::WriteString(file, (const char *)glGetString(GL_RENDERER));
+		fprintf(file, ", \"version\": ");
+		Benchmark::WriteString(file, (const char *)glGetString(GL_VERSION));
+		fprintf(file, "}");
+	}
+	else
+	{
+		fprintf(file, "null");
+	}
+
+	fprintf(file, ",\n\"cases\": [");
+
+	for(size_t i=0; i<results.size(); i++)
+	{
+		const Result &result = results[i];
+		vector<double> sorted(result.samples);
+		sort(sorted.begin(), sorted.end());
+
+		double mean = 0.0, variance = 0.0;
+		for(size_t s=0; s<sorted.size(); s++)
+			mean += sorted[s] / sorted.size();
+		for(size_t s=0; s<sorted.size(); s++)
+			variance += (sorted[s] - mean) * (sorted[s] - mean) / sorted.size();
+
+		double median = GetPercentile(sorted, 50.0);
+
+		fprintf(file, "%s\n\t{\"name\": \"%s\", \"unit\": \"%s\", \"items\": %.6g, \"iterations\": %d, "
+					  "\"min_us\": %.3f, \"median_us\": %.3f, \"mean_us\": %.3f, \"max_us\": %.3f, "
+					  "\"stddev_us\": %.3f, \"items_per_s\": %.6g,\n\t \"samples_us\": [",
+				i ? "," : "", result.test->name, result.test->unit, result.items, result.iterations,
+				sorted.front() * 1e6, median * 1e6, mean * 1e6, sorted.back() * 1e6,
+				sqrt(variance) * 1e6, median > 0.0 ? result.items / median : 0.0);
+
+		for(size_t s=0; s<result.samples.size(); s++)
+			fprintf(file, "%s%.3f", s ? ", " : "", result.samples[s] * 1e6);
+
+		fprintf(file, "],\n\t \"counters\": ");
+
+		if(counters.IsAvailable())
+		{
+			const char *units[2] = {"iteration", result.test->unit};
+			double iterations = (double)result.iterations * result.samples.size();
+			double items[2] = {iterations, iterations * result.items};
+
+			PerfCounters::WriteJSON(file, result.counts, counters, items, units, 2);
+		}
+		else
+		{
+			fprintf(file, "null");
+		}
+
+		fprintf(file, "}");
+	}
+
+	fprintf(file, "\n]\n}\n");
+
+	return fclose(file) == 0;
+}
+
+int main(int argc, char *argv[])
+{
+	int reps				= 10;
+	int warmup				= 2;
+	double minTime			= 0.010;
+	int pin					= -1;
+	const char *filter		= NULL;
+	const char *json		= NULL;
+	bool list				= false;
+	const int caseCount		= sizeof(s_Cases) / sizeof(s_Cases[0]);
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-reps") && i+1 < argc)
+			reps = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-warmup") && i+1 < argc)
+			warmup = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-mintime") && i+1 < argc)
+			minTime = atof(argv[++i]) / 1000.0;
+		else if(!strcmp(argv[i], "-pin") && i+1 < argc)
+			pin = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-filter") && i+1 < argc)
+			filter = argv[++i];
+		else if(!strcmp(argv[i], "-json") && i+1 < argc)
+			json = argv[++i];
+		else if(!strcmp(argv[i], "-list"))
+			list = true;
+		else
+		{
+			fprintf(stderr, "usage: %s [-reps N] [-warmup N] [-mintime ms] [-pin cpu] "
+							"[-filter text] [-json file] [-list]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if(reps < 1)
+		reps = 1;
+
+	if(list)
+	{
+		for(int c=0; c<caseCount; c++)
+			printf("%s\n", s_Cases[c].name);
+		return 0;
+	}
+
+	//one processor, so the samples don't move between caches
+	if(pin >= 0)
+	{
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(pin, &cpus);
+
+		if(sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+		{
+			fprintf(stderr, "Could not pin to processor %d.\n", pin);
+			return 1;
+		}
+	}
+
+	bool graphics = false;
+	for(int c=0; c<caseCount; c++)
+		if(!filter || strstr(s_Cases[c].name, filter))
+			graphics = graphics || s_Cases[c].graphics;
+
+	//the compatibility profile has both the immediate mode & GLSL 3.30
+	HeadlessContext context;
+	FrameBuffer frameBuffer;
+
+	if(graphics)
+	{
+		if(!context.Create(false) || !InitExtensions() || !frameBuffer.Create(DRAW_SIZE, DRAW_SIZE))
+		{
+			fprintf(stderr, "Could not create a headless OpenGL context.\n");
+			return 1;
+		}
+
+		frameBuffer.Bind();
+		glViewport(0, 0, DRAW_SIZE, DRAW_SIZE);
+		glEnable(GL_DEPTH_TEST);
+	}
+
+	Fixture fixture;
+	fixture.geometry	= new Geometry();
+	fixture.iteration	= 0;
+
+	unsigned int hash;
+	ShaderSource::Load("CharcoalRendering.vert", fixture.vertexSource, hash);
+	ShaderSource::Load("CharcoalRendering.frag", fixture.fragmentSource, hash);
+	ShaderSource::Load("CharcoalRendering330.vert", fixture.vertexSource330, hash);
+	ShaderSource::Load("CharcoalRendering330.frag", fixture.fragmentSource330, hash);
+
+	//frame times jittering around the budget, some of them over it
+	fixture.recorder.SetBudget(1.0 / 60.0);
+	for(int i=0; i<OVERLAY_FRAMES; i++)
+		fixture.recorder.Record(0.0167 + 0.002 * sin(i * 0.7), 0.004 + 0.001 * sin(i * 1.3), 0.008 + 0.001 * cos(i * 0.9));
+
+	BatchOverlay(fixture);
+
+	if(graphics)
+	{
+		fixture.mesh.Build(fixture.geometry->GetModel());
+		fixture.mesh.Upload();
+
+		if(!fixture.overlay.Init(false))
+			fprintf(stderr, "Could not create the overlay, its draw case does nothing.\n");
+
+		fixture.overlay.SetVisible(true);
+	}
+
+	//after the context, its threads aren't the code measured
+	PerfCounters counters;
+	if(!counters.Open())
+		fprintf(stderr, "No hardware counters (%s).\n", counters.GetError().c_str());
+
+	if(!WriteRLE(TEXTURE_FILE, RLE_FILE))
+		fprintf(stderr, "Could not write %s, the RLE case fails.\n", RLE_FILE);
+	else if(!SamePixels(TEXTURE_FILE, RLE_FILE))
+		fprintf(stderr, "%s doesn't decode like %s.\n", RLE_FILE, TEXTURE_FILE);
+
+	vector<Result> results;
+
+	printf("%-12s %10s %12s %12s %12s %9s %18s%s\n", "case", "iterations", "median us", "min us",
+		   "max us", "stddev", "items/s", counters.IsAvailable() ? "    IPC  misses/item" : "");
+
+	for(int c=0; c<caseCount; c++)
+	{
+		const Case &test = s_Cases[c];
+		if(filter && !strstr(test.name, filter))
+			continue;
+
+		Result result;
+		result.test			= &test;
+		result.iterations	= 1;
+		result.items		= 0.0;
+		PerfCounters::Clear(result.counts);
+
+		//one iteration to see whether it works, then twice as many until a
+		//sample takes -mintime, the first runs are slower than the rest
+		RunSample(test, fixture, 1, result.items, counters, NULL);
+		if(result.items <= 0.0)
+		{
+			fprintf(stderr, "%s failed, skipped.\n", test.name);
+			continue;
+		}
+
+		double perIteration = RunSample(test, fixture, 1, result.items, counters, NULL);
+
+		while(perIteration * result.iterations < minTime && result.iterations < MAX_ITERATIONS)
+		{
+			result.iterations *= 2;
+			perIteration = RunSample(test, fixture, result.iterations, result.items, counters, NULL);
+		}
+
+		for(int rep=0; rep<warmup; rep++)
+			RunSample(test, fixture, result.iterations, result.items, counters, NULL);
+
+		for(int rep=0; rep<reps; rep++)
+			result.samples.push_back(RunSample(test, fixture, result.iterations, result.items, counters, &result.counts));
+
+		vector<double> sorted(result.samples);
+		sort(sorted.begin(), sorted.end());
+
+		double mean = 0.0, variance = 0.0;
+		for(size_t s=0; s<sorted.size(); s++)
+			mean += sorted[s] / sorted.size();
+		for(size_t s=0; s<sorted.size(); s++)
+			variance += (sorted[s] - mean) * (sorted[s] - mean) / sorted.size();
+
+		double median = GetPercentile(sorted, 50.0);
+
+		printf("%-12s %10d %12.3f %12.3f %12.3f %8.1f%% %10.4g %-7s",
+			   test.name, result.iterations, median * 1e6, sorted.front() * 1e6, sorted.back() * 1e6,
+			   mean > 0.0 ? 100.0 * sqrt(variance) / mean : 0.0, result.items / median, test.unit);
+
+		//the cache misses are the ones the loaders & the welding are about
+		if(counters.IsAvailable())
+		{
+			const double *counts = result.counts.counts;
+			double items = result.items * result.iterations * reps;
+
+			printf(" %6.2f %12.4f", counts[PC_CYCLES] > 0.0 ? counts[PC_INSTRUCTIONS] / counts[PC_CYCLES] : 0.0,
+				   counts[PC_CACHE_MISSES] / items);
+		}
+
+		printf("\n");
+
+		results.push_back(result);
+	}
+
+	if(json && !WriteJSON(json, results, counters, graphics, reps, warmup, minTime, pin))
+	{
+		fprintf(stderr, "Could not write %s\n", json);
+		return 1;
+	}
+
+	if(graphics)
+	{
+		fixture.mesh.Release();
+		fixture.overlay.ShutDown();
+		frameBuffer.Release();
+		context.Destroy();
+	}
+
+	return 0;
+}
@@ -11,12 +11,17 @@
 	This file may be used only as long as this copyright notice remains intact.
 */
 
+#ifdef _WIN32
 #include <windows.h>		// Header File For Windows
-#include <gl\gl.h>			// Header File For The OpenGL32 Library
+#endif
+#include <GL/gl.h>			// Header File For The OpenGL32 Library
 
 #include "MilkshapeModel.h"
+#include "Tracer.h"
+#include "MemoryStats.h"
 
 #include <fstream>
+#include <string.h>
 using namespace std;
 
 MilkshapeModel::MilkshapeModel()
@@ -115,7 +120,13 @@ struct MS3DKeyframe
 
 bool MilkshapeModel::loadModelData( const char *filename )
 {
+	TRACE_ZONE("loadModelData");
+
+#ifdef _MSC_VER
 	ifstream inputFile( filename, ios::binary | ios::in | ios::_Nocreate);
+#else
+	ifstream inputFile( filename, ios::binary | ios::in );
+#endif
 	if ( inputFile.fail())
 		return false;	// "Couldn't open the model file."
 
@@ -132,10 +143,16 @@ bool MilkshapeModel::loadModelData( const char *filename )
 	pPtr += sizeof( MS3DHeader );
 
 	if ( strncmp( pHeader->m_ID, "MS3D000000", 10 ) != 0 )
+	{
+		delete[] pBuffer;
 		return false; // "Not a valid Milkshape3D model file."
+	}
 
 	if ( pHeader->m_version < 3 || pHeader->m_version > 4 )
+	{
+		delete[] pBuffer;
 		return false; // "Unhandled file version. Only Milkshape3D Version 1.3 and 1.4 is supported." );
+	}
 
 	int nVertices = *( word* )pPtr; 
 	m_numVertices = nVertices;
@@ -215,6 +232,8 @@ bool MilkshapeModel::loadModelData( const char *filename )
 
 	delete[] pBuffer;
 
+	MemoryStats::Allocate( MC_MESH, MP_CPU, getMemorySize() );
+
 	return true;
 }
 
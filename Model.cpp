@@ -11,10 +11,16 @@
 	This file may be used only as long as this copyright notice remains intact.
 */
 
+#ifdef _WIN32
 #include <windows.h>		// Header File For Windows
-#include <gl\gl.h>			// Header File For The OpenGL32 Library
+#endif
+#include <GL/gl.h>			// Header File For The OpenGL32 Library
 
 #include "Model.h"
+#include "GLStats.h"
+#include "MemoryStats.h"
+
+#include <string.h>
 
 Model::Model()
 {
@@ -30,6 +36,8 @@ Model::Model()
 
 Model::~Model()
 {
+	MemoryStats::Free( MC_MESH, MP_CPU, getMemorySize() );
+
 	int i;
 	for ( i = 0; i < m_numMeshes; i++ )
 		delete[] m_pMeshes[i].m_pTriangleIndices;
@@ -121,6 +129,19 @@ void Model::draw()
 		glDisable( GL_TEXTURE_2D );
 }
 
+size_t Model::getMemorySize() const
+{
+	size_t size = m_numVertices*sizeof( Vertex ) + m_numTriangles*sizeof( Triangle ) +
+				  m_numMeshes*sizeof( Mesh ) + m_numMaterials*sizeof( Material );
+	int i;
+	for ( i = 0; i < m_numMeshes; i++ )
+		size += m_pMeshes[i].m_numTriangles*sizeof( int );
+	for ( i = 0; i < m_numMaterials; i++ )
+		size += strlen( m_pMaterials[i].m_pTextureFilename )+1;
+
+	return size;
+}
+
 void Model::reloadTextures()
 {
 	for ( int i = 0; i < m_numMaterials; i++ )
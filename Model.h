@@ -14,6 +14,8 @@
 #ifndef MODEL_H
 #define MODEL_H
 
+#include <stddef.h>
+
 class Model
 {
 	public:
@@ -72,6 +74,21 @@ class Model
 		*/
 		void reloadTextures();
 
+		/*
+			Read only access to the loaded geometry, used to build vertex buffers.
+		*/
+		int getNumMeshes() const { return m_numMeshes; }
+		const Mesh *getMeshes() const { return m_pMeshes; }
+		int getNumTriangles() const { return m_numTriangles; }
+		const Triangle *getTriangles() const { return m_pTriangles; }
+		int getNumVertices() const { return m_numVertices; }
+		const Vertex *getVertices() const { return m_pVertices; }
+
+		/*
+			Bytes of the arrays above, for the memory accounting.
+		*/
+		size_t getMemorySize() const;
+
 	protected:
 		//	Meshes used
 		int m_numMeshes;
@@ -0,0 +1,19 @@
+#version 330
+//
+//@file	PaperBackground330.frag
+//@brief	Draws the paper texture behind the model in the core profile.
+//
+//@author	Hctor Morales Piloni
+//@date	October 19, 2026
+//
+
+uniform sampler2D paperTex;	//paper texture
+
+in vec2 paperCoord;			//paper texture coordinates
+
+out vec4 fragColor;			//output color
+
+void main()
+{
+	fragColor = texture(paperTex, paperCoord);
+}
@@ -0,0 +1,20 @@
+#version 330
+//
+//@file	PaperBackground330.vert
+//@brief	Draws the paper texture behind the model in the core profile.
+//			A single triangle covers the screen, no vertex buffer needed.
+//
+//@author	Hctor Morales Piloni
+//@date	October 19, 2026
+//
+
+out vec2 paperCoord;	//paper texture coordinates
+
+void main()
+{
+	//(-1,-1), (3,-1), (-1,3)
+	vec2 position = vec2((gl_VertexID & 1) * 4 - 1, (gl_VertexID & 2) * 2 - 1);
+
+	gl_Position = vec4(position, 0.0, 1.0);
+	paperCoord = position * 0.5 + 0.5;
+}
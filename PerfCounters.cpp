@@ -0,0 +1,247 @@
+///============================================================================
+///@file	PerfCounters.cpp
+///@brief	Performance Counters Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "PerfCounters.h"
+#include "FramePacer.h"
+
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+static const char *s_CounterNames[PC_COUNT] = {"cycles", "instructions", "cache_misses", "branch_misses", "tlb_misses"};
+
+#ifdef __linux__
+//type & config of each counter
+static const unsigned int s_CounterTypes[PC_COUNT] =
+{
+	PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE
+};
+
+static const unsigned long long s_CounterConfigs[PC_COUNT] =
+{
+	PERF_COUNT_HW_CPU_CYCLES,
+	PERF_COUNT_HW_INSTRUCTIONS,
+	PERF_COUNT_HW_CACHE_MISSES,
+	PERF_COUNT_HW_BRANCH_MISSES,
+	PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+};
+#endif
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+PerfCounters::PerfCounters()
+{
+	for(int i=0; i<PC_COUNT; i++)
+		m_Counters[i] = -1;
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+PerfCounters::~PerfCounters()
+{
+	Close();
+}
+
+///----------------------------------------------------------------------------
+///Opens the counters of the calling thread, the threads it starts from
+///now on are counted too.
+///@return	true if any counter could be opened, GetError() tells why the
+///			others couldn't
+///----------------------------------------------------------------------------
+bool PerfCounters::Open()
+{
+	Close();
+
+#ifdef __linux__
+	for(int i=0; i<PC_COUNT; i++)
+	{
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+
+		attr.size			= sizeof(attr);
+		attr.type			= s_CounterTypes[i];
+		attr.config			= s_CounterConfigs[i];
+		attr.read_format	= PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		attr.inherit		= 1;	//threads started later add to the counts
+		attr.exclude_kernel	= 1;	//allowed up to perf_event_paranoid 2
+		attr.exclude_hv		= 1;
+
+		m_Counters[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+
+		//the first failure is the reason, usually the same for all
+		if(m_Counters[i] < 0 && m_Error.empty())
+			m_Error = string(s_CounterNames[i]) + ": " + strerror(errno);
+	}
+#else
+	m_Error = "no performance counters on this platform";
+#endif
+
+	return IsAvailable();
+}
+
+///----------------------------------------------------------------------------
+///Closes the counters.
+///----------------------------------------------------------------------------
+void PerfCounters::Close()
+{
+	for(int i=0; i<PC_COUNT; i++)
+	{
+#ifdef __linux__
+		if(m_Counters[i] >= 0)
+			close(m_Counters[i]);
+#endif
+		m_Counters[i] = -1;
+	}
+
+	m_Error.clear();
+}
+
+///----------------------------------------------------------------------------
+///Reads the counts since Open(), scaled up if a counter only ran part of
+///the time because the CPU had more counters open than it has registers.
+///@param	values - receives the counts & the current time
+///----------------------------------------------------------------------------
+void PerfCounters::Read(CounterValues &values) const
+{
+	Clear(values);
+	values.seconds = FramePacer::GetTime();
+
+#ifdef __linux__
+	for(int i=0; i<PC_COUNT; i++)
+	{
+		//value, time enabled & time running
+		unsigned long long data[3];
+
+		if(m_Counters[i] < 0 || read(m_Counters[i], data, sizeof(data)) != sizeof(data))
+			continue;
+
+		values.counts[i] = (data[2] > 0 && data[2] < data[1]) ?
+						   (double)data[0] * data[1] / data[2] : (double)data[0];
+	}
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Tells whether any counter is open.
+///@return	true if zones can have counts
+///----------------------------------------------------------------------------
+bool PerfCounters::IsAvailable() const
+{
+	for(int i=0; i<PC_COUNT; i++)
+		if(m_Counters[i] >= 0)
+			return true;
+
+	return false;
+}
+
+///----------------------------------------------------------------------------
+///Tells whether a counter is open.
+///@param	type - the counter
+///@return	true if its counts are meaningful
+///----------------------------------------------------------------------------
+bool PerfCounters::IsCounting(CounterType type) const
+{
+	return m_Counters[type] >= 0;
+}
+
+///----------------------------------------------------------------------------
+///Gets why counters are missing.
+///@return	the first error of Open(), empty if every counter opened
+///----------------------------------------------------------------------------
+const string& PerfCounters::GetError() const
+{
+	return m_Error;
+}
+
+///----------------------------------------------------------------------------
+///Zeroes counts.
+///@param	values - the counts
+///----------------------------------------------------------------------------
+void PerfCounters::Clear(CounterValues &values)
+{
+	for(int i=0; i<PC_COUNT; i++)
+		values.counts[i] = 0.0;
+
+	values.seconds = 0.0;
+}
+
+///----------------------------------------------------------------------------
+///Adds the counts of a zone to totals.
+///@param	total - the totals
+///@param	start - counts read at the start of the zone
+///@param	end - counts read at its end
+///----------------------------------------------------------------------------
+void PerfCounters::Accumulate(CounterValues &total, const CounterValues &start, const CounterValues &end)
+{
+	for(int i=0; i<PC_COUNT; i++)
+		total.counts[i] += end.counts[i] - start.counts[i];
+
+	total.seconds += end.seconds - start.seconds;
+}
+
+///----------------------------------------------------------------------------
+///Gets the name of a counter.
+///@param	type - the counter
+///@return	its name in reports
+///----------------------------------------------------------------------------
+const char* PerfCounters::GetCounterName(CounterType type)
+{
+	return s_CounterNames[type];
+}
+
+///----------------------------------------------------------------------------
+///Writes counts as a JSON object, with the IPC & each count per item
+///processed ("cache_misses_per_vertex"...). Counters that aren't open are
+///null.
+///@param	file - the output file
+///@param	values - the counts
+///@param	counters - tells which counters are open
+///@param	items - items processed during the counts, for each unit
+///@param	units - what the items are (vertex, texel...)
+///@param	unitCount - number of units
+///----------------------------------------------------------------------------
+void PerfCounters::WriteJSON(FILE *file, const CounterValues &values, const PerfCounters &counters,
+							 const double *items, const char *const *units, int unitCount)
+{
+	fprintf(file, "{\"seconds\": %.6f", values.seconds);
+
+	for(int i=0; i<PC_COUNT; i++)
+	{
+		if(counters.IsCounting((CounterType)i))
+			fprintf(file, ", \"%s\": %.0f", s_CounterNames[i], values.counts[i]);
+		else
+			fprintf(file, ", \"%s\": null", s_CounterNames[i]);
+	}
+
+	if(counters.IsCounting(PC_CYCLES) && counters.IsCounting(PC_INSTRUCTIONS) && values.counts[PC_CYCLES] > 0.0)
+		fprintf(file, ", \"ipc\": %.3f", values.counts[PC_INSTRUCTIONS] / values.counts[PC_CYCLES]);
+	else
+		fprintf(file, ", \"ipc\": null");
+
+	for(int u=0; u<unitCount; u++)
+	{
+		fprintf(file, ", \"%s_count\": %.0f", units[u], items[u]);
+
+		for(int i=0; i<PC_COUNT; i++)
+		{
+			if(counters.IsCounting((CounterType)i) && items[u] > 0.0)
+				fprintf(file, ", \"%s_per_%s\": %.4f", s_CounterNames[i], units[u], values.counts[i] / items[u]);
+			else
+				fprintf(file, ", \"%s_per_%s\": null", s_CounterNames[i], units[u]);
+		}
+	}
+
+	fprintf(file, "}");
+}
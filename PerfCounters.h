@@ -0,0 +1,79 @@
+///============================================================================
+///@file	PerfCounters.h
+///@brief	Hardware performance counters on Linux (perf_event_open):
+///			cycles, instructions, cache, branch & data TLB misses, in user
+///			space, of the thread that opens them and the threads it starts
+///			afterwards. Each counter is opened on its own, so the ones the
+///			CPU, VM or container doesn't offer (or perf_event_paranoid
+///			forbids) are just missing; without any, zones only measure time.
+///			Counters multiplexed with others are scaled by the time they
+///			actually ran. Other platforms have none.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <stdio.h>
+#include <string>
+
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//Counters read
+//-----------------------------------------------------------------------------
+enum CounterType
+{
+	PC_CYCLES = 0,		///> core cycles
+	PC_INSTRUCTIONS,	///> instructions retired
+	PC_CACHE_MISSES,	///> last level cache misses
+	PC_BRANCH_MISSES,	///> mispredicted branches
+	PC_TLB_MISSES,		///> data TLB read misses
+	PC_COUNT
+};
+
+//-----------------------------------------------------------------------------
+//Counts of a zone, or running totals
+//-----------------------------------------------------------------------------
+struct CounterValues
+{
+	double	counts[PC_COUNT];	///> Count of each counter, 0 if it isn't open
+	double	seconds;			///> Wall clock time
+};
+
+class PerfCounters
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	PerfCounters();
+	~PerfCounters();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	bool			Open();
+	void			Close();
+	void			Read(CounterValues &values) const;
+	bool			IsAvailable() const;
+	bool			IsCounting(CounterType type) const;
+	const string&	GetError() const;
+
+	static void			Clear(CounterValues &values);
+	static void			Accumulate(CounterValues &total, const CounterValues &start, const CounterValues &end);
+	static const char*	GetCounterName(CounterType type);
+	static void			WriteJSON(FILE *file, const CounterValues &values, const PerfCounters &counters,
+								  const double *items, const char *const *units, int unitCount);
+
+private:
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	int		m_Counters[PC_COUNT];	///> File descriptor of each counter, -1 if not open
+	string	m_Error;				///> Why counters are missing, empty if none are
+};
+
+#endif
@@ -0,0 +1,775 @@
+///============================================================================
+///@file	PerfOverlay.cpp
+///@brief	Performance Overlay Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "PerfOverlay.h"
+#include "ShaderSource.h"
+#include "MemoryStats.h"
+
+#include <stdio.h>
+#include <stddef.h>
+#include <math.h>
+
+const int FONT_FIRST		= 32;		// First character in the font, ' '
+const int FONT_COUNT		= 95;		// Printable ASCII, up to '~'
+const int FONT_ROWS			= 7;		// Glyph height, 5 bits wide rows
+const int GLYPH_ADVANCE		= 6;		// Font pixels from one character to the next
+const int LINE_HEIGHT		= 9;		// Font pixels from one line to the next
+const int ATLAS_CELL		= 8;		// Atlas pixels per glyph cell
+const int ATLAS_COLUMNS		= 16;		// Glyph cells per atlas row
+const int ATLAS_WIDTH		= 128;
+const int ATLAS_HEIGHT		= 64;
+const int SOLID_CELL		= FONT_COUNT;	// Cell filled in for panels & bars
+const int OVERLAY_MARGIN	= 6;		// Pixels around the panel's contents
+const int GRAPH_BARS		= 120;		// Frames shown by a graph
+const int GRAPH_HEIGHT		= 24;		// Font pixels of a graph's height
+const int RECENT_FRAMES		= 120;		// Frames averaged for the text
+const int STATS_REFRESH		= 15;		// Frames the text is kept, readable & cheaper
+const int OVERLAY_QUADS		= 4096;		// Quads a frame can batch, 16 bit indices
+
+const unsigned int PANEL_COLOR	= 0x000000A0;	// RGBA colors
+const unsigned int GRAPH_COLOR	= 0x30303090;
+const unsigned int BUDGET_COLOR	= 0x808080FF;
+const unsigned int OVER_COLOR	= 0xFF4040FF;
+const unsigned int LABEL_COLOR	= 0xC0C0C0FF;
+
+//-----------------------------------------------------------------------------
+//5x7 font, one byte per row from the top, bit 4 is the leftmost pixel
+//-----------------------------------------------------------------------------
+static const unsigned char s_Font[FONT_COUNT][FONT_ROWS] =
+{
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},	// space
+	{0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04},	// !
+	{0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00},	// "
+	{0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A},	// #
+	{0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04},	// $
+	{0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03},	// %
+	{0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D},	// &
+	{0x04, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00},	// quote
+	{0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02},	// (
+	{0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08},	// )
+	{0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00},	// *
+	{0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00},	// +
+	{0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08},	// ,
+	{0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00},	// -
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C},	// .
+	{0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00},	// /
+	{0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E},	// 0
+	{0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E},	// 1
+	{0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F},	// 2
+	{0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E},	// 3
+	{0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02},	// 4
+	{0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E},	// 5
+	{0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E},	// 6
+	{0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},	// 7
+	{0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E},	// 8
+	{0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C},	// 9
+	{0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00},	// :
+	{0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08},	// ;
+	{0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02},	// <
+	{0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00},	// =
+	{0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08},	// >
+	{0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04},	// ?
+	{0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E},	// @
+	{0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},	// A
+	{0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E},	// B
+	{0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E},	// C
+	{0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C},	// D
+	{0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F},	// E
+	{0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10},	// F
+	{0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F},	// G
+	{0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},	// H
+	{0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},	// I
+	{0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C},	// J
+	{0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11},	// K
+	{0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F},	// L
+	{0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11},	// M
+	{0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11},	// N
+	{0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},	// O
+	{0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10},	// P
+	{0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D},	// Q
+	{0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11},	// R
+	{0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E},	// S
+	{0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},	// T
+	{0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},	// U
+	{0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04},	// V
+	{0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A},	// W
+	{0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11},	// X
+	{0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04},	// Y
+	{0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F},	// Z
+	{0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E},	// [
+	{0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00},	// backslash
+	{0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E},	// ]
+	{0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00},	// ^
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F},	// _
+	{0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00},	// `
+	{0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F},	// a
+	{0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E},	// b
+	{0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E},	// c
+	{0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F},	// d
+	{0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E},	// e
+	{0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08},	// f
+	{0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E},	// g
+	{0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11},	// h
+	{0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E},	// i
+	{0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C},	// j
+	{0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12},	// k
+	{0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},	// l
+	{0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11},	// m
+	{0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11},	// n
+	{0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E},	// o
+	{0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10},	// p
+	{0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01},	// q
+	{0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10},	// r
+	{0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E},	// s
+	{0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06},	// t
+	{0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D},	// u
+	{0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04},	// v
+	{0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A},	// w
+	{0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11},	// x
+	{0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E},	// y
+	{0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F},	// z
+	{0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02},	// {
+	{0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},	// |
+	{0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08},	// }
+	{0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00},	// ~
+};
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+PerfOverlay::PerfOverlay()
+{
+	m_Atlas			= 0;
+	m_Buffer		= 0;
+	m_Indices		= 0;
+	m_VertexArray	= 0;
+	m_BufferSize	= 0;
+	m_Program		= NULL;
+	m_Vertex		= NULL;
+	m_Fragment		= NULL;
+	m_Width			= 0;
+	m_Height		= 0;
+	m_Scale			= 1.0f;
+	m_CursorY		= 0.0f;
+	m_PanelRight	= 0.0f;
+	m_StatsAge		= 0;
+	m_Visible		= false;
+}
+
+///----------------------------------------------------------------------------
+///Default destructor, ShutDown() must have released the GL objects.
+///----------------------------------------------------------------------------
+PerfOverlay::~PerfOverlay()
+{
+	delete m_Program;
+	delete m_Vertex;
+	delete m_Fragment;
+}
+
+///----------------------------------------------------------------------------
+///Creates the atlas, vertex buffer & shaders, the context must be current
+///& its extensions initialized.
+///@param	coreProfile - whether the context is a core profile one
+///@return	true if the overlay can be drawn
+///----------------------------------------------------------------------------
+bool PerfOverlay::Init(bool coreProfile)
+{
+	ShutDown();
+
+	const GLCapabilities &caps = GetCapabilities();
+
+	if(!caps.shaderObjects || !glGenBuffers)
+		return false;
+
+	if(!CreateAtlas() || !CreateProgram(coreProfile))
+	{
+		ShutDown();
+		return false;
+	}
+
+	glGenBuffers(1, &m_Buffer);
+	CreateIndices();
+
+	if(caps.vertexArrayObjects)
+		glGenVertexArrays(1, &m_VertexArray);
+
+	//the attribute layout is set once when there is a vertex array
+	if(m_VertexArray)
+	{
+		glBindVertexArray(m_VertexArray);
+		glBindBuffer(GL_ARRAY_BUFFER, m_Buffer);
+		glEnableVertexAttribArray(0);
+		glEnableVertexAttribArray(1);
+		glEnableVertexAttribArray(2);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)offsetof(Vertex, x));
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)offsetof(Vertex, u));
+		glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (const GLvoid*)offsetof(Vertex, color));
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Indices);
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Deletes the GL objects, the context must still be current.
+///----------------------------------------------------------------------------
+void PerfOverlay::ShutDown()
+{
+	if(m_Atlas)
+	{
+		glDeleteTextures(1, &m_Atlas);
+		MemoryStats::Free(MC_TEXTURE, MP_GPU, MemoryStats::GetTextureSize(ATLAS_WIDTH, ATLAS_HEIGHT, GL_RGBA8));
+	}
+
+	if(m_Buffer)
+		glDeleteBuffers(1, &m_Buffer);
+
+	if(m_Indices)
+	{
+		glDeleteBuffers(1, &m_Indices);
+		MemoryStats::Free(MC_FRAME, MP_GPU, OVERLAY_QUADS * 6 * sizeof(GLushort));
+	}
+
+	MemoryStats::Free(MC_FRAME, MP_GPU, m_BufferSize);
+	m_BufferSize = 0;
+
+	if(m_VertexArray)
+		glDeleteVertexArrays(1, &m_VertexArray);
+
+	delete m_Program;
+	delete m_Vertex;
+	delete m_Fragment;
+
+	m_Atlas			= 0;
+	m_Buffer		= 0;
+	m_Indices		= 0;
+	m_VertexArray	= 0;
+	m_Program		= NULL;
+	m_Vertex		= NULL;
+	m_Fragment		= NULL;
+
+	m_Vertices.clear();
+	m_Stats.clear();
+}
+
+///----------------------------------------------------------------------------
+///Shows or hides the overlay.
+///@param	visible - true to draw it
+///----------------------------------------------------------------------------
+void PerfOverlay::SetVisible(bool visible)
+{
+	//stale text isn't shown for STATS_REFRESH frames after a while hidden
+	if(visible && !m_Visible)
+		m_Stats.clear();
+
+	m_Visible = visible;
+}
+
+///----------------------------------------------------------------------------
+///Shows the overlay if hidden & hides it if shown.
+///----------------------------------------------------------------------------
+void PerfOverlay::Toggle()
+{
+	SetVisible(!m_Visible);
+}
+
+///----------------------------------------------------------------------------
+///Tells whether the overlay is shown.
+///@return	true if it is drawn
+///----------------------------------------------------------------------------
+bool PerfOverlay::IsVisible() const
+{
+	return m_Visible;
+}
+
+///----------------------------------------------------------------------------
+///Starts a new batch. The panel behind the lines & graphs is the first
+///quad, its size is filled in by Draw().
+///@param	width - viewport width
+///@param	height - viewport height
+///----------------------------------------------------------------------------
+void PerfOverlay::Begin(int width, int height)
+{
+	m_Width		= width;
+	m_Height	= height;
+
+	//twice the size on large screens so it stays readable
+	m_Scale			= (height >= 720) ? 2.0f : 1.0f;
+	m_CursorY		= (float)OVERLAY_MARGIN;
+	m_PanelRight	= 0.0f;
+
+	m_Vertices.clear();
+	AddRect(0.0f, 0.0f, 0.0f, 0.0f, PANEL_COLOR);
+}
+
+///----------------------------------------------------------------------------
+///Adds a line of text under the previous one.
+///@param	text - the text, printable ASCII
+///@param	color - RGBA color, i.e. 0xFFFFFFFF for white
+///----------------------------------------------------------------------------
+void PerfOverlay::AddLine(const char *text, unsigned int color)
+{
+	AddText((float)OVERLAY_MARGIN, m_CursorY, text, color);
+	m_CursorY += LINE_HEIGHT * m_Scale;
+}
+
+///----------------------------------------------------------------------------
+///Adds text at any position.
+///@param	x, y - top left corner, in pixels from the top left of the screen
+///@param	text - the text, printable ASCII
+///@param	color - RGBA color
+///----------------------------------------------------------------------------
+void PerfOverlay::AddText(float x, float y, const char *text, unsigned int color)
+{
+	const float width	= 5 * m_Scale;
+	const float height	= FONT_ROWS * m_Scale;
+
+	for(const char *c = text; *c; c++, x += GLYPH_ADVANCE * m_Scale)
+	{
+		int glyph = (unsigned char)*c - FONT_FIRST;
+
+		if(glyph == 0)
+			continue;
+
+		if(glyph < 0 || glyph >= FONT_COUNT)
+			glyph = '?' - FONT_FIRST;
+
+		float u = (float)(glyph % ATLAS_COLUMNS * ATLAS_CELL) / ATLAS_WIDTH;
+		float v = (float)(glyph / ATLAS_COLUMNS * ATLAS_CELL) / ATLAS_HEIGHT;
+
+		AddQuad(x, y, x + width, y + height, 
+				u, v, u + 5.0f / ATLAS_WIDTH, v + (float)FONT_ROWS / ATLAS_HEIGHT, color);
+	}
+
+	if(x > m_PanelRight)
+		m_PanelRight = x;
+}
+
+///----------------------------------------------------------------------------
+///Adds a filled rectangle.
+///@param	x, y - top left corner, in pixels from the top left of the screen
+///@param	width, height - size in pixels
+///@param	color - RGBA color
+///----------------------------------------------------------------------------
+void PerfOverlay::AddRect(float x, float y, float width, float height, unsigned int color)
+{
+	//the middle of the solid cell, so filtering can't reach a glyph
+	float u = (SOLID_CELL % ATLAS_COLUMNS * ATLAS_CELL + ATLAS_CELL * 0.5f) / ATLAS_WIDTH;
+	float v = (SOLID_CELL / ATLAS_COLUMNS * ATLAS_CELL + ATLAS_CELL * 0.5f) / ATLAS_HEIGHT;
+
+	AddQuad(x, y, x + width, y + height, u, v, u, v, color);
+}
+
+///----------------------------------------------------------------------------
+///Adds a bar graph of the last frames, the newest on the right. Full
+///height is twice the budget, the bars going over it are red.
+///@param	x, y - top left corner, in pixels from the top left of the screen
+///@param	width, height - size in pixels
+///@param	recorder - the frames
+///@param	series - which time of the frames to show
+///@param	budget - frame time budget in seconds, 0 to use 30 FPS
+///@param	color - RGBA color of the bars within the budget
+///----------------------------------------------------------------------------
+void PerfOverlay::AddGraph(float x, float y, float width, float height, const FrameRecorder &recorder,
+						   FrameSeries series, double budget, unsigned int color)
+{
+	if(budget <= 0.0)
+		budget = 1.0 / 30.0;
+
+	AddRect(x, y, width, height, GRAPH_COLOR);
+	AddRect(x, y + height * 0.5f, width, m_Scale, BUDGET_COLOR);
+
+	int bars = (int)(width / m_Scale);
+	if(bars > (int)recorder.GetSampleCount())
+		bars = (int)recorder.GetSampleCount();
+
+	//a run of bars of the same height & color is one quad, from runLeft
+	//to runRight; tops are whole pixels so steady frames make long runs
+	float runLeft = 0.0f, runRight = 0.0f, runTop = 0.0f;
+	unsigned int runColor = 0;
+
+	for(int i=0; i<=bars; i++)
+	{
+		float left = x + width - (i + 1) * m_Scale;
+		float top = 0.0f;
+		unsigned int barColor = 0;
+		bool bar = false;
+
+		if(i < bars)
+		{
+			const FrameSample &sample = recorder.GetSample(i);
+			double time = (series == FS_FRAME) ? sample.frameTime : (series == FS_CPU) ? sample.cpuTime : sample.gpuTime;
+
+			//GPU times arrive a few frames late
+			if(time >= 0.0)
+			{
+				float fraction = (float)(time / (2.0 * budget));
+				if(fraction > 1.0f)
+					fraction = 1.0f;
+
+				top			= floorf(y + height * (1.0f - fraction) + 0.5f);
+				barColor	= (time > budget) ? OVER_COLOR : color;
+				bar			= true;
+			}
+		}
+
+		//extend the run to the left, or close it
+		if(bar && runRight > runLeft && top == runTop && barColor == runColor)
+		{
+			runLeft = left;
+			continue;
+		}
+
+		if(runRight > runLeft)
+			AddRect(runLeft, runTop, runRight - runLeft, y + height - runTop, runColor);
+
+		runLeft		= left;
+		runRight	= bar ? left + m_Scale : left;
+		runTop		= top;
+		runColor	= barColor;
+	}
+
+	if(x + width > m_PanelRight)
+		m_PanelRight = x + width;
+}
+
+///----------------------------------------------------------------------------
+///Adds the standard statistics under the lines added so far: recent &
+///overall frame, CPU & GPU times, stutters, per stage times and a graph of
+///each series. The text is formatted again every STATS_REFRESH frames, the
+///graphs every frame.
+///@param	recorder - the frames
+///@param	profiler - the per stage times, or NULL
+///----------------------------------------------------------------------------
+void PerfOverlay::AddStats(const FrameRecorder &recorder, const GpuProfiler *profiler)
+{
+	const FrameSeries series[3]			= {FS_FRAME, FS_CPU, FS_GPU};
+	const char *names[3]				= {"frame", "cpu", "gpu"};
+	const unsigned int colors[3]		= {0x80FF80FF, 0xFFE060FF, 0x60C0FFFF};
+
+	if(m_Stats.empty() || ++m_StatsAge >= STATS_REFRESH)
+	{
+		FormatStats(recorder, profiler);
+		m_StatsAge = 0;
+	}
+
+	for(size_t i=0; i<m_Stats.size(); i++)
+		AddLine(m_Stats[i].text, m_Stats[i].color);
+
+	//one graph per series, labelled in its corner
+	const float width = GRAPH_BARS * m_Scale;
+	const float height = GRAPH_HEIGHT * m_Scale;
+
+	for(int s=0; s<3; s++)
+	{
+		m_CursorY += m_Scale * 2;
+		AddGraph((float)OVERLAY_MARGIN, m_CursorY, width, height, recorder, series[s], recorder.GetBudget(), colors[s]);
+		AddText(OVERLAY_MARGIN + m_Scale, m_CursorY + m_Scale, names[s], LABEL_COLOR);
+		m_CursorY += height;
+	}
+}
+
+///----------------------------------------------------------------------------
+///Formats the text lines of AddStats() into m_Stats.
+///@param	recorder - the frames
+///@param	profiler - the per stage times, or NULL
+///----------------------------------------------------------------------------
+void PerfOverlay::FormatStats(const FrameRecorder &recorder, const GpuProfiler *profiler)
+{
+	const char *names[3]				= {"frame", "cpu", "gpu"};
+	const unsigned int colors[3]		= {0x80FF80FF, 0xFFE060FF, 0x60C0FFFF};
+	const FrameHistogram *histograms[3]	= {&recorder.GetFrameTimes(), &recorder.GetCpuTimes(), &recorder.GetGpuTimes()};
+	StatsLine line;
+
+	m_Stats.clear();
+
+	//mean & max of the recent frames, p99 of the whole run
+	for(int s=0; s<3; s++)
+	{
+		double sum = 0.0, peak = 0.0;
+		int count = 0;
+
+		for(unsigned int i=0; i<recorder.GetSampleCount() && i<RECENT_FRAMES; i++)
+		{
+			const FrameSample &sample = recorder.GetSample(i);
+			double time = (s == 0) ? sample.frameTime : (s == 1) ? sample.cpuTime : sample.gpuTime;
+
+			if(time < 0.0)
+				continue;
+
+			sum += time;
+			peak = (time > peak) ? time : peak;
+			count++;
+		}
+
+		if(count > 0)
+			sprintf(line.text, "%-5s %6.2f ms  max %6.2f  p99 %6.2f", names[s], 
+					sum / count * 1000.0, peak * 1000.0, histograms[s]->GetPercentile(99.0) * 1000.0);
+		else
+			sprintf(line.text, "%-5s     -", names[s]);
+
+		line.color = colors[s];
+		m_Stats.push_back(line);
+	}
+
+	sprintf(line.text, "stutters %lu  over budget %lu", recorder.GetStutterCount(), recorder.GetOverBudgetCount());
+	line.color = LABEL_COLOR;
+	m_Stats.push_back(line);
+
+	//live memory & high-water marks, in the builds that account them
+	if(MemoryStats::IsCompiledIn())
+	{
+		MemoryStats::GetSummary(line.text);
+		line.color = LABEL_COLOR;
+		m_Stats.push_back(line);
+	}
+
+	if(profiler)
+	{
+		for(int i=RS_PAPER; i<RS_COUNT; i++)
+		{
+			const FrameHistogram &cpu = profiler->GetCpuTimes((RenderStage)i);
+			const FrameHistogram &gpu = profiler->GetGpuTimes((RenderStage)i);
+
+			if(cpu.GetCount() == 0)
+				continue;
+
+			if(gpu.GetCount() > 0)
+				sprintf(line.text, "%-8s cpu %6.3f  gpu %6.3f", GpuProfiler::GetStageName((RenderStage)i),
+						cpu.GetMean() * 1000.0, gpu.GetMean() * 1000.0);
+			else
+				sprintf(line.text, "%-8s cpu %6.3f", GpuProfiler::GetStageName((RenderStage)i), cpu.GetMean() * 1000.0);
+
+			line.color = LABEL_COLOR;
+			m_Stats.push_back(line);
+		}
+	}
+}
+
+///----------------------------------------------------------------------------
+///Uploads the batch & draws it with one call over the frame. Nothing is
+///queried: the overlay leaves the state the backends draw with, the depth
+///test on & blending off, and the atlas bound to unit 0 (the backends bind
+///their own textures).
+///----------------------------------------------------------------------------
+void PerfOverlay::Draw()
+{
+	if(!m_Visible || !m_Program || m_Vertices.size() <= 4)
+		return;
+
+	//the panel behind everything, now that its size is known
+	float right = m_PanelRight + OVERLAY_MARGIN;
+	float bottom = m_CursorY + OVERLAY_MARGIN;
+	m_Vertices[1].x = m_Vertices[2].x = right;
+	m_Vertices[2].y = m_Vertices[3].y = bottom;
+
+	GLsizei indices = (GLsizei)(m_Vertices.size() / 4 * 6);
+
+	glDisable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, m_Atlas);
+
+	m_Program->EnableShader();
+	m_Program->SetUniform("screenSize", (GLfloat)m_Width, (GLfloat)m_Height);
+	m_Program->SetUniform("atlasTex", 0);
+
+	//a new store every frame, the driver doesn't wait for the last one
+	glBindBuffer(GL_ARRAY_BUFFER, m_Buffer);
+	glBufferData(GL_ARRAY_BUFFER, m_Vertices.size() * sizeof(Vertex), &m_Vertices[0], GL_STREAM_DRAW);
+
+	MemoryStats::Free(MC_FRAME, MP_GPU, m_BufferSize);
+	m_BufferSize = m_Vertices.size() * sizeof(Vertex);
+	MemoryStats::Allocate(MC_FRAME, MP_GPU, m_BufferSize);
+
+	if(m_VertexArray)
+	{
+		glBindVertexArray(m_VertexArray);
+		glDrawElements(GL_TRIANGLES, indices, GL_UNSIGNED_SHORT, 0);
+		glBindVertexArray(0);
+	}
+	else
+	{
+		glEnableVertexAttribArray(0);
+		glEnableVertexAttribArray(1);
+		glEnableVertexAttribArray(2);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)offsetof(Vertex, x));
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)offsetof(Vertex, u));
+		glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (const GLvoid*)offsetof(Vertex, color));
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Indices);
+		glDrawElements(GL_TRIANGLES, indices, GL_UNSIGNED_SHORT, 0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+		glDisableVertexAttribArray(0);
+		glDisableVertexAttribArray(1);
+		glDisableVertexAttribArray(2);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	m_Program->DisableShader();
+
+	glDisable(GL_BLEND);
+	glEnable(GL_DEPTH_TEST);
+}
+
+///----------------------------------------------------------------------------
+///Gets the size of the batch.
+///@return	the vertices added since Begin()
+///----------------------------------------------------------------------------
+unsigned int PerfOverlay::GetVertexCount() const
+{
+	return (unsigned int)m_Vertices.size();
+}
+
+///----------------------------------------------------------------------------
+///Adds the four corners of a rectangle, the index buffer makes them two
+///triangles. Quads past OVERLAY_QUADS are dropped.
+///@param	x0, y0, x1, y1 - top left & bottom right corners, in pixels
+///@param	u0, v0, u1, v1 - atlas coordinates of those corners
+///@param	color - RGBA color
+///----------------------------------------------------------------------------
+void PerfOverlay::AddQuad(float x0, float y0, float x1, float y1,
+						  float u0, float v0, float u1, float v1, unsigned int color)
+{
+	if(m_Vertices.size() >= OVERLAY_QUADS * 4)
+		return;
+
+	Vertex corners[4];
+
+	corners[0].x = x0;	corners[0].y = y0;	corners[0].u = u0;	corners[0].v = v0;
+	corners[1].x = x1;	corners[1].y = y0;	corners[1].u = u1;	corners[1].v = v0;
+	corners[2].x = x1;	corners[2].y = y1;	corners[2].u = u1;	corners[2].v = v1;
+	corners[3].x = x0;	corners[3].y = y1;	corners[3].u = u0;	corners[3].v = v1;
+
+	for(int i=0; i<4; i++)
+	{
+		corners[i].color[0] = (GLubyte)(color >> 24);
+		corners[i].color[1] = (GLubyte)(color >> 16);
+		corners[i].color[2] = (GLubyte)(color >> 8);
+		corners[i].color[3] = (GLubyte)color;
+	}
+
+	//Draw() stretches the panel by moving 1, 2 & 3
+	m_Vertices.insert(m_Vertices.end(), corners, corners + 4);
+}
+
+///----------------------------------------------------------------------------
+///Creates the index buffer shared by every frame: 0 1 2, 0 2 3 for each
+///of OVERLAY_QUADS quads.
+///----------------------------------------------------------------------------
+void PerfOverlay::CreateIndices()
+{
+	vector<GLushort> indices(OVERLAY_QUADS * 6);
+
+	for(int i=0; i<OVERLAY_QUADS; i++)
+	{
+		GLushort first = (GLushort)(i * 4);
+
+		indices[i * 6 + 0] = first;
+		indices[i * 6 + 1] = first + 1;
+		indices[i * 6 + 2] = first + 2;
+		indices[i * 6 + 3] = first;
+		indices[i * 6 + 4] = first + 2;
+		indices[i * 6 + 5] = first + 3;
+	}
+
+	glGenBuffers(1, &m_Indices);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Indices);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), &indices[0], GL_STATIC_DRAW);
+
+	MemoryStats::Allocate(MC_FRAME, MP_GPU, indices.size() * sizeof(GLushort));
+}
+
+///----------------------------------------------------------------------------
+///Bakes the font into the atlas texture: white texels whose alpha is the
+///glyph's coverage, one 8x8 cell per character and a solid cell last.
+///@return	true if the texture was created
+///----------------------------------------------------------------------------
+bool PerfOverlay::CreateAtlas()
+{
+	vector<GLubyte> texels(ATLAS_WIDTH * ATLAS_HEIGHT * 4, 255);
+
+	for(int y=0; y<ATLAS_HEIGHT; y++)
+	{
+		for(int x=0; x<ATLAS_WIDTH; x++)
+		{
+			int cell = (y / ATLAS_CELL) * ATLAS_COLUMNS + x / ATLAS_CELL;
+			int column = x % ATLAS_CELL;
+			int row = y % ATLAS_CELL;
+			bool set;
+
+			if(cell == SOLID_CELL)
+				set = true;
+			else if(cell < FONT_COUNT && column < 5 && row < FONT_ROWS)
+				set = ((s_Font[cell][row] >> (4 - column)) & 1) != 0;
+			else
+				set = false;
+
+			texels[(y * ATLAS_WIDTH + x) * 4 + 3] = set ? 255 : 0;
+		}
+	}
+
+	GLint previous = 0;
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous);
+
+	glGenTextures(1, &m_Atlas);
+	glBindTexture(GL_TEXTURE_2D, m_Atlas);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, ATLAS_WIDTH, ATLAS_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, &texels[0]);
+	glBindTexture(GL_TEXTURE_2D, previous);
+
+	MemoryStats::Allocate(MC_TEXTURE, MP_GPU, MemoryStats::GetTextureSize(ATLAS_WIDTH, ATLAS_HEIGHT, GL_RGBA8));
+
+	return m_Atlas != 0;
+}
+
+///----------------------------------------------------------------------------
+///Builds the overlay program, GLSL 3.30 for core profiles & 1.10 otherwise.
+///@param	coreProfile - whether the context is a core profile one
+///@return	true if the program linked
+///----------------------------------------------------------------------------
+bool PerfOverlay::CreateProgram(bool coreProfile)
+{
+	string vertexSource, fragmentSource;
+	unsigned int hash;
+
+	if(!ShaderSource::Load(coreProfile ? "PerfOverlay330.vert" : "PerfOverlay.vert", vertexSource, hash) ||
+	   !ShaderSource::Load(coreProfile ? "PerfOverlay330.frag" : "PerfOverlay.frag", fragmentSource, hash))
+		return false;
+
+	m_Vertex	= new ShaderObject(GL_VERTEX_SHADER, vertexSource, "");
+	m_Fragment	= new ShaderObject(GL_FRAGMENT_SHADER, fragmentSource, "");
+	m_Program	= new ShaderProgram();
+
+	m_Program->CreateShader();
+	m_Program->AttachObject(m_Vertex);
+	m_Program->AttachObject(m_Fragment);
+	m_Program->BindAttribute(0, "position");
+	m_Program->BindAttribute(1, "texCoord");
+	m_Program->BindAttribute(2, "color");
+	m_Program->Link();
+
+	if(m_Program->IsLinked())
+		return true;
+
+	OutputDebugString("Performance overlay program failed to build:\n");
+	OutputDebugString(m_Vertex->GetLog().c_str());
+	OutputDebugString(m_Fragment->GetLog().c_str());
+	OutputDebugString(m_Program->GetLog().c_str());
+
+	return false;
+}
@@ -0,0 +1,18 @@
+//
+//@file	PerfOverlay.frag
+//@brief	Performance overlay fragment shader (GLSL 1.10), the atlas holds
+//			the coverage of the glyphs
+//
+//@author	Hctor Morales Piloni
+//@date	October 19, 2026
+//
+
+uniform sampler2D atlasTex;	//glyph atlas
+
+varying vec2 atlasCoord;	//glyph atlas coordinates
+varying vec4 overlayColor;	//vertex color
+
+void main()
+{
+	gl_FragColor = vec4(overlayColor.rgb, overlayColor.a * texture2D(atlasTex, atlasCoord).a);
+}
@@ -0,0 +1,122 @@
+///============================================================================
+///@file	PerfOverlay.h
+///@brief	On screen performance overlay: frame rate, frame/CPU/GPU time
+///			percentiles, per stage times and graphs of the last frames.
+///			Glyphs come from a 5x7 font baked into a small atlas texture;
+///			every character, panel & graph bar of a frame is batched into
+///			one vertex buffer and drawn with a single indexed call, four
+///			vertices a quad. Graph bars of the same height & color next to
+///			each other are merged into one quad.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef PERFOVERLAY_H
+#define PERFOVERLAY_H
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <vector>
+
+#include "FrameRecorder.h"
+#include "GpuProfiler.h"
+#include "ShaderProgram.h"
+#include "ShaderObject.h"
+#include "GLExtensions.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//Times of a frame a graph can show
+//-----------------------------------------------------------------------------
+enum FrameSeries
+{
+	FS_FRAME = 0,	///> time since the previous frame
+	FS_CPU,			///> CPU time
+	FS_GPU			///> GPU time
+};
+
+class PerfOverlay
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	PerfOverlay();
+	~PerfOverlay();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	bool	Init(bool coreProfile);
+	void	ShutDown();
+	void	SetVisible(bool visible);
+	void	Toggle();
+	bool	IsVisible() const;
+
+	void	Begin(int width, int height);
+	void	AddLine(const char *text, unsigned int color = 0xFFFFFFFF);
+	void	AddText(float x, float y, const char *text, unsigned int color);
+	void	AddRect(float x, float y, float width, float height, unsigned int color);
+	void	AddGraph(float x, float y, float width, float height, const FrameRecorder &recorder,
+					 FrameSeries series, double budget, unsigned int color);
+	void	AddStats(const FrameRecorder &recorder, const GpuProfiler *profiler);
+	void	Draw();
+
+	unsigned int	GetVertexCount() const;
+
+private:
+	//-------------------------------------------------------------------------
+	//Private types
+	//-------------------------------------------------------------------------
+	struct Vertex
+	{
+		GLfloat	x, y;		///> Position, in pixels from the top left corner
+		GLfloat	u, v;		///> Atlas coordinates
+		GLubyte	color[4];	///> RGBA color
+	};
+
+	struct StatsLine
+	{
+		char			text[128];	///> Formatted line
+		unsigned int	color;		///> RGBA color
+	};
+
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	void	AddQuad(float x0, float y0, float x1, float y1,
+					float u0, float v0, float u1, float v1, unsigned int color);
+	void	FormatStats(const FrameRecorder &recorder, const GpuProfiler *profiler);
+	bool	CreateAtlas();
+	void	CreateIndices();
+	bool	CreateProgram(bool coreProfile);
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	vector<Vertex>	m_Vertices;		///> Batch of the current frame
+	vector<StatsLine>	m_Stats;	///> Text of AddStats(), formatted every STATS_REFRESH frames
+	int				m_StatsAge;		///> Frames since m_Stats was formatted
+	GLuint			m_Atlas;		///> Glyph atlas texture
+	GLuint			m_Buffer;		///> Vertex buffer the batch is streamed to
+	GLuint			m_Indices;		///> Index buffer of OVERLAY_QUADS quads, never changes
+	GLuint			m_VertexArray;	///> Vertex array object, 0 if not supported
+	size_t			m_BufferSize;	///> Bytes of the vertex buffer's store
+	ShaderProgram	*m_Program;		///> Overlay shader program
+	ShaderObject	*m_Vertex;		///> Overlay vertex shader
+	ShaderObject	*m_Fragment;	///> Overlay fragment shader
+	int				m_Width;		///> Viewport width
+	int				m_Height;		///> Viewport height
+	float			m_Scale;		///> Pixels per font pixel
+	float			m_CursorY;		///> Top of the next AddLine()
+	float			m_PanelRight;	///> Right edge of the lines & graphs so far
+	bool			m_Visible;		///> Drawn or not
+};
+
+#endif
@@ -0,0 +1,25 @@
+//
+//@file	PerfOverlay.vert
+//@brief	Performance overlay vertex shader (GLSL 1.10): text & graphs
+//			given in pixels from the top left corner of the screen
+//
+//@author	Hctor Morales Piloni
+//@date	October 19, 2026
+//
+
+uniform vec2 screenSize;	//viewport size, in pixels
+
+attribute vec2 position;	//vertex position, in pixels
+attribute vec2 texCoord;	//glyph atlas coordinates
+attribute vec4 color;		//vertex color
+
+varying vec2 atlasCoord;	//glyph atlas coordinates
+varying vec4 overlayColor;	//vertex color
+
+void main()
+{
+	gl_Position = vec4(position.x * 2.0 / screenSize.x - 1.0, 1.0 - position.y * 2.0 / screenSize.y, 0.0, 1.0);
+
+	atlasCoord = texCoord;
+	overlayColor = color;
+}
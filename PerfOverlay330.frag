@@ -0,0 +1,21 @@
+#version 330
+//
+//@file	PerfOverlay330.frag
+//@brief	Performance overlay fragment shader for the core profile, the
+//			atlas holds the coverage of the glyphs
+//
+//@author	Hctor Morales Piloni
+//@date	October 19, 2026
+//
+
+uniform sampler2D atlasTex;	//glyph atlas
+
+in vec2 atlasCoord;			//glyph atlas coordinates
+in vec4 overlayColor;		//vertex color
+
+out vec4 fragColor;			//output color
+
+void main()
+{
+	fragColor = vec4(overlayColor.rgb, overlayColor.a * texture(atlasTex, atlasCoord).a);
+}
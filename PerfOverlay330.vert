@@ -0,0 +1,26 @@
+#version 330
+//
+//@file	PerfOverlay330.vert
+//@brief	Performance overlay vertex shader for the core profile: text &
+//			graphs given in pixels from the top left corner of the screen
+//
+//@author	Hctor Morales Piloni
+//@date	October 19, 2026
+//
+
+layout(location = 0) in vec2 position;	//vertex position, in pixels
+layout(location = 1) in vec2 texCoord;	//glyph atlas coordinates
+layout(location = 2) in vec4 color;		//vertex color
+
+uniform vec2 screenSize;	//viewport size, in pixels
+
+out vec2 atlasCoord;		//glyph atlas coordinates
+out vec4 overlayColor;		//vertex color
+
+void main()
+{
+	gl_Position = vec4(position.x * 2.0 / screenSize.x - 1.0, 1.0 - position.y * 2.0 / screenSize.y, 0.0, 1.0);
+
+	atlasCoord = texCoord;
+	overlayColor = color;
+}
@@ -0,0 +1,191 @@
+///============================================================================
+///@file	RenderBackend.cpp
+///@brief	Render Backend Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "RenderBackend.h"
+#include "MatrixMath.h"
+
+///----------------------------------------------------------------------------
+///Constructor.
+///@param	vertexFile - charcoal vertex shader source name
+///@param	fragmentFile - charcoal fragment shader source name
+///----------------------------------------------------------------------------
+RenderBackend::RenderBackend(const char *vertexFile, const char *fragmentFile)
+{
+	m_Geometry		= NULL;
+	m_VertexFile	= vertexFile;
+	m_FragmentFile	= fragmentFile;
+
+	m_Stats.drawCalls	= 0;
+	m_Stats.triangles	= 0;
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+RenderBackend::~RenderBackend()
+{
+}
+
+///----------------------------------------------------------------------------
+///Gets the charcoal shader variants of this backend.
+///@return	the shader permutation cache
+///----------------------------------------------------------------------------
+ShaderPermutation& RenderBackend::GetShaders()
+{
+	return m_Shaders;
+}
+
+///----------------------------------------------------------------------------
+///Gets the charcoal vertex shader file, i.e. the one to watch for changes.
+///@return	the file name
+///----------------------------------------------------------------------------
+const char* RenderBackend::GetVertexFile() const
+{
+	return m_VertexFile;
+}
+
+///----------------------------------------------------------------------------
+///Gets the charcoal fragment shader file, i.e. the one to watch for changes.
+///@return	the file name
+///----------------------------------------------------------------------------
+const char* RenderBackend::GetFragmentFile() const
+{
+	return m_FragmentFile;
+}
+
+///----------------------------------------------------------------------------
+///Gets what the last frame submitted, i.e. for the benchmark report.
+///@return	the draw call & triangle counts
+///----------------------------------------------------------------------------
+const DrawStats& RenderBackend::GetDrawStats() const
+{
+	return m_Stats;
+}
+
+///----------------------------------------------------------------------------
+///Loads the charcoal shader sources, the variants are compiled on demand.
+///@return	true if both sources were found
+///----------------------------------------------------------------------------
+bool RenderBackend::InitShaders()
+{
+	return m_Shaders.SetSources(m_VertexFile, m_FragmentFile);
+}
+
+///----------------------------------------------------------------------------
+///Binds the textures the charcoal shader reads & gets the variant for the
+///requested tier, or whatever is ready if it's still compiling.
+///@param	quality - the requested quality tier
+///@return	the program to use, NULL if no variant has finished yet or the
+///			context has no GLSL support
+///----------------------------------------------------------------------------
+ShaderProgram* RenderBackend::BindShader(QualityTier quality)
+{
+	if(!GetCapabilities().shaderObjects)
+		return NULL;
+
+	//never waits for the compiler
+	ShaderProgram *shader = m_Shaders.Acquire(ShaderPermutation::GetTierFeatures(quality));
+	GLuint lookup = (m_Shaders.GetCurrentFeatures() & SF_CEO_LUT) ? m_Shaders.GetLookupTexture() : 0;
+
+	//bind textures that our shader will use
+	if(GetCapabilities().directStateAccess)
+	{
+		//no active texture unit switches
+		glBindTextureUnit(0, m_Geometry->GetTexObj(0));
+		glBindTextureUnit(1, m_Geometry->GetTexObj(1));
+		glBindTextureUnit(2, m_Geometry->GetTexObj(2));
+		if(lookup)
+			glBindTextureUnit(3, lookup);
+
+		return shader;
+	}
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, m_Geometry->GetTexObj(0));
+
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, m_Geometry->GetTexObj(1));
+
+	glActiveTexture(GL_TEXTURE2);
+	glBindTexture(GL_TEXTURE_2D, m_Geometry->GetTexObj(2));
+
+	if(lookup)
+	{
+		glActiveTexture(GL_TEXTURE3);
+		glBindTexture(GL_TEXTURE_2D, lookup);
+	}
+
+	glActiveTexture(GL_TEXTURE0);
+
+	return shader;
+}
+
+///----------------------------------------------------------------------------
+///Sets the texture units of the charcoal shader samplers.
+///@param	shader - the enabled charcoal program
+///----------------------------------------------------------------------------
+void RenderBackend::SetSamplers(ShaderProgram *shader)
+{
+	shader->SetUniform("paperTex", 0);
+	shader->SetUniform("noiseTex", 1);
+	shader->SetUniform("CET", 2);
+	shader->SetUniform("ceoLUT", 3);
+}
+
+///----------------------------------------------------------------------------
+///Computes the camera projection, what gluPerspective() used to build.
+///@param	width - viewport width
+///@param	height - viewport height
+///@param	projection - receives the column-major matrix
+///----------------------------------------------------------------------------
+void RenderBackend::ComputeProjection(int width, int height, GLfloat *projection)
+{
+	GLfloat aspect = (height > 0) ? (GLfloat)width / height : 1.0f;
+
+	PerspectiveMatrix(FIELD_OF_VIEW, aspect, NEAR_PLANE, FAR_PLANE, projection);
+}
+
+///----------------------------------------------------------------------------
+///Computes the camera view, looking at (0,30,0) from the camera position.
+///@param	geometry - the scene geometry (camera position)
+///@param	view - receives the column-major matrix
+///----------------------------------------------------------------------------
+void RenderBackend::ComputeView(const Geometry *geometry, GLfloat *view)
+{
+	GLfloat cameraPos[3];
+	const GLfloat target[3] = {0.0f, 30.0f, 0.0f};
+
+	geometry->GetCameraPosition(cameraPos);
+	LookAtMatrix(cameraPos, target, view);
+}
+
+///----------------------------------------------------------------------------
+///Computes the matrices the fixed function pipeline used to provide: the 
+///camera looks at (0,30,0) like the legacy backend and the model is rotated
+///around X then Y like Geometry::Draw().
+///@param	geometry - the scene geometry (camera position)
+///@param	scene - the frame state
+///@param	modelViewProjection - receives projection * view * model
+///@param	normalMatrix - receives the 3x3 normal matrix
+///----------------------------------------------------------------------------
+void RenderBackend::ComputeMatrices(const Geometry *geometry, const SceneState &scene, GLfloat *modelViewProjection, GLfloat *normalMatrix)
+{
+	GLfloat projection[16], view[16], rotateX[16], rotateY[16];
+	GLfloat model[16], modelView[16];
+
+	ComputeProjection(scene.width, scene.height, projection);
+	ComputeView(geometry, view);
+	RotationMatrix(scene.spinY, 0, rotateX);
+	RotationMatrix(-scene.spinX, 1, rotateY);
+
+	MultiplyMatrix(rotateX, rotateY, model);
+	MultiplyMatrix(view, model, modelView);
+	MultiplyMatrix(projection, modelView, modelViewProjection);
+
+	NormalMatrix(modelView, normalMatrix);
+}
@@ -0,0 +1,101 @@
+///============================================================================
+///@file	RenderBackend.h
+///@brief	Abstract render path. GLApp owns the window, context & scene
+///			state, the backend turns that state into GL calls: the legacy
+///			backend uses the fixed function pipeline & GLSL 1.10, the core
+///			backend a GL 3.3 core profile with GLSL 3.30.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef RENDERBACKEND_H
+#define RENDERBACKEND_H
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include "Geometry.h"
+#include "ShaderPermutation.h"
+#include "GpuProfiler.h"
+#include "GLExtensions.h"
+
+const GLfloat LIGHT_AMBIENT	= 0.0f;		// GL_LIGHT0 default ambient
+const GLfloat FIELD_OF_VIEW	= 45.0f;	// vertical, in degrees
+const GLfloat NEAR_PLANE	= 1.0f;
+const GLfloat FAR_PLANE		= 1000.0f;
+
+//-----------------------------------------------------------------------------
+//Per frame state handed from GLApp to the backend
+//-----------------------------------------------------------------------------
+struct SceneState
+{
+	GLfloat			spinX;			///> Model rotation around Y (mouse x)
+	GLfloat			spinY;			///> Model rotation around X (mouse y)
+	int				width;			///> Viewport width
+	int				height;			///> Viewport height
+	QualityTier		quality;		///> Requested quality tier
+	const GLfloat	*projection;	///> Camera projection matrix (legacy only)
+	const GLfloat	*view;			///> Camera model-view matrix (legacy only)
+	GpuProfiler		*profiler;		///> Times the paper & model stages, or NULL
+};
+
+//-----------------------------------------------------------------------------
+//What the backend submitted for the last frame
+//-----------------------------------------------------------------------------
+struct DrawStats
+{
+	unsigned long	drawCalls;		///> Draw calls, a glBegin/glEnd pair counts as one
+	unsigned long	triangles;		///> Triangles submitted, quads count as two
+};
+
+class RenderBackend
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	virtual ~RenderBackend();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	virtual bool	Init(Geometry *geometry) = 0;
+	virtual void	Render(const SceneState &scene) = 0;
+	virtual void	ShutDown() = 0;
+
+	ShaderPermutation&	GetShaders();
+	const char*			GetVertexFile() const;
+	const char*			GetFragmentFile() const;
+	const DrawStats&	GetDrawStats() const;
+
+	static void	ComputeProjection(int width, int height, GLfloat *projection);
+	static void	ComputeView(const Geometry *geometry, GLfloat *view);
+	static void	ComputeMatrices(const Geometry *geometry, const SceneState &scene, 
+								GLfloat *modelViewProjection, GLfloat *normalMatrix);
+
+protected:
+	//-------------------------------------------------------------------------
+	//Protected methods
+	//-------------------------------------------------------------------------
+	RenderBackend(const char *vertexFile, const char *fragmentFile);
+
+	bool			InitShaders();
+	ShaderProgram*	BindShader(QualityTier quality);
+	void			SetSamplers(ShaderProgram *shader);
+
+	//-------------------------------------------------------------------------
+	//Protected members
+	//-------------------------------------------------------------------------
+	Geometry			*m_Geometry;		///> Scene geometry & textures
+	ShaderPermutation	m_Shaders;			///> Charcoal shader variants
+	const char			*m_VertexFile;		///> Charcoal vertex shader source name
+	const char			*m_FragmentFile;	///> Charcoal fragment shader source name
+	DrawStats			m_Stats;			///> Draw calls & triangles of the last frame
+};
+
+#endif
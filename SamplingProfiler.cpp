@@ -0,0 +1,413 @@
+///============================================================================
+///@file	SamplingProfiler.cpp
+///@brief	Sampling Profiler Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "SamplingProfiler.h"
+#include "Thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <link.h>
+#include <ucontext.h>
+#include <cxxabi.h>
+#include <map>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+using namespace std;
+
+SamplingProfiler::Sample	*SamplingProfiler::s_Samples	= NULL;
+volatile long				SamplingProfiler::s_Count		= 0;
+timer_t						SamplingProfiler::s_Timer;
+bool						SamplingProfiler::s_Running		= false;
+string						SamplingProfiler::s_FileName;
+__thread size_t				SamplingProfiler::s_StackTop	= 0;
+
+//-----------------------------------------------------------------------------
+//Function symbols of an executable or library
+//-----------------------------------------------------------------------------
+struct Symbol
+{
+	size_t	start;		///> Address, relative to the load address for PIC
+	size_t	end;		///> First address past the function
+	string	name;		///> Mangled name
+
+	bool operator<(const Symbol &other) const { return start < other.start; }
+};
+
+struct Module
+{
+	bool			relative;	///> Symbols are relative to the load address
+	vector<Symbol>	symbols;	///> Sorted by address
+};
+
+///----------------------------------------------------------------------------
+///Reads the function symbols of an ELF file, from .symtab if it isn't
+///stripped, else from .dynsym.
+///@param	fileName - the executable or library
+///@param	module - receives the symbols
+///----------------------------------------------------------------------------
+static void LoadSymbols(const char *fileName, Module &module)
+{
+	module.relative = true;
+
+	FILE *file = fopen(fileName, "rb");
+	if(!file)
+		return;
+
+	ElfW(Ehdr) header;
+	if(fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.e_ident, ELFMAG, SELFMAG) != 0 ||
+	   header.e_shentsize != sizeof(ElfW(Shdr)))
+	{
+		fclose(file);
+		return;
+	}
+
+	module.relative = (header.e_type == ET_DYN);
+
+	vector<ElfW(Shdr)> sections(header.e_shnum);
+	fseek(file, (long)header.e_shoff, SEEK_SET);
+	if(sections.empty() || fread(&sections[0], sizeof(ElfW(Shdr)), sections.size(), file) != sections.size())
+	{
+		fclose(file);
+		return;
+	}
+
+	//the full table has the static functions too
+	int table = -1;
+	for(size_t i=0; i<sections.size(); i++)
+	{
+		if(sections[i].sh_type == SHT_SYMTAB)
+			table = (int)i;
+		else if(sections[i].sh_type == SHT_DYNSYM && table < 0)
+			table = (int)i;
+	}
+
+	if(table < 0 || sections[table].sh_link >= sections.size())
+	{
+		fclose(file);
+		return;
+	}
+
+	const ElfW(Shdr) &symbolSection = sections[table];
+	const ElfW(Shdr) &stringSection = sections[symbolSection.sh_link];
+
+	vector<ElfW(Sym)> symbols(symbolSection.sh_size / sizeof(ElfW(Sym)));
+	vector<char> strings(stringSection.sh_size + 1, '\0');
+
+	fseek(file, (long)symbolSection.sh_offset, SEEK_SET);
+	bool read = symbols.empty() || fread(&symbols[0], sizeof(ElfW(Sym)), symbols.size(), file) == symbols.size();
+
+	fseek(file, (long)stringSection.sh_offset, SEEK_SET);
+	read = read && (strings.size() == 1 || fread(&strings[0], 1, stringSection.sh_size, file) == stringSection.sh_size);
+
+	fclose(file);
+
+	if(!read)
+		return;
+
+	for(size_t i=0; i<symbols.size(); i++)
+	{
+		const ElfW(Sym) &symbol = symbols[i];
+
+		if(ELF32_ST_TYPE(symbol.st_info) != STT_FUNC || symbol.st_value == 0 || symbol.st_name >= stringSection.sh_size)
+			continue;
+
+		Symbol function;
+		function.start	= symbol.st_value;
+		function.end	= symbol.st_value + (symbol.st_size ? symbol.st_size : 1);
+		function.name	= &strings[symbol.st_name];
+		module.symbols.push_back(function);
+	}
+
+	sort(module.symbols.begin(), module.symbols.end());
+}
+
+///----------------------------------------------------------------------------
+///Gets the name of the function an address is in, demangled.
+///@param	address - the address
+///@param	modules - symbols of the files seen so far, loaded as needed
+///@return	the function, or the file & offset if it has no symbol
+///----------------------------------------------------------------------------
+static string Symbolize(size_t address, map<string, Module> &modules)
+{
+	Dl_info info;
+	if(!dladdr((void*)address, &info) || !info.dli_fname)
+		return "[unknown]";
+
+	map<string, Module>::iterator found = modules.find(info.dli_fname);
+	if(found == modules.end())
+	{
+		//the executable is /proc/self/exe when its path is empty
+		found = modules.insert(make_pair(string(info.dli_fname), Module())).first;
+		LoadSymbols(*info.dli_fname ? info.dli_fname : "/proc/self/exe", found->second);
+	}
+
+	const Module &module = found->second;
+	size_t base = (size_t)info.dli_fbase;
+	size_t offset = module.relative ? address - base : address;
+	string name;
+
+	//the last function starting at or before the address
+	Symbol key;
+	key.start = offset;
+	vector<Symbol>::const_iterator symbol = upper_bound(module.symbols.begin(), module.symbols.end(), key);
+
+	if(symbol != module.symbols.begin() && offset < (symbol - 1)->end)
+		name = (symbol - 1)->name;
+	else if(info.dli_sname)
+		name = info.dli_sname;
+
+	if(name.empty())
+	{
+		const char *file = strrchr(info.dli_fname, '/');
+		char text[64];
+		sprintf(text, "+0x%lx", (unsigned long)(address - base));
+
+		return string(file ? file + 1 : info.dli_fname) + text;
+	}
+
+	int status;
+	char *demangled = abi::__cxa_demangle(name.c_str(), NULL, NULL, &status);
+	if(status == 0 && demangled)
+		name = demangled;
+	free(demangled);
+
+	//';' separates the frames of a folded stack
+	replace(name.begin(), name.end(), ';', ':');
+
+	return name;
+}
+
+///----------------------------------------------------------------------------
+///Starts sampling the process, the stacks are written when Stop() is
+///called (at exit at the latest). Call it on the main thread.
+///@param	fileName - the folded stacks file
+///@param	rate - samples per second of CPU time
+///@return	true if the timer is running
+///----------------------------------------------------------------------------
+bool SamplingProfiler::Start(const char *fileName, int rate)
+{
+	static bool registered = false;
+
+	Stop();
+
+	if(rate <= 0)
+		rate = SAMPLER_RATE;
+
+	if(!s_Samples)
+		s_Samples = new Sample[SAMPLER_CAPACITY];
+
+	s_Count		= 0;
+	s_FileName	= fileName;
+
+	RegisterThread();
+
+	//SA_RESTART, so the waits of the program aren't cut short
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+	action.sa_sigaction	= OnSignal;
+	action.sa_flags		= SA_SIGINFO | SA_RESTART;
+	sigemptyset(&action.sa_mask);
+
+	if(sigaction(SIGPROF, &action, NULL) != 0)
+		return false;
+
+	struct sigevent event;
+	memset(&event, 0, sizeof(event));
+	event.sigev_notify	= SIGEV_SIGNAL;
+	event.sigev_signo	= SIGPROF;
+
+	if(timer_create(CLOCK_PROCESS_CPUTIME_ID, &event, &s_Timer) != 0)
+		return false;
+
+	struct itimerspec interval;
+	interval.it_interval.tv_sec		= 0;
+	interval.it_interval.tv_nsec	= 1000000000L / rate;
+	interval.it_value				= interval.it_interval;
+
+	if(timer_settime(s_Timer, 0, &interval, NULL) != 0)
+	{
+		timer_delete(s_Timer);
+		return false;
+	}
+
+	s_Running = true;
+
+	//an early return from main still gets the stacks
+	if(!registered)
+		atexit(Stop);
+	registered = true;
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Stops sampling, symbolizes the stacks & writes them.
+///----------------------------------------------------------------------------
+void SamplingProfiler::Stop()
+{
+	if(!s_Running)
+		return;
+
+	timer_delete(s_Timer);
+
+	//a signal still pending mustn't take the default action & end the process
+	signal(SIGPROF, SIG_IGN);
+	s_Running = false;
+
+	if(!WriteFolded())
+		fprintf(stderr, "Could not write %s\n", s_FileName.c_str());
+}
+
+///----------------------------------------------------------------------------
+///Tells whether the process is being sampled.
+///@return	true between Start() & Stop()
+///----------------------------------------------------------------------------
+bool SamplingProfiler::IsRunning()
+{
+	return s_Running;
+}
+
+///----------------------------------------------------------------------------
+///Looks up where the calling thread's stack ends, so its samples can be
+///unwound. Thread calls it for the threads it starts.
+///----------------------------------------------------------------------------
+void SamplingProfiler::RegisterThread()
+{
+	pthread_attr_t attributes;
+	void *stack;
+	size_t size;
+
+	if(pthread_getattr_np(pthread_self(), &attributes) != 0)
+		return;
+
+	if(pthread_attr_getstack(&attributes, &stack, &size) == 0)
+		s_StackTop = (size_t)stack + size;
+
+	pthread_attr_destroy(&attributes);
+}
+
+///----------------------------------------------------------------------------
+///SIGPROF handler, runs on the thread that was interrupted. It only reads
+///its registers & stack and writes its own sample: no locks, no memory
+///allocation, nothing that isn't async signal safe.
+///@param	signal - SIGPROF
+///@param	info - unused
+///@param	context - the interrupted thread's registers
+///----------------------------------------------------------------------------
+void SamplingProfiler::OnSignal(int, siginfo_t *, void *context)
+{
+	int error = errno;
+	long index = AtomicIncrement(&s_Count) - 1;
+
+	if(!s_Samples || index >= SAMPLER_CAPACITY)
+	{
+		errno = error;
+		return;
+	}
+
+	const mcontext_t &registers = ((ucontext_t*)context)->uc_mcontext;
+
+#if defined(__x86_64__)
+	size_t pc = (size_t)registers.gregs[REG_RIP];
+	size_t fp = (size_t)registers.gregs[REG_RBP];
+	size_t sp = (size_t)registers.gregs[REG_RSP];
+#elif defined(__i386__)
+	size_t pc = (size_t)registers.gregs[REG_EIP];
+	size_t fp = (size_t)registers.gregs[REG_EBP];
+	size_t sp = (size_t)registers.gregs[REG_ESP];
+#else
+	size_t pc = 0, fp = 0, sp = 0;
+#endif
+
+	Sample &sample = s_Samples[index];
+	int depth = 0;
+
+	sample.frames[depth++] = pc;
+
+	//each frame holds the caller's frame pointer & the return address;
+	//only addresses inside this thread's stack are read, so a register
+	//that isn't a frame pointer ends the walk instead of faulting
+	size_t top = s_StackTop;
+
+	while(depth < SAMPLER_DEPTH && fp >= sp && fp + 2 * sizeof(size_t) <= top && (fp & (sizeof(size_t) - 1)) == 0)
+	{
+		const size_t *frame = (const size_t*)fp;
+
+		if(frame[1] == 0)
+			break;
+
+		sample.frames[depth++] = frame[1];
+
+		if(frame[0] <= fp)
+			break;
+
+		fp = frame[0];
+	}
+
+	sample.depth = depth;
+	errno = error;
+}
+
+///----------------------------------------------------------------------------
+///Writes the samples as folded stacks, the most frequent first. Return
+///addresses are symbolized one byte back, inside the call.
+///@return	true if the file was written
+///----------------------------------------------------------------------------
+bool SamplingProfiler::WriteFolded()
+{
+	long count = s_Count < SAMPLER_CAPACITY ? s_Count : SAMPLER_CAPACITY;
+	map<string, Module> modules;
+	map<size_t, string> names;
+	map<string, unsigned long> stacks;
+
+	for(long i=0; i<count; i++)
+	{
+		const Sample &sample = s_Samples[i];
+		string stack;
+
+		//root first
+		for(int f=sample.depth-1; f>=0; f--)
+		{
+			size_t address = sample.frames[f] - (f > 0 ? 1 : 0);
+
+			map<size_t, string>::iterator name = names.find(address);
+			if(name == names.end())
+				name = names.insert(make_pair(address, Symbolize(address, modules))).first;
+
+			if(!stack.empty())
+				stack += ';';
+			stack += name->second;
+		}
+
+		stacks[stack]++;
+	}
+
+	vector< pair<unsigned long, string> > sorted;
+	for(map<string, unsigned long>::iterator i=stacks.begin(); i!=stacks.end(); i++)
+		sorted.push_back(make_pair(i->second, i->first));
+
+	sort(sorted.rbegin(), sorted.rend());
+
+	FILE *file = fopen(s_FileName.c_str(), "w");
+	if(!file)
+		return false;
+
+	for(size_t i=0; i<sorted.size(); i++)
+		fprintf(file, "%s %lu\n", sorted[i].second.c_str(), sorted[i].first);
+
+	if(s_Count > SAMPLER_CAPACITY)
+		fprintf(stderr, "%ld samples dropped, the buffer holds %d.\n", s_Count - SAMPLER_CAPACITY, SAMPLER_CAPACITY);
+
+	return fclose(file) == 0;
+}
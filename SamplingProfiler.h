@@ -0,0 +1,71 @@
+///============================================================================
+///@file	SamplingProfiler.h
+///@brief	In-process sampling profiler for Linux. A CPU time timer
+///			(timer_create) sends SIGPROF about SAMPLER_RATE times per second
+///			of CPU used; the handler walks the frame pointers of whichever
+///			thread was running and stores the stack in a preallocated
+///			buffer, nothing else. At Stop() the addresses are symbolized
+///			from the ELF symbol tables of the executable & libraries and the
+///			stacks are written as folded stacks, "main;a;b count" per line,
+///			for flamegraph.pl or speedscope.
+///
+///			Stacks are only complete in code built with frame pointers
+///			(-fno-omit-frame-pointer). A thread is unwound within its own
+///			stack: the main thread & the threads started by Thread know
+///			theirs, other threads (the driver's) only get their leaf.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef SAMPLINGPROFILER_H
+#define SAMPLINGPROFILER_H
+
+#include <stddef.h>
+#include <signal.h>
+#include <time.h>
+#include <string>
+
+const int SAMPLER_RATE		= 997;		// Samples per CPU second, prime so it doesn't beat with the frames
+const int SAMPLER_DEPTH		= 64;		// Frames of a stack at most
+const int SAMPLER_CAPACITY	= 32768;	// Samples kept, the later ones are dropped
+
+class SamplingProfiler
+{
+public:
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	static bool	Start(const char *fileName, int rate = SAMPLER_RATE);
+	static void	Stop();
+	static bool	IsRunning();
+	static void	RegisterThread();
+
+private:
+	//-------------------------------------------------------------------------
+	//Private types
+	//-------------------------------------------------------------------------
+	struct Sample
+	{
+		int		depth;					///> Frames of the stack
+		size_t	frames[SAMPLER_DEPTH];	///> Program counter, then the return addresses
+	};
+
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	static void	OnSignal(int signal, siginfo_t *info, void *context);
+	static bool	WriteFolded();
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	static Sample			*s_Samples;		///> SAMPLER_CAPACITY samples
+	static volatile long	s_Count;		///> Samples taken, some may be dropped
+	static timer_t			s_Timer;		///> CPU time timer sending SIGPROF
+	static bool				s_Running;		///> Between Start() & Stop()
+	static std::string		s_FileName;		///> Folded stacks file
+	static __thread size_t	s_StackTop;		///> End of the calling thread's stack, 0 if unknown
+};
+
+#endif
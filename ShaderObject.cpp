@@ -7,13 +7,36 @@
 ///============================================================================
 
 #include "ShaderObject.h"
+#include "Tracer.h"
 
 ///----------------------------------------------------------------------------
 ///Default constructor.
 ///----------------------------------------------------------------------------
 ShaderObject::ShaderObject(LPSTR fileName, GLenum shaderType)
 {
-	CreateShader(fileName, shaderType);
+	CreateShader(fileName, shaderType, "");
+}
+
+///----------------------------------------------------------------------------
+///Constructor for a specialized shader variant.
+///@param	fileName - the name of the shader source file
+///@param	shaderType - GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+///@param	defines - #define block prepended to the source
+///----------------------------------------------------------------------------
+ShaderObject::ShaderObject(LPSTR fileName, GLenum shaderType, const string &defines)
+{
+	CreateShader(fileName, shaderType, defines);
+}
+
+///----------------------------------------------------------------------------
+///Constructor from source code already in memory.
+///@param	shaderType - GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+///@param	source - the shader source code
+///@param	defines - #define block prepended to the source
+///----------------------------------------------------------------------------
+ShaderObject::ShaderObject(GLenum shaderType, const string &source, const string &defines)
+{
+	CreateShader(shaderType, source, defines);
 }
 
 ///----------------------------------------------------------------------------
@@ -21,92 +44,134 @@ ShaderObject::ShaderObject(LPSTR fileName, GLenum shaderType)
 ///----------------------------------------------------------------------------
 ShaderObject::~ShaderObject()
 {
-	glDeleteObject(m_Shader);
+	glDeleteShader(m_Shader);
 }
 
 ///----------------------------------------------------------------------------
 ///Get handle to shader object.
 ///@return the object handle
 ///----------------------------------------------------------------------------
-GLhandleARB ShaderObject::GetHandle() const
+GLuint ShaderObject::GetHandle() const
 {
 	return m_Shader;
 }
 
 ///----------------------------------------------------------------------------
-///Loads a shader program from an external file into the specified buffer
+///Checks the compile status of the shader object. The compilation is only
+///issued by the constructor, so this waits for the compiler if it's still
+///running; use ShaderProgram::IsReady() to poll without blocking.
+///@return true if the shader compiled successfully
+///----------------------------------------------------------------------------
+bool ShaderObject::IsCompiled() const
+{
+	GLint compiled = 0;
+	glGetShaderiv(m_Shader, GL_COMPILE_STATUS, &compiled);
+
+	return compiled != 0;
+}
+
+///----------------------------------------------------------------------------
+///Gets the compiler info log of the shader object.
+///@return	a string with the log
+///----------------------------------------------------------------------------
+string ShaderObject::GetLog() const
+{
+	GLint length = 0;
+	GLsizei charsRead = 0;
+	string log;
+
+	glGetShaderiv(m_Shader, GL_INFO_LOG_LENGTH, &length);
+	if(length <= 1)
+		return log;
+
+	log.resize(length);
+	glGetShaderInfoLog(m_Shader, length, &charsRead, &log[0]);
+	log.resize(charsRead);
+
+	return log;
+}
+
+///----------------------------------------------------------------------------
+///Loads a shader program from an external file in a single read. Line 
+///endings are normalized and a final new line is added if missing, so the
+///result (and its hash) matches the sources embedded by EmbedShaders.py.
 ///@param	fileName - the name of the shader program to load
-///@return	a pointer to the buffer that receives the data read
+///@return	the shader source code, empty if the file couldn't be read
 ///----------------------------------------------------------------------------
 string ShaderObject::LoadShaderFromFile(LPSTR fileName)
 {
-	string line;
 	string buffer;
 
 	//load the file
-    ifstream file(fileName);
-
-	//read each line
-    while(getline(file, line))
-        buffer += line + "\n";
-
-	return buffer;
+	ifstream file(fileName, ios::in | ios::binary);
+	if(!file)
+		return buffer;
 
-	/* FANCY STUFF THAT DIDN'T WORK AT ALL... BECAUSE OF THE NULL TERMINATED ISSUE
-	HANDLE hFile;
-	DWORD fileSize;
-	DWORD bytesRead;
-	LPVOID pBuffer;
+	//size the buffer once and read the whole file into it
+	file.seekg(0, ios::end);
+	streamoff size = file.tellg();
+	file.seekg(0, ios::beg);
 
-	//open the existing file
-	hFile = CreateFile(fileName,				//the name of the file to open
-					   GENERIC_READ,			//the access to the object (can be RW, WR or both)
-					   0,						//share mode (zero for no sharing)
-					   NULL,					//security attributes
-					   OPEN_EXISTING,			//action to take on files
-					   FILE_ATTRIBUTE_NORMAL,	//attributes and flags
-					   NULL);					//handle to template
+	if(size <= 0)
+		return buffer;
 
-	//get file size
-	fileSize = GetFileSize(hFile, NULL);
+	buffer.resize((size_t)size);
+	file.read(&buffer[0], size);
+	buffer.resize((size_t)file.gcount());
 
-	//save memory space for buffer
-	pBuffer = malloc(fileSize * sizeof(GLcharARB));
+	//CRLF -> LF
+	buffer.erase(remove(buffer.begin(), buffer.end(), '\r'), buffer.end());
 
-	//read file into specified buffer
-	ReadFile(hFile, pBuffer, fileSize, &bytesRead, NULL);
+	if(!buffer.empty() && buffer[buffer.size() - 1] != '\n')
+		buffer += '\n';
 
-	//close file handle
-	CloseHandle(hFile);
-
-	return (GLcharARB*)pBuffer;
-	*/
+	return buffer;
 }
 
 ///----------------------------------------------------------------------------
-///Create, load, compile & link a shader object
+///Create, load & compile a shader object
 ///@param	fileName - the name of the shader source file
+///@param	shaderType - GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+///@param	defines - #define block prepended to the source (may be empty)
 ///----------------------------------------------------------------------------
-void ShaderObject::CreateShader(LPSTR fileName, GLenum shaderType)
+void ShaderObject::CreateShader(LPSTR fileName, GLenum shaderType, const string &defines)
 {
-	GLcharARB *shaderSrc = NULL;
-	string str;
+	//the string owns the source, it lives until the call returns
+	CreateShader(shaderType, LoadShaderFromFile(fileName), defines);
+}
 
-	//load shader from file
-	str = LoadShaderFromFile(fileName);
+///----------------------------------------------------------------------------
+///Create & compile a shader object from source code in memory
+///@param	shaderType - GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+///@param	source - the shader source code
+///@param	defines - #define block prepended to the source (may be empty)
+///----------------------------------------------------------------------------
+void ShaderObject::CreateShader(GLenum shaderType, const string &source, const string &defines)
+{
+	const GLchar *sources[3];
+	string version;
+	string::size_type body = 0;
 
-	//convert the contents of a string as a C-style, null-terminated string
-	shaderSrc = (GLcharARB *) str.c_str();
+	//the #version directive must come before anything else,
+	//so the defines go between it and the rest of the source
+	if(source.compare(0, 8, "#version") == 0)
+	{
+		body = source.find('\n');
+		body = (body == string::npos) ? source.size() : body + 1;
+		version = source.substr(0, body);
+	}
 
-	//create shader object
-	m_Shader = glCreateShaderObject(shaderType);
+	TRACE_ZONE("CompileShader");
 
-	//set shader program source
-	glShaderSource(m_Shader, 1, (const GLchar**)&shaderSrc, NULL);
+	//create shader object
+	m_Shader = glCreateShader(shaderType);
 
-	//free our temporal buffer
-	free(shaderSrc);
+	//set shader program source, defines after the version
+	sources[0] = version.c_str();
+	sources[1] = defines.c_str();
+	sources[2] = source.c_str() + body;
+	glShaderSource(m_Shader, 3, sources, NULL);
 
-	//compile shader
+	//queue the compilation
 	glCompileShader(m_Shader);
-}
+}
\ No newline at end of file
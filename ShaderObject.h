@@ -9,10 +9,13 @@
 #ifndef SHADEROBJECT_H
 #define SHADEROBJECT_H
 
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <algorithm>
 #include <GL/gl.h>
 #include <GL/glu.h>
 #include <GL/glut.h>
@@ -29,24 +32,30 @@ public:
 	//Constructors and destructors
 	//-------------------------------------------------------------------------
 	ShaderObject(LPSTR fileName, GLenum shaderType);
+	ShaderObject(LPSTR fileName, GLenum shaderType, const string &defines);
+	ShaderObject(GLenum shaderType, const string &source, const string &defines);
 	~ShaderObject();
 
 	//-------------------------------------------------------------------------
 	//Public methods
 	//-------------------------------------------------------------------------
-	GLhandleARB GetHandle() const;
+	GLuint		GetHandle() const;
+	bool		IsCompiled() const;
+	string		GetLog() const;
+
+	static string LoadShaderFromFile(LPSTR fileName);
 
 private:
 	//-------------------------------------------------------------------------
 	//Private methods
 	//-------------------------------------------------------------------------
-	void CreateShader(LPSTR fileName, GLenum shaderType);
-	string LoadShaderFromFile(LPSTR fileName);
+	void CreateShader(LPSTR fileName, GLenum shaderType, const string &defines);
+	void CreateShader(GLenum shaderType, const string &source, const string &defines);
 
 	//-------------------------------------------------------------------------
 	//Private members
 	//-------------------------------------------------------------------------
-	GLhandleARB m_Shader;	///> Handle to Shader objects
+	GLuint		m_Shader;	///> Handle to Shader objects
 };
 
 #endif
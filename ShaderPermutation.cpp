@@ -0,0 +1,508 @@
+///============================================================================
+///@file	ShaderPermutation.cpp
+///@brief	Shader Permutation Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "ShaderPermutation.h"
+#include "MemoryStats.h"
+
+#include <stdio.h>
+#include <math.h>
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+ShaderPermutation::ShaderPermutation()
+{
+	m_LookupTex		= 0;
+	m_VertexHash	= 0;
+	m_FragmentHash	= 0;
+	m_Current		= GetProgramKey(0);
+	m_HasCurrent	= false;
+
+	//original charcoal look
+	m_Constants.oversaturation	= 1.5f;
+	m_Constants.contrastExp		= 3.5f;
+	m_Constants.cetScale		= 0.5f;
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+ShaderPermutation::~ShaderPermutation()
+{
+	Clear();
+	MemoryStats::Free(MC_SHADER, MP_CPU, GetSourceSize());
+}
+
+///----------------------------------------------------------------------------
+///Sets the shader sources every variant is compiled from. They come from
+///the embedded shader table, or from disk in development mode.
+///@param	vertexName - vertex shader source name
+///@param	fragmentName - fragment shader source name
+///@return	true if both sources were found
+///----------------------------------------------------------------------------
+bool ShaderPermutation::SetSources(const char *vertexName, const char *fragmentName)
+{
+	Clear();
+	MemoryStats::Free(MC_SHADER, MP_CPU, GetSourceSize());
+
+	bool found = ShaderSource::Load(vertexName, m_VertexSource, m_VertexHash);
+	found = ShaderSource::Load(fragmentName, m_FragmentSource, m_FragmentHash) && found;
+
+	MemoryStats::Allocate(MC_SHADER, MP_CPU, GetSourceSize());
+
+	return found;
+}
+
+///----------------------------------------------------------------------------
+///Rebuilds every variant from new sources. Since variants are keyed by the
+///hashes of their sources, the current programs keep being used until their
+///replacements have linked, then Acquire() switches to them between frames;
+///a replacement that fails is logged and the last good program stays.
+///@param	vertexSource - new vertex shader source code
+///@param	fragmentSource - new fragment shader source code
+///----------------------------------------------------------------------------
+void ShaderPermutation::Reload(const string &vertexSource, const string &fragmentSource)
+{
+	MemoryStats::Free(MC_SHADER, MP_CPU, GetSourceSize());
+
+	m_VertexSource		= vertexSource;
+	m_FragmentSource	= fragmentSource;
+
+	MemoryStats::Allocate(MC_SHADER, MP_CPU, GetSourceSize());
+	m_VertexHash		= ShaderSource::Hash(m_VertexSource.c_str(), (unsigned int)m_VertexSource.size());
+	m_FragmentHash		= ShaderSource::Hash(m_FragmentSource.c_str(), (unsigned int)m_FragmentSource.size());
+
+	//collect the features in use, dropping whatever isn't usable;
+	//a newer edit supersedes a reload that is still compiling
+	unsigned int features[1 << 4];
+	unsigned int count = 0;
+
+	VariantMap::iterator it = m_Variants.begin();
+	while(it != m_Variants.end())
+	{
+		bool known = false;
+		for(unsigned int i=0; i<count; i++)
+			known = known || (features[i] == it->second.features);
+
+		if(!known && count < sizeof(features)/sizeof(features[0]))
+			features[count++] = it->second.features;
+
+		if(it->second.status != VS_READY)
+		{
+			DeleteVariant(it->second);
+			m_Variants.erase(it++);
+		}
+		else
+			++it;
+	}
+
+	for(unsigned int i=0; i<count; i++)
+		GetVariant(features[i]);
+}
+
+///----------------------------------------------------------------------------
+///Sets the constants folded into the variants. Since they are compiled in,
+///all the variants built so far are discarded.
+///@param	constants - the new charcoal constants
+///----------------------------------------------------------------------------
+void ShaderPermutation::SetConstants(const CharcoalConstants &constants)
+{
+	m_Constants = constants;
+	Clear();
+}
+
+///----------------------------------------------------------------------------
+///Gets the variant compiled with the given features from the current
+///sources, compiling it on the first request and returning the memoized
+///program afterwards. The program may still be compiling, use Acquire()
+///from the frame loop.
+///@param	features - bitwise OR of ShaderFeature values
+///@return	the shader program
+///----------------------------------------------------------------------------
+ShaderProgram* ShaderPermutation::GetVariant(unsigned int features)
+{
+	VariantKey key = GetProgramKey(features);
+
+	VariantMap::iterator it = m_Variants.find(key);
+	if(it != m_Variants.end())
+		return it->second.program;
+
+	Variant variant = BuildVariant(features);
+	m_Variants[key] = variant;
+
+	return variant.program;
+}
+
+///----------------------------------------------------------------------------
+///Gets the variant for the given quality tier.
+///@param	tier - the requested quality tier
+///@return	the shader program
+///----------------------------------------------------------------------------
+ShaderProgram* ShaderPermutation::GetTier(QualityTier tier)
+{
+	return GetVariant(GetTierFeatures(tier));
+}
+
+///----------------------------------------------------------------------------
+///Gets the program to render with this frame. If the requested variant is
+///ready it becomes the current one, otherwise the previous current variant
+///keeps being used. With GL_KHR_parallel_shader_compile this never waits
+///for the compiler; without it the link status of a new variant is queried
+///a few frames after it was queued (see ShaderProgram::IsReady()), and that
+///frame may still wait if the driver hasn't finished.
+///@param	features - bitwise OR of ShaderFeature values
+///@return	the program to use, NULL if no variant has finished yet
+///----------------------------------------------------------------------------
+ShaderProgram* ShaderPermutation::Acquire(unsigned int features)
+{
+	GetVariant(features);
+
+	VariantKey key = GetProgramKey(features);
+	Variant &variant = m_Variants[key];
+	UpdateStatus(variant);
+
+	if(variant.status == VS_READY && (!m_HasCurrent || m_Current != key))
+	{
+		m_Current		= key;
+		m_HasCurrent	= true;
+		EvictSuperseded(key);
+	}
+
+	if(!m_HasCurrent)
+		return NULL;
+
+	return m_Variants[m_Current].program;
+}
+
+///----------------------------------------------------------------------------
+///Gets the features of the program last returned by Acquire(), which may
+///differ from the requested ones while a variant is compiling.
+///@return	bitwise OR of ShaderFeature values
+///----------------------------------------------------------------------------
+unsigned int ShaderPermutation::GetCurrentFeatures() const
+{
+	VariantMap::const_iterator it = m_Variants.find(m_Current);
+
+	if(!m_HasCurrent || it == m_Variants.end())
+		return 0;
+
+	return it->second.features;
+}
+
+///----------------------------------------------------------------------------
+///Checks whether any variant is still compiling.
+///@return	true if at least one variant hasn't finished
+///----------------------------------------------------------------------------
+bool ShaderPermutation::IsPending() const
+{
+	for(VariantMap::const_iterator it = m_Variants.begin(); it != m_Variants.end(); ++it)
+		if(it->second.status == VS_PENDING)
+			return true;
+
+	return false;
+}
+
+///----------------------------------------------------------------------------
+///Gets the CEO lookup texture used by SF_CEO_LUT variants, it is created
+///from the current constants the first time it is needed.
+///@return	the lookup texture object
+///----------------------------------------------------------------------------
+GLuint ShaderPermutation::GetLookupTexture()
+{
+	if(!m_LookupTex)
+		CreateLookupTexture();
+
+	return m_LookupTex;
+}
+
+///----------------------------------------------------------------------------
+///Deletes all the compiled variants and the lookup texture, the sources
+///are kept.
+///----------------------------------------------------------------------------
+void ShaderPermutation::Clear()
+{
+	for(VariantMap::iterator it = m_Variants.begin(); it != m_Variants.end(); ++it)
+		DeleteVariant(it->second);
+	m_Variants.clear();
+	m_HasCurrent = false;
+
+	if(m_LookupTex)
+	{
+		glDeleteTextures(1, &m_LookupTex);
+		m_LookupTex = 0;
+
+		MemoryStats::Free(MC_SHADER, MP_GPU, MemoryStats::GetTextureSize(CEO_LUT_SIZE, 1, GL_RGB));
+	}
+}
+
+///----------------------------------------------------------------------------
+///Gets the features enabled for a quality tier.
+///@param	tier - the quality tier
+///@return	bitwise OR of ShaderFeature values
+///----------------------------------------------------------------------------
+unsigned int ShaderPermutation::GetTierFeatures(QualityTier tier)
+{
+	switch(tier)
+	{
+		case QT_LOW:
+			return SF_PAPER_OVERLAY | SF_CEO_LUT;
+
+		case QT_MEDIUM:
+			return SF_PAPER_OVERLAY | SF_CET_SMUDGE | SF_CEO_LUT;
+
+		case QT_HIGH:
+		default:
+			return SF_PAPER_OVERLAY | SF_NOISE_JITTER | SF_CET_SMUDGE;
+	}
+}
+
+///----------------------------------------------------------------------------
+///Builds the #define block that specializes the charcoal shader.
+///@param	features - bitwise OR of ShaderFeature values
+///@param	constants - constants to fold into the variant
+///@return	the preprocessor block to prepend to the sources
+///----------------------------------------------------------------------------
+string ShaderPermutation::BuildDefines(unsigned int features, const CharcoalConstants &constants)
+{
+	char buffer[256];
+	string defines;
+
+	if(features & SF_PAPER_OVERLAY)	defines += "#define CHARCOAL_PAPER_OVERLAY\n";
+	if(features & SF_NOISE_JITTER)	defines += "#define CHARCOAL_NOISE_JITTER\n";
+	if(features & SF_CET_SMUDGE)	defines += "#define CHARCOAL_CET_SMUDGE\n";
+	if(features & SF_CEO_LUT)		defines += "#define CHARCOAL_CEO_LUT\n";
+
+	//floats are always written with a decimal point,
+	//GLSL 1.10 doesn't convert int literals implicitly
+	sprintf(buffer,
+			"#define CHARCOAL_OVERSATURATION %.6f\n"
+			"#define CHARCOAL_CONTRAST_EXP %.6f\n"
+			"#define CHARCOAL_CET_SCALE %.6f\n",
+			constants.oversaturation,
+			constants.contrastExp,
+			constants.cetScale);
+	defines += buffer;
+
+	return defines;
+}
+
+///----------------------------------------------------------------------------
+///Gets the cache key of a variant: the precomputed hashes of the sources
+///and the feature mask, so no source text is compared at runtime. The
+///fields are compared as they are, two feature masks never share a key.
+///@param	features - bitwise OR of ShaderFeature values
+///@return	the program cache key
+///----------------------------------------------------------------------------
+ShaderPermutation::VariantKey ShaderPermutation::GetProgramKey(unsigned int features) const
+{
+	VariantKey key;
+	key.vertexHash		= m_VertexHash;
+	key.fragmentHash	= m_FragmentHash;
+	key.features		= features;
+
+	return key;
+}
+
+///----------------------------------------------------------------------------
+///Orders the keys of the variant map, field by field.
+///@param	other - the key to compare with
+///@return	true if this key goes first
+///----------------------------------------------------------------------------
+bool ShaderPermutation::VariantKey::operator<(const VariantKey &other) const
+{
+	if(vertexHash != other.vertexHash)
+		return vertexHash < other.vertexHash;
+
+	if(fragmentHash != other.fragmentHash)
+		return fragmentHash < other.fragmentHash;
+
+	return features < other.features;
+}
+
+///----------------------------------------------------------------------------
+///Compares two keys of the variant map, field by field.
+///@param	other - the key to compare with
+///@return	true if every field is the same
+///----------------------------------------------------------------------------
+bool ShaderPermutation::VariantKey::operator==(const VariantKey &other) const
+{
+	return vertexHash == other.vertexHash && fragmentHash == other.fragmentHash && features == other.features;
+}
+
+///----------------------------------------------------------------------------
+///Tells whether two keys name different variants.
+///@param	other - the key to compare with
+///@return	true if any field differs
+///----------------------------------------------------------------------------
+bool ShaderPermutation::VariantKey::operator!=(const VariantKey &other) const
+{
+	return !(*this == other);
+}
+
+///----------------------------------------------------------------------------
+///Creates the shader objects & program of a variant and queues their
+///compilation and link.
+///@param	features - bitwise OR of ShaderFeature values
+///@return	the new (pending) variant
+///----------------------------------------------------------------------------
+ShaderPermutation::Variant ShaderPermutation::BuildVariant(unsigned int features)
+{
+	string defines = BuildDefines(features, m_Constants);
+
+	Variant variant;
+	variant.status		= VS_PENDING;
+	variant.features	= features;
+	variant.vertex		= new ShaderObject(GL_VERTEX_SHADER, m_VertexSource, defines);
+	variant.fragment	= new ShaderObject(GL_FRAGMENT_SHADER, m_FragmentSource, defines);
+	variant.program		= new ShaderProgram();
+	variant.gpuSize		= 0;
+
+	MemoryStats::Allocate(MC_SHADER, MP_CPU, sizeof(ShaderProgram) + 2 * sizeof(ShaderObject));
+
+	variant.program->CreateShader();
+	variant.program->AttachObject(variant.vertex);
+	variant.program->AttachObject(variant.fragment);
+	variant.program->Link();
+
+	return variant;
+}
+
+///----------------------------------------------------------------------------
+///Deletes the program and shader objects of a variant.
+///@param	variant - the variant to delete
+///----------------------------------------------------------------------------
+void ShaderPermutation::DeleteVariant(Variant &variant)
+{
+	if(variant.program)
+		MemoryStats::Free(MC_SHADER, MP_CPU, sizeof(ShaderProgram) + 2 * sizeof(ShaderObject));
+
+	MemoryStats::Free(MC_SHADER, MP_GPU, variant.gpuSize);
+
+	delete variant.program;
+	delete variant.vertex;
+	delete variant.fragment;
+
+	variant.program		= NULL;
+	variant.vertex		= NULL;
+	variant.fragment	= NULL;
+	variant.gpuSize		= 0;
+}
+
+///----------------------------------------------------------------------------
+///Moves a pending variant to ready or failed once the driver is done with
+///it. Compile and link errors are sent to the debugger output.
+///@param	variant - the variant to update
+///----------------------------------------------------------------------------
+void ShaderPermutation::UpdateStatus(Variant &variant)
+{
+	if(variant.status != VS_PENDING || !variant.program->IsReady())
+		return;
+
+	if(variant.program->IsLinked())
+	{
+		variant.status	= VS_READY;
+		variant.gpuSize	= variant.program->GetBinarySize();
+
+		MemoryStats::Allocate(MC_SHADER, MP_GPU, variant.gpuSize);
+		return;
+	}
+
+	variant.status = VS_FAILED;
+
+	OutputDebugString("Charcoal shader variant failed to build:\n");
+	OutputDebugString(variant.vertex->GetLog().c_str());
+	OutputDebugString(variant.fragment->GetLog().c_str());
+	OutputDebugString(variant.program->GetLog().c_str());
+}
+
+///----------------------------------------------------------------------------
+///Deletes the variants built from older sources once a variant with the
+///same features from the current sources has become the current program.
+///@param	key - key of the variant that just became current
+///----------------------------------------------------------------------------
+void ShaderPermutation::EvictSuperseded(const VariantKey &key)
+{
+	unsigned int features = key.features;
+
+	VariantMap::iterator it = m_Variants.begin();
+	while(it != m_Variants.end())
+	{
+		if(it->first != key && it->second.features == features)
+		{
+			DeleteVariant(it->second);
+			m_Variants.erase(it++);
+		}
+		else
+			++it;
+	}
+}
+
+///----------------------------------------------------------------------------
+///Bakes oversaturation and contrast enhancement into a 1D lookup table
+///indexed by the (ambient added) lambertian intensity.
+///@param	constants - the charcoal constants
+///@param	table - receives CEO_LUT_SIZE 8 bit values
+///----------------------------------------------------------------------------
+void ShaderPermutation::BuildLookupTable(const CharcoalConstants &constants, GLubyte *table)
+{
+	for(int i=0; i<CEO_LUT_SIZE; i++)
+	{
+		float LI = (float)i / (CEO_LUT_SIZE - 1);
+
+		LI *= constants.oversaturation;
+		if(LI > 1.0f) LI = 1.0f;
+
+		table[i] = (GLubyte)(powf(LI, constants.contrastExp) * 255.0f + 0.5f);
+	}
+}
+
+///----------------------------------------------------------------------------
+///Creates the CEO lookup texture. The value is stored in all three 
+///channels, luminance textures don't exist in core profiles.
+///----------------------------------------------------------------------------
+void ShaderPermutation::CreateLookupTexture()
+{
+	GLubyte values[CEO_LUT_SIZE];
+	GLubyte table[CEO_LUT_SIZE * 3];
+
+	BuildLookupTable(m_Constants, values);
+
+	for(int i=0; i<CEO_LUT_SIZE; i++)
+	{
+		table[i*3 + 0] = values[i];
+		table[i*3 + 1] = values[i];
+		table[i*3 + 2] = values[i];
+	}
+
+	glGenTextures(1, &m_LookupTex);
+	glBindTexture(GL_TEXTURE_2D, m_LookupTex);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexImage2D(GL_TEXTURE_2D,
+				 0,
+				 GL_RGB,
+				 CEO_LUT_SIZE,
+				 1,
+				 0,
+				 GL_RGB,
+				 GL_UNSIGNED_BYTE,
+				 table);
+
+	MemoryStats::Allocate(MC_SHADER, MP_GPU, MemoryStats::GetTextureSize(CEO_LUT_SIZE, 1, GL_RGB));
+}
+
+///----------------------------------------------------------------------------
+///Gets the bytes of the shader sources kept.
+///@return	their length in bytes
+///----------------------------------------------------------------------------
+size_t ShaderPermutation::GetSourceSize() const
+{
+	return m_VertexSource.size() + m_FragmentSource.size();
+}
@@ -0,0 +1,155 @@
+///============================================================================
+///@file	ShaderPermutation.h
+///@brief	Compiles and caches specialized variants of the charcoal shader.
+///			Every feature of the charcoal pipeline is a #define key, so a
+///			variant only pays for the features it was compiled with.
+///			Variants compile while the previous one keeps rendering; only
+///			without GL_KHR_parallel_shader_compile may the frame that
+///			first checks a new variant wait for the driver.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef SHADERPERMUTATION_H
+#define SHADERPERMUTATION_H
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <map>
+#include <string>
+
+#include <GL/gl.h>
+#include <GL/glu.h>
+#include <GL/glut.h>
+#include <GL/glext.h>
+
+#include "ShaderProgram.h"
+#include "ShaderObject.h"
+#include "ShaderSource.h"
+#include "GLExtensions.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//Charcoal features, each one maps to a #define in CharcoalRendering.frag
+//-----------------------------------------------------------------------------
+enum ShaderFeature
+{
+	SF_PAPER_OVERLAY	= 1 << 0,	///> overlay the inverted paper texture
+	SF_NOISE_JITTER		= 1 << 1,	///> jitter the CET lookup with noise
+	SF_CET_SMUDGE		= 1 << 2,	///> blend the CEO with the CET
+	SF_CEO_LUT			= 1 << 3	///> CEO from a lookup table instead of pow()
+};
+
+//-----------------------------------------------------------------------------
+//Quality tiers, selectable at runtime
+//-----------------------------------------------------------------------------
+enum QualityTier
+{
+	QT_LOW = 0,
+	QT_MEDIUM,
+	QT_HIGH,
+	QT_COUNT
+};
+
+const int CEO_LUT_SIZE = 256;	// Number of entries in the CEO lookup table
+
+//-----------------------------------------------------------------------------
+//Constants folded into every variant at compile time
+//-----------------------------------------------------------------------------
+struct CharcoalConstants
+{
+	GLfloat oversaturation;		///> lambertian oversaturation (closure effect)
+	GLfloat contrastExp;		///> contrast enhancement exponent
+	GLfloat cetScale;			///> scale applied to the CET coordinates
+};
+
+class ShaderPermutation
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	ShaderPermutation();
+	~ShaderPermutation();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	bool			SetSources(const char *vertexName, const char *fragmentName);
+	void			Reload(const string &vertexSource, const string &fragmentSource);
+	void			SetConstants(const CharcoalConstants &constants);
+	ShaderProgram*	GetVariant(unsigned int features);
+	ShaderProgram*	GetTier(QualityTier tier);
+	ShaderProgram*	Acquire(unsigned int features);
+	unsigned int	GetCurrentFeatures() const;
+	bool			IsPending() const;
+	GLuint			GetLookupTexture();
+	void			Clear();
+
+	static unsigned int	GetTierFeatures(QualityTier tier);
+	static string		BuildDefines(unsigned int features, const CharcoalConstants &constants);
+	static void			BuildLookupTable(const CharcoalConstants &constants, GLubyte *table);
+
+private:
+	//-------------------------------------------------------------------------
+	//Private types
+	//-------------------------------------------------------------------------
+	enum VariantStatus
+	{
+		VS_PENDING,		///> compile/link issued, not finished yet
+		VS_READY,		///> linked successfully
+		VS_FAILED		///> compile or link error
+	};
+
+	struct Variant
+	{
+		VariantStatus	status;
+		unsigned int	features;
+		ShaderProgram	*program;
+		ShaderObject	*vertex;
+		ShaderObject	*fragment;
+		size_t			gpuSize;	///> Linked program's size, once ready
+	};
+
+	struct VariantKey
+	{
+		unsigned int	vertexHash;		///> ShaderSource::Hash() of the vertex source
+		unsigned int	fragmentHash;	///> ShaderSource::Hash() of the fragment source
+		unsigned int	features;		///> bitwise OR of ShaderFeature values
+
+		bool operator<(const VariantKey &other) const;
+		bool operator==(const VariantKey &other) const;
+		bool operator!=(const VariantKey &other) const;
+	};
+
+	typedef map<VariantKey, Variant> VariantMap;
+
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	VariantKey		GetProgramKey(unsigned int features) const;
+	Variant			BuildVariant(unsigned int features);
+	void			DeleteVariant(Variant &variant);
+	void			UpdateStatus(Variant &variant);
+	void			EvictSuperseded(const VariantKey &key);
+	void			CreateLookupTexture();
+	size_t			GetSourceSize() const;
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	VariantMap			m_Variants;		///> Variants keyed by source hashes & features
+	CharcoalConstants	m_Constants;	///> Constants folded into the variants
+	string				m_VertexSource;	///> Vertex shader source code
+	string				m_FragmentSource;///> Fragment shader source code
+	unsigned int		m_VertexHash;	///> Hash of the vertex shader source
+	unsigned int		m_FragmentHash;	///> Hash of the fragment shader source
+	VariantKey			m_Current;		///> Key of the variant in use
+	bool				m_HasCurrent;	///> Whether any variant is usable yet
+	GLuint				m_LookupTex;	///> CEO lookup table texture
+};
+
+#endif
@@ -7,13 +7,15 @@
 ///============================================================================
 
 #include "ShaderProgram.h"
+#include "Tracer.h"
 
 ///----------------------------------------------------------------------------
 ///Default constructor.
 ///----------------------------------------------------------------------------
 ShaderProgram::ShaderProgram()
 {
-	m_Program = NULL;
+	m_Program	= 0;
+	m_Polls		= 0;
 }
 
 ///----------------------------------------------------------------------------
@@ -29,7 +31,7 @@ ShaderProgram::~ShaderProgram()
 ///----------------------------------------------------------------------------
 void ShaderProgram::EnableShader()
 {
-	glUseProgramObject(m_Program);
+	glUseProgram(m_Program);
 }
 
 ///----------------------------------------------------------------------------
@@ -37,7 +39,7 @@ void ShaderProgram::EnableShader()
 ///----------------------------------------------------------------------------
 void ShaderProgram::DisableShader()
 {
-	glUseProgramObject(0);
+	glUseProgram(0);
 }
 
 ///----------------------------------------------------------------------------
@@ -45,7 +47,7 @@ void ShaderProgram::DisableShader()
 ///----------------------------------------------------------------------------
 void ShaderProgram::CreateShader()
 {
-	m_Program = glCreateProgramObject();
+	m_Program = glCreateProgram();
 }
 
 ///----------------------------------------------------------------------------
@@ -54,15 +56,76 @@ void ShaderProgram::CreateShader()
 ///----------------------------------------------------------------------------
 void ShaderProgram::AttachObject(ShaderObject *obj)
 {
-	glAttachObject(m_Program, obj->GetHandle());
+	glAttachShader(m_Program, obj->GetHandle());
 }
 
 ///----------------------------------------------------------------------------
-///Link program object and leave it ready to use
+///Assigns a vertex attribute index to a name, for shaders that can't set
+///it themselves (GLSL 1.10). Takes effect on the next link.
+///@param index	the attribute index
+///@param attributeName	the attribute name in the vertex shader
+///----------------------------------------------------------------------------
+void ShaderProgram::BindAttribute(GLuint index, const GLcharARB* attributeName)
+{
+	glBindAttribLocation(m_Program, index, attributeName);
+}
+
+///----------------------------------------------------------------------------
+///Link program object and leave it ready to use. Like the compilation of
+///the attached objects, the link is only queued here.
 ///----------------------------------------------------------------------------
 void ShaderProgram::Link()
 {
+	TRACE_ZONE("LinkProgram");
 	glLinkProgram(m_Program);
+	m_Polls = 0;
+}
+
+///----------------------------------------------------------------------------
+///Polls whether the compilation & link of this program have finished.
+///With GL_KHR_parallel_shader_compile this never blocks. Without it there
+///is no way to ask: the program is reported ready after LINK_SETTLE_POLLS
+///polls, one a frame, so drivers that compile on their own threads have
+///had a few frames to finish; on the others the first IsLinked() still
+///waits for the compiler.
+///@return	true if the program status can be queried
+///----------------------------------------------------------------------------
+bool ShaderProgram::IsReady()
+{
+	if(!glMaxShaderCompilerThreads)
+		return ++m_Polls > LINK_SETTLE_POLLS;
+
+	GLint completed = GL_TRUE;
+	glGetProgramiv(m_Program, GL_COMPLETION_STATUS_KHR, &completed);
+
+	return completed != GL_FALSE;
+}
+
+///----------------------------------------------------------------------------
+///Checks the link status of the program, call it once IsReady() is true.
+///@return	true if the program linked successfully
+///----------------------------------------------------------------------------
+bool ShaderProgram::IsLinked() const
+{
+	GLint linked = 0;
+	glGetProgramiv(m_Program, GL_LINK_STATUS, &linked);
+
+	return linked != 0;
+}
+
+///----------------------------------------------------------------------------
+///Gets the size of the linked program the driver keeps, when it can tell
+///(GL 4.1 / ARB_get_program_binary).
+///@return	the binary size in bytes, 0 if unknown
+///----------------------------------------------------------------------------
+GLint ShaderProgram::GetBinarySize() const
+{
+	GLint size = 0;
+
+	if(GetCapabilities().programBinary)
+		glGetProgramiv(m_Program, GL_PROGRAM_BINARY_LENGTH, &size);
+
+	return size;
 }
 
 ///----------------------------------------------------------------------------
@@ -71,8 +134,9 @@ void ShaderProgram::Link()
 void ShaderProgram::DestroyShader()
 {
 	//objects attached to this program will be flagged for deletion
-	glUseProgramObject(0);
-	glDeleteObject(m_Program);
+	glUseProgram(0);
+	glDeleteProgram(m_Program);
+	m_Program = 0;
 }
 
 ///----------------------------------------------------------------------------
@@ -175,24 +239,45 @@ void ShaderProgram::SetUniform(const GLcharARB *uniformName, GLfloat v1, GLfloat
 	glUniform4f(location, v1, v2, v3, v4);
 }
 
+///----------------------------------------------------------------------------
+///Sets a shader uniform mat3 variable
+///@param	uniformName - the name of the uniform variable
+///@param	matrix - 9 floats in column-major order
+///----------------------------------------------------------------------------
+void ShaderProgram::SetUniformMatrix3(const GLcharARB *uniformName, const GLfloat *matrix)
+{
+	int location = glGetUniformLocation(m_Program, uniformName);
+	glUniformMatrix3fv(location, 1, GL_FALSE, matrix);
+}
+
+///----------------------------------------------------------------------------
+///Sets a shader uniform mat4 variable
+///@param	uniformName - the name of the uniform variable
+///@param	matrix - 16 floats in column-major order
+///----------------------------------------------------------------------------
+void ShaderProgram::SetUniformMatrix4(const GLcharARB *uniformName, const GLfloat *matrix)
+{
+	int location = glGetUniformLocation(m_Program, uniformName);
+	glUniformMatrix4fv(location, 1, GL_FALSE, matrix);
+}
+
 ///----------------------------------------------------------------------------
 ///Gets the info log for the current shader program
 ///@return	a string with the log
 ///----------------------------------------------------------------------------
-/*
-GLcharARB* ShaderProgram::GetLog() const
+string ShaderProgram::GetLog() const
 {
-	int compiled;
-	int length;
-	int charsRead;
-	GLcharARB *logStr;
+	GLint length = 0;
+	GLsizei charsRead = 0;
+	string log;
+
+	glGetProgramiv(m_Program, GL_INFO_LOG_LENGTH, &length);
+	if(length <= 1)
+		return log;
 
-	compiled = length = charsRead = 0;
-	glValidateProgram(m_Shader);
-	glGetObjectParameteriv(m_Shader, GL_OBJECT_INFO_LOG_LENGTH_ARB, &length);
-	logStr = (GLcharARB*)malloc(length*sizeof(GLcharARB));
-	glGetInfoLog(m_Shader, length, &charsRead, logStr);
+	log.resize(length);
+	glGetProgramInfoLog(m_Program, length, &charsRead, &log[0]);
+	log.resize(charsRead);
 
-	return logStr;
+	return log;
 }
-*/
\ No newline at end of file
@@ -9,7 +9,9 @@
 #ifndef SHADERPROGRAM_H
 #define SHADERPROGRAM_H
 
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 #include <GL/gl.h>
 #include <GL/glu.h>
@@ -19,6 +21,8 @@
 #include "ShaderObject.h"
 #include "GLExtensions.h"
 
+const int LINK_SETTLE_POLLS = 3;	// Polls (frames) before querying a link without KHR_parallel_shader_compile
+
 class ShaderProgram
 {
 public:
@@ -36,7 +40,11 @@ public:
 	void CreateShader();
 	void DestroyShader();
 	void AttachObject(ShaderObject* obj);
+	void BindAttribute(GLuint index, const GLcharARB* attributeName);
 	void Link();
+	bool IsReady();
+	bool IsLinked() const;
+	GLint GetBinarySize() const;
 	void SetUniform(const GLcharARB* uniformName, GLint value);
 	void SetUniform(const GLcharARB* uniformName, GLint v1, GLint v2);
 	void SetUniform(const GLcharARB* uniformName, GLint v1, GLint v2, GLint v3);
@@ -45,14 +53,17 @@ public:
 	void SetUniform(const GLcharARB* uniformName, GLfloat v1, GLfloat v2);
 	void SetUniform(const GLcharARB* uniformName, GLfloat v1, GLfloat v2, GLfloat v3);
 	void SetUniform(const GLcharARB* uniformName, GLfloat v1, GLfloat v2, GLfloat v3, GLfloat v4);
-	//GLcharARB* GetLog() const;
+	void SetUniformMatrix3(const GLcharARB* uniformName, const GLfloat *matrix);
+	void SetUniformMatrix4(const GLcharARB* uniformName, const GLfloat *matrix);
+	string GetLog() const;
 
 protected:
 	//-------------------------------------------------------------------------
 	//Private Members
 	//-------------------------------------------------------------------------
 	ShaderObject *m_Shaders;	///> Attachable shader objects (i.e. Vertex/Fragment shaders)
-	GLhandleARB m_Program;		///> Handle to Shader program
+	GLuint		m_Program;		///> Handle to Shader program
+	int			m_Polls;		///> IsReady() calls since the last Link()
 };
 
 #endif
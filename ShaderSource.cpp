@@ -0,0 +1,102 @@
+///============================================================================
+///@file	ShaderSource.cpp
+///@brief	Shader Source Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "ShaderSource.h"
+#include "ShaderObject.h"
+
+#include <string.h>
+
+//debug builds read the shaders from disk so they can be hot reloaded
+#ifdef _DEBUG
+bool ShaderSource::s_DevMode = true;
+#else
+bool ShaderSource::s_DevMode = false;
+#endif
+
+///----------------------------------------------------------------------------
+///Gets the source code of a shader and its hash. In development mode the
+///file is read from disk and hashed, otherwise the embedded copy and its
+///precomputed hash are returned without any file I/O.
+///@param	name - the shader file name
+///@param	source - receives the source code
+///@param	hash - receives the source hash
+///@return	true if the shader was found
+///----------------------------------------------------------------------------
+bool ShaderSource::Load(const char *name, string &source, unsigned int &hash)
+{
+	if(s_DevMode)
+	{
+		source = ShaderObject::LoadShaderFromFile((LPSTR)name);
+		hash = Hash(source.c_str(), (unsigned int)source.size());
+
+		if(!source.empty())
+			return true;
+	}
+
+	//not in development mode or the file is missing
+	const EmbeddedShader *shader = Find(name);
+	if(!shader)
+		return false;
+
+	source.assign(shader->source, shader->length);
+	hash = shader->hash;
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Looks up a shader in the embedded table.
+///@param	name - the shader file name
+///@return	the table entry, NULL if there is no such shader
+///----------------------------------------------------------------------------
+const EmbeddedShader* ShaderSource::Find(const char *name)
+{
+	for(unsigned int i=0; i<g_EmbeddedShaderCount; i++)
+		if(strcmp(g_EmbeddedShaders[i].name, name) == 0)
+			return &g_EmbeddedShaders[i];
+
+	return NULL;
+}
+
+///----------------------------------------------------------------------------
+///32 bit FNV-1a hash, must match the one in tools/EmbedShaders.py.
+///@param	data - bytes to hash
+///@param	length - number of bytes
+///@param	seed - previous hash to chain hashes, FNV offset basis by default
+///@return	the hash value
+///----------------------------------------------------------------------------
+unsigned int ShaderSource::Hash(const char *data, unsigned int length, unsigned int seed)
+{
+	unsigned int hash = seed;
+
+	for(unsigned int i=0; i<length; i++)
+	{
+		hash ^= (unsigned char)data[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+///----------------------------------------------------------------------------
+///Enables or disables development mode (reading the sources from disk).
+///@param	enabled - true to read from disk
+///----------------------------------------------------------------------------
+void ShaderSource::SetDevMode(bool enabled)
+{
+	s_DevMode = enabled;
+}
+
+///----------------------------------------------------------------------------
+///Checks whether the sources are read from disk.
+///@return	true in development mode
+///----------------------------------------------------------------------------
+bool ShaderSource::IsDevMode()
+{
+	return s_DevMode;
+}
@@ -0,0 +1,52 @@
+///============================================================================
+///@file	ShaderSource.h
+///@brief	Access to the shader sources. Release builds use the sources
+///			embedded into the executable at build time (EmbeddedShaders.cpp,
+///			generated by tools/EmbedShaders.py), development mode reads them
+///			from disk so they can be edited while the demo runs.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef SHADERSOURCE_H
+#define SHADERSOURCE_H
+
+#include <string>
+
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//Entry of the embedded shader table
+//-----------------------------------------------------------------------------
+struct EmbeddedShader
+{
+	const char		*name;		///> Shader file name (i.e. "CharcoalRendering.frag")
+	const char		*source;	///> Null terminated source code
+	unsigned int	length;		///> Source length in bytes
+	unsigned int	hash;		///> ShaderSource::Hash() of the source
+};
+
+extern const EmbeddedShader	g_EmbeddedShaders[];
+extern const unsigned int	g_EmbeddedShaderCount;
+
+class ShaderSource
+{
+public:
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	static bool			Load(const char *name, string &source, unsigned int &hash);
+	static const EmbeddedShader* Find(const char *name);
+	static unsigned int	Hash(const char *data, unsigned int length, unsigned int seed = 2166136261u);
+	static void			SetDevMode(bool enabled);
+	static bool			IsDevMode();
+
+private:
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	static bool	s_DevMode;	///> Read the sources from disk instead of the table
+};
+
+#endif
@@ -0,0 +1,249 @@
+///============================================================================
+///@file	ShaderWatcher.cpp
+///@brief	Shader Watcher Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "ShaderWatcher.h"
+#include "ShaderObject.h"
+#include "Tracer.h"
+
+#ifndef _WIN32
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+const unsigned int WATCH_TIMEOUT	= 100;	// ms between checks of the stop flag
+const unsigned int SETTLE_TIME		= 20;	// ms to let the editor finish writing
+
+///----------------------------------------------------------------------------
+///Splits a path into its directory and file name.
+///@param	path - the path to split
+///@param	directory - receives the directory ("." if none)
+///@param	name - receives the file name
+///----------------------------------------------------------------------------
+static void SplitPath(const string &path, string &directory, string &name)
+{
+	string::size_type slash = path.find_last_of("/\\");
+
+	if(slash == string::npos)
+	{
+		directory	= ".";
+		name		= path;
+	}
+	else
+	{
+		directory	= path.substr(0, slash);
+		name		= path.substr(slash + 1);
+	}
+}
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+ShaderWatcher::ShaderWatcher()
+{
+	m_Stop		= false;
+	m_Changed	= false;
+	m_Dirty		= NULL;
+#ifdef _WIN32
+	m_Notify	= INVALID_HANDLE_VALUE;
+#else
+	m_Notify	= -1;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+ShaderWatcher::~ShaderWatcher()
+{
+	Stop();
+}
+
+///----------------------------------------------------------------------------
+///Starts watching the given shader files. Both must live in the same
+///directory, which is the one being watched.
+///@param	vertexFile - vertex shader file
+///@param	fragmentFile - fragment shader file
+///@return	true if the watcher thread is running
+///----------------------------------------------------------------------------
+bool ShaderWatcher::Watch(const char *vertexFile, const char *fragmentFile)
+{
+	string directory;
+
+	Stop();
+
+	m_VertexFile	= vertexFile;
+	m_FragmentFile	= fragmentFile;
+	SplitPath(m_VertexFile, m_Directory, directory);
+
+#ifdef _WIN32
+	m_Notify = FindFirstChangeNotification(m_Directory.c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE);
+	if(m_Notify == INVALID_HANDLE_VALUE)
+		return false;
+#else
+	//editors either rewrite the file or rename a temporary over it
+	m_Notify = inotify_init();
+	if(m_Notify < 0)
+		return false;
+
+	if(inotify_add_watch(m_Notify, m_Directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0)
+	{
+		close(m_Notify);
+		m_Notify = -1;
+		return false;
+	}
+#endif
+
+	m_Stop = false;
+
+	return Start();
+}
+
+///----------------------------------------------------------------------------
+///Stops the watcher thread and releases the notification handle.
+///----------------------------------------------------------------------------
+void ShaderWatcher::Stop()
+{
+	m_Stop = true;
+	Join();
+
+#ifdef _WIN32
+	if(m_Notify != INVALID_HANDLE_VALUE)
+		FindCloseChangeNotification(m_Notify);
+	m_Notify = INVALID_HANDLE_VALUE;
+#else
+	if(m_Notify >= 0)
+		close(m_Notify);
+	m_Notify = -1;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Gets the new shader sources if they changed since the last call. Meant to
+///be polled once per frame from the render thread, it never blocks on I/O.
+///@param	vertexSource - receives the vertex shader source
+///@param	fragmentSource - receives the fragment shader source
+///@return	true if there are new sources
+///----------------------------------------------------------------------------
+bool ShaderWatcher::GetChanges(string &vertexSource, string &fragmentSource)
+{
+	ScopedLock lock(m_Lock);
+
+	if(!m_Changed)
+		return false;
+
+	vertexSource	= m_VertexSource;
+	fragmentSource	= m_FragmentSource;
+	m_Changed		= false;
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Sets the dirty state marked whenever new sources are read, for render
+///loops that only draw on demand. Must be set before Watch().
+///@param	dirty - the dirty state, NULL for none
+///----------------------------------------------------------------------------
+void ShaderWatcher::SetDirtyState(DirtyState *dirty)
+{
+	m_Dirty = dirty;
+}
+
+///----------------------------------------------------------------------------
+///Watcher thread, reads the sources every time the directory changes.
+///----------------------------------------------------------------------------
+void ShaderWatcher::Run()
+{
+	TRACE_THREAD("shader watcher");
+
+	//the sources on disk right now are the ones already compiled
+	{
+		ScopedLock lock(m_Lock);
+		m_VertexSource		= ShaderObject::LoadShaderFromFile((LPSTR)m_VertexFile.c_str());
+		m_FragmentSource	= ShaderObject::LoadShaderFromFile((LPSTR)m_FragmentFile.c_str());
+	}
+
+	while(!m_Stop)
+	{
+		if(!WaitForChange())
+			continue;
+
+		Thread::Sleep(SETTLE_TIME);
+		ReadSources();
+	}
+}
+
+///----------------------------------------------------------------------------
+///Waits (up to WATCH_TIMEOUT) for a change to one of the shader files.
+///@return	true if something changed
+///----------------------------------------------------------------------------
+bool ShaderWatcher::WaitForChange()
+{
+#ifdef _WIN32
+	if(WaitForSingleObject(m_Notify, WATCH_TIMEOUT) != WAIT_OBJECT_0)
+		return false;
+
+	//any write in the directory, ReadSources() filters out the rest
+	FindNextChangeNotification(m_Notify);
+
+	return true;
+#else
+	struct pollfd fd;
+	fd.fd		= m_Notify;
+	fd.events	= POLLIN;
+
+	if(poll(&fd, 1, WATCH_TIMEOUT) <= 0)
+		return false;
+
+	char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+	ssize_t length = read(m_Notify, buffer, sizeof(buffer));
+	bool changed = false;
+
+	string directory, vertexName, fragmentName;
+	SplitPath(m_VertexFile, directory, vertexName);
+	SplitPath(m_FragmentFile, directory, fragmentName);
+
+	for(char *ptr = buffer; ptr < buffer + length; )
+	{
+		struct inotify_event *event = (struct inotify_event*)ptr;
+
+		if(event->len && (vertexName == event->name || fragmentName == event->name))
+			changed = true;
+
+		ptr += sizeof(struct inotify_event) + event->len;
+	}
+
+	return changed;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Reads both shader files and publishes them if their contents changed.
+///----------------------------------------------------------------------------
+void ShaderWatcher::ReadSources()
+{
+	string vertexSource		= ShaderObject::LoadShaderFromFile((LPSTR)m_VertexFile.c_str());
+	string fragmentSource	= ShaderObject::LoadShaderFromFile((LPSTR)m_FragmentFile.c_str());
+
+	//caught in the middle of a save, the next notification will follow
+	if(vertexSource.empty() || fragmentSource.empty())
+		return;
+
+	ScopedLock lock(m_Lock);
+
+	if(vertexSource == m_VertexSource && fragmentSource == m_FragmentSource)
+		return;
+
+	m_VertexSource		= vertexSource;
+	m_FragmentSource	= fragmentSource;
+	m_Changed			= true;
+
+	//wake up an on demand render loop to pick them up
+	if(m_Dirty)
+		m_Dirty->Mark(DIRTY_SHADERS);
+}
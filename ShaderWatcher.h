@@ -0,0 +1,70 @@
+///============================================================================
+///@file	ShaderWatcher.h
+///@brief	Watches the shader source files and reads them in a background
+///			thread whenever they change, so the render loop can rebuild the
+///			shaders without restarting the application.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef SHADERWATCHER_H
+#define SHADERWATCHER_H
+
+#include <string>
+
+#include "Thread.h"
+#include "DirtyState.h"
+
+using namespace std;
+
+class ShaderWatcher : public Thread
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	ShaderWatcher();
+	virtual ~ShaderWatcher();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	bool Watch(const char *vertexFile, const char *fragmentFile);
+	void Stop();
+	bool GetChanges(string &vertexSource, string &fragmentSource);
+	void SetDirtyState(DirtyState *dirty);
+
+protected:
+	//-------------------------------------------------------------------------
+	//Protected methods
+	//-------------------------------------------------------------------------
+	virtual void Run();
+
+private:
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	bool WaitForChange();
+	void ReadSources();
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	Mutex			m_Lock;				///> Guards the sources shared with the render thread
+	volatile bool	m_Stop;				///> Asks the watcher thread to finish
+	bool			m_Changed;			///> New sources haven't been picked up yet
+	string			m_Directory;		///> Directory holding the shader files
+	string			m_VertexFile;		///> Vertex shader file name
+	string			m_FragmentFile;		///> Fragment shader file name
+	string			m_VertexSource;		///> Last vertex shader source read
+	string			m_FragmentSource;	///> Last fragment shader source read
+	DirtyState		*m_Dirty;			///> Marked when new sources are read, may be NULL
+#ifdef _WIN32
+	HANDLE			m_Notify;			///> Directory change notification handle
+#else
+	int				m_Notify;			///> inotify descriptor
+#endif
+};
+
+#endif
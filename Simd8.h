@@ -0,0 +1,298 @@
+///============================================================================
+///@file	Simd8.h
+///@brief	8 lane float & int vectors for the CPU renderer. AVX2 builds
+///			(/arch:AVX2, -mavx2 -mfma) use one 256 bit register, everything
+///			else a pair of SSE2 registers, so the same code runs on any x86.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef SIMD8_H
+#define SIMD8_H
+
+#if defined(__AVX2__)
+#define SIMD8_AVX2
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+
+//-----------------------------------------------------------------------------
+//8 floats
+//-----------------------------------------------------------------------------
+struct Float8
+{
+#ifdef SIMD8_AVX2
+	__m256	v;
+#else
+	__m128	lo;		///> lanes 0-3
+	__m128	hi;		///> lanes 4-7
+#endif
+};
+
+//-----------------------------------------------------------------------------
+//8 32 bit integers, also used for lane masks (all bits set = true)
+//-----------------------------------------------------------------------------
+struct Int8
+{
+#ifdef SIMD8_AVX2
+	__m256i	v;
+#else
+	__m128i	lo;		///> lanes 0-3
+	__m128i	hi;		///> lanes 4-7
+#endif
+};
+
+#ifdef SIMD8_AVX2
+
+//-----------------------------------------------------------------------------
+//AVX2
+//-----------------------------------------------------------------------------
+inline Float8 MakeFloat8(__m256 v)	{ Float8 r; r.v = v; return r; }
+inline Int8 MakeInt8(__m256i v)		{ Int8 r; r.v = v; return r; }
+
+inline Float8 Set1(float a)			{ return MakeFloat8(_mm256_set1_ps(a)); }
+inline Float8 Set8(float a0, float a1, float a2, float a3, float a4, float a5, float a6, float a7)
+									{ return MakeFloat8(_mm256_setr_ps(a0, a1, a2, a3, a4, a5, a6, a7)); }
+inline Int8 Set1(int a)				{ return MakeInt8(_mm256_set1_epi32(a)); }
+inline Int8 Set8(int a0, int a1, int a2, int a3, int a4, int a5, int a6, int a7)
+									{ return MakeInt8(_mm256_setr_epi32(a0, a1, a2, a3, a4, a5, a6, a7)); }
+
+inline Float8 operator+(const Float8 &a, const Float8 &b)	{ return MakeFloat8(_mm256_add_ps(a.v, b.v)); }
+inline Float8 operator-(const Float8 &a, const Float8 &b)	{ return MakeFloat8(_mm256_sub_ps(a.v, b.v)); }
+inline Float8 operator*(const Float8 &a, const Float8 &b)	{ return MakeFloat8(_mm256_mul_ps(a.v, b.v)); }
+inline Float8 operator/(const Float8 &a, const Float8 &b)	{ return MakeFloat8(_mm256_div_ps(a.v, b.v)); }
+inline Float8 Min(const Float8 &a, const Float8 &b)			{ return MakeFloat8(_mm256_min_ps(a.v, b.v)); }
+inline Float8 Max(const Float8 &a, const Float8 &b)			{ return MakeFloat8(_mm256_max_ps(a.v, b.v)); }
+inline Float8 Sqrt(const Float8 &a)							{ return MakeFloat8(_mm256_sqrt_ps(a.v)); }
+inline Float8 Floor(const Float8 &a)						{ return MakeFloat8(_mm256_floor_ps(a.v)); }
+
+inline Int8 operator+(const Int8 &a, const Int8 &b)			{ return MakeInt8(_mm256_add_epi32(a.v, b.v)); }
+inline Int8 operator-(const Int8 &a, const Int8 &b)			{ return MakeInt8(_mm256_sub_epi32(a.v, b.v)); }
+inline Int8 operator&(const Int8 &a, const Int8 &b)			{ return MakeInt8(_mm256_and_si256(a.v, b.v)); }
+inline Int8 operator|(const Int8 &a, const Int8 &b)			{ return MakeInt8(_mm256_or_si256(a.v, b.v)); }
+inline Int8 AndNot(const Int8 &a, const Int8 &b)			{ return MakeInt8(_mm256_andnot_si256(a.v, b.v)); }
+inline Int8 ShiftLeft(const Int8 &a, int bits)				{ return MakeInt8(_mm256_slli_epi32(a.v, bits)); }
+inline Int8 ShiftRight(const Int8 &a, int bits)				{ return MakeInt8(_mm256_srli_epi32(a.v, bits)); }
+inline Int8 ShiftRightArithmetic(const Int8 &a, int bits)	{ return MakeInt8(_mm256_srai_epi32(a.v, bits)); }
+
+inline Int8 Less(const Float8 &a, const Float8 &b)			{ return MakeInt8(_mm256_castps_si256(_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ))); }
+inline Int8 Greater(const Float8 &a, const Float8 &b)		{ return MakeInt8(_mm256_castps_si256(_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ))); }
+inline Float8 Select(const Int8 &mask, const Float8 &a, const Float8 &b)	{ return MakeFloat8(_mm256_blendv_ps(b.v, a.v, _mm256_castsi256_ps(mask.v))); }
+inline Int8 Select(const Int8 &mask, const Int8 &a, const Int8 &b)			{ return MakeInt8(_mm256_blendv_epi8(b.v, a.v, mask.v)); }
+inline int MoveMask(const Int8 &mask)						{ return _mm256_movemask_ps(_mm256_castsi256_ps(mask.v)); }
+
+inline Int8 ToInt(const Float8 &a)							{ return MakeInt8(_mm256_cvttps_epi32(a.v)); }
+inline Int8 ToIntRound(const Float8 &a)						{ return MakeInt8(_mm256_cvtps_epi32(a.v)); }
+inline Float8 ToFloat(const Int8 &a)						{ return MakeFloat8(_mm256_cvtepi32_ps(a.v)); }
+inline Int8 AsInt(const Float8 &a)							{ return MakeInt8(_mm256_castps_si256(a.v)); }
+inline Float8 AsFloat(const Int8 &a)						{ return MakeFloat8(_mm256_castsi256_ps(a.v)); }
+
+//loads/stores lanes 0-3 from/to one row and lanes 4-7 from/to another
+inline Float8 LoadRows(const float *row0, const float *row1)
+{
+	return MakeFloat8(_mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(row0)), _mm_loadu_ps(row1), 1));
+}
+
+inline Int8 LoadRows(const unsigned int *row0, const unsigned int *row1)
+{
+	return MakeInt8(_mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)row0)), 
+											_mm_loadu_si128((const __m128i*)row1), 1));
+}
+
+inline void StoreRows(float *row0, float *row1, const Float8 &a)
+{
+	_mm_storeu_ps(row0, _mm256_castps256_ps128(a.v));
+	_mm_storeu_ps(row1, _mm256_extractf128_ps(a.v, 1));
+}
+
+inline void StoreRows(unsigned int *row0, unsigned int *row1, const Int8 &a)
+{
+	_mm_storeu_si128((__m128i*)row0, _mm256_castsi256_si128(a.v));
+	_mm_storeu_si128((__m128i*)row1, _mm256_extracti128_si256(a.v, 1));
+}
+
+inline Int8 Gather(const unsigned int *base, const Int8 &index)
+{
+	return MakeInt8(_mm256_i32gather_epi32((const int*)base, index.v, 4));
+}
+
+//packs the low byte of 4 channels into BGRA pixels
+inline Int8 PackBGRA(const Int8 &b, const Int8 &g, const Int8 &r, const Int8 &a)
+{
+	return b | ShiftLeft(g, 8) | ShiftLeft(r, 16) | ShiftLeft(a, 24);
+}
+
+#else
+
+//-----------------------------------------------------------------------------
+//SSE2
+//-----------------------------------------------------------------------------
+inline Float8 MakeFloat8(__m128 lo, __m128 hi)	{ Float8 r; r.lo = lo; r.hi = hi; return r; }
+inline Int8 MakeInt8(__m128i lo, __m128i hi)	{ Int8 r; r.lo = lo; r.hi = hi; return r; }
+
+inline Float8 Set1(float a)			{ __m128 v = _mm_set1_ps(a); return MakeFloat8(v, v); }
+inline Float8 Set8(float a0, float a1, float a2, float a3, float a4, float a5, float a6, float a7)
+									{ return MakeFloat8(_mm_setr_ps(a0, a1, a2, a3), _mm_setr_ps(a4, a5, a6, a7)); }
+inline Int8 Set1(int a)				{ __m128i v = _mm_set1_epi32(a); return MakeInt8(v, v); }
+inline Int8 Set8(int a0, int a1, int a2, int a3, int a4, int a5, int a6, int a7)
+									{ return MakeInt8(_mm_setr_epi32(a0, a1, a2, a3), _mm_setr_epi32(a4, a5, a6, a7)); }
+
+inline Float8 operator+(const Float8 &a, const Float8 &b)	{ return MakeFloat8(_mm_add_ps(a.lo, b.lo), _mm_add_ps(a.hi, b.hi)); }
+inline Float8 operator-(const Float8 &a, const Float8 &b)	{ return MakeFloat8(_mm_sub_ps(a.lo, b.lo), _mm_sub_ps(a.hi, b.hi)); }
+inline Float8 operator*(const Float8 &a, const Float8 &b)	{ return MakeFloat8(_mm_mul_ps(a.lo, b.lo), _mm_mul_ps(a.hi, b.hi)); }
+inline Float8 operator/(const Float8 &a, const Float8 &b)	{ return MakeFloat8(_mm_div_ps(a.lo, b.lo), _mm_div_ps(a.hi, b.hi)); }
+inline Float8 Min(const Float8 &a, const Float8 &b)			{ return MakeFloat8(_mm_min_ps(a.lo, b.lo), _mm_min_ps(a.hi, b.hi)); }
+inline Float8 Max(const Float8 &a, const Float8 &b)			{ return MakeFloat8(_mm_max_ps(a.lo, b.lo), _mm_max_ps(a.hi, b.hi)); }
+inline Float8 Sqrt(const Float8 &a)							{ return MakeFloat8(_mm_sqrt_ps(a.lo), _mm_sqrt_ps(a.hi)); }
+
+inline Int8 operator+(const Int8 &a, const Int8 &b)			{ return MakeInt8(_mm_add_epi32(a.lo, b.lo), _mm_add_epi32(a.hi, b.hi)); }
+inline Int8 operator-(const Int8 &a, const Int8 &b)			{ return MakeInt8(_mm_sub_epi32(a.lo, b.lo), _mm_sub_epi32(a.hi, b.hi)); }
+inline Int8 operator&(const Int8 &a, const Int8 &b)			{ return MakeInt8(_mm_and_si128(a.lo, b.lo), _mm_and_si128(a.hi, b.hi)); }
+inline Int8 operator|(const Int8 &a, const Int8 &b)			{ return MakeInt8(_mm_or_si128(a.lo, b.lo), _mm_or_si128(a.hi, b.hi)); }
+inline Int8 AndNot(const Int8 &a, const Int8 &b)			{ return MakeInt8(_mm_andnot_si128(a.lo, b.lo), _mm_andnot_si128(a.hi, b.hi)); }
+inline Int8 ShiftLeft(const Int8 &a, int bits)				{ return MakeInt8(_mm_slli_epi32(a.lo, bits), _mm_slli_epi32(a.hi, bits)); }
+inline Int8 ShiftRight(const Int8 &a, int bits)				{ return MakeInt8(_mm_srli_epi32(a.lo, bits), _mm_srli_epi32(a.hi, bits)); }
+inline Int8 ShiftRightArithmetic(const Int8 &a, int bits)	{ return MakeInt8(_mm_srai_epi32(a.lo, bits), _mm_srai_epi32(a.hi, bits)); }
+
+inline Int8 Less(const Float8 &a, const Float8 &b)			{ return MakeInt8(_mm_castps_si128(_mm_cmplt_ps(a.lo, b.lo)), _mm_castps_si128(_mm_cmplt_ps(a.hi, b.hi))); }
+inline Int8 Greater(const Float8 &a, const Float8 &b)		{ return MakeInt8(_mm_castps_si128(_mm_cmpgt_ps(a.lo, b.lo)), _mm_castps_si128(_mm_cmpgt_ps(a.hi, b.hi))); }
+inline int MoveMask(const Int8 &mask)						{ return _mm_movemask_ps(_mm_castsi128_ps(mask.lo)) | (_mm_movemask_ps(_mm_castsi128_ps(mask.hi)) << 4); }
+
+inline Int8 ToInt(const Float8 &a)							{ return MakeInt8(_mm_cvttps_epi32(a.lo), _mm_cvttps_epi32(a.hi)); }
+inline Int8 ToIntRound(const Float8 &a)						{ return MakeInt8(_mm_cvtps_epi32(a.lo), _mm_cvtps_epi32(a.hi)); }
+inline Float8 ToFloat(const Int8 &a)						{ return MakeFloat8(_mm_cvtepi32_ps(a.lo), _mm_cvtepi32_ps(a.hi)); }
+inline Int8 AsInt(const Float8 &a)							{ return MakeInt8(_mm_castps_si128(a.lo), _mm_castps_si128(a.hi)); }
+inline Float8 AsFloat(const Int8 &a)						{ return MakeFloat8(_mm_castsi128_ps(a.lo), _mm_castsi128_ps(a.hi)); }
+
+inline Float8 Select(const Int8 &mask, const Float8 &a, const Float8 &b)
+{
+	Float8 m = AsFloat(mask);
+	return MakeFloat8(_mm_or_ps(_mm_and_ps(m.lo, a.lo), _mm_andnot_ps(m.lo, b.lo)),
+					  _mm_or_ps(_mm_and_ps(m.hi, a.hi), _mm_andnot_ps(m.hi, b.hi)));
+}
+
+inline Int8 Select(const Int8 &mask, const Int8 &a, const Int8 &b)
+{
+	return (mask & a) | AndNot(mask, b);
+}
+
+//SSE2 has no floor, truncate & step back where that rounded up
+inline Float8 Floor(const Float8 &a)
+{
+	Float8 t = ToFloat(ToInt(a));
+	return t - AsFloat(Greater(t, a) & AsInt(Set1(1.0f)));
+}
+
+//loads/stores lanes 0-3 from/to one row and lanes 4-7 from/to another
+inline Float8 LoadRows(const float *row0, const float *row1)
+{
+	return MakeFloat8(_mm_loadu_ps(row0), _mm_loadu_ps(row1));
+}
+
+inline Int8 LoadRows(const unsigned int *row0, const unsigned int *row1)
+{
+	return MakeInt8(_mm_loadu_si128((const __m128i*)row0), _mm_loadu_si128((const __m128i*)row1));
+}
+
+inline void StoreRows(float *row0, float *row1, const Float8 &a)
+{
+	_mm_storeu_ps(row0, a.lo);
+	_mm_storeu_ps(row1, a.hi);
+}
+
+inline void StoreRows(unsigned int *row0, unsigned int *row1, const Int8 &a)
+{
+	_mm_storeu_si128((__m128i*)row0, a.lo);
+	_mm_storeu_si128((__m128i*)row1, a.hi);
+}
+
+//no gather instruction, one scalar load per lane
+inline Int8 Gather(const unsigned int *base, const Int8 &index)
+{
+#ifdef _MSC_VER
+	__declspec(align(16)) int lanes[8];
+#else
+	int lanes[8] __attribute__((aligned(16)));
+#endif
+	_mm_store_si128((__m128i*)lanes, index.lo);
+	_mm_store_si128((__m128i*)(lanes + 4), index.hi);
+
+	return Set8((int)base[lanes[0]], (int)base[lanes[1]], (int)base[lanes[2]], (int)base[lanes[3]],
+				(int)base[lanes[4]], (int)base[lanes[5]], (int)base[lanes[6]], (int)base[lanes[7]]);
+}
+
+//packs the low byte of 4 channels into BGRA pixels
+inline Int8 PackBGRA(const Int8 &b, const Int8 &g, const Int8 &r, const Int8 &a)
+{
+	return b | ShiftLeft(g, 8) | ShiftLeft(r, 16) | ShiftLeft(a, 24);
+}
+
+#endif
+
+//-----------------------------------------------------------------------------
+//Common helpers
+//-----------------------------------------------------------------------------
+inline Float8 Clamp(const Float8 &a, const Float8 &low, const Float8 &high)	{ return Min(Max(a, low), high); }
+inline Float8 Lerp(const Float8 &a, const Float8 &b, const Float8 &t)		{ return a + (b - a) * t; }
+
+//natural logarithm of positive values (Cephes logf, ~1e-7 relative error)
+inline Float8 Log(const Float8 &x)
+{
+	Int8 bits = AsInt(x);
+	Float8 e = ToFloat(ShiftRight(bits, 23) - Set1(126));
+	Float8 m = AsFloat((bits & Set1(0x007FFFFF)) | Set1(0x3F000000));	// [0.5, 1)
+
+	//keep the mantissa in [sqrt(0.5), sqrt(2)) around 1
+	Int8 small = Less(m, Set1(0.707106781186547524f));
+	e = e - AsFloat(small & AsInt(Set1(1.0f)));
+	m = m + AsFloat(small & AsInt(m)) - Set1(1.0f);
+
+	Float8 z = m * m;
+	Float8 y = Set1(7.0376836292E-2f);
+	y = y * m + Set1(-1.1514610310E-1f);
+	y = y * m + Set1(1.1676998740E-1f);
+	y = y * m + Set1(-1.2420140846E-1f);
+	y = y * m + Set1(1.4249322787E-1f);
+	y = y * m + Set1(-1.6668057665E-1f);
+	y = y * m + Set1(2.0000714765E-1f);
+	y = y * m + Set1(-2.4999993993E-1f);
+	y = y * m + Set1(3.3333331174E-1f);
+	y = y * m * z;
+
+	y = y + e * Set1(-2.12194440e-4f);
+	y = y - z * Set1(0.5f);
+
+	return m + y + e * Set1(0.693359375f);
+}
+
+//e raised to x (Cephes expf, ~1e-7 relative error)
+inline Float8 Exp(const Float8 &value)
+{
+	Float8 x = Clamp(value, Set1(-87.3f), Set1(88.3f));
+	Float8 fx = Floor(x * Set1(1.44269504088896341f) + Set1(0.5f));
+
+	x = x - fx * Set1(0.693359375f) - fx * Set1(-2.12194440e-4f);
+
+	Float8 z = x * x;
+	Float8 y = Set1(1.9875691500E-4f);
+	y = y * x + Set1(1.3981999507E-3f);
+	y = y * x + Set1(8.3334519073E-3f);
+	y = y * x + Set1(4.1665795894E-2f);
+	y = y * x + Set1(1.6666665459E-1f);
+	y = y * x + Set1(5.0000001201E-1f);
+	y = y * z + x + Set1(1.0f);
+
+	//scale by 2^fx building the exponent bits directly
+	return y * AsFloat(ShiftLeft(ToInt(fx) + Set1(127), 23));
+}
+
+//x raised to a constant power, 0 for x <= 0 like pow() on [0,1] inputs
+inline Float8 Pow(const Float8 &x, float exponent)
+{
+	Int8 positive = Greater(x, Set1(0.0f));
+	return Select(positive, Exp(Log(Max(x, Set1(1e-30f))) * Set1(exponent)), Set1(0.0f));
+}
+
+#endif
@@ -0,0 +1,731 @@
+///============================================================================
+///@file	SoftwareRenderer.cpp
+///@brief	Software Renderer Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "SoftwareRenderer.h"
+#include "Simd8.h"
+#include "Tracer.h"
+#include "MemoryStats.h"
+
+#include <math.h>
+#include <string.h>
+
+const int		SUBPIXEL_BITS	= 4;		// 28.4 fixed point screen positions
+const int		SUBPIXEL_ONE	= 1 << SUBPIXEL_BITS;
+const GLfloat	GUARD_BAND		= 16.0f;	// Clip only beyond 16x the viewport
+const long long	EDGE_LIMIT		= 1 << 30;	// Edge values stay in 32 bit lanes
+
+//4x2 pixel block covered by the 8 SIMD lanes
+static const int LANE_X[8] = {0, 1, 2, 3, 0, 1, 2, 3};
+static const int LANE_Y[8] = {0, 0, 0, 0, 1, 1, 1, 1};
+
+///----------------------------------------------------------------------------
+///Converts colors in [0,1] to BGRA pixels, rounding like the GL does.
+///@return	the packed pixels
+///----------------------------------------------------------------------------
+static inline Int8 PackColor(const Float8 &red, const Float8 &green, const Float8 &blue, const Float8 &alpha)
+{
+	Float8 zero = Set1(0.0f);
+	Float8 one = Set1(1.0f);
+	Float8 scale = Set1(255.0f);
+	Float8 half = Set1(0.5f);
+
+	return PackBGRA(ToInt(Clamp(blue, zero, one) * scale + half),
+					ToInt(Clamp(green, zero, one) * scale + half),
+					ToInt(Clamp(red, zero, one) * scale + half),
+					ToInt(Clamp(alpha, zero, one) * scale + half));
+}
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+SoftwareRenderer::SoftwareRenderer()
+{
+	m_Geometry	= NULL;
+	m_Phase		= PHASE_TRANSFORM;
+	m_Width		= 0;
+	m_Height	= 0;
+	m_TilesX	= 0;
+	m_TilesY	= 0;
+	m_Features	= 0;
+
+	//same look as the shader defaults
+	m_Constants.oversaturation	= 1.5f;
+	m_Constants.contrastExp		= 3.5f;
+	m_Constants.cetScale		= 0.5f;
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+SoftwareRenderer::~SoftwareRenderer()
+{
+	ShutDown();
+}
+
+///----------------------------------------------------------------------------
+///Loads the textures & the mesh and starts the worker threads.
+///@param	geometry - scene geometry, camera & light
+///@param	threads - number of worker threads, 0 for one per processor
+///@return	true if the renderer is ready
+///----------------------------------------------------------------------------
+bool SoftwareRenderer::Init(Geometry *geometry, unsigned int threads)
+{
+	ShutDown();
+
+	m_Geometry = geometry;
+	m_Mesh.Build(m_Geometry->GetModel());
+
+	const vector<MeshVertex> &vertices = m_Mesh.GetVertices();
+	m_Transform.SetGuardBand(GUARD_BAND);
+	m_Transform.SetPositions(vertices.empty() ? NULL : vertices[0].position, vertices.size(), sizeof(MeshVertex));
+
+	//same files Geometry::SetTextures() uploads to the GL
+	if(!m_Paper.Load("textures/paper.tga") ||
+	   !m_Noise.Load("textures/noise.tga") ||
+	   !m_Contrast.Load("textures/contrast.tga"))
+	{
+		OutputDebugString("Software renderer could not load its textures.\n");
+		return false;
+	}
+
+	SetConstants(m_Constants);
+
+	if(!m_Pool.Start(threads))
+	{
+		ShutDown();
+		return false;
+	}
+
+	for(unsigned int i=0; i<m_Pool.GetThreadCount(); i++)
+		m_Workers.push_back(new WorkerData());
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Renders a frame of the charcoal scene.
+///@param	scene - the scene state, only spin, size & quality are used
+///@return	the frame pixels (BGRA, bottom row first), valid until the next
+///			frame is rendered
+///----------------------------------------------------------------------------
+const unsigned char* SoftwareRenderer::Render(const SceneState &scene)
+{
+	if(m_Workers.empty() || scene.width <= 0 || scene.height <= 0)
+		return NULL;
+
+	TRACE_ZONE("software frame");
+
+	if(scene.width != m_Width || scene.height != m_Height)
+		Resize(scene.width, scene.height);
+
+	RenderBackend::ComputeMatrices(m_Geometry, scene, m_ModelViewProjection, m_NormalMatrix);
+	m_Geometry->GetLightPosition(m_Light);
+	m_Features = ShaderPermutation::GetTierFeatures(scene.quality);
+
+	m_Transformed.resize(m_Mesh.GetVertices().size());
+	RunPhase(PHASE_TRANSFORM);
+	RunPhase(PHASE_BIN);
+
+	//each worker starts on its own contiguous range of tiles
+	long tiles = m_TilesX * m_TilesY;
+	long workers = (long)m_Workers.size();
+
+	for(long i=0; i<workers; i++)
+	{
+		m_Workers[i]->nextTile	= tiles * i / workers - 1;
+		m_Workers[i]->endTile	= tiles * (i + 1) / workers;
+	}
+
+	RunPhase(PHASE_RASTERIZE);
+
+	return &m_Pixels[0];
+}
+
+///----------------------------------------------------------------------------
+///Changes the charcoal look constants & rebuilds the CEO lookup table.
+///@param	constants - new constants
+///----------------------------------------------------------------------------
+void SoftwareRenderer::SetConstants(const CharcoalConstants &constants)
+{
+	GLubyte table[CEO_LUT_SIZE];
+
+	m_Constants = constants;
+	ShaderPermutation::BuildLookupTable(m_Constants, table);
+
+	for(int i=0; i<CEO_LUT_SIZE; i++)
+		m_Lookup[i] = table[i];
+}
+
+///----------------------------------------------------------------------------
+///Stops the worker threads & releases the frame.
+///----------------------------------------------------------------------------
+void SoftwareRenderer::ShutDown()
+{
+	m_Pool.Stop();
+
+	for(size_t i=0; i<m_Workers.size(); i++)
+		delete m_Workers[i];
+
+	m_Workers.clear();
+
+	MemoryStats::Free(MC_FRAME, MP_CPU, m_Pixels.size());
+	vector<unsigned char>().swap(m_Pixels);
+	m_Width		= 0;
+	m_Height	= 0;
+}
+
+///----------------------------------------------------------------------------
+///Allocates the frame & the tile bins for a new frame size.
+///@param	width - frame width
+///@param	height - frame height
+///----------------------------------------------------------------------------
+void SoftwareRenderer::Resize(int width, int height)
+{
+	m_Width		= width;
+	m_Height	= height;
+	m_TilesX	= (width + TILE_SIZE - 1) / TILE_SIZE;
+	m_TilesY	= (height + TILE_SIZE - 1) / TILE_SIZE;
+
+	MemoryStats::Free(MC_FRAME, MP_CPU, m_Pixels.size());
+	m_Pixels.resize(width * height * 4);
+	MemoryStats::Allocate(MC_FRAME, MP_CPU, m_Pixels.size());
+
+	for(size_t i=0; i<m_Workers.size(); i++)
+		m_Workers[i]->bins.resize(m_TilesX * m_TilesY);
+}
+
+///----------------------------------------------------------------------------
+///Runs a phase on every worker & waits for all of them to finish it.
+///@param	phase - the phase to run
+///----------------------------------------------------------------------------
+void SoftwareRenderer::RunPhase(Phase phase)
+{
+	m_Phase = phase;
+	m_Pool.Run(*this);
+}
+
+///----------------------------------------------------------------------------
+///Runs the current phase on a worker thread.
+///@param	worker - worker number
+///@param	workers - number of workers, one WorkerData each
+///----------------------------------------------------------------------------
+void SoftwareRenderer::Execute(unsigned int worker, unsigned int workers)
+{
+	int index = (int)worker;
+
+	switch(m_Phase)
+	{
+		case PHASE_TRANSFORM:
+		{
+			TRACE_ZONE("transform");
+			TransformVertices(index, workers);
+			break;
+		}
+
+		case PHASE_BIN:
+		{
+			TRACE_ZONE("bin");
+			BinTriangles(index, workers);
+			break;
+		}
+
+		case PHASE_RASTERIZE:
+		{
+			TRACE_ZONE("rasterize");
+			RasterizeTiles(index);
+			break;
+		}
+
+		default:
+			break;
+	}
+}
+
+///----------------------------------------------------------------------------
+///Runs the vertex shader on the worker's slice of the vertices.
+///@param	index - worker number
+///@param	workers - number of workers sharing the vertices
+///----------------------------------------------------------------------------
+void SoftwareRenderer::TransformVertices(int index, unsigned int workers)
+{
+	const vector<MeshVertex> &vertices = m_Mesh.GetVertices();
+	size_t first, last;
+	const GLfloat *n = m_NormalMatrix;
+
+	//8 vertex batches for the SIMD transform
+	GetRange(vertices.size(), index, workers, first, last, 8);
+	m_Transform.TransformRange(m_ModelViewProjection, first, last);
+
+	const GLfloat *clipX = m_Transform.GetClipX();
+	const GLfloat *clipY = m_Transform.GetClipY();
+	const GLfloat *clipZ = m_Transform.GetClipZ();
+	const GLfloat *clipW = m_Transform.GetClipW();
+
+	for(size_t i=first; i<last; i++)
+	{
+		const GLfloat *p = vertices[i].position;
+		const GLfloat *normal = vertices[i].normal;
+		ClipVertex &out = m_Transformed[i];
+
+		out.position[0] = clipX[i];
+		out.position[1] = clipY[i];
+		out.position[2] = clipZ[i];
+		out.position[3] = clipW[i];
+
+		GLfloat w = (out.position[3] != 0.0f) ? out.position[3] : 1.0f;
+
+		//N, L, paper & noise coordinates, as in CharcoalRendering330.vert
+		for(int row=0; row<3; row++)
+		{
+			out.varyings[row] = n[row] * normal[0] + n[3 + row] * normal[1] + n[6 + row] * normal[2];
+			out.varyings[3 + row] = m_Light[row] - p[row];
+		}
+
+		out.varyings[6] = out.position[0] / w * 0.5f + 0.5f;
+		out.varyings[7] = out.position[1] / w * 0.5f + 0.5f;
+		out.varyings[8] = out.position[0];
+		out.varyings[9] = out.position[1];
+	}
+}
+
+///----------------------------------------------------------------------------
+///Clips, sets up & bins the worker's slice of the triangles.
+///@param	index - worker number
+///@param	workers - number of workers sharing the triangles
+///----------------------------------------------------------------------------
+void SoftwareRenderer::BinTriangles(int index, unsigned int workers)
+{
+	WorkerData &data = *m_Workers[index];
+	const vector<GLuint> &indices = m_Mesh.GetIndices();
+	size_t count = indices.size() / 3;
+	size_t first = count * index / workers;
+	size_t last = count * (index + 1) / workers;
+
+	//keep the capacity, the scene is about the same from frame to frame
+	data.triangles.clear();
+	for(size_t i=0; i<data.bins.size(); i++)
+		data.bins[i].clear();
+
+	const unsigned int *outcodes = m_Transform.GetOutcodes();
+
+	for(size_t i=first; i<last; i++)
+	{
+		GLuint i0 = indices[i*3 + 0];
+		GLuint i1 = indices[i*3 + 1];
+		GLuint i2 = indices[i*3 + 2];
+
+		//all 3 vertices out of the same plane
+		if(outcodes[i0] & outcodes[i1] & outcodes[i2])
+			continue;
+
+		//the view volume sides are left to the rasterizer's bounding box
+		unsigned int planes = (outcodes[i0] | outcodes[i1] | outcodes[i2]) & OC_CLIP;
+
+		if(planes)
+			ClipTriangle(data, m_Transformed[i0], m_Transformed[i1], m_Transformed[i2], planes);
+		else
+			SetupTriangle(data, m_Transformed[i0], m_Transformed[i1], m_Transformed[i2]);
+	}
+}
+
+///----------------------------------------------------------------------------
+///Clips a triangle crossing the near or far planes or the guard band & sets
+///up the polygon left as a fan.
+///@param	data - worker doing the setup
+///@param	v0, v1, v2 - triangle vertices
+///@param	planes - outcode bits of the planes it crosses
+///----------------------------------------------------------------------------
+void SoftwareRenderer::ClipTriangle(WorkerData &data, const ClipVertex &v0, const ClipVertex &v1, const ClipVertex &v2,
+									unsigned int planes)
+{
+	ClipVertex polygon[MAX_CLIP_VERTICES];
+	const int stride = sizeof(ClipVertex) / sizeof(GLfloat);
+
+	int count = m_Transform.ClipTriangle(v0.position, v1.position, v2.position, stride, planes, polygon[0].position);
+
+	for(int i=1; i<count-1; i++)
+		SetupTriangle(data, polygon[0], polygon[i], polygon[i + 1]);
+}
+
+///----------------------------------------------------------------------------
+///Computes the edge functions, bounding box & interpolation planes of a
+///triangle and adds it to the bins of the tiles it overlaps.
+///@param	data - worker doing the setup
+///@param	v0, v1, v2 - clipped triangle vertices
+///----------------------------------------------------------------------------
+void SoftwareRenderer::SetupTriangle(WorkerData &data, const ClipVertex &v0, const ClipVertex &v1, const ClipVertex &v2)
+{
+	const ClipVertex *vertex[3] = {&v0, &v1, &v2};
+	GLfloat attributes[3][NUM_PLANES];
+	GLfloat screenX[3], screenY[3];
+	long long X[3], Y[3];
+
+	for(int i=0; i<3; i++)
+	{
+		const GLfloat *p = vertex[i]->position;
+		GLfloat oneOverW = 1.0f / p[3];
+
+		//viewport transform, snapped to the subpixel grid for coverage
+		screenX[i] = ((p[0] * oneOverW) * 0.5f + 0.5f) * m_Width;
+		screenY[i] = ((p[1] * oneOverW) * 0.5f + 0.5f) * m_Height;
+		X[i] = (long long)floor(screenX[i] * SUBPIXEL_ONE + 0.5f);
+		Y[i] = (long long)floor(screenY[i] * SUBPIXEL_ONE + 0.5f);
+
+		//perspective correct varyings are interpolated divided by w
+		attributes[i][0] = oneOverW;
+		attributes[i][1] = (p[2] * oneOverW) * 0.5f + 0.5f;
+		for(int j=0; j<NUM_VARYINGS; j++)
+			attributes[i][2 + j] = vertex[i]->varyings[j] * oneOverW;
+	}
+
+	long long area = (X[1] - X[0]) * (Y[2] - Y[0]) - (X[2] - X[0]) * (Y[1] - Y[0]);
+	if(area == 0)
+		return;
+
+	//no culling, wind everything counter-clockwise
+	int order[3] = {0, 1, 2};
+	if(area < 0)
+	{
+		order[1] = 2;
+		order[2] = 1;
+		area = -area;
+	}
+
+	TriangleSetup triangle;
+	long long minXf = X[0], maxXf = X[0], minYf = Y[0], maxYf = Y[0];
+
+	for(int k=0; k<3; k++)
+	{
+		int a = order[k], b = order[(k + 1) % 3];
+		long long dx = X[b] - X[a];
+		long long dy = Y[b] - Y[a];
+
+		triangle.edgeA[k] = -dy;
+		triangle.edgeB[k] = dx;
+		triangle.edgeC[k] = -(triangle.edgeA[k] * X[a] + triangle.edgeB[k] * Y[a]);
+
+		//top-left fill rule, pixels on other edges belong to the neighbor
+		if(!(dy < 0 || (dy == 0 && dx < 0)))
+			triangle.edgeC[k] -= 1;
+
+		for(int lane=0; lane<8; lane++)
+			triangle.laneOffset[k][lane] = (int)(triangle.edgeA[k] * SUBPIXEL_ONE * LANE_X[lane] +
+												 triangle.edgeB[k] * SUBPIXEL_ONE * LANE_Y[lane]);
+
+		if(X[k] < minXf) minXf = X[k];
+		if(X[k] > maxXf) maxXf = X[k];
+		if(Y[k] < minYf) minYf = Y[k];
+		if(Y[k] > maxYf) maxYf = Y[k];
+	}
+
+	//pixels whose center is inside the box
+	long long half = SUBPIXEL_ONE / 2;
+	long long minX = (minXf - half + SUBPIXEL_ONE - 1) >> SUBPIXEL_BITS;
+	long long maxX = (maxXf - half) >> SUBPIXEL_BITS;
+	long long minY = (minYf - half + SUBPIXEL_ONE - 1) >> SUBPIXEL_BITS;
+	long long maxY = (maxYf - half) >> SUBPIXEL_BITS;
+
+	triangle.minX = (int)((minX < 0) ? 0 : minX);
+	triangle.minY = (int)((minY < 0) ? 0 : minY);
+	triangle.maxX = (int)((maxX >= m_Width) ? m_Width - 1 : maxX);
+	triangle.maxY = (int)((maxY >= m_Height) ? m_Height - 1 : maxY);
+
+	if(triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+		return;
+
+	//attribute planes from the exact positions, the noise coordinates step
+	//dozens of texels per pixel & would shift with the subpixel snapping
+	GLfloat x0 = screenX[0], y0 = screenY[0];
+	GLfloat x1 = screenX[1] - x0, y1 = screenY[1] - y0;
+	GLfloat x2 = screenX[2] - x0, y2 = screenY[2] - y0;
+	GLfloat determinant = x1 * y2 - x2 * y1;
+
+	if(determinant == 0.0f)
+		return;
+
+	triangle.x0 = x0;
+	triangle.y0 = y0;
+
+	for(int j=0; j<NUM_PLANES; j++)
+	{
+		GLfloat f1 = attributes[1][j] - attributes[0][j];
+		GLfloat f2 = attributes[2][j] - attributes[0][j];
+
+		triangle.planes[j][0] = attributes[0][j];
+		triangle.planes[j][1] = (f1 * y2 - f2 * y1) / determinant;
+		triangle.planes[j][2] = (f2 * x1 - f1 * x2) / determinant;
+	}
+
+	int index = (int)data.triangles.size();
+	data.triangles.push_back(triangle);
+
+	for(int ty=triangle.minY / TILE_SIZE; ty<=triangle.maxY / TILE_SIZE; ty++)
+		for(int tx=triangle.minX / TILE_SIZE; tx<=triangle.maxX / TILE_SIZE; tx++)
+			data.bins[ty * m_TilesX + tx].push_back(index);
+}
+
+///----------------------------------------------------------------------------
+///Draws tiles until there are none left, starting with the worker's own
+///range & then stealing from the others.
+///@param	index - worker number
+///----------------------------------------------------------------------------
+void SoftwareRenderer::RasterizeTiles(int index)
+{
+	WorkerData &data = *m_Workers[index];
+	int tile;
+
+	while(TakeTile(index, tile))
+		DrawTile(data, tile);
+}
+
+///----------------------------------------------------------------------------
+///Takes the next free tile.
+///@param	index - worker number
+///@param	tile - receives the tile number
+///@return	false if every tile was taken
+///----------------------------------------------------------------------------
+bool SoftwareRenderer::TakeTile(int index, int &tile)
+{
+	size_t workers = m_Workers.size();
+
+	for(size_t i=0; i<workers; i++)
+	{
+		//a taken range just keeps counting past its end
+		WorkerData &owner = *m_Workers[(index + i) % workers];
+		long next = AtomicIncrement(&owner.nextTile);
+		if(next < owner.endTile)
+		{
+			tile = (int)next;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+///----------------------------------------------------------------------------
+///Draws one tile: the paper background, then every triangle binned to it in
+///submission order, and copies it to the frame.
+///@param	data - worker drawing the tile
+///@param	tile - tile number
+///----------------------------------------------------------------------------
+void SoftwareRenderer::DrawTile(WorkerData &data, int tile)
+{
+	int originX = (tile % m_TilesX) * TILE_SIZE;
+	int originY = (tile / m_TilesX) * TILE_SIZE;
+
+	for(int i=0; i<TILE_SIZE * TILE_SIZE; i++)
+		data.depth[i] = 1.0f;
+
+	DrawPaper(data, originX, originY);
+
+	//workers binned consecutive slices of the triangle list
+	for(size_t w=0; w<m_Workers.size(); w++)
+	{
+		const WorkerData &binner = *m_Workers[w];
+		const vector<int> &bin = binner.bins[tile];
+
+		for(size_t i=0; i<bin.size(); i++)
+			DrawTriangle(data, binner.triangles[bin[i]], originX, originY);
+	}
+
+	int width = (m_Width - originX < TILE_SIZE) ? m_Width - originX : TILE_SIZE;
+	int height = (m_Height - originY < TILE_SIZE) ? m_Height - originY : TILE_SIZE;
+
+	for(int y=0; y<height; y++)
+		memcpy(&m_Pixels[((originY + y) * m_Width + originX) * 4], &data.color[y * TILE_SIZE], width * 4);
+}
+
+///----------------------------------------------------------------------------
+///Fills a tile with the paper texture, as PaperBackground330 does.
+///@param	data - worker drawing the tile
+///@param	originX, originY - tile position in the frame
+///----------------------------------------------------------------------------
+void SoftwareRenderer::DrawPaper(WorkerData &data, int originX, int originY)
+{
+	Float8 laneX = Set8(0.5f, 1.5f, 2.5f, 3.5f, 0.5f, 1.5f, 2.5f, 3.5f);
+	Float8 laneY = Set8(0.5f, 0.5f, 0.5f, 0.5f, 1.5f, 1.5f, 1.5f, 1.5f);
+	Float8 scaleX = Set1(1.0f / m_Width);
+	Float8 scaleY = Set1(1.0f / m_Height);
+	Float8 one = Set1(1.0f);
+	Float8 red, green, blue;
+
+	for(int y=0; y<TILE_SIZE; y+=2)
+	{
+		if(originY + y >= m_Height)
+			break;
+
+		for(int x=0; x<TILE_SIZE; x+=4)
+		{
+			if(originX + x >= m_Width)
+				break;
+
+			Float8 s = (Set1((float)(originX + x)) + laneX) * scaleX;
+			Float8 t = (Set1((float)(originY + y)) + laneY) * scaleY;
+
+			m_Paper.SampleBilinear(s, t, 0, red, green, blue);
+
+			StoreRows(&data.color[y * TILE_SIZE + x], &data.color[(y + 1) * TILE_SIZE + x],
+					  PackColor(red, green, blue, one));
+		}
+	}
+}
+
+///----------------------------------------------------------------------------
+///Rasterizes & shades the part of a triangle inside a tile, 4x2 pixels at
+///a time, following CharcoalRendering330.frag.
+///@param	data - worker drawing the tile
+///@param	triangle - the set up triangle
+///@param	originX, originY - tile position in the frame
+///----------------------------------------------------------------------------
+void SoftwareRenderer::DrawTriangle(WorkerData &data, const TriangleSetup &triangle, int originX, int originY)
+{
+	int startX = (triangle.minX > originX) ? triangle.minX : originX;
+	int startY = (triangle.minY > originY) ? triangle.minY : originY;
+	int endX = (triangle.maxX < originX + TILE_SIZE - 1) ? triangle.maxX : originX + TILE_SIZE - 1;
+	int endY = (triangle.maxY < originY + TILE_SIZE - 1) ? triangle.maxY : originY + TILE_SIZE - 1;
+
+	if(startX > endX || startY > endY)
+		return;
+
+	//blocks stay aligned to the tile
+	startX = originX + ((startX - originX) & ~3);
+	startY = originY + ((startY - originY) & ~1);
+
+	Int8 offsets[3];
+	for(int k=0; k<3; k++)
+		offsets[k] = LoadRows((const unsigned int*)&triangle.laneOffset[k][0], (const unsigned int*)&triangle.laneOffset[k][4]);
+
+	Float8 laneX = Set8(0.0f, 1.0f, 2.0f, 3.0f, 0.0f, 1.0f, 2.0f, 3.0f);
+	Float8 laneY = Set8(0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+	Float8 zero = Set1(0.0f);
+	Float8 one = Set1(1.0f);
+	Float8 half = Set1(0.5f);
+	bool lookup		= (m_Features & SF_CEO_LUT) != 0;
+	bool smudge		= (m_Features & SF_CET_SMUDGE) != 0;
+	bool jitter		= (m_Features & SF_NOISE_JITTER) != 0;
+	bool overlay	= (m_Features & SF_PAPER_OVERLAY) != 0;
+
+	for(int by=startY; by<=endY; by+=2)
+	{
+		int row = (by - originY) * TILE_SIZE;
+		Float8 fy = Set1(by + 0.5f - triangle.y0) + laneY;
+
+		for(int bx=startX; bx<=endX; bx+=4)
+		{
+			//edge functions at the first pixel center of the block
+			Int8 edges[3];
+			long long px = ((long long)bx << SUBPIXEL_BITS) + SUBPIXEL_ONE / 2;
+			long long py = ((long long)by << SUBPIXEL_BITS) + SUBPIXEL_ONE / 2;
+
+			for(int k=0; k<3; k++)
+			{
+				long long e = triangle.edgeA[k] * px + triangle.edgeB[k] * py + triangle.edgeC[k];
+
+				//far from the edge only the sign matters
+				if(e > EDGE_LIMIT)	e = EDGE_LIMIT;
+				if(e < -EDGE_LIMIT)	e = -EDGE_LIMIT;
+
+				edges[k] = Set1((int)e) + offsets[k];
+			}
+
+			Int8 outside = ShiftRightArithmetic(edges[0] | edges[1] | edges[2], 31);
+			Int8 covered = AndNot(outside, Set1(-1));
+
+			if(MoveMask(covered) == 0)
+				continue;
+
+			int column = bx - originX;
+			GLfloat *depth0 = &data.depth[row + column];
+			GLfloat *depth1 = &data.depth[row + TILE_SIZE + column];
+			Float8 fx = Set1(bx + 0.5f - triangle.x0) + laneX;
+
+			//depth test (GL_LESS)
+			Float8 z = Set1(triangle.planes[1][0]) + Set1(triangle.planes[1][1]) * fx + Set1(triangle.planes[1][2]) * fy;
+			Float8 oldZ = LoadRows(depth0, depth1);
+			Int8 pass = covered & Less(z, oldZ);
+
+			if(MoveMask(pass) == 0)
+				continue;
+
+			StoreRows(depth0, depth1, Select(pass, z, oldZ));
+
+			//perspective correct varyings
+			Float8 oneOverW = Set1(triangle.planes[0][0]) + Set1(triangle.planes[0][1]) * fx + Set1(triangle.planes[0][2]) * fy;
+			Float8 w = one / oneOverW;
+			Float8 v[NUM_VARYINGS];
+
+			for(int j=0; j<NUM_VARYINGS; j++)
+			{
+				const GLfloat *plane = triangle.planes[2 + j];
+				v[j] = (Set1(plane[0]) + Set1(plane[1]) * fx + Set1(plane[2]) * fy) * w;
+			}
+
+			//CEO: lambertian intensity, oversaturated & contrast enhanced
+			Float8 NdotL = v[0] * v[3] + v[1] * v[4] + v[2] * v[5];
+			Float8 NN = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+			Float8 LL = v[3] * v[3] + v[4] * v[4] + v[5] * v[5];
+			Float8 LI = Max(zero, NdotL / Sqrt(Max(NN * LL, Set1(1e-30f))));
+			Float8 diffuse;
+
+			LI = Clamp(LI + Set1(LIGHT_AMBIENT), zero, one);
+
+			if(lookup)
+			{
+				//linear filtering, clamped to the edges of the table
+				Float8 u = Clamp(LI * Set1((float)CEO_LUT_SIZE) - half, zero, Set1((float)(CEO_LUT_SIZE - 1)));
+				Float8 u0 = Floor(u);
+				Int8 i0 = ToInt(u0);
+				Int8 i1 = ToInt(Min(u0 + one, Set1((float)(CEO_LUT_SIZE - 1))));
+
+				diffuse = Lerp(ToFloat(Gather(m_Lookup, i0)), ToFloat(Gather(m_Lookup, i1)), u - u0) * Set1(1.0f / 255.0f);
+			}
+			else
+			{
+				diffuse = Pow(Clamp(LI * Set1(m_Constants.oversaturation), zero, one), m_Constants.contrastExp);
+			}
+
+			Float8 red = diffuse, green = diffuse, blue = diffuse, alpha = diffuse;
+
+			//blend with the contrast enhanced texture
+			if(smudge)
+			{
+				Float8 noise = zero, unused0, unused1;
+				Float8 cetRed, cetGreen, cetBlue;
+				Float8 cetScale = Set1(m_Constants.cetScale);
+
+				if(jitter)
+					m_Noise.SampleBilinear(v[8], v[9], 0, noise, unused0, unused1);
+
+				m_Contrast.SampleBilinear(noise * cetScale, diffuse * cetScale, 0, cetRed, cetGreen, cetBlue);
+
+				red		= (diffuse + cetRed) * half;
+				green	= (diffuse + cetGreen) * half;
+				blue	= (diffuse + cetBlue) * half;
+				alpha	= (diffuse + one) * half;
+			}
+
+			//overlay the inverted paper
+			if(overlay)
+			{
+				Float8 paperRed, paperGreen, paperBlue;
+
+				m_Paper.SampleBilinear(v[6], v[7], 0, paperRed, paperGreen, paperBlue);
+
+				red		= red - (one - paperRed);
+				green	= green - (one - paperGreen);
+				blue	= blue - (one - paperBlue);
+			}
+
+			unsigned int *color0 = &data.color[row + column];
+			unsigned int *color1 = &data.color[row + TILE_SIZE + column];
+
+			StoreRows(color0, color1, Select(pass, PackColor(red, green, blue, alpha), LoadRows(color0, color1)));
+		}
+	}
+}
@@ -0,0 +1,131 @@
+///============================================================================
+///@file	SoftwareRenderer.h
+///@brief	CPU implementation of the charcoal pipeline for machines without
+///			a GPU. The screen is split in tiles, triangles are binned per tile
+///			and rasterized with fixed point edge functions, 8 pixels at a time
+///			(Simd8.h), by one worker per core stealing tiles from each other.
+///			Vertices are transformed, outcoded & clipped by VertexTransform.
+///			The shading follows CharcoalRendering330.vert/.frag so images
+///			match the core backend within rounding.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef SOFTWARERENDERER_H
+#define SOFTWARERENDERER_H
+
+#include <vector>
+
+#include "RenderBackend.h"
+#include "MeshBuffer.h"
+#include "Thread.h"
+#include "TextureStorage.h"
+#include "VertexTransform.h"
+
+using namespace std;
+
+const int TILE_SIZE		= 64;	// Tile width & height in pixels
+const int NUM_VARYINGS	= 10;	// N, L, paper & noise coordinates
+const int NUM_PLANES	= 12;	// 1/w, depth & the varyings divided by w
+
+class SoftwareRenderer : public ParallelTask
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	SoftwareRenderer();
+	~SoftwareRenderer();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	bool					Init(Geometry *geometry, unsigned int threads = 0);
+	const unsigned char*	Render(const SceneState &scene);
+	void					SetConstants(const CharcoalConstants &constants);
+	void					ShutDown();
+	virtual void			Execute(unsigned int worker, unsigned int workers);
+
+private:
+	//-------------------------------------------------------------------------
+	//Private types
+	//-------------------------------------------------------------------------
+	enum Phase
+	{
+		PHASE_TRANSFORM,	///> transform a slice of the vertices
+		PHASE_BIN,			///> clip, set up & bin a slice of the triangles
+		PHASE_RASTERIZE		///> rasterize & shade tiles until none is left
+	};
+
+	struct ClipVertex
+	{
+		GLfloat	position[4];			///> Clip space position
+		GLfloat	varyings[NUM_VARYINGS];	///> Vertex shader outputs
+	};
+
+	struct TriangleSetup
+	{
+		long long	edgeA[3];			///> Edge functions E = A*x + B*y + C,
+		long long	edgeB[3];			///> in 28.4 fixed point with the fill 
+		long long	edgeC[3];			///> rule folded into C
+		int			laneOffset[3][8];	///> Edge increments for the 4x2 pixel lanes
+		int			minX, minY;			///> Bounding box, in pixels
+		int			maxX, maxY;
+		GLfloat		x0, y0;				///> First vertex, origin of the planes
+		GLfloat		planes[NUM_PLANES][3];	///> Value at (x0,y0), d/dx & d/dy
+	};
+
+	struct WorkerData
+	{
+		vector<TriangleSetup>	triangles;		///> Triangles this worker set up
+		vector< vector<int> >	bins;			///> Its triangles overlapping each tile
+		volatile long			nextTile;		///> Next tile of its range to take
+		long					endTile;		///> End of its range of tiles
+		GLfloat					depth[TILE_SIZE * TILE_SIZE];	///> Tile depth buffer
+		unsigned int			color[TILE_SIZE * TILE_SIZE];	///> Tile color buffer
+	};
+
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	void	Resize(int width, int height);
+	void	RunPhase(Phase phase);
+	void	TransformVertices(int index, unsigned int workers);
+	void	BinTriangles(int index, unsigned int workers);
+	void	ClipTriangle(WorkerData &data, const ClipVertex &v0, const ClipVertex &v1, const ClipVertex &v2,
+						 unsigned int planes);
+	void	SetupTriangle(WorkerData &data, const ClipVertex &v0, const ClipVertex &v1, const ClipVertex &v2);
+	void	RasterizeTiles(int index);
+	bool	TakeTile(int index, int &tile);
+	void	DrawTile(WorkerData &data, int tile);
+	void	DrawPaper(WorkerData &data, int originX, int originY);
+	void	DrawTriangle(WorkerData &data, const TriangleSetup &triangle, int originX, int originY);
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	Geometry				*m_Geometry;		///> Scene geometry, camera & light
+	MeshBuffer				m_Mesh;				///> Welded model vertices & indices
+	VertexTransform			m_Transform;		///> SoA positions, clip positions & outcodes
+	vector<ClipVertex>		m_Transformed;		///> Vertex shader outputs
+	ThreadPool				m_Pool;				///> Worker threads
+	vector<WorkerData*>		m_Workers;			///> One per thread
+	TextureStorage			m_Paper;			///> Paper texture
+	TextureStorage			m_Noise;			///> Noise texture
+	TextureStorage			m_Contrast;			///> Contrast enhanced texture (CET)
+	unsigned int			m_Lookup[CEO_LUT_SIZE];	///> CEO lookup table (0-255)
+	CharcoalConstants		m_Constants;		///> Charcoal look constants
+	vector<unsigned char>	m_Pixels;			///> Frame (BGRA, bottom row first)
+	Phase					m_Phase;			///> Phase the workers run
+	int						m_Width;			///> Frame width
+	int						m_Height;			///> Frame height
+	int						m_TilesX;			///> Tiles per row
+	int						m_TilesY;			///> Tiles per column
+	unsigned int			m_Features;			///> ShaderFeature bits of this frame
+	GLfloat					m_ModelViewProjection[16];	///> This frame's matrices
+	GLfloat					m_NormalMatrix[9];
+	GLfloat					m_Light[3];			///> Light position (object space)
+};
+
+#endif
@@ -0,0 +1,242 @@
+///============================================================================
+///@file	TextureBenchmark.cpp
+///@brief	Charcoal Rendering, texture sampling benchmark.
+///			Measures bilinear & trilinear samples per second of the
+///			TextureStorage samplers with row-major & Morton storage, over
+///			the access patterns the CPU renderer produces.
+///
+///			usage: TextureBenchmark [-size N] [-reps N] [-texture file.tga]
+///
+///			-size is the side of the synthetic texture (2048 by default,
+///			16MB so it doesn't fit in the caches), -texture benchmarks a
+///			TGA file instead.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <vector>
+
+#include "TextureStorage.h"
+
+using namespace std;
+
+const int SCREEN_WIDTH	= 1920;		// Pixels sampled per pass
+const int SCREEN_HEIGHT	= 1080;
+const int RANDOM_COUNT	= 1 << 20;	// Random coordinates per pass
+
+//-----------------------------------------------------------------------------
+//Access patterns, a screen walked in 4x2 pixel blocks with texture
+//coordinates stepping (du, dv) per pixel along x & y
+//-----------------------------------------------------------------------------
+struct Pattern
+{
+	const char	*name;
+	float		dudx, dvdx;		///> Texels per pixel along a row
+	float		dudy, dvdy;		///> Texels per pixel along a column
+	bool		random;			///> Random coordinates instead of a walk
+	bool		trilinear;		///> Sample between mip levels
+};
+
+///----------------------------------------------------------------------------
+///Gets a monotonic time stamp.
+///@return	the time in seconds
+///----------------------------------------------------------------------------
+static double GetSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+///----------------------------------------------------------------------------
+///Adds up the lanes, so the compiler can't drop the samples.
+///@param	value - the samples
+///@return	the sum of the lanes
+///----------------------------------------------------------------------------
+static float SumLanes(const Float8 &value)
+{
+	float lanes[8];
+	StoreRows(lanes, lanes + 4, value);
+
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+}
+
+///----------------------------------------------------------------------------
+///Samples the texture once per pixel of the screen (or per random
+///coordinate) following a pattern.
+///@param	texture - the texture
+///@param	pattern - the access pattern
+///@param	random - random coordinates, RANDOM_COUNT pairs
+///@param	samples - receives the number of samples taken
+///@return	checksum of the samples
+///----------------------------------------------------------------------------
+static float RunPattern(const TextureStorage &texture, const Pattern &pattern,
+						const vector<float> &random, int &samples)
+{
+	Float8 red, green, blue;
+	Float8 sum = Set1(0.0f);
+	float width = (float)texture.GetWidth();
+	float height = (float)texture.GetHeight();
+
+	if(pattern.random)
+	{
+		for(int i=0; i<RANDOM_COUNT; i+=8)
+		{
+			Float8 s = LoadRows(&random[i], &random[i + 4]);
+			Float8 t = LoadRows(&random[RANDOM_COUNT + i], &random[RANDOM_COUNT + i + 4]);
+
+			texture.SampleBilinear(s, t, 0, red, green, blue);
+			sum = sum + red + green + blue;
+		}
+
+		samples = RANDOM_COUNT;
+
+		return SumLanes(sum);
+	}
+
+	//texels per pixel of the footprint, for the trilinear level of detail
+	float footprint = sqrtf(pattern.dudx * pattern.dudx + pattern.dvdx * pattern.dvdx);
+	float lod = (footprint > 1.0f) ? logf(footprint) / logf(2.0f) : 0.0f;
+
+	Float8 dsdx = Set1(pattern.dudx / width);
+	Float8 dtdx = Set1(pattern.dvdx / height);
+	Float8 dsdy = Set1(pattern.dudy / width);
+	Float8 dtdy = Set1(pattern.dvdy / height);
+	Float8 laneX = Set8(0.0f, 1.0f, 2.0f, 3.0f, 0.0f, 1.0f, 2.0f, 3.0f);
+	Float8 laneY = Set8(0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+
+	for(int y=0; y<SCREEN_HEIGHT; y+=2)
+	{
+		Float8 py = Set1((float)y) + laneY;
+
+		for(int x=0; x<SCREEN_WIDTH; x+=4)
+		{
+			Float8 px = Set1((float)x) + laneX;
+			Float8 s = px * dsdx + py * dsdy;
+			Float8 t = px * dtdx + py * dtdy;
+
+			if(pattern.trilinear)
+				texture.SampleTrilinear(s, t, lod, red, green, blue);
+			else
+				texture.SampleBilinear(s, t, 0, red, green, blue);
+
+			sum = sum + red + green + blue;
+		}
+	}
+
+	samples = SCREEN_WIDTH * SCREEN_HEIGHT;
+
+	return SumLanes(sum);
+}
+
+int main(int argc, char *argv[])
+{
+	int size			= 2048;
+	int reps			= 5;
+	const char *file	= NULL;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-size") && i+1 < argc)
+			size = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-reps") && i+1 < argc)
+			reps = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-texture") && i+1 < argc)
+			file = argv[++i];
+		else
+		{
+			fprintf(stderr, "usage: %s [-size N] [-reps N] [-texture file.tga]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	TextureStorage textures[2];
+	const char *layoutNames[2] = {"row-major", "morton"};
+
+	for(int layout=0; layout<2; layout++)
+	{
+		bool loaded;
+
+		if(file)
+		{
+			loaded = textures[layout].Load(file, (TextureLayout)layout);
+		}
+		else
+		{
+			//noise, so a wrong texel can't go unnoticed in the checksums
+			vector<unsigned int> texels(size * size);
+			srand(1);
+			for(size_t i=0; i<texels.size(); i++)
+				texels[i] = (rand() & 0xFFFF) | ((rand() & 0xFFFF) << 16);
+
+			loaded = textures[layout].Create(&texels[0], size, size, (TextureLayout)layout);
+		}
+
+		if(!loaded)
+		{
+			fprintf(stderr, "Could not create a power of two texture.\n");
+			return 1;
+		}
+	}
+
+	vector<float> random(RANDOM_COUNT * 2);
+	for(size_t i=0; i<random.size(); i++)
+		random[i] = (float)rand() / RAND_MAX;
+
+	//the paper at screen scale, turned like the model & minified
+	const float angle = 0.6f;
+	const Pattern patterns[] = {
+		{"rows 1:1",		1.0f, 0.0f, 0.0f, 1.0f, false, false},
+		{"columns 1:1",		0.0f, 1.0f, 1.0f, 0.0f, false, false},
+		{"rotated 1:1",		cosf(angle), sinf(angle), -sinf(angle), cosf(angle), false, false},
+		{"rotated 4:1",		4 * cosf(angle), 4 * sinf(angle), -4 * sinf(angle), 4 * cosf(angle), false, false},
+		{"trilinear 4:1",	4 * cosf(angle), 4 * sinf(angle), -4 * sinf(angle), 4 * cosf(angle), false, true},
+		{"random",			0.0f, 0.0f, 0.0f, 0.0f, true, false}
+	};
+
+	printf("%dx%d texture, %d mip levels, best of %d\n",
+		   textures[0].GetWidth(), textures[0].GetHeight(), textures[0].GetLevelCount(), reps);
+	printf("%-16s %-10s %14s %14s %9s\n", "pattern", "layout", "samples/s", "texels/s", "speedup");
+
+	for(size_t p=0; p<sizeof(patterns) / sizeof(patterns[0]); p++)
+	{
+		double rate[2];
+		float checksum[2];
+
+		for(int layout=0; layout<2; layout++)
+		{
+			double best = 1e30;
+			int samples = 0;
+
+			//the first pass warms up the caches
+			for(int rep=0; rep<=reps; rep++)
+			{
+				double start = GetSeconds();
+				checksum[layout] = RunPattern(textures[layout], patterns[p], random, samples);
+				double elapsed = GetSeconds() - start;
+
+				if(rep > 0 && elapsed < best)
+					best = elapsed;
+			}
+
+			//4 texels per bilinear sample, twice that for trilinear
+			int texelsPerSample = patterns[p].trilinear ? 8 : 4;
+			rate[layout] = samples / best;
+
+			printf("%-16s %-10s %14.0f %14.0f %8.2fx\n", patterns[p].name, layoutNames[layout],
+				   rate[layout], rate[layout] * texelsPerSample, rate[layout] / rate[0]);
+		}
+
+		if(checksum[0] != checksum[1])
+			fprintf(stderr, "%s: the layouts sampled different texels!\n", patterns[p].name);
+	}
+
+	return 0;
+}
@@ -0,0 +1,398 @@
+///============================================================================
+///@file	TextureStorage.cpp
+///@brief	Texture Storage Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "TextureStorage.h"
+#include "ltga.h"
+
+#include <math.h>
+
+///----------------------------------------------------------------------------
+///Spreads the low 16 bits of a value to the even bits.
+///@param	value - the value
+///@return	the dilated value
+///----------------------------------------------------------------------------
+static inline unsigned int Dilate(unsigned int value)
+{
+	value = (value | (value << 8)) & 0x00FF00FF;
+	value = (value | (value << 4)) & 0x0F0F0F0F;
+	value = (value | (value << 2)) & 0x33333333;
+	value = (value | (value << 1)) & 0x55555555;
+
+	return value;
+}
+
+//8 lane version
+static inline Int8 Dilate(const Int8 &value)
+{
+	Int8 v = (value | ShiftLeft(value, 8)) & Set1(0x00FF00FF);
+	v = (v | ShiftLeft(v, 4)) & Set1(0x0F0F0F0F);
+	v = (v | ShiftLeft(v, 2)) & Set1(0x33333333);
+	v = (v | ShiftLeft(v, 1)) & Set1(0x55555555);
+
+	return v;
+}
+
+///----------------------------------------------------------------------------
+///Gets the base 2 logarithm of a power of two.
+///@param	value - the power of two
+///@return	its exponent, -1 if value isn't a power of two
+///----------------------------------------------------------------------------
+static int Log2(int value)
+{
+	if(value <= 0 || (value & (value - 1)))
+		return -1;
+
+	int shift = 0;
+	while((1 << shift) < value)
+		shift++;
+
+	return shift;
+}
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+TextureStorage::TextureStorage()
+{
+	m_Layout = TL_MORTON;
+}
+
+///----------------------------------------------------------------------------
+///Loads a TGA file.
+///@param	fileName - TGA file name
+///@param	layout - order to store the texels in
+///@return	true if the file was loaded & its size is a power of two
+///----------------------------------------------------------------------------
+bool TextureStorage::Load(const char *fileName, TextureLayout layout)
+{
+	LTGA image(fileName);
+	const byte *pixels = image.GetPixels();
+	int bytesPerPixel = image.GetPixelDepth() / 8;
+	int width = image.GetImageWidth();
+	int height = image.GetImageHeight();
+
+	if(!pixels || bytesPerPixel == 2 || width <= 0 || height <= 0)
+		return false;
+
+	//LTGA gives RGB(A) rows in file order, which the GL takes as t = 0 up
+	vector<unsigned int> texels(width * height);
+
+	for(size_t i=0; i<texels.size(); i++)
+	{
+		const byte *pixel = pixels + i * bytesPerPixel;
+		unsigned int red	= pixel[0];
+		unsigned int green	= (bytesPerPixel > 1) ? pixel[1] : red;
+		unsigned int blue	= (bytesPerPixel > 1) ? pixel[2] : red;
+		unsigned int alpha	= (bytesPerPixel > 3) ? pixel[3] : 0xFF;
+
+		texels[i] = blue | (green << 8) | (red << 16) | (alpha << 24);
+	}
+
+	return Create(&texels[0], width, height, layout);
+}
+
+///----------------------------------------------------------------------------
+///Copies an image into the chosen layout & builds its mip levels.
+///@param	texels - BGRA texels, row by row, bottom row first
+///@param	width - width, a power of two
+///@param	height - height, a power of two
+///@param	layout - order to store the texels in
+///@return	true if the size is valid
+///----------------------------------------------------------------------------
+bool TextureStorage::Create(const unsigned int *texels, int width, int height, TextureLayout layout)
+{
+	Release();
+
+	//the wrapping & the Morton order rely on powers of two
+	int widthShift = Log2(width);
+	int heightShift = Log2(height);
+
+	if(widthShift < 0 || heightShift < 0 || widthShift > 15 || heightShift > 15)
+		return false;
+
+	m_Layout = layout;
+	AddLevel(widthShift, heightShift);
+
+	for(int y=0; y<height; y++)
+		for(int x=0; x<width; x++)
+			m_Texels[GetIndex(x, y, m_Levels[0])] = texels[y * width + x];
+
+	BuildMipmaps();
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Frees the texels.
+///----------------------------------------------------------------------------
+void TextureStorage::Release()
+{
+	m_Texels.clear();
+	m_Levels.clear();
+}
+
+///----------------------------------------------------------------------------
+///Samples a mip level with bilinear filtering & GL_REPEAT wrapping, the
+///same as a GL_LINEAR texture.
+///@param	s, t - texture coordinates of the 8 lanes
+///@param	level - mip level, must exist
+///@param	red, green, blue - receive the filtered channels in [0,1]
+///----------------------------------------------------------------------------
+void TextureStorage::SampleBilinear(const Float8 &s, const Float8 &t, int level,
+									Float8 &red, Float8 &green, Float8 &blue) const
+{
+	const Level &l = m_Levels[level];
+	Float8 u = s * Set1((float)l.width) - Set1(0.5f);
+	Float8 v = t * Set1((float)l.height) - Set1(0.5f);
+	Float8 u0 = Floor(u);
+	Float8 v0 = Floor(v);
+	Float8 fracU = u - u0;
+	Float8 fracV = v - v0;
+
+	//power of two sizes wrap with a mask, negative coordinates included
+	Int8 x0 = ToInt(u0) & Set1(l.width - 1);
+	Int8 y0 = ToInt(v0) & Set1(l.height - 1);
+
+	//both layouts split in a column & a row part. The next column (row) is
+	//an add with the carry running over the other coordinate's bits, the
+	//mask wraps it around.
+	Int8 columnMask = Set1(l.columnMask);
+	Int8 rowMask = Set1(l.rowMask);
+	Int8 column0 = GetColumn(x0, l);
+	Int8 row0 = GetRow(y0, l);
+	Int8 column1 = ((column0 | Set1(~l.columnMask)) + Set1(1)) & columnMask;
+	Int8 row1 = ((row0 | Set1(~l.rowMask)) + Set1(l.rowStep)) & rowMask;
+
+	const unsigned int *texels = &m_Texels[l.offset];
+	Int8 t00 = Gather(texels, row0 | column0);
+	Int8 t10 = Gather(texels, row0 | column1);
+	Int8 t01 = Gather(texels, row1 | column0);
+	Int8 t11 = Gather(texels, row1 | column1);
+
+	Int8 byteMask = Set1(0xFF);
+	Float8 scale = Set1(1.0f / 255.0f);
+	Float8 *channels[3] = {&blue, &green, &red};
+
+	for(int c=0; c<3; c++)
+	{
+		int shift = c * 8;
+		Float8 c00 = ToFloat(ShiftRight(t00, shift) & byteMask);
+		Float8 c10 = ToFloat(ShiftRight(t10, shift) & byteMask);
+		Float8 c01 = ToFloat(ShiftRight(t01, shift) & byteMask);
+		Float8 c11 = ToFloat(ShiftRight(t11, shift) & byteMask);
+
+		*channels[c] = Lerp(Lerp(c00, c10, fracU), Lerp(c01, c11, fracU), fracV) * scale;
+	}
+}
+
+///----------------------------------------------------------------------------
+///Samples between two mip levels, as GL_LINEAR_MIPMAP_LINEAR does. The
+///level of detail is shared by the 8 lanes, like a GPU shares it across a
+///pixel quad.
+///@param	s, t - texture coordinates of the 8 lanes
+///@param	lod - level of detail, log2 of the texels per pixel
+///@param	red, green, blue - receive the filtered channels in [0,1]
+///----------------------------------------------------------------------------
+void TextureStorage::SampleTrilinear(const Float8 &s, const Float8 &t, float lod,
+									 Float8 &red, Float8 &green, Float8 &blue) const
+{
+	int last = (int)m_Levels.size() - 1;
+
+	if(lod <= 0.0f)
+	{
+		SampleBilinear(s, t, 0, red, green, blue);
+		return;
+	}
+
+	if(lod >= (float)last)
+	{
+		SampleBilinear(s, t, last, red, green, blue);
+		return;
+	}
+
+	int level = (int)lod;
+	Float8 weight = Set1(lod - level);
+	Float8 red1, green1, blue1;
+
+	SampleBilinear(s, t, level, red, green, blue);
+	SampleBilinear(s, t, level + 1, red1, green1, blue1);
+
+	red		= Lerp(red, red1, weight);
+	green	= Lerp(green, green1, weight);
+	blue	= Lerp(blue, blue1, weight);
+}
+
+///----------------------------------------------------------------------------
+///Gets a single texel.
+///@param	x, y - texel position, wrapped around
+///@param	level - mip level, must exist
+///@return	the BGRA texel
+///----------------------------------------------------------------------------
+unsigned int TextureStorage::GetTexel(int x, int y, int level) const
+{
+	const Level &l = m_Levels[level];
+
+	return m_Texels[l.offset + GetIndex(x & (l.width - 1), y & (l.height - 1), l)];
+}
+
+///----------------------------------------------------------------------------
+///Gets the width of a mip level.
+///@param	level - mip level
+///@return	width in texels
+///----------------------------------------------------------------------------
+int TextureStorage::GetWidth(int level) const
+{
+	return m_Levels[level].width;
+}
+
+///----------------------------------------------------------------------------
+///Gets the height of a mip level.
+///@param	level - mip level
+///@return	height in texels
+///----------------------------------------------------------------------------
+int TextureStorage::GetHeight(int level) const
+{
+	return m_Levels[level].height;
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of mip levels.
+///@return	levels down to 1x1, 0 if nothing was loaded
+///----------------------------------------------------------------------------
+int TextureStorage::GetLevelCount() const
+{
+	return (int)m_Levels.size();
+}
+
+///----------------------------------------------------------------------------
+///Gets the layout of the texels.
+///@return	the layout
+///----------------------------------------------------------------------------
+TextureLayout TextureStorage::GetLayout() const
+{
+	return m_Layout;
+}
+
+///----------------------------------------------------------------------------
+///Appends an empty mip level.
+///@param	widthShift - log2 of the level width
+///@param	heightShift - log2 of the level height
+///----------------------------------------------------------------------------
+void TextureStorage::AddLevel(int widthShift, int heightShift)
+{
+	Level level;
+
+	level.widthShift	= widthShift;
+	level.heightShift	= heightShift;
+	level.width			= 1 << widthShift;
+	level.height		= 1 << heightShift;
+	level.offset		= (int)m_Texels.size();
+	level.columnMask	= GetIndex(level.width - 1, 0, level);
+	level.rowMask		= GetIndex(0, level.height - 1, level);
+	level.rowStep		= GetIndex(0, 1, level);
+
+	m_Texels.resize(m_Texels.size() + level.width * level.height);
+	m_Levels.push_back(level);
+}
+
+///----------------------------------------------------------------------------
+///Builds the mip levels down to 1x1 with a box filter.
+///----------------------------------------------------------------------------
+void TextureStorage::BuildMipmaps()
+{
+	while(m_Levels.back().width > 1 || m_Levels.back().height > 1)
+	{
+		Level parent = m_Levels.back();
+
+		AddLevel((parent.widthShift > 0) ? parent.widthShift - 1 : 0,
+				 (parent.heightShift > 0) ? parent.heightShift - 1 : 0);
+
+		const Level &level = m_Levels.back();
+
+		//a side already down to 1 texel averages along the other one only
+		int stepX = (parent.width > 1) ? 1 : 0;
+		int stepY = (parent.height > 1) ? 1 : 0;
+
+		for(int y=0; y<level.height; y++)
+		{
+			for(int x=0; x<level.width; x++)
+			{
+				int px = x << stepX, py = y << stepY;
+				unsigned int taps[4] = {
+					m_Texels[parent.offset + GetIndex(px, py, parent)],
+					m_Texels[parent.offset + GetIndex(px + stepX, py, parent)],
+					m_Texels[parent.offset + GetIndex(px, py + stepY, parent)],
+					m_Texels[parent.offset + GetIndex(px + stepX, py + stepY, parent)]
+				};
+				unsigned int texel = 0;
+
+				for(int shift=0; shift<32; shift+=8)
+				{
+					unsigned int sum = 2;
+					for(int i=0; i<4; i++)
+						sum += (taps[i] >> shift) & 0xFF;
+
+					texel |= (sum / 4) << shift;
+				}
+
+				m_Texels[level.offset + GetIndex(x, y, level)] = texel;
+			}
+		}
+	}
+}
+
+///----------------------------------------------------------------------------
+///Gets the position of a texel within its level. Morton order interleaves
+///the bits both sides have, the extra high bits of a longer side go on top.
+///@param	x, y - texel position, inside the level
+///@param	level - the mip level
+///@return	the texel index from the start of the level
+///----------------------------------------------------------------------------
+int TextureStorage::GetIndex(int x, int y, const Level &level) const
+{
+	if(m_Layout == TL_ROW_MAJOR)
+		return (y << level.widthShift) + x;
+
+	int bits = (level.widthShift < level.heightShift) ? level.widthShift : level.heightShift;
+	int low = (1 << bits) - 1;
+
+	return (int)(Dilate(x & low) | (Dilate(y & low) << 1) | (((x >> bits) | (y >> bits)) << (bits * 2)));
+}
+
+///----------------------------------------------------------------------------
+///Gets the part of the texel indices that depends on x, ORed with GetRow()
+///it gives the same index as GetIndex().
+///@param	x - texel columns, inside the level
+///@param	level - the mip level
+///@return	the column part of the indices
+///----------------------------------------------------------------------------
+Int8 TextureStorage::GetColumn(const Int8 &x, const Level &level) const
+{
+	if(m_Layout == TL_ROW_MAJOR)
+		return x;
+
+	int bits = (level.widthShift < level.heightShift) ? level.widthShift : level.heightShift;
+
+	return Dilate(x & Set1((1 << bits) - 1)) | ShiftLeft(ShiftRight(x, bits), bits * 2);
+}
+
+///----------------------------------------------------------------------------
+///Gets the part of the texel indices that depends on y.
+///@param	y - texel rows, inside the level
+///@param	level - the mip level
+///@return	the row part of the indices
+///----------------------------------------------------------------------------
+Int8 TextureStorage::GetRow(const Int8 &y, const Level &level) const
+{
+	if(m_Layout == TL_ROW_MAJOR)
+		return ShiftLeft(y, level.widthShift);
+
+	int bits = (level.widthShift < level.heightShift) ? level.widthShift : level.heightShift;
+
+	return ShiftLeft(Dilate(y & Set1((1 << bits) - 1)), 1) | ShiftLeft(ShiftRight(y, bits), bits * 2);
+}
@@ -0,0 +1,90 @@
+///============================================================================
+///@file	TextureStorage.h
+///@brief	CPU side copy of a texture for the software renderer. Texels can
+///			be stored row by row like LTGA loads them, or in Morton (Z) order
+///			so the 2x2 footprint of a bilinear lookup shares cache lines in
+///			both directions. Every mip level is kept, and the samplers fetch
+///			8 lanes at once (Simd8.h).
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef TEXTURESTORAGE_H
+#define TEXTURESTORAGE_H
+
+#include <vector>
+
+#include "Simd8.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//Texel layouts
+//-----------------------------------------------------------------------------
+enum TextureLayout
+{
+	TL_ROW_MAJOR = 0,	///> rows one after the other, as loaded
+	TL_MORTON			///> x & y bits interleaved (Z-order)
+};
+
+class TextureStorage
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	TextureStorage();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	bool			Load(const char *fileName, TextureLayout layout = TL_MORTON);
+	bool			Create(const unsigned int *texels, int width, int height, TextureLayout layout = TL_MORTON);
+	void			Release();
+
+	void			SampleBilinear(const Float8 &s, const Float8 &t, int level,
+								   Float8 &red, Float8 &green, Float8 &blue) const;
+	void			SampleTrilinear(const Float8 &s, const Float8 &t, float lod,
+									Float8 &red, Float8 &green, Float8 &blue) const;
+
+	unsigned int	GetTexel(int x, int y, int level = 0) const;
+	int				GetWidth(int level = 0) const;
+	int				GetHeight(int level = 0) const;
+	int				GetLevelCount() const;
+	TextureLayout	GetLayout() const;
+
+private:
+	//-------------------------------------------------------------------------
+	//Private types
+	//-------------------------------------------------------------------------
+	struct Level
+	{
+		int		width;			///> Width, a power of two
+		int		height;			///> Height, a power of two
+		int		widthShift;		///> log2(width)
+		int		heightShift;	///> log2(height)
+		int		offset;			///> First texel of the level
+		int		columnMask;		///> Index bits holding x
+		int		rowMask;		///> Index bits holding y
+		int		rowStep;		///> Lowest bit of rowMask, y + 1 in index bits
+	};
+
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	void	AddLevel(int widthShift, int heightShift);
+	void	BuildMipmaps();
+	int		GetIndex(int x, int y, const Level &level) const;
+	Int8	GetColumn(const Int8 &x, const Level &level) const;
+	Int8	GetRow(const Int8 &y, const Level &level) const;
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	vector<unsigned int>	m_Texels;	///> BGRA texels of every level, bottom row first
+	vector<Level>			m_Levels;	///> Mip levels, 0 is the full size image
+	TextureLayout			m_Layout;	///> Order of the texels within a level
+};
+
+#endif
@@ -0,0 +1,451 @@
+///============================================================================
+///@file	Thread.cpp
+///@brief	Thread and Mutex Classes Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "Thread.h"
+#include "Tracer.h"
+
+#ifndef _WIN32
+#include <time.h>
+#include <unistd.h>
+#include <errno.h>
+#include "SamplingProfiler.h"
+#endif
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+Mutex::Mutex()
+{
+#ifdef _WIN32
+	InitializeCriticalSection(&m_Lock);
+#else
+	pthread_mutex_init(&m_Lock, NULL);
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+Mutex::~Mutex()
+{
+#ifdef _WIN32
+	DeleteCriticalSection(&m_Lock);
+#else
+	pthread_mutex_destroy(&m_Lock);
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Acquires the lock, waiting for other threads to release it.
+///----------------------------------------------------------------------------
+void Mutex::Lock()
+{
+#ifdef _WIN32
+	EnterCriticalSection(&m_Lock);
+#else
+	pthread_mutex_lock(&m_Lock);
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Releases the lock.
+///----------------------------------------------------------------------------
+void Mutex::Unlock()
+{
+#ifdef _WIN32
+	LeaveCriticalSection(&m_Lock);
+#else
+	pthread_mutex_unlock(&m_Lock);
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Default constructor, the event starts non signaled.
+///----------------------------------------------------------------------------
+Event::Event()
+{
+#ifdef _WIN32
+	m_Event = CreateEvent(NULL, FALSE, FALSE, NULL);
+#else
+	pthread_mutex_init(&m_Lock, NULL);
+	pthread_cond_init(&m_Condition, NULL);
+	m_Signaled = false;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+Event::~Event()
+{
+#ifdef _WIN32
+	CloseHandle(m_Event);
+#else
+	pthread_cond_destroy(&m_Condition);
+	pthread_mutex_destroy(&m_Lock);
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Signals the event, releasing the thread waiting on it (or the next one 
+///to wait).
+///----------------------------------------------------------------------------
+void Event::Set()
+{
+#ifdef _WIN32
+	SetEvent(m_Event);
+#else
+	pthread_mutex_lock(&m_Lock);
+	m_Signaled = true;
+	pthread_cond_signal(&m_Condition);
+	pthread_mutex_unlock(&m_Lock);
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Waits until the event is signaled & resets it.
+///----------------------------------------------------------------------------
+void Event::Wait()
+{
+#ifdef _WIN32
+	WaitForSingleObject(m_Event, INFINITE);
+#else
+	pthread_mutex_lock(&m_Lock);
+	while(!m_Signaled)
+		pthread_cond_wait(&m_Condition, &m_Lock);
+	m_Signaled = false;
+	pthread_mutex_unlock(&m_Lock);
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Atomically increments a shared counter.
+///@param	value - the counter
+///@return	the incremented value
+///----------------------------------------------------------------------------
+long AtomicIncrement(volatile long *value)
+{
+#ifdef _WIN32
+	return InterlockedIncrement(value);
+#else
+	return __sync_add_and_fetch(value, 1);
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Atomically sets bits of a shared value.
+///@param	value - the value
+///@param	bits - bits to set
+///@return	the value before the bits were set
+///----------------------------------------------------------------------------
+long AtomicOr(volatile long *value, long bits)
+{
+#ifdef _WIN32
+	long previous;
+
+	do
+	{
+		previous = *value;
+	}
+	while(InterlockedCompareExchange(value, previous | bits, previous) != previous);
+
+	return previous;
+#else
+	return __sync_fetch_and_or(value, bits);
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Atomically replaces a shared value.
+///@param	value - the value
+///@param	exchange - the new value
+///@return	the previous value
+///----------------------------------------------------------------------------
+long AtomicExchange(volatile long *value, long exchange)
+{
+#ifdef _WIN32
+	return InterlockedExchange(value, exchange);
+#else
+	//a full barrier first, __sync_lock_test_and_set alone only acquires
+	__sync_synchronize();
+	return __sync_lock_test_and_set(value, exchange);
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+Thread::Thread()
+{
+#ifdef _WIN32
+	m_Thread = NULL;
+#endif
+	m_Running = false;
+}
+
+///----------------------------------------------------------------------------
+///Default destructor. Derived classes must stop and Join() their thread
+///before being destroyed, Run() can't be called on a half destroyed object.
+///----------------------------------------------------------------------------
+Thread::~Thread()
+{
+}
+
+///----------------------------------------------------------------------------
+///Starts executing Run() in a new thread.
+///@return	true if the thread was created
+///----------------------------------------------------------------------------
+bool Thread::Start()
+{
+	if(m_Running)
+		return false;
+
+#ifdef _WIN32
+	m_Thread = CreateThread(NULL, 0, ThreadProc, this, 0, NULL);
+	m_Running = (m_Thread != NULL);
+#else
+	m_Running = (pthread_create(&m_Thread, NULL, ThreadProc, this) == 0);
+#endif
+
+	return m_Running;
+}
+
+///----------------------------------------------------------------------------
+///Waits for Run() to return.
+///----------------------------------------------------------------------------
+void Thread::Join()
+{
+	if(!m_Running)
+		return;
+
+#ifdef _WIN32
+	WaitForSingleObject(m_Thread, INFINITE);
+	CloseHandle(m_Thread);
+	m_Thread = NULL;
+#else
+	pthread_join(m_Thread, NULL);
+#endif
+
+	m_Running = false;
+}
+
+///----------------------------------------------------------------------------
+///Checks whether the thread was started and hasn't been joined.
+///@return	true if running
+///----------------------------------------------------------------------------
+bool Thread::IsRunning() const
+{
+	return m_Running;
+}
+
+///----------------------------------------------------------------------------
+///Suspends the calling thread.
+///@param	milliseconds - time to sleep
+///----------------------------------------------------------------------------
+void Thread::Sleep(unsigned int milliseconds)
+{
+#ifdef _WIN32
+	::Sleep(milliseconds);
+#else
+	struct timespec ts;
+	ts.tv_sec	= milliseconds / 1000;
+	ts.tv_nsec	= (milliseconds % 1000) * 1000000L;
+
+	//the profiler's signals interrupt the sleep, the rest is slept again
+	while(nanosleep(&ts, &ts) != 0 && errno == EINTR)
+		;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of processors the threads can run on.
+///@return	the processor count, at least 1
+///----------------------------------------------------------------------------
+unsigned int Thread::GetProcessorCount()
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+
+	return info.dwNumberOfProcessors;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return (count > 0) ? (unsigned int)count : 1;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+ParallelTask::~ParallelTask()
+{
+}
+
+///----------------------------------------------------------------------------
+///Splits count items in even contiguous ranges, one per worker.
+///@param	count - number of items
+///@param	worker - worker number
+///@param	workers - number of workers
+///@param	first - receives the first item of the worker
+///@param	last - receives one past the last item of the worker
+///@param	alignment - ranges start at multiples of it (SIMD batches)
+///----------------------------------------------------------------------------
+void ParallelTask::GetRange(size_t count, unsigned int worker, unsigned int workers, 
+							size_t &first, size_t &last, size_t alignment)
+{
+	size_t batches = (count + alignment - 1) / alignment;
+
+	first	= batches * worker / workers * alignment;
+	last	= batches * (worker + 1) / workers * alignment;
+
+	if(first > count)	first = count;
+	if(last > count)	last = count;
+}
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+ThreadPool::ThreadPool()
+{
+	m_Task = NULL;
+}
+
+///----------------------------------------------------------------------------
+///Default destructor.
+///----------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+	Stop();
+}
+
+///----------------------------------------------------------------------------
+///Starts the worker threads.
+///@param	threads - number of threads, 0 for one per processor
+///@return	true if all of them were started
+///----------------------------------------------------------------------------
+bool ThreadPool::Start(unsigned int threads)
+{
+	Stop();
+
+	if(threads == 0)
+		threads = Thread::GetProcessorCount();
+
+	for(unsigned int i=0; i<threads; i++)
+	{
+		Worker *worker = new Worker(this, i);
+		m_Workers.push_back(worker);
+
+		if(!worker->Start())
+		{
+			Stop();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Stops & joins the worker threads.
+///----------------------------------------------------------------------------
+void ThreadPool::Stop()
+{
+	//a NULL task tells the workers to leave
+	m_Task = NULL;
+
+	for(size_t i=0; i<m_Workers.size(); i++)
+	{
+		m_Workers[i]->m_Start.Set();
+		m_Workers[i]->Join();
+		delete m_Workers[i];
+	}
+
+	m_Workers.clear();
+}
+
+///----------------------------------------------------------------------------
+///Runs a task on every worker & waits until all of them are done. Without
+///workers the task runs on the calling thread.
+///@param	task - the task
+///----------------------------------------------------------------------------
+void ThreadPool::Run(ParallelTask &task)
+{
+	if(m_Workers.empty())
+	{
+		task.Execute(0, 1);
+		return;
+	}
+
+	m_Task = &task;
+
+	for(size_t i=0; i<m_Workers.size(); i++)
+		m_Workers[i]->m_Start.Set();
+
+	for(size_t i=0; i<m_Workers.size(); i++)
+		m_Workers[i]->m_Done.Wait();
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of worker threads.
+///@return	the thread count, 0 if the pool isn't started
+///----------------------------------------------------------------------------
+unsigned int ThreadPool::GetThreadCount() const
+{
+	return (unsigned int)m_Workers.size();
+}
+
+///----------------------------------------------------------------------------
+///Constructor.
+///@param	pool - pool the worker belongs to
+///@param	index - worker number
+///----------------------------------------------------------------------------
+ThreadPool::Worker::Worker(ThreadPool *pool, unsigned int index)
+{
+	m_Pool	= pool;
+	m_Index	= index;
+}
+
+///----------------------------------------------------------------------------
+///Worker thread, runs the pool's task each time it is started.
+///----------------------------------------------------------------------------
+void ThreadPool::Worker::Run()
+{
+	TRACE_THREAD("worker");
+
+	for(;;)
+	{
+		m_Start.Wait();
+
+		ParallelTask *task = m_Pool->m_Task;
+		if(!task)
+			return;
+
+		task->Execute(m_Index, (unsigned int)m_Pool->m_Workers.size());
+		m_Done.Set();
+	}
+}
+
+///----------------------------------------------------------------------------
+///Thread entry point, forwards to the Run() method of the instance.
+///@param	param - the Thread instance
+///----------------------------------------------------------------------------
+#ifdef _WIN32
+DWORD WINAPI Thread::ThreadProc(LPVOID param)
+{
+	((Thread*)param)->Run();
+	return 0;
+}
+#else
+void* Thread::ThreadProc(void *param)
+{
+	SamplingProfiler::RegisterThread();
+	((Thread*)param)->Run();
+	return NULL;
+}
+#endif
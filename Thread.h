@@ -0,0 +1,230 @@
+///============================================================================
+///@file	Thread.h
+///@brief	Minimal thread and mutex wrappers over Win32 and POSIX threads,
+///			plus a pool of workers to split per frame work across cores.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef THREAD_H
+#define THREAD_H
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#include <vector>
+#include <stddef.h>
+
+//-----------------------------------------------------------------------------
+//Mutual exclusion lock
+//-----------------------------------------------------------------------------
+class Mutex
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	Mutex();
+	~Mutex();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	void Lock();
+	void Unlock();
+
+private:
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+#ifdef _WIN32
+	CRITICAL_SECTION	m_Lock;		///> Win32 critical section
+#else
+	pthread_mutex_t		m_Lock;		///> POSIX mutex
+#endif
+};
+
+//-----------------------------------------------------------------------------
+//Locks a mutex for the lifetime of the scope
+//-----------------------------------------------------------------------------
+class ScopedLock
+{
+public:
+	ScopedLock(Mutex &mutex) : m_Mutex(mutex) { m_Mutex.Lock(); }
+	~ScopedLock() { m_Mutex.Unlock(); }
+
+private:
+	Mutex &m_Mutex;
+};
+
+//-----------------------------------------------------------------------------
+//Auto-reset event, each Set() releases one Wait()
+//-----------------------------------------------------------------------------
+class Event
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	Event();
+	~Event();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	void Set();
+	void Wait();
+
+private:
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+#ifdef _WIN32
+	HANDLE			m_Event;		///> Win32 auto-reset event
+#else
+	pthread_mutex_t	m_Lock;			///> Guards the signaled flag
+	pthread_cond_t	m_Condition;	///> Wakes up the waiting thread
+	bool			m_Signaled;		///> Set() was called & not consumed yet
+#endif
+};
+
+//-----------------------------------------------------------------------------
+//Atomically increments a shared counter
+//@return	the incremented value
+//-----------------------------------------------------------------------------
+long AtomicIncrement(volatile long *value);
+
+//-----------------------------------------------------------------------------
+//Atomically sets bits of a shared value
+//@return	the value before the bits were set
+//-----------------------------------------------------------------------------
+long AtomicOr(volatile long *value, long bits);
+
+//-----------------------------------------------------------------------------
+//Atomically replaces a shared value
+//@return	the previous value
+//-----------------------------------------------------------------------------
+long AtomicExchange(volatile long *value, long exchange);
+
+//-----------------------------------------------------------------------------
+//Abstract thread, derived classes implement Run()
+//-----------------------------------------------------------------------------
+class Thread
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	Thread();
+	virtual ~Thread();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	bool Start();
+	void Join();
+	bool IsRunning() const;
+
+	static void			Sleep(unsigned int milliseconds);
+	static unsigned int	GetProcessorCount();
+
+protected:
+	//-------------------------------------------------------------------------
+	//Protected methods
+	//-------------------------------------------------------------------------
+	virtual void Run() = 0;
+
+private:
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+#ifdef _WIN32
+	static DWORD WINAPI ThreadProc(LPVOID param);
+#else
+	static void* ThreadProc(void *param);
+#endif
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+#ifdef _WIN32
+	HANDLE		m_Thread;		///> Win32 thread handle
+#else
+	pthread_t	m_Thread;		///> POSIX thread
+#endif
+	bool		m_Running;		///> Whether the thread was started and not joined
+};
+
+//-----------------------------------------------------------------------------
+//Work split across the threads of a ThreadPool
+//-----------------------------------------------------------------------------
+class ParallelTask
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	virtual ~ParallelTask();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	virtual void Execute(unsigned int worker, unsigned int workers) = 0;
+
+	static void GetRange(size_t count, unsigned int worker, unsigned int workers, 
+						 size_t &first, size_t &last, size_t alignment = 1);
+};
+
+//-----------------------------------------------------------------------------
+//Persistent worker threads, Run() executes a task on all of them & waits
+//-----------------------------------------------------------------------------
+class ThreadPool
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	ThreadPool();
+	~ThreadPool();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	bool			Start(unsigned int threads = 0);
+	void			Stop();
+	void			Run(ParallelTask &task);
+	unsigned int	GetThreadCount() const;
+
+private:
+	//-------------------------------------------------------------------------
+	//Private types
+	//-------------------------------------------------------------------------
+	class Worker : public Thread
+	{
+	public:
+		Worker(ThreadPool *pool, unsigned int index);
+
+		Event			m_Start;		///> Set when there is a task to run
+		Event			m_Done;			///> Set when the task is finished
+
+	protected:
+		virtual void	Run();
+
+	private:
+		ThreadPool		*m_Pool;		///> Pool the worker belongs to
+		unsigned int	m_Index;		///> Worker number
+	};
+
+	friend class Worker;
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	std::vector<Worker*>	m_Workers;	///> The worker threads
+	ParallelTask			*m_Task;	///> Task being run, NULL to stop
+};
+
+#endif
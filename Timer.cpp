@@ -34,6 +34,10 @@ Timer::Timer()
 
 	// Clear any needed values
     m_SampleCount       = 0;
+    m_SampleIndex       = 0;
+    m_SampleSum         = 0.0f;
+    m_TimeElapsed       = 0.0f;
+    m_LastElapsed       = 0.0f;
 	m_FrameRate			= 0;
 	m_FPSFrameCount		= 0;
 	m_FPSTimeElapsed	= 0.0f;
@@ -51,7 +55,7 @@ Timer::~Timer()
 // Name : Tick () 
 // Desc : Function which signals that frame has advanced
 // Note : You can specify a number of frames per second to lock the frame rate
-//        to. This will simply soak up the remaining time to hit that target.
+//        to. The frame pacer sleeps away the remaining time to hit that target.
 //-----------------------------------------------------------------------------
 void Timer::Tick( float fLockFPS )
 {
@@ -79,37 +83,49 @@ void Timer::Tick( float fLockFPS )
     // Should we lock the frame rate ?
     if ( fLockFPS > 0.0f )
     {
-        while ( fTimeElapsed < (1.0f / fLockFPS))
+        // Sleep (rather than spin) until the frame's deadline
+        m_Pacer.SetTargetRate( fLockFPS );
+        m_Pacer.Wait();
+
+        // Is performance hardware available?
+	    if ( m_PerfHardware ) 
+        {
+            // Query high-resolution performance hardware
+		    QueryPerformanceCounter((LARGE_INTEGER*)&m_CurrentTime);
+	    } 
+        else 
         {
-            // Is performance hardware available?
-	        if ( m_PerfHardware ) 
-            {
-                // Query high-resolution performance hardware
-		        QueryPerformanceCounter((LARGE_INTEGER*)&m_CurrentTime);
-	        } 
-            else 
-            {
-                // Fall back to less accurate timer
-		        m_CurrentTime = timeGetTime();
-
-	        } // End If no hardware available
-
-	        // Calculate elapsed time in seconds
-	        fTimeElapsed = (m_CurrentTime - m_LastTime) * m_TimeScale;
-
-        } // End While
+            // Fall back to less accurate timer
+		    m_CurrentTime = timeGetTime();
+
+	    } // End If no hardware available
+
+	    // Calculate elapsed time in seconds
+	    fTimeElapsed = (m_CurrentTime - m_LastTime) * m_TimeScale;
+
     } // End If
 
 	// Save current frame time
 	m_LastTime = m_CurrentTime;
+    m_LastElapsed = fTimeElapsed;
 
     // Filter out values wildly different from current average
     if ( fabsf(fTimeElapsed - m_TimeElapsed) < 1.0f  )
     {
-        // Wrap FIFO frame time buffer.
-        memmove( &m_FrameTime[1], m_FrameTime, (MAX_SAMPLE_COUNT - 1) * sizeof(float) );
-        m_FrameTime[ 0 ] = fTimeElapsed;
+        // Overwrite the oldest sample of the ring buffer, keeping the sum
         if ( m_SampleCount < MAX_SAMPLE_COUNT ) m_SampleCount++;
+        else m_SampleSum -= m_FrameTime[ m_SampleIndex ];
+
+        m_FrameTime[ m_SampleIndex ] = fTimeElapsed;
+        m_SampleSum += fTimeElapsed;
+        m_SampleIndex = (m_SampleIndex + 1) % MAX_SAMPLE_COUNT;
+
+        // Start the sum over once per lap so float rounding can't build up
+        if ( m_SampleIndex == 0 )
+        {
+            m_SampleSum = 0.0f;
+            for ( ULONG i = 0; i < m_SampleCount; i++ ) m_SampleSum += m_FrameTime[ i ];
+        }
 
     } // End if
     
@@ -124,10 +140,8 @@ void Timer::Tick( float fLockFPS )
 		m_FPSTimeElapsed	= 0.0f;
 	} // End If Second Elapsed
 
-    // Count up the new average elapsed time
-    m_TimeElapsed = 0.0f;
-    for ( ULONG i = 0; i < m_SampleCount; i++ ) m_TimeElapsed += m_FrameTime[ i ];
-    if ( m_SampleCount > 0 ) m_TimeElapsed /= m_SampleCount;
+    // New average elapsed time from the running sum
+    if ( m_SampleCount > 0 ) m_TimeElapsed = m_SampleSum / m_SampleCount;
 
 }
 
@@ -160,3 +174,42 @@ float Timer::GetTimeElapsed() const
 {
     return m_TimeElapsed;
 }
+
+//-----------------------------------------------------------------------------
+// Name : GetLastFrameTime () 
+// Desc : Returns the time the last frame took, unfiltered & unaveraged
+//        (Seconds)
+//-----------------------------------------------------------------------------
+float Timer::GetLastFrameTime() const
+{
+    return m_LastElapsed;
+}
+
+//-----------------------------------------------------------------------------
+// Name : EndFrame () 
+// Desc : Records the last frame in the frame recorder, along with the CPU
+//        time it took to build & the GPU time to draw (negative if unknown)
+//-----------------------------------------------------------------------------
+void Timer::EndFrame( double fCpuTime, double fGpuTime )
+{
+    m_Recorder.Record( m_LastElapsed, fCpuTime, fGpuTime );
+}
+
+//-----------------------------------------------------------------------------
+// Name : GetPacer () 
+// Desc : Returns the frame pacer used to lock the frame rate, for vsync
+//        setup & pacing statistics.
+//-----------------------------------------------------------------------------
+FramePacer& Timer::GetPacer()
+{
+    return m_Pacer;
+}
+
+//-----------------------------------------------------------------------------
+// Name : GetRecorder () 
+// Desc : Returns the frame recorder, for percentiles & CSV / JSON export.
+//-----------------------------------------------------------------------------
+FrameRecorder& Timer::GetRecorder()
+{
+    return m_Recorder;
+}
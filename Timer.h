@@ -15,6 +15,9 @@
 #include <math.h>
 #include <tchar.h>
 
+#include "FramePacer.h"
+#include "FrameRecorder.h"
+
 const ULONG MAX_SAMPLE_COUNT = 50; // Maximum frame time sample count
 
 //-----------------------------------------------------------------------------
@@ -38,6 +41,10 @@ public:
 	void	        Tick( float fLockFPS = 0.0f );
     unsigned long   GetFrameRate( LPTSTR lpszString = NULL ) const;
     float           GetTimeElapsed() const;
+    float           GetLastFrameTime() const;
+    void            EndFrame( double fCpuTime, double fGpuTime = -1.0 );
+    FramePacer&     GetPacer();
+    FrameRecorder&  GetRecorder();
 
 private:
 	//------------------------------------------------------------
@@ -50,12 +57,18 @@ private:
     __int64         m_LastTime;                 // Performance Counter last frame
 	__int64         m_PerfFreq;                 // Performance Frequency
 
-    float           m_FrameTime[MAX_SAMPLE_COUNT];
-    ULONG           m_SampleCount;
+    float           m_LastElapsed;              // Unfiltered time of the last frame
+    float           m_FrameTime[MAX_SAMPLE_COUNT]; // Ring buffer of frame times
+    ULONG           m_SampleCount;              // Samples in the ring buffer
+    ULONG           m_SampleIndex;              // Next slot to overwrite
+    float           m_SampleSum;                // Running sum of the samples
 
     unsigned long   m_FrameRate;                // Stores current framerate
 	unsigned long   m_FPSFrameCount;            // Elapsed frames in any given second
 	float           m_FPSTimeElapsed;           // How much time has passed during FPS sample
+
+    FramePacer      m_Pacer;                    // Sleeps until the locked frame rate's deadline
+    FrameRecorder   m_Recorder;                 // Frame time history & percentiles
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,275 @@
+///============================================================================
+///@file	Tracer.cpp
+///@brief	Tracer Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "Tracer.h"
+
+#include <stdlib.h>
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+volatile bool				Tracer::s_Enabled	= false;
+FILE						*Tracer::s_File		= NULL;
+unsigned long long			Tracer::s_Origin	= 0;
+unsigned long				Tracer::s_Written	= 0;
+Mutex						Tracer::s_Lock;
+std::vector<Tracer::ThreadRing*>	Tracer::s_Rings;
+Tracer::Writer				Tracer::s_Writer;
+TRACE_THREAD_LOCAL Tracer::ThreadRing	*Tracer::s_Ring = NULL;
+
+///----------------------------------------------------------------------------
+///Starts recording the zones of every thread into a trace file, the file
+///is complete once Stop() is called (at exit at the latest).
+///@param	fileName - the Chrome trace JSON file
+///@return	true if the file was created, false if it couldn't be or the
+///			zones are compiled out
+///----------------------------------------------------------------------------
+bool Tracer::Start(const char *fileName)
+{
+	static bool registered = false;
+
+	if(!IsCompiledIn())
+		return false;
+
+	Stop();
+
+	s_File = fopen(fileName, "w");
+	if(!s_File)
+		return false;
+
+	//zones left over from an earlier trace are skipped
+	{
+		ScopedLock lock(s_Lock);
+
+		for(size_t i=0; i<s_Rings.size(); i++)
+		{
+			AtomicExchange(&s_Rings[i]->tail, s_Rings[i]->head);
+			AtomicExchange(&s_Rings[i]->dropped, 0);
+		}
+	}
+
+	fprintf(s_File, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n"
+					"{\"ph\": \"M\", \"name\": \"process_name\", \"pid\": 1, \"args\": {\"name\": \"CharcoalRendering\"}}");
+
+	s_Origin	= GetTimestamp();
+	s_Written	= 0;
+
+	s_Writer.m_Stop = false;
+	if(!s_Writer.Start())
+	{
+		fclose(s_File);
+		s_File = NULL;
+		return false;
+	}
+
+	s_Enabled = true;
+
+	//an early return from main still gets a complete file
+	if(!registered)
+		atexit(Stop);
+	registered = true;
+
+	return true;
+}
+
+///----------------------------------------------------------------------------
+///Stops recording, writes the zones still in the rings & the thread names
+///and closes the file.
+///----------------------------------------------------------------------------
+void Tracer::Stop()
+{
+	if(!s_File)
+		return;
+
+	s_Enabled = false;
+
+	s_Writer.m_Stop = true;
+	s_Writer.Join();
+
+	//zones that ended before s_Enabled was cleared
+	Drain();
+
+	ScopedLock lock(s_Lock);
+	long dropped = 0;
+
+	for(size_t i=0; i<s_Rings.size(); i++)
+	{
+		const char *name = s_Rings[i]->name ? s_Rings[i]->name : "thread";
+
+		fprintf(s_File, ",\n{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": 1, \"tid\": %u, \"args\": {\"name\": \"%s\"}}",
+				s_Rings[i]->id, name);
+		dropped += AtomicOr(&s_Rings[i]->dropped, 0);
+	}
+
+	fprintf(s_File, "\n],\n\"otherData\": {\"zones\": %lu, \"dropped\": %ld}}\n", s_Written, dropped);
+	fclose(s_File);
+	s_File = NULL;
+}
+
+///----------------------------------------------------------------------------
+///Tells whether zones are being recorded.
+///@return	true between Start() & Stop()
+///----------------------------------------------------------------------------
+bool Tracer::IsEnabled()
+{
+	return s_Enabled;
+}
+
+///----------------------------------------------------------------------------
+///Tells whether this build has the zones.
+///@return	true in debug builds & with CHARCOAL_TRACE
+///----------------------------------------------------------------------------
+bool Tracer::IsCompiledIn()
+{
+#ifdef CHARCOAL_TRACE
+	return true;
+#else
+	return false;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Names the calling thread in the trace.
+///@param	name - the name, a literal
+///----------------------------------------------------------------------------
+void Tracer::SetThreadName(const char *name)
+{
+	ThreadRing *ring = GetRing();
+	if(ring)
+		ring->name = name;
+}
+
+///----------------------------------------------------------------------------
+///Records a zone of the calling thread.
+///@param	name - zone name, a literal
+///@param	start - time stamp of its start, from GetTimestamp()
+///@param	end - time stamp of its end
+///----------------------------------------------------------------------------
+void Tracer::AddZone(const char *name, unsigned long long start, unsigned long long end)
+{
+	ThreadRing *ring = GetRing();
+	if(!ring || !s_Enabled)
+		return;
+
+	//the writer frees a slot by moving the tail, the barrier makes sure it
+	//was done reading it
+	long head = ring->head;
+	if((unsigned long)(head - AtomicOr(&ring->tail, 0)) >= (unsigned long)TRACE_RING)
+	{
+		AtomicIncrement(&ring->dropped);
+		return;
+	}
+
+	Zone &zone	= ring->zones[head & (TRACE_RING - 1)];
+	zone.name	= name;
+	zone.start	= start;
+	zone.end	= end;
+
+	//published only once written
+	AtomicExchange(&ring->head, head + 1);
+}
+
+///----------------------------------------------------------------------------
+///Gets a monotonic time stamp.
+///@return	the time in nanoseconds
+///----------------------------------------------------------------------------
+unsigned long long Tracer::GetTimestamp()
+{
+#ifdef _WIN32
+	static LARGE_INTEGER frequency = {0};
+	LARGE_INTEGER counter;
+
+	if(frequency.QuadPart == 0)
+		QueryPerformanceFrequency(&frequency);
+
+	QueryPerformanceCounter(&counter);
+
+	//split to keep the multiplication from overflowing
+	unsigned long long seconds = counter.QuadPart / frequency.QuadPart;
+	unsigned long long rest = counter.QuadPart % frequency.QuadPart;
+
+	return seconds * 1000000000ULL + rest * 1000000000ULL / frequency.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+///----------------------------------------------------------------------------
+///Gets the calling thread's ring, created the first time the thread
+///records while tracing. Rings live until the process ends, a thread that
+///finished may still have zones to write.
+///@return	the ring, NULL if not tracing
+///----------------------------------------------------------------------------
+Tracer::ThreadRing* Tracer::GetRing()
+{
+	if(s_Ring || !s_Enabled)
+		return s_Ring;
+
+	ThreadRing *ring = new ThreadRing;
+	ring->head		= 0;
+	ring->tail		= 0;
+	ring->dropped	= 0;
+	ring->name		= NULL;
+
+	ScopedLock lock(s_Lock);
+
+	ring->id = (unsigned int)s_Rings.size() + 1;
+	s_Rings.push_back(ring);
+	s_Ring = ring;
+
+	return ring;
+}
+
+///----------------------------------------------------------------------------
+///Writes the zones recorded since the last drain, called by the writer
+///thread only (or once it has stopped).
+///----------------------------------------------------------------------------
+void Tracer::Drain()
+{
+	ScopedLock lock(s_Lock);
+
+	for(size_t i=0; i<s_Rings.size(); i++)
+	{
+		ThreadRing *ring = s_Rings[i];
+
+		//the barrier makes the zones before the head visible
+		long head = AtomicOr(&ring->head, 0);
+		long tail = ring->tail;
+
+		for(; tail != head; tail++)
+		{
+			const Zone &zone = ring->zones[tail & (TRACE_RING - 1)];
+
+			//a ring cleared by Start() may hold zones of the last trace
+			if(zone.start < s_Origin)
+				continue;
+
+			fprintf(s_File, ",\n{\"ph\": \"X\", \"name\": \"%s\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f}",
+					zone.name, ring->id, (zone.start - s_Origin) / 1000.0, (zone.end - zone.start) / 1000.0);
+			s_Written++;
+		}
+
+		AtomicExchange(&ring->tail, tail);
+	}
+}
+
+///----------------------------------------------------------------------------
+///Writer thread, drains the rings until asked to stop.
+///----------------------------------------------------------------------------
+void Tracer::Writer::Run()
+{
+	while(!m_Stop)
+	{
+		Thread::Sleep(TRACE_FLUSH);
+		Drain();
+	}
+}
@@ -0,0 +1,138 @@
+///============================================================================
+///@file	Tracer.h
+///@brief	Timeline of scoped zones across threads, for chrome://tracing or
+///			ui.perfetto.dev. A zone is recorded when its scope ends into a
+///			ring owned by its thread: the thread only writes its ring and a
+///			background thread only reads it, so recording takes no lock and
+///			never waits (a full ring drops the zone & counts it). The writer
+///			drains the rings every few milliseconds into a Chrome trace
+///			JSON file, nanosecond time stamps written as microseconds.
+///
+///			The TRACE_ macros are compiled in debug builds, and in release
+///			builds only with CHARCOAL_TRACE defined; otherwise they are
+///			empty. Zone & thread names must be string literals, the writer
+///			reads them after the scope is gone.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <stdio.h>
+
+#include "Thread.h"
+
+//debug builds always have the zones
+#if defined(_DEBUG) && !defined(CHARCOAL_TRACE)
+#define CHARCOAL_TRACE
+#endif
+
+#define TRACE_CONCAT2(a, b)	a##b
+#define TRACE_CONCAT(a, b)	TRACE_CONCAT2(a, b)
+
+#ifdef _MSC_VER
+#define TRACE_THREAD_LOCAL	__declspec(thread)
+#else
+#define TRACE_THREAD_LOCAL	__thread
+#endif
+
+#ifdef CHARCOAL_TRACE
+#define TRACE_ZONE(name)	TraceZone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_THREAD(name)	Tracer::SetThreadName(name)
+#else
+#define TRACE_ZONE(name)
+#define TRACE_THREAD(name)
+#endif
+
+const int TRACE_RING			= 8192;	// Zones a thread can have waiting, a power of 2
+const unsigned int TRACE_FLUSH	= 10;	// ms between drains of the rings
+
+class Tracer
+{
+public:
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	static bool					Start(const char *fileName);
+	static void					Stop();
+	static bool					IsEnabled();
+	static bool					IsCompiledIn();
+	static void					SetThreadName(const char *name);
+	static void					AddZone(const char *name, unsigned long long start, unsigned long long end);
+	static unsigned long long	GetTimestamp();
+
+private:
+	//-------------------------------------------------------------------------
+	//Private types
+	//-------------------------------------------------------------------------
+	struct Zone
+	{
+		const char			*name;		///> Zone name, a literal
+		unsigned long long	start;		///> Start, in ns
+		unsigned long long	end;		///> End, in ns
+	};
+
+	//written by its thread only, read by the writer only
+	struct ThreadRing
+	{
+		Zone			zones[TRACE_RING];	///> Recorded zones
+		volatile long	head;			///> Zones written, by the thread
+		volatile long	tail;			///> Zones read, by the writer
+		volatile long	dropped;		///> Zones lost to a full ring
+		const char		*name;			///> Thread name, a literal
+		unsigned int	id;				///> Thread id in the trace
+	};
+
+	class Writer : public Thread
+	{
+	public:
+		volatile bool	m_Stop;			///> Asks the writer to finish
+	protected:
+		virtual void	Run();
+	};
+
+	//-------------------------------------------------------------------------
+	//Private methods
+	//-------------------------------------------------------------------------
+	static ThreadRing*	GetRing();
+	static void			Drain();
+
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	static volatile bool			s_Enabled;	///> Zones are being recorded
+	static FILE						*s_File;	///> Trace being written
+	static unsigned long long		s_Origin;	///> Time stamp of Start()
+	static unsigned long			s_Written;	///> Zones written to the file
+	static Mutex					s_Lock;		///> Guards the list of rings
+	static std::vector<ThreadRing*>	s_Rings;	///> Every thread's ring
+	static Writer					s_Writer;	///> Drains the rings
+	static TRACE_THREAD_LOCAL ThreadRing	*s_Ring;	///> The calling thread's ring, NULL until it records
+};
+
+//-----------------------------------------------------------------------------
+//Records a zone from its construction to the end of the scope
+//-----------------------------------------------------------------------------
+class TraceZone
+{
+public:
+	TraceZone(const char *name)
+	{
+		m_Name	= Tracer::IsEnabled() ? name : NULL;
+		m_Start	= m_Name ? Tracer::GetTimestamp() : 0;
+	}
+
+	~TraceZone()
+	{
+		if(m_Name)
+			Tracer::AddZone(m_Name, m_Start, Tracer::GetTimestamp());
+	}
+
+private:
+	const char			*m_Name;	///> Zone name, NULL if not tracing
+	unsigned long long	m_Start;	///> Start time stamp, in ns
+};
+
+#endif
@@ -0,0 +1,278 @@
+///============================================================================
+///@file	TransformBenchmark.cpp
+///@brief	Charcoal Rendering, vertex transform benchmark.
+///			Measures vertices per second of a scalar transform over an array
+///			of structures against VertexTransform's SIMD structure of arrays
+///			on one thread & on a ThreadPool, then the triangles per second
+///			its outcodes & clipper get through.
+///
+///			usage: TransformBenchmark [-vertices N] [-reps N] [-threads N]
+///
+///			-vertices is the size of the synthetic mesh (1M by default, a
+///			strip wandering around the camera so some of its triangles
+///			cross the near plane & the guard band), -threads the size of
+///			the pool (one per processor by default).
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <vector>
+
+#include "VertexTransform.h"
+#include "MatrixMath.h"
+
+using namespace std;
+
+const GLfloat	GUARD_BAND	= 16.0f;	// Same guard band as the CPU renderer
+const int		STRIDE		= 8;		// Clip position + 4 varyings per vertex
+
+//-----------------------------------------------------------------------------
+//Array of structures vertices for the scalar version
+//-----------------------------------------------------------------------------
+struct Position
+{
+	GLfloat	x, y, z;
+};
+
+struct ClipPosition
+{
+	GLfloat			position[4];
+	unsigned int	outcode;
+};
+
+///----------------------------------------------------------------------------
+///Gets a monotonic time stamp.
+///@return	the time in seconds
+///----------------------------------------------------------------------------
+static double GetSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+///----------------------------------------------------------------------------
+///Transforms & outcodes one vertex at a time, like the CPU renderer did
+///before VertexTransform.
+///@param	m - column major model-view-projection matrix
+///@param	in - object space positions
+///@param	out - receives the clip positions & outcodes
+///----------------------------------------------------------------------------
+static void TransformScalar(const GLfloat *m, const vector<Position> &in, vector<ClipPosition> &out)
+{
+	for(size_t i=0; i<in.size(); i++)
+	{
+		const GLfloat p[3] = {in[i].x, in[i].y, in[i].z};
+		ClipPosition &clip = out[i];
+
+		for(int row=0; row<4; row++)
+			clip.position[row] = m[row] * p[0] + m[4 + row] * p[1] + m[8 + row] * p[2] + m[12 + row];
+
+		GLfloat x = clip.position[0], y = clip.position[1], z = clip.position[2], w = clip.position[3];
+		GLfloat guardW = GUARD_BAND * w;
+
+		clip.outcode = ((w + z < 0.0f) ? OC_NEAR : 0) |
+					   ((w - z < 0.0f) ? OC_FAR : 0) |
+					   ((guardW + x < 0.0f) ? OC_GUARD_LEFT : 0) |
+					   ((guardW - x < 0.0f) ? OC_GUARD_RIGHT : 0) |
+					   ((guardW + y < 0.0f) ? OC_GUARD_BOTTOM : 0) |
+					   ((guardW - y < 0.0f) ? OC_GUARD_TOP : 0) |
+					   ((w + x < 0.0f) ? OC_LEFT : 0) |
+					   ((w - x < 0.0f) ? OC_RIGHT : 0) |
+					   ((w + y < 0.0f) ? OC_BOTTOM : 0) |
+					   ((w - y < 0.0f) ? OC_TOP : 0);
+	}
+}
+
+///----------------------------------------------------------------------------
+///Rejects, clips & counts the triangles of a strip over the vertices.
+///@param	transform - transformed vertices
+///@param	vertices - the vertices, STRIDE floats each
+///@param	clipped - receives the number of triangles that needed clipping
+///@return	number of triangles left after clipping (fans included)
+///----------------------------------------------------------------------------
+static size_t ClipTriangles(const VertexTransform &transform, const vector<GLfloat> &vertices, size_t &clipped)
+{
+	const unsigned int *outcodes = transform.GetOutcodes();
+	GLfloat polygon[MAX_CLIP_VERTICES * STRIDE];
+	size_t triangles = 0;
+
+	clipped = 0;
+
+	for(size_t i=0; i+2<transform.GetCount(); i++)
+	{
+		unsigned int oc0 = outcodes[i], oc1 = outcodes[i + 1], oc2 = outcodes[i + 2];
+
+		if(oc0 & oc1 & oc2)
+			continue;
+
+		unsigned int planes = (oc0 | oc1 | oc2) & OC_CLIP;
+
+		if(!planes)
+		{
+			triangles++;
+			continue;
+		}
+
+		int count = transform.ClipTriangle(&vertices[i * STRIDE], &vertices[(i + 1) * STRIDE],
+										   &vertices[(i + 2) * STRIDE], STRIDE, planes, polygon);
+		if(count >= 3)
+			triangles += count - 2;
+
+		clipped++;
+	}
+
+	return triangles;
+}
+
+int main(int argc, char *argv[])
+{
+	int count				= 1 << 20;
+	int reps				= 5;
+	unsigned int threads	= 0;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-vertices") && i+1 < argc)
+			count = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-reps") && i+1 < argc)
+			reps = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-threads") && i+1 < argc)
+			threads = (unsigned int)atoi(argv[++i]);
+		else
+		{
+			fprintf(stderr, "usage: %s [-vertices N] [-reps N] [-threads N]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if(count < 3)
+		count = 3;
+
+	//a random walk around the scene's camera, each 3 vertices in a row
+	//make a small triangle of the strip
+	vector<Position> positions(count);
+	GLfloat walk[3] = {0.0f, 0.0f, 0.0f};
+	const GLfloat low[3] = {-5.0f, -5.0f, -20.0f};
+	const GLfloat high[3] = {5.0f, 5.0f, 20.0f};
+
+	srand(1);
+	for(int i=0; i<count; i++)
+	{
+		for(int c=0; c<3; c++)
+		{
+			walk[c] += ((GLfloat)rand() / RAND_MAX - 0.5f) * 2.0f;
+			if(walk[c] < low[c])	walk[c] = low[c];
+			if(walk[c] > high[c])	walk[c] = high[c];
+		}
+
+		positions[i].x = walk[0];
+		positions[i].y = walk[1];
+		positions[i].z = walk[2];
+	}
+
+	GLfloat projection[16], view[16], mvp[16];
+	const GLfloat eye[3] = {0.0f, 0.0f, 15.0f};
+	const GLfloat center[3] = {0.0f, 0.0f, 0.0f};
+
+	PerspectiveMatrix(45.0f, 4.0f / 3.0f, 1.0f, 100.0f, projection);
+	LookAtMatrix(eye, center, view);
+	MultiplyMatrix(projection, view, mvp);
+
+	VertexTransform transform;
+	transform.SetGuardBand(GUARD_BAND);
+	transform.SetPositions(&positions[0].x, count, sizeof(Position));
+
+	ThreadPool pool;
+	if(!pool.Start(threads))
+	{
+		fprintf(stderr, "Could not start the worker threads.\n");
+		return 1;
+	}
+
+	vector<ClipPosition> scalar(count);
+	const char *names[3] = {"scalar AoS", "SIMD SoA", "SIMD SoA pool"};
+	double rate[3];
+
+	printf("%d vertices, %u threads, best of %d\n", count, pool.GetThreadCount(), reps);
+	printf("%-16s %14s %9s\n", "transform", "vertices/s", "speedup");
+
+	for(int version=0; version<3; version++)
+	{
+		double best = 1e30;
+
+		//the first pass warms up the caches
+		for(int rep=0; rep<=reps; rep++)
+		{
+			double start = GetSeconds();
+
+			if(version == 0)
+				TransformScalar(mvp, positions, scalar);
+			else
+				transform.Transform(mvp, (version == 2) ? &pool : NULL);
+
+			double elapsed = GetSeconds() - start;
+			if(rep > 0 && elapsed < best)
+				best = elapsed;
+		}
+
+		rate[version] = count / best;
+		printf("%-16s %14.0f %8.2fx\n", names[version], rate[version], rate[version] / rate[0]);
+	}
+
+	//FMA builds may round differently, but no more than that
+	int positionErrors = 0, outcodeErrors = 0;
+	const GLfloat *clip[4] = {transform.GetClipX(), transform.GetClipY(), transform.GetClipZ(), transform.GetClipW()};
+
+	for(int i=0; i<count; i++)
+	{
+		for(int c=0; c<4; c++)
+		{
+			GLfloat error = fabsf(clip[c][i] - scalar[i].position[c]);
+			if(error > 1e-5f * (1.0f + fabsf(scalar[i].position[c])))
+				positionErrors++;
+		}
+
+		if(transform.GetOutcodes()[i] != scalar[i].outcode)
+			outcodeErrors++;
+	}
+
+	if(positionErrors || outcodeErrors)
+		fprintf(stderr, "SIMD & scalar differ: %d positions, %d outcodes!\n", positionErrors, outcodeErrors);
+
+	//clip position followed by a few varyings to interpolate
+	vector<GLfloat> vertices(count * STRIDE);
+	for(int i=0; i<count; i++)
+	{
+		for(int c=0; c<4; c++)
+			vertices[i * STRIDE + c] = clip[c][i];
+		for(int c=4; c<STRIDE; c++)
+			vertices[i * STRIDE + c] = (GLfloat)c;
+	}
+
+	double best = 1e30;
+	size_t triangles = 0, clipped = 0;
+
+	for(int rep=0; rep<=reps; rep++)
+	{
+		double start = GetSeconds();
+		triangles = ClipTriangles(transform, vertices, clipped);
+		double elapsed = GetSeconds() - start;
+
+		if(rep > 0 && elapsed < best)
+			best = elapsed;
+	}
+
+	size_t input = count - 2;
+	printf("clipping: %.0f triangles/s, %.2f%% clipped, %lu triangles out of %lu\n",
+		   input / best, 100.0 * clipped / input, (unsigned long)triangles, (unsigned long)input);
+
+	return (positionErrors || outcodeErrors) ? 1 : 0;
+}
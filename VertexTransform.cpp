@@ -0,0 +1,319 @@
+///============================================================================
+///@file	VertexTransform.cpp
+///@brief	Vertex Transform Class Implementation
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#include "VertexTransform.h"
+#include "Simd8.h"
+
+#include <string.h>
+
+const int MAX_CLIP_STRIDE	= 32;	// Floats per vertex ClipTriangle() can handle
+const int NUM_CLIP_PLANES	= 10;	// One per outcode bit
+
+///----------------------------------------------------------------------------
+///Turns a lane mask into an outcode bit.
+///@param	outside - all ones where the vertex is outside the plane
+///@param	bit - the outcode bit
+///@return	the bit where outside, 0 elsewhere
+///----------------------------------------------------------------------------
+static inline Int8 OutcodeBit(const Int8 &outside, int bit)
+{
+	return outside & Set1(bit);
+}
+
+///----------------------------------------------------------------------------
+///Default constructor.
+///----------------------------------------------------------------------------
+VertexTransform::VertexTransform()
+{
+	m_Count		= 0;
+	m_GuardBand	= 16.0f;
+	m_Matrix	= NULL;
+}
+
+///----------------------------------------------------------------------------
+///Copies the object space positions into the x, y & z arrays.
+///@param	positions - x, y & z of the first vertex
+///@param	count - number of vertices
+///@param	stride - bytes from one vertex to the next
+///----------------------------------------------------------------------------
+void VertexTransform::SetPositions(const GLfloat *positions, size_t count, size_t stride)
+{
+	//the last batch is padded with vertices at the origin
+	size_t padded = (count + 7) & ~(size_t)7;
+	const char *vertex = (const char*)positions;
+
+	m_Count = count;
+	m_X.assign(padded, 0.0f);
+	m_Y.assign(padded, 0.0f);
+	m_Z.assign(padded, 0.0f);
+
+	for(size_t i=0; i<count; i++, vertex+=stride)
+	{
+		const GLfloat *p = (const GLfloat*)vertex;
+
+		m_X[i] = p[0];
+		m_Y[i] = p[1];
+		m_Z[i] = p[2];
+	}
+
+	m_ClipX.resize(padded);
+	m_ClipY.resize(padded);
+	m_ClipZ.resize(padded);
+	m_ClipW.resize(padded);
+	m_Outcodes.resize(padded);
+}
+
+///----------------------------------------------------------------------------
+///Sets the size of the guard band the OC_GUARD_* bits test against.
+///@param	guardBand - guard band, in viewport sizes (1 is the view volume)
+///----------------------------------------------------------------------------
+void VertexTransform::SetGuardBand(GLfloat guardBand)
+{
+	m_GuardBand = guardBand;
+}
+
+///----------------------------------------------------------------------------
+///Transforms every vertex & computes its outcode.
+///@param	matrix - column major model-view-projection matrix
+///@param	pool - splits the vertices across its threads, NULL to run
+///			on the calling thread
+///----------------------------------------------------------------------------
+void VertexTransform::Transform(const GLfloat *matrix, ThreadPool *pool)
+{
+	if(!pool)
+	{
+		TransformRange(matrix, 0, m_Count);
+		return;
+	}
+
+	m_Matrix = matrix;
+	pool->Run(*this);
+	m_Matrix = NULL;
+}
+
+///----------------------------------------------------------------------------
+///Transforms a range of vertices & computes their outcodes, 8 at a time.
+///Ranges must start at a multiple of 8 so threads never share a batch.
+///@param	matrix - column major model-view-projection matrix
+///@param	first - first vertex, a multiple of 8
+///@param	last - one past the last vertex
+///----------------------------------------------------------------------------
+void VertexTransform::TransformRange(const GLfloat *matrix, size_t first, size_t last)
+{
+	const GLfloat *m = matrix;
+	Float8 zero = Set1(0.0f);
+	Float8 guardBand = Set1(m_GuardBand);
+	Float8 column[4][4];
+
+	for(int i=0; i<16; i++)
+		column[i / 4][i % 4] = Set1(m[i]);
+
+	for(size_t i=first; i<last; i+=8)
+	{
+		Float8 x = LoadRows(&m_X[i], &m_X[i + 4]);
+		Float8 y = LoadRows(&m_Y[i], &m_Y[i + 4]);
+		Float8 z = LoadRows(&m_Z[i], &m_Z[i + 4]);
+		Float8 clip[4];
+
+		//same order of operations as a row by row scalar transform
+		for(int row=0; row<4; row++)
+			clip[row] = column[0][row] * x + column[1][row] * y + column[2][row] * z + column[3][row];
+
+		Float8 w = clip[3];
+		Float8 guardW = guardBand * w;
+
+		Int8 outcode = OutcodeBit(Less(w + clip[2], zero), OC_NEAR) |
+					   OutcodeBit(Less(w - clip[2], zero), OC_FAR) |
+					   OutcodeBit(Less(guardW + clip[0], zero), OC_GUARD_LEFT) |
+					   OutcodeBit(Less(guardW - clip[0], zero), OC_GUARD_RIGHT) |
+					   OutcodeBit(Less(guardW + clip[1], zero), OC_GUARD_BOTTOM) |
+					   OutcodeBit(Less(guardW - clip[1], zero), OC_GUARD_TOP) |
+					   OutcodeBit(Less(w + clip[0], zero), OC_LEFT) |
+					   OutcodeBit(Less(w - clip[0], zero), OC_RIGHT) |
+					   OutcodeBit(Less(w + clip[1], zero), OC_BOTTOM) |
+					   OutcodeBit(Less(w - clip[1], zero), OC_TOP);
+
+		StoreRows(&m_ClipX[i], &m_ClipX[i + 4], clip[0]);
+		StoreRows(&m_ClipY[i], &m_ClipY[i + 4], clip[1]);
+		StoreRows(&m_ClipZ[i], &m_ClipZ[i + 4], clip[2]);
+		StoreRows(&m_ClipW[i], &m_ClipW[i + 4], clip[3]);
+		StoreRows(&m_Outcodes[i], &m_Outcodes[i + 4], outcode);
+	}
+}
+
+///----------------------------------------------------------------------------
+///Transforms the worker's share of the vertices, for Transform().
+///@param	worker - worker number
+///@param	workers - number of workers
+///----------------------------------------------------------------------------
+void VertexTransform::Execute(unsigned int worker, unsigned int workers)
+{
+	size_t first, last;
+
+	GetRange(m_Count, worker, workers, first, last, 8);
+	TransformRange(m_Matrix, first, last);
+}
+
+///----------------------------------------------------------------------------
+///Clips a triangle in homogeneous space (Sutherland-Hodgman). Vertices are
+///arrays of floats starting with the clip space position, the rest of them
+///(texture coordinates, colors...) is interpolated along.
+///@param	v0, v1, v2 - triangle vertices
+///@param	stride - floats per vertex, up to 32
+///@param	planes - outcode bits of the planes to clip against, usually the
+///			OC_CLIP bits of (outcode0 | outcode1 | outcode2)
+///@param	out - receives the polygon, MAX_CLIP_VERTICES * stride floats
+///@return	number of polygon vertices, 0 if nothing is left
+///----------------------------------------------------------------------------
+int VertexTransform::ClipTriangle(const GLfloat *v0, const GLfloat *v1, const GLfloat *v2, 
+								  int stride, unsigned int planes, GLfloat *out) const
+{
+	if(stride < 4 || stride > MAX_CLIP_STRIDE)
+		return 0;
+
+	int passes = 0;
+	for(int plane=0; plane<NUM_CLIP_PLANES; plane++)
+		if(planes & (1 << plane))
+			passes++;
+
+	//ping-pong between the buffers so the last pass writes to out
+	GLfloat temp[MAX_CLIP_VERTICES * MAX_CLIP_STRIDE];
+	GLfloat *buffers[2] = {out, temp};
+	int current = passes & 1;
+	int count = 3;
+
+	memcpy(buffers[current], v0, stride * sizeof(GLfloat));
+	memcpy(buffers[current] + stride, v1, stride * sizeof(GLfloat));
+	memcpy(buffers[current] + stride * 2, v2, stride * sizeof(GLfloat));
+
+	for(int plane=0; plane<NUM_CLIP_PLANES; plane++)
+	{
+		if(!(planes & (1 << plane)))
+			continue;
+
+		const GLfloat *in = buffers[current];
+		GLfloat *result = buffers[current ^ 1];
+		int resultCount = 0;
+
+		for(int i=0; i<count; i++)
+		{
+			const GLfloat *a = in + i * stride;
+			const GLfloat *b = in + ((i + 1) % count) * stride;
+			GLfloat da = GetPlaneDistance(a, plane);
+			GLfloat db = GetPlaneDistance(b, plane);
+
+			if(da >= 0.0f)
+				memcpy(result + (resultCount++) * stride, a, stride * sizeof(GLfloat));
+
+			if((da >= 0.0f) != (db >= 0.0f))
+			{
+				GLfloat t = da / (da - db);
+				GLfloat *v = result + (resultCount++) * stride;
+
+				for(int j=0; j<stride; j++)
+					v[j] = a[j] + (b[j] - a[j]) * t;
+			}
+		}
+
+		current ^= 1;
+		count = resultCount;
+
+		if(count < 3)
+			return 0;
+	}
+
+	return count;
+}
+
+///----------------------------------------------------------------------------
+///Distance of a clip space position to one of the planes, positive inside.
+///@param	position - clip space position
+///@param	plane - plane number, the bit number of its outcode
+///@return	the signed distance
+///----------------------------------------------------------------------------
+GLfloat VertexTransform::GetPlaneDistance(const GLfloat *position, int plane) const
+{
+	GLfloat x = position[0], y = position[1], z = position[2], w = position[3];
+
+	switch(plane)
+	{
+		case 0:		return w + z;
+		case 1:		return w - z;
+		case 2:		return m_GuardBand * w + x;
+		case 3:		return m_GuardBand * w - x;
+		case 4:		return m_GuardBand * w + y;
+		case 5:		return m_GuardBand * w - y;
+		case 6:		return w + x;
+		case 7:		return w - x;
+		case 8:		return w + y;
+		default:	return w - y;
+	}
+}
+
+///----------------------------------------------------------------------------
+///Gets the number of vertices.
+///@return	the vertex count, without the padding
+///----------------------------------------------------------------------------
+size_t VertexTransform::GetCount() const
+{
+	return m_Count;
+}
+
+///----------------------------------------------------------------------------
+///Gets the guard band.
+///@return	the guard band, in viewport sizes
+///----------------------------------------------------------------------------
+GLfloat VertexTransform::GetGuardBand() const
+{
+	return m_GuardBand;
+}
+
+///----------------------------------------------------------------------------
+///Gets the clip space x of every vertex.
+///@return	the transformed x array
+///----------------------------------------------------------------------------
+const GLfloat* VertexTransform::GetClipX() const
+{
+	return m_ClipX.empty() ? NULL : &m_ClipX[0];
+}
+
+///----------------------------------------------------------------------------
+///Gets the clip space y of every vertex.
+///@return	the transformed y array
+///----------------------------------------------------------------------------
+const GLfloat* VertexTransform::GetClipY() const
+{
+	return m_ClipY.empty() ? NULL : &m_ClipY[0];
+}
+
+///----------------------------------------------------------------------------
+///Gets the clip space z of every vertex.
+///@return	the transformed z array
+///----------------------------------------------------------------------------
+const GLfloat* VertexTransform::GetClipZ() const
+{
+	return m_ClipZ.empty() ? NULL : &m_ClipZ[0];
+}
+
+///----------------------------------------------------------------------------
+///Gets the clip space w of every vertex.
+///@return	the transformed w array
+///----------------------------------------------------------------------------
+const GLfloat* VertexTransform::GetClipW() const
+{
+	return m_ClipW.empty() ? NULL : &m_ClipW[0];
+}
+
+///----------------------------------------------------------------------------
+///Gets the outcode of every vertex.
+///@return	the Outcode bits array
+///----------------------------------------------------------------------------
+const unsigned int* VertexTransform::GetOutcodes() const
+{
+	return m_Outcodes.empty() ? NULL : &m_Outcodes[0];
+}
@@ -0,0 +1,96 @@
+///============================================================================
+///@file	VertexTransform.h
+///@brief	Vertex positions kept as structure of arrays (all x, then all y,
+///			then all z) so 8 of them go through the model-view-projection
+///			matrix at once (Simd8.h), along with their clip outcodes. Big
+///			meshes can be split across a ThreadPool in 8 vertex chunks. The
+///			triangles the outcodes flag are clipped in homogeneous space.
+///
+///@author	Hctor Morales Piloni
+///@date	October 19, 2026
+///============================================================================
+
+#ifndef VERTEXTRANSFORM_H
+#define VERTEXTRANSFORM_H
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <vector>
+#include <GL/gl.h>
+
+#include "Thread.h"
+
+using namespace std;
+
+const int MAX_CLIP_VERTICES	= 13;	// 3 + one per clipping plane
+
+//-----------------------------------------------------------------------------
+//Outcode bits, set when a vertex is outside the plane. The bit order is the
+//order planes are clipped in.
+//-----------------------------------------------------------------------------
+enum Outcode
+{
+	OC_NEAR			= 1 << 0,	///> z < -w
+	OC_FAR			= 1 << 1,	///> z > w
+	OC_GUARD_LEFT	= 1 << 2,	///> x < -g*w, g being the guard band
+	OC_GUARD_RIGHT	= 1 << 3,	///> x > g*w
+	OC_GUARD_BOTTOM	= 1 << 4,	///> y < -g*w
+	OC_GUARD_TOP	= 1 << 5,	///> y > g*w
+	OC_LEFT			= 1 << 6,	///> x < -w
+	OC_RIGHT		= 1 << 7,	///> x > w
+	OC_BOTTOM		= 1 << 8,	///> y < -w
+	OC_TOP			= 1 << 9,	///> y > w
+
+	///> planes a rasterizer can't leave to its bounding box
+	OC_CLIP = OC_NEAR | OC_FAR | OC_GUARD_LEFT | OC_GUARD_RIGHT | OC_GUARD_BOTTOM | OC_GUARD_TOP
+};
+
+class VertexTransform : public ParallelTask
+{
+public:
+	//-------------------------------------------------------------------------
+	//Constructors and destructors
+	//-------------------------------------------------------------------------
+	VertexTransform();
+
+	//-------------------------------------------------------------------------
+	//Public methods
+	//-------------------------------------------------------------------------
+	void			SetPositions(const GLfloat *positions, size_t count, size_t stride);
+	void			SetGuardBand(GLfloat guardBand);
+
+	void			Transform(const GLfloat *matrix, ThreadPool *pool = NULL);
+	void			TransformRange(const GLfloat *matrix, size_t first, size_t last);
+	virtual void	Execute(unsigned int worker, unsigned int workers);
+
+	int				ClipTriangle(const GLfloat *v0, const GLfloat *v1, const GLfloat *v2, 
+								 int stride, unsigned int planes, GLfloat *out) const;
+	GLfloat			GetPlaneDistance(const GLfloat *position, int plane) const;
+
+	size_t			GetCount() const;
+	GLfloat			GetGuardBand() const;
+	const GLfloat*	GetClipX() const;
+	const GLfloat*	GetClipY() const;
+	const GLfloat*	GetClipZ() const;
+	const GLfloat*	GetClipW() const;
+	const unsigned int*	GetOutcodes() const;
+
+private:
+	//-------------------------------------------------------------------------
+	//Private members
+	//-------------------------------------------------------------------------
+	size_t					m_Count;		///> Number of vertices
+	vector<GLfloat>			m_X;			///> Object space positions, padded
+	vector<GLfloat>			m_Y;			///> to a multiple of 8 vertices
+	vector<GLfloat>			m_Z;
+	vector<GLfloat>			m_ClipX;		///> Clip space positions
+	vector<GLfloat>			m_ClipY;
+	vector<GLfloat>			m_ClipZ;
+	vector<GLfloat>			m_ClipW;
+	vector<unsigned int>	m_Outcodes;		///> Outcode bits of each vertex
+	GLfloat					m_GuardBand;	///> Guard band, in viewport sizes
+	const GLfloat			*m_Matrix;		///> Matrix of the running Transform()
+};
+
+#endif
@@ -26,7 +26,9 @@ THE POSSIBILITY OF SUCH DAMAGE.
 ------------------------------------------------------------------------------*/
 
 #include "ltga.h"
+#include "MemoryStats.h"
 #include <fstream>
+#include <stdlib.h>
 
 //--------------------------------------------------
 // global functions
@@ -162,6 +164,7 @@ bool LTGA::LoadFromFile(const std::string &filename)
     file.seekg(IDLength, std::ios::cur);
 
     m_pixels = (byte*) malloc(m_width*m_height*(m_pixelDepth/8));
+    MemoryStats::Allocate(MC_TEXTURE, MP_CPU, m_width*m_height*(m_pixelDepth/8));
 
     if (!rle)
         ReadData(file, (char*)m_pixels, m_width*m_height*(m_pixelDepth/8));
@@ -218,7 +221,10 @@ bool LTGA::LoadFromFile(const std::string &filename)
 void LTGA::Clear()
 {
     if (m_pixels)
+    {
         free(m_pixels);
+        MemoryStats::Free(MC_TEXTURE, MP_CPU, m_width*m_height*(m_pixelDepth/8));
+    }
     m_pixels = 0;
     m_loaded = false;
     m_width = 0;
@@ -10,6 +10,7 @@
 
 #include <windows.h>
 #include "GLApp.h"
+#include "Tracer.h"
 
 GLApp *myApp;
 
@@ -17,6 +18,12 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPTSTR lpCmdLin
 {
 	int retCode;
 
+	//"-trace" writes the timeline of the run to trace.json, in the builds
+	//that have the zones
+	if(lpCmdLine && strstr(lpCmdLine, "-trace"))
+		Tracer::Start("trace.json");
+	TRACE_THREAD("main");
+
 	//create a new 512x512 window application
 	myApp = new GLApp("Charcoal Rendering Demo", 512, 512);
 	
@@ -32,6 +39,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPTSTR lpCmdLin
 
 	//clean-up
 	delete myApp;
+	Tracer::Stop();
 
 	return retCode;
 }
\ No newline at end of file
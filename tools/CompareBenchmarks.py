@@ -0,0 +1,359 @@
+#!/usr/bin/env python
+#
+#@file	CompareBenchmarks.py
+#@brief	Compares the benchmark reports (see Benchmark.h) of a baseline with
+#		one or more candidates, i.e. before & after a change to Model::draw,
+#		the shaders or the loaders:
+#
+#		python tools/CompareBenchmarks.py base.json new.json [new2.json ...]
+#			[-threshold 5] [-confidence 95] [-resamples 2000] [-json out.json]
+#
+#		Several runs of the same build are joined with commas (a.json,b.json)
+#		and reports of different scenes (renderer, quality, size & path) are
+#		matched by scene. For each scene the median, p90 & p99 of the frame,
+#		CPU & GPU times are compared with a bootstrap confidence interval of
+#		the change, and the stages by their means.
+#
+#		Frame times follow each other (a slow frame is often followed by
+#		another), so whole blocks of frames are resampled rather than single
+#		frames. Frame i of every run has the same pose, so the same blocks
+#		are taken from the baseline & the candidate and the cost of the
+#		views cancels out. With several runs the runs are resampled too: how
+#		much the host changed between runs ends up in the interval. A change
+#		is only a regression if the whole interval is beyond the threshold,
+#		there are two runs a side at least and the change is larger than the
+#		spread of the baseline runs among themselves; otherwise it is at most
+#		"noisy", never a false alarm. One run a side can't tell the change
+#		from the host drifting between runs. The exit status is 1 if anything
+#		regressed.
+#
+#@author	Hector Morales Piloni
+#@date	October 19, 2026
+#
+
+from __future__ import division
+
+import json
+import math
+import random
+import sys
+
+#frame metrics compared: (label, report key, percentiles)
+METRICS = [
+	('frame', 'frame_ms', [50.0, 90.0, 99.0]),
+	('cpu', 'cpu_ms', [50.0, 99.0]),
+	('gpu', 'gpu_ms', [50.0, 99.0]),
+]
+
+#column of each report key in the samples, [frame, frame_ms, cpu_ms, gpu_ms]
+COLUMNS = {'frame_ms': 1, 'cpu_ms': 2, 'gpu_ms': 3}
+
+#metadata that makes runs incomparable if it differs
+METADATA = [
+	('build', 'compiler'), ('build', 'simd'), ('build', 'configuration'),
+	('host', 'name'), ('driver', 'renderer'), ('driver', 'version'),
+]
+
+class Options:
+	threshold	= 5.0		# Smallest change in % flagged
+	confidence	= 95.0		# Confidence interval, in %
+	resamples	= 2000		# Bootstrap resamples
+	runs		= 2			# Runs a side needed to flag a change
+	seed		= 1			# Same intervals for the same files
+	json		= None		# Machine readable output
+
+def percentile(values, p):
+	"""Linear interpolation between the closest ranks of sorted values."""
+	if not values:
+		return float('nan')
+	position = (len(values) - 1) * p / 100.0
+	low = int(math.floor(position))
+	high = min(low + 1, len(values) - 1)
+	return values[low] + (values[high] - values[low]) * (position - low)
+
+def load(path):
+	with open(path) as f:
+		report = json.load(f)
+
+	if 'benchmark' not in report or 'frame_times' not in report:
+		raise ValueError('%s is not a benchmark report' % path)
+
+	if 'samples' not in report['frame_times']:
+		raise ValueError('%s has no frame samples' % path)
+
+	report['path'] = path
+	return report
+
+def scene_of(report):
+	#the poses depend on the frame count too
+	b = report['benchmark']
+	return '%s %s %dx%d %s/%d' % (b['renderer'], b['quality'], b['width'], b['height'],
+								  b['path'], b['frames'])
+
+def group(paths):
+	"""Reports of one build, by scene."""
+	scenes = {}
+	for path in paths.split(','):
+		report = load(path)
+		scenes.setdefault(scene_of(report), []).append(report)
+	return scenes
+
+def samples_of(report, key):
+	"""The times of every frame in order, None where there is none."""
+	column = COLUMNS[key]
+	return [s[column] for s in report['frame_times']['samples']]
+
+def measured(values):
+	return [v for v in values if v is not None]
+
+def block_length(count):
+	#long enough to keep the correlation of neighbouring frames
+	return max(1, int(round(count ** (1.0 / 3.0))))
+
+def pick_frames(count, rng):
+	"""Frame indices of a circular block bootstrap."""
+	length = block_length(count)
+	picked = []
+	while len(picked) < count:
+		start = rng.randrange(count)
+		picked.extend((start + i) % count for i in range(length))
+	return picked[:count]
+
+def resample(runs, frames, rng):
+	"""The picked frames of each run, the runs resampled first."""
+	if len(runs) > 1:
+		runs = [runs[rng.randrange(len(runs))] for run in runs]
+
+	out = []
+	for run in runs:
+		out.extend(run[i] for i in frames if i < len(run) and run[i] is not None)
+	return out
+
+def change(base, new):
+	if base == 0.0:
+		return float('nan')
+	return 100.0 * (new - base) / base
+
+def spread_of(values):
+	"""How much a statistic of the baseline runs differs among them, in %."""
+	if len(values) < 2:
+		return float('nan')
+	return change(min(values), max(values))
+
+def verdict(value, low, high, spread, runs, options):
+	"""Flags a change only if the interval, the runs & the host all agree."""
+	if math.isnan(low):
+		return ''
+	if low > options.threshold:
+		flagged = 'REGRESSION'
+	elif high < -options.threshold:
+		flagged = 'improvement'
+	elif high > options.threshold or low < -options.threshold:
+		#the interval reaches past the threshold, the runs can't tell
+		return 'noisy'
+	else:
+		return ''
+
+	#too few runs, or the host alone moves the baseline as much
+	if runs < options.runs or math.isnan(spread) or spread >= abs(value):
+		return 'noisy'
+	return flagged
+
+def interval(baseRuns, newRuns, statistics, rng, options):
+	"""Bootstrap intervals of the changes of some statistics, in %."""
+	count = min(len(run) for run in baseRuns + newRuns)
+	changes = [[] for statistic in statistics]
+	for i in range(options.resamples):
+		frames = pick_frames(count, rng)
+		base = sorted(resample(baseRuns, frames, rng))
+		new = sorted(resample(newRuns, frames, rng))
+		for statistic, out in zip(statistics, changes):
+			out.append(change(statistic(base), statistic(new)))
+
+	tail = (100.0 - options.confidence) / 2.0
+	intervals = []
+	for out in changes:
+		out = sorted(c for c in out if not math.isnan(c))
+		intervals.append((percentile(out, tail), percentile(out, 100.0 - tail)))
+	return intervals
+
+def compare_frames(baseReports, newReports, rng, options):
+	rows = []
+	for label, key, percentiles in METRICS:
+		baseRuns = [run for run in (samples_of(r, key) for r in baseReports) if measured(run)]
+		newRuns = [run for run in (samples_of(r, key) for r in newReports) if measured(run)]
+		if not baseRuns or not newRuns:
+			continue
+
+		#percentiles of sorted values, one sort for all of them
+		statistics = [lambda values, p=p: percentile(values, p) for p in percentiles]
+		base = sorted(measured(sum(baseRuns, [])))
+		new = sorted(measured(sum(newRuns, [])))
+		intervals = interval(baseRuns, newRuns, statistics, rng, options)
+		runs = min(len(baseRuns), len(newRuns))
+
+		for p, statistic, (low, high) in zip(percentiles, statistics, intervals):
+			value = change(statistic(base), statistic(new))
+			spread = spread_of([statistic(sorted(measured(run))) for run in baseRuns])
+			rows.append({'metric': '%s p%g' % (label, p), 'base': statistic(base), 'new': statistic(new),
+						 'change': value, 'low': low, 'high': high, 'spread': spread,
+						 'verdict': verdict(value, low, high, spread, runs, options)})
+	return rows
+
+def compare_stages(baseReports, newReports, rng, options):
+	"""Stages only have summaries, their intervals need two runs a side."""
+	rows = []
+	stages = []
+	for report in baseReports:
+		for stage in sorted((report.get('stages') or {}).get('stages', {})):
+			if stage not in stages:
+				stages.append(stage)
+
+	for stage in stages:
+		for clock in ('cpu_ms', 'gpu_ms'):
+			def means(reports):
+				out = []
+				for report in reports:
+					times = (report.get('stages') or {}).get('stages', {}).get(stage)
+					if times and times.get(clock):
+						out.append(times[clock]['mean'])
+				return out
+
+			baseMeans, newMeans = means(baseReports), means(newReports)
+			if not baseMeans or not newMeans:
+				continue
+
+			mean = lambda values: sum(values) / len(values)
+			base, new = mean(baseMeans), mean(newMeans)
+			low = high = float('nan')
+			if len(baseMeans) > 1 and len(newMeans) > 1:
+				low, high = interval([[m] for m in baseMeans], [[m] for m in newMeans],
+									 [mean], rng, options)[0]
+
+			value, spread = change(base, new), spread_of(baseMeans)
+			rows.append({'metric': '%s %s' % (stage, clock[:3]), 'base': base, 'new': new,
+						 'change': value, 'low': low, 'high': high, 'spread': spread,
+						 'verdict': verdict(value, low, high, spread,
+											min(len(baseMeans), len(newMeans)), options)})
+	return rows
+
+def warnings_of(baseReports, newReports, options):
+	out = []
+	for section, key in METADATA:
+		values = lambda reports: sorted(set(str((r.get(section) or {}).get(key)) for r in reports))
+		base, new = values(baseReports), values(newReports)
+		if base != new:
+			out.append('%s %s differs: %s vs %s' % (section, key, ', '.join(base), ', '.join(new)))
+
+	def draws(reports):
+		return sorted(set((r.get('draws') or {}).get('triangles_per_frame') for r in reports))
+	if draws(baseReports) != draws(newReports):
+		out.append('triangles per frame differ: %s vs %s' % (draws(baseReports), draws(newReports)))
+
+	#the baseline runs against each other, what the host alone does
+	if len(baseReports) == 1 or len(newReports) == 1:
+		out.append('one run a side, changes of the host between runs are not in the intervals; '
+				   'nothing is flagged beyond noisy')
+	elif len(baseReports) > 1:
+		medians = [percentile(sorted(measured(samples_of(r, 'frame_ms'))), 50.0) for r in baseReports]
+		spread = change(min(medians), max(medians))
+		if spread > options.threshold:
+			out.append('baseline runs differ by %.1f%% among themselves, the host is noisy' % spread)
+	return out
+
+def format_value(value):
+	return '-' if value is None or math.isnan(value) else '%.3f' % value
+
+def format_change(value):
+	return '-' if math.isnan(value) else '%+.1f%%' % value
+
+def write_rows(rows, options):
+	sys.stdout.write('\t%-14s %10s %10s %8s  %-20s %8s\n' %
+					 ('metric', 'base ms', 'new ms', 'change', '%g%% interval' % options.confidence, 'spread'))
+	for row in rows:
+		ci = '-' if math.isnan(row['low']) else '[%s, %s]' % (format_change(row['low']), format_change(row['high']))
+		spread = '-' if math.isnan(row['spread']) else '%.1f%%' % row['spread']
+		sys.stdout.write('\t%-14s %10s %10s %8s  %-20s %8s  %s\n' %
+						 (row['metric'], format_value(row['base']), format_value(row['new']),
+						  format_change(row['change']), ci, spread, row['verdict']))
+
+def to_json(value):
+	"""NaN isn't JSON, null instead."""
+	if isinstance(value, float) and math.isnan(value):
+		return None
+	if isinstance(value, dict):
+		return dict((k, to_json(v)) for k, v in value.items())
+	if isinstance(value, list):
+		return [to_json(v) for v in value]
+	return value
+
+def parse(argv, options):
+	files = []
+	i = 1
+	while i < len(argv):
+		arg = argv[i]
+		if arg in ('-threshold', '-confidence', '-resamples', '-seed', '-json') and i + 1 < len(argv):
+			value = argv[i + 1]
+			if arg == '-threshold':		options.threshold = float(value)
+			if arg == '-confidence':	options.confidence = float(value)
+			if arg == '-resamples':		options.resamples = int(value)
+			if arg == '-seed':			options.seed = int(value)
+			if arg == '-json':			options.json = value
+			i += 2
+		elif arg.startswith('-'):
+			return None
+		else:
+			files.append(arg)
+			i += 1
+	return files
+
+def main(argv):
+	options = Options()
+	files = parse(argv, options)
+	if not files or len(files) < 2:
+		sys.stderr.write('usage: CompareBenchmarks.py base.json[,base2.json] new.json[,new2.json] ... '
+						 '[-threshold %] [-confidence %] [-resamples N] [-seed N] [-json out.json]\n')
+		return 2
+
+	try:
+		base = group(files[0])
+		candidates = [(paths, group(paths)) for paths in files[1:]]
+	except (IOError, ValueError) as e:
+		sys.stderr.write('%s\n' % e)
+		return 2
+
+	rng = random.Random(options.seed)
+	results = []
+	regressed = False
+
+	for paths, scenes in candidates:
+		for scene in sorted(scenes):
+			if scene not in base:
+				sys.stderr.write('%s: no baseline for scene %s\n' % (paths, scene))
+				continue
+
+			baseReports, newReports = base[scene], scenes[scene]
+			rows = compare_frames(baseReports, newReports, rng, options)
+			rows += compare_stages(baseReports, newReports, rng, options)
+			warnings = warnings_of(baseReports, newReports, options)
+
+			sys.stdout.write('%s vs %s, %s (%d vs %d runs)\n' %
+							 (files[0], paths, scene, len(baseReports), len(newReports)))
+			for warning in warnings:
+				sys.stdout.write('\twarning: %s\n' % warning)
+			write_rows(rows, options)
+			sys.stdout.write('\n')
+
+			regressed = regressed or any(row['verdict'] == 'REGRESSION' for row in rows)
+			results.append({'base': files[0], 'new': paths, 'scene': scene,
+							'warnings': warnings, 'metrics': rows})
+
+	if options.json:
+		with open(options.json, 'w') as f:
+			json.dump(to_json({'threshold': options.threshold, 'confidence': options.confidence,
+							   'regressed': regressed, 'comparisons': results}), f, indent=1)
+
+	return 1 if regressed else 0
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv))
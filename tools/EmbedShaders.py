@@ -0,0 +1,104 @@
+#!/usr/bin/env python
+#
+#@file	EmbedShaders.py
+#@brief	Generates EmbeddedShaders.cpp, the table of shader sources compiled
+#		into the executable (see ShaderSource.h). Run as a pre-build step:
+#
+#		python tools/EmbedShaders.py EmbeddedShaders.cpp CharcoalRendering.vert ...
+#
+#@author	Hector Morales Piloni
+#@date	October 19, 2026
+#
+
+import os
+import sys
+
+def fnv1a(data, seed=2166136261):
+	"""32 bit FNV-1a, must match ShaderSource::Hash()."""
+	h = seed
+	for byte in bytearray(data):
+		h ^= byte
+		h = (h * 16777619) & 0xFFFFFFFF
+	return h
+
+def escape(line):
+	out = []
+	for ch in line:
+		if ch == '\\' or ch == '"':
+			out.append('\\' + ch)
+		elif ch == '\t':
+			out.append('\\t')
+		elif ord(ch) < 32 or ord(ch) > 126:
+			#octal escapes are at most 3 digits, safe before any character
+			out.append('\\%03o' % ord(ch))
+		else:
+			out.append(ch)
+	return ''.join(out)
+
+def embed(path):
+	with open(path, 'rb') as f:
+		#same bytes the text mode reader returns on every platform
+		data = f.read().replace(b'\r\n', b'\n')
+
+	lines = data.decode('latin-1').split('\n')
+	if lines and lines[-1] == '':
+		lines.pop()
+
+	literal = '\n'.join('\t"%s\\n"' % escape(line) for line in lines)
+	if not literal:
+		literal = '\t""'
+
+	# sources without a trailing new line get one, like the disk loader
+	if not data.endswith(b'\n') and data:
+		data += b'\n'
+
+	return os.path.basename(path), literal, len(data), fnv1a(data)
+
+def main(argv):
+	if len(argv) < 3:
+		sys.stderr.write('usage: EmbedShaders.py output.cpp shader...\n')
+		return 1
+
+	output = argv[1]
+	shaders = [embed(path) for path in argv[2:]]
+
+	out = []
+	out.append('///============================================================================')
+	out.append('///@file\t%s' % os.path.basename(output))
+	out.append('///@brief\tShader sources embedded at build time.')
+	out.append('///\t\t\tGENERATED by tools/EmbedShaders.py, do not edit.')
+	out.append('///============================================================================')
+	out.append('')
+	out.append('#include "ShaderSource.h"')
+	out.append('')
+
+	for index, (name, literal, length, hash) in enumerate(shaders):
+		out.append('//%s' % name)
+		out.append('static const char s_Source%d[] =' % index)
+		out.append(literal + ';')
+		out.append('')
+
+	out.append('const EmbeddedShader g_EmbeddedShaders[] =')
+	out.append('{')
+	for index, (name, literal, length, hash) in enumerate(shaders):
+		out.append('\t{ "%s", s_Source%d, %d, 0x%08Xu },' % (name, index, length, hash))
+	out.append('};')
+	out.append('')
+	out.append('const unsigned int g_EmbeddedShaderCount = sizeof(g_EmbeddedShaders) / sizeof(g_EmbeddedShaders[0]);')
+	out.append('')
+
+	text = '\n'.join(out)
+
+	#don't touch the file if nothing changed, avoids needless rebuilds
+	if os.path.exists(output):
+		with open(output, 'rb') as f:
+			if f.read().decode('latin-1') == text:
+				return 0
+
+	with open(output, 'wb') as f:
+		f.write(text.encode('latin-1'))
+
+	return 0
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv))